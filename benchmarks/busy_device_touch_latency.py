@@ -0,0 +1,71 @@
+#!/usr/bin/python3
+
+# Measures how much a busy input device delays the touches of another device.
+# One touch screen is flooded with motion while a second one performs slow
+# drags; the kernel to client latency of the second screen is compared with
+# and without a dedicated seat dispatch thread in the host server.
+
+from mir_perf_framework import PerformanceTest, Server, Client, TouchScreen
+import threading
+import time
+import statistics
+
+####### TEST #######
+
+busy_screen = TouchScreen(name="busy-finger")
+quiet_screen = TouchScreen(name="quiet-finger")
+
+def flood(screen, stop):
+    xy = (10, 10)
+    screen.finger_down_at(xy)
+    while not stop.is_set():
+        xy = (10 + (xy[0] + 1) % 300, 10 + (xy[1] + 1) % 300)
+        screen.finger_move_to(xy)
+    screen.finger_up()
+
+def run(host_options):
+    host = Server(reports=["input"], options=host_options)
+    client = Client(server=host, reports=["client-input-receiver"], options=["-f"])
+
+    test = PerformanceTest([host, client])
+    test.start()
+
+    stop = threading.Event()
+    flooder = threading.Thread(target=flood, args=(busy_screen, stop))
+    flooder.start()
+
+    # Perform three 1-second drag movements
+    for i in range(3):
+        xy = (100,100)
+        quiet_screen.finger_down_at(xy)
+        for i in range(100):
+            quiet_screen.finger_move_to(xy)
+            xy = (xy[0] + 5, xy[1] + 5)
+            time.sleep(0.01)
+        quiet_screen.finger_up()
+
+    stop.set()
+    flooder.join()
+    test.stop()
+
+    ####### TRACE PARSING #######
+
+    data = {}
+
+    for event in test.babeltrace().events:
+        if event.name == "mir_client_input_receiver:touch_event":
+            device = event["device_id"]
+            if device not in data: data[device] = []
+            data[device].append((event.timestamp - event["event_time"]) / 1000000.0)
+
+    # The quiet screen is the device that sent the fewest events
+    return min(data.values(), key=len)
+
+print("=== Results ===")
+
+for (label, options) in [("Shared input thread", []),
+                         ("Seat dispatch thread", ["--seat-dispatch-thread=true"])]:
+    quiet_data = run(options)
+    print("%s: client received %d events from the quiet device" % (label, len(quiet_data)))
+    print("%s: kernel to client mean: %f ms stdev: %f ms max: %f ms" %
+          (label, statistics.mean(quiet_data), statistics.stdev(quiet_data), max(quiet_data)))
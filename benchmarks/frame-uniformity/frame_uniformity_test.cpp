@@ -18,14 +18,25 @@
 
 #include "frame_uniformity_test.h"
 
+#include "mir_test_framework/headless_nested_server_runner.h"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+namespace mtf = mir_test_framework;
+
 FrameUniformityTest::FrameUniformityTest(FrameUniformityTestParameters const& parameters)
-    : client_ready_fence{2},
+    : parameters(parameters),
+      client_ready_fence{2},
       server_configuration({{0, 0}, parameters.screen_size},
           parameters.touch_start,
           parameters.touch_end,
           parameters.touch_duration,
+          parameters.vsync_rate_in_hz,
+          parameters.input_rate_in_hz,
           client_ready_fence),
-      client(client_ready_fence, parameters.touch_duration)
+      client(client_ready_fence, parameters.screen_size, parameters.touch_duration)
 {
 }
 
@@ -37,7 +48,41 @@ mir::DefaultServerConfiguration& FrameUniformityTest::server_config()
 void FrameUniformityTest::run_test()
 {
     start_server();
-    client.run(new_connection());
+
+    std::unique_ptr<mtf::HeadlessNestedServerRunner> nested_server;
+    if (parameters.nested)
+    {
+        nested_server = std::make_unique<mtf::HeadlessNestedServerRunner>(new_connection());
+        nested_server->start_server();
+    }
+
+    auto const connect_string = [&]
+        { return nested_server ? nested_server->new_connection() : new_connection(); };
+
+    mir::test::Barrier windows_ready(parameters.background_clients + 1);
+    std::atomic<bool> stop_rendering{false};
+    std::vector<std::thread> background_clients;
+
+    for (int i = 0; i != parameters.background_clients; ++i)
+    {
+        background_clients.emplace_back(
+            [this, &windows_ready, &stop_rendering, connect_string = connect_string()]
+            {
+                RenderingClient{windows_ready, parameters.screen_size, stop_rendering}.run(connect_string);
+            });
+    }
+
+    // The measured window is created last so that it is on top and receives the touches
+    windows_ready.ready();
+    client.run(connect_string());
+
+    stop_rendering = true;
+    for (auto& thread : background_clients)
+        thread.join();
+
+    if (nested_server)
+        nested_server->stop_server();
+
     stop_server();
 }
 
@@ -39,6 +39,14 @@ struct FrameUniformityTestParameters
     mir::geometry::Point touch_end;
 
     std::chrono::milliseconds touch_duration;
+
+    int vsync_rate_in_hz;
+    int input_rate_in_hz;
+
+    // Clients rendering continuously beneath the measured one
+    int background_clients;
+    // Whether the measured client connects through a nested server
+    bool nested;
 };
 
 class FrameUniformityTest : public mir_test_framework::ServerRunner
@@ -56,6 +64,7 @@ public:
     TouchProducingServer::TouchTimings server_timings();
 
 private:
+    FrameUniformityTestParameters const parameters;
     mir::test::Barrier client_ready_fence;
     TouchProducingServer server_configuration;
     TouchMeasuringClient client;
@@ -18,18 +18,25 @@
 
 #include "frame_uniformity_test.h"
 #include "mir_test_framework/executable_path.h"
+#include "mir_test_framework/main.h"
 #include "mir/geometry/displacement.h"
 
+#include <boost/program_options.hpp>
+
 #include <assert.h>
 #include <cmath>
 
 #include <chrono>
+#include <fstream>
 #include <iostream>
+#include <sstream>
 
 #include <gtest/gtest.h>
+#include <gmock/gmock.h>
 
 namespace geom = mir::geometry;
 namespace mtf = mir_test_framework;
+namespace po = boost::program_options;
 
 namespace
 {
@@ -105,28 +112,87 @@ Results compute_frame_uniformity(std::vector<TouchSamples::Sample> const& result
     return {average_pixel_offset, uniformity};
 }
 
+struct Options
+{
+    int screen_width;
+    int screen_height;
+    int touch_start_x;
+    int touch_start_y;
+    int touch_end_x;
+    int touch_end_y;
+    int touch_duration_ms;
+    int vsync_rate_in_hz;
+    int input_rate_in_hz;
+    int run_count;
+    int background_clients;
+    bool nested;
+    std::string json_output;
+    std::string baseline;
+    double tolerance_percent;
+} options;
+
+void write_json(std::ostream& out, std::vector<Results> const& runs, Results const& average)
+{
+    out << "{\n"
+        << "  \"benchmark\": \"frame-uniformity\",\n"
+        << "  \"parameters\": {"
+        << "\"screen_width\": " << options.screen_width
+        << ", \"screen_height\": " << options.screen_height
+        << ", \"touch_start\": [" << options.touch_start_x << ", " << options.touch_start_y << "]"
+        << ", \"touch_end\": [" << options.touch_end_x << ", " << options.touch_end_y << "]"
+        << ", \"touch_duration_ms\": " << options.touch_duration_ms
+        << ", \"vsync_rate\": " << options.vsync_rate_in_hz
+        << ", \"input_rate\": " << options.input_rate_in_hz
+        << ", \"background_clients\": " << options.background_clients
+        << ", \"nested\": " << (options.nested ? "true" : "false")
+        << "},\n"
+        << "  \"runs\": [";
+
+    for (auto run = runs.begin(); run != runs.end(); ++run)
+    {
+        out << (run == runs.begin() ? "" : ", ")
+            << "{\"pixel_lag\": " << run->average_pixel_offset
+            << ", \"uniformity\": " << run->frame_uniformity << "}";
+    }
+
+    out << "],\n"
+        << "  \"average_pixel_lag\": " << average.average_pixel_offset << ",\n"
+        << "  \"frame_uniformity\": " << average.frame_uniformity << "\n"
+        << "}\n";
+}
+
+// The baseline is the output of a previous run, so we only need to find its summary values
+double baseline_value(std::string const& json, std::string const& key)
+{
+    auto const pos = json.find("\"" + key + "\":");
+    if (pos == std::string::npos)
+        throw std::runtime_error("Baseline has no \"" + key + "\"");
+
+    return std::stod(json.substr(pos + key.size() + 3));
+}
 }
 
-// Main is inside a test to work around mir_test_framework 'issues' (e.g. mir_test_framework contains
-// a main function).
+// Main is inside a test to work around mir_test_framework 'issues' (e.g. the server
+// configuration is taken from the command line mir_test_framework::main() is given).
 TEST(FrameUniformity, average_frame_offset)
 {
-    geom::Size const screen_size{1024, 1024};
-    geom::Point const touch_start_point{0, 0};
-    geom::Point const touch_end_point{1024, 1024};
-    std::chrono::milliseconds touch_duration{1000};
-    
-    int const run_count = 1;
-    double average_lag = 0, average_uniformity = 0;
+    geom::Size const screen_size{options.screen_width, options.screen_height};
+    geom::Point const touch_start_point{options.touch_start_x, options.touch_start_y};
+    geom::Point const touch_end_point{options.touch_end_x, options.touch_end_y};
+    std::chrono::milliseconds const touch_duration{options.touch_duration_ms};
+
+    std::vector<Results> runs;
+    Results average{0, 0};
 
     // Ensure we load the correct platform libraries
     setenv("MIR_CLIENT_PLATFORM_PATH",
            (mtf::library_path() + "/client-modules").c_str(),
            true);
     
-    for (int i = 0; i < run_count; i++)
+    for (int i = 0; i < options.run_count; i++)
     {
-        FrameUniformityTest t({screen_size, touch_start_point, touch_end_point, touch_duration});
+        FrameUniformityTest t({screen_size, touch_start_point, touch_end_point, touch_duration,
+            options.vsync_rate_in_hz, options.input_rate_in_hz, options.background_clients, options.nested});
 
         t.run_test();
   
@@ -135,17 +201,103 @@ TEST(FrameUniformity, average_frame_offset)
         auto touch_end_time = touch_timings.touch_end;
         auto samples = t.client_results()->get();
 
-        auto results = compute_frame_uniformity(samples, touch_start_point, touch_end_point,
-            touch_start_time, touch_end_time);
+        ASSERT_THAT(samples, testing::Not(testing::IsEmpty())) << "The client saw no touches";
+
+        runs.push_back(compute_frame_uniformity(samples, touch_start_point, touch_end_point,
+            touch_start_time, touch_end_time));
         
-        average_lag += results.average_pixel_offset;
-        average_uniformity += results.frame_uniformity;
+        average.average_pixel_offset += runs.back().average_pixel_offset;
+        average.frame_uniformity += runs.back().frame_uniformity;
     }
     
-    average_lag /= run_count;
-    average_uniformity /= run_count;
+    average.average_pixel_offset /= options.run_count;
+    average.frame_uniformity /= options.run_count;
     
-    std::cout << "Average pixel lag: " << average_lag << "px" << std::endl;
-    std::cout << "Frame Uniformity (smaller scores are more uniform): " << average_uniformity << "px per sample\n"
+    std::cout << "Average pixel lag: " << average.average_pixel_offset << "px" << std::endl;
+    std::cout << "Frame Uniformity (smaller scores are more uniform): " << average.frame_uniformity << "px per sample\n"
         << std::endl;
+
+    if (!options.json_output.empty())
+    {
+        std::ofstream out{options.json_output};
+        write_json(out, runs, average);
+        EXPECT_TRUE(out.good()) << "Failed to write " << options.json_output;
+    }
+
+    if (!options.baseline.empty())
+    {
+        std::ifstream in{options.baseline};
+        ASSERT_TRUE(in.good()) << "Failed to read " << options.baseline;
+
+        std::stringstream baseline;
+        baseline << in.rdbuf();
+
+        auto const allowance = 1.0 + options.tolerance_percent / 100.0;
+        auto const baseline_lag = baseline_value(baseline.str(), "average_pixel_lag");
+        auto const baseline_uniformity = baseline_value(baseline.str(), "frame_uniformity");
+
+        std::cout << "Baseline pixel lag: " << baseline_lag << "px, "
+            << "frame uniformity: " << baseline_uniformity << "px per sample" << std::endl;
+
+        EXPECT_THAT(average.average_pixel_offset, testing::Le(baseline_lag * allowance))
+            << "Average pixel lag regressed by more than " << options.tolerance_percent << "%";
+        EXPECT_THAT(average.frame_uniformity, testing::Le(baseline_uniformity * allowance))
+            << "Frame uniformity regressed by more than " << options.tolerance_percent << "%";
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    po::options_description description{"Frame uniformity benchmark options"};
+    description.add_options()
+        ("help", "Show these options (others are passed on to gtest and the server)")
+        ("config", po::value<std::string>(), "Read options from a file of \"option=value\" lines")
+        ("screen-width", po::value(&options.screen_width)->default_value(1024), "Width of the simulated display [px]")
+        ("screen-height", po::value(&options.screen_height)->default_value(1024), "Height of the simulated display [px]")
+        ("touch-start-x", po::value(&options.touch_start_x)->default_value(0), "Where the touch starts [px]")
+        ("touch-start-y", po::value(&options.touch_start_y)->default_value(0), "Where the touch starts [px]")
+        ("touch-end-x", po::value(&options.touch_end_x)->default_value(1024), "Where the touch ends [px]")
+        ("touch-end-y", po::value(&options.touch_end_y)->default_value(1024), "Where the touch ends [px]")
+        ("touch-duration", po::value(&options.touch_duration_ms)->default_value(1000), "Duration of the touch [ms]")
+        ("vsync-rate", po::value(&options.vsync_rate_in_hz)->default_value(60), "Simulated display refresh rate [Hz]")
+        ("input-rate", po::value(&options.input_rate_in_hz)->default_value(100), "Touch event rate [Hz]")
+        ("runs", po::value(&options.run_count)->default_value(1), "Number of runs to average the results over")
+        ("background-clients", po::value(&options.background_clients)->default_value(0),
+            "Number of clients rendering beneath the measured one")
+        ("nested", po::bool_switch(&options.nested), "Measure a client of a nested server")
+        ("json", po::value(&options.json_output), "Write the parameters and results to this file as JSON")
+        ("baseline", po::value(&options.baseline), "Fail if the results are worse than in this JSON output of a previous run")
+        ("tolerance", po::value(&options.tolerance_percent)->default_value(10.0),
+            "How much worse than the baseline the results may be [%]");
+
+    po::variables_map variables;
+    auto const parsed = po::command_line_parser(argc, argv).options(description).allow_unregistered().run();
+    po::store(parsed, variables);
+
+    if (variables.count("config"))
+        po::store(po::parse_config_file<char>(variables["config"].as<std::string>().c_str(), description), variables);
+
+    po::notify(variables);
+
+    if (variables.count("help"))
+    {
+        std::cout << description << std::endl;
+        return 0;
+    }
+
+    if (options.vsync_rate_in_hz < 1 || options.input_rate_in_hz < 1 || options.run_count < 1 ||
+        options.background_clients < 0 || options.screen_width < 1 || options.screen_height < 1)
+    {
+        std::cerr << "Invalid options\n" << description << std::endl;
+        return 1;
+    }
+
+    // Everything we don't recognise is for gtest and the server
+    auto passed_on = po::collect_unrecognized(parsed.options, po::include_positional);
+    std::vector<char*> args{argv[0]};
+    for (auto& arg : passed_on)
+        args.push_back(&arg[0]);
+    args.push_back(nullptr);
+
+    return mtf::main(args.size() - 1, args.data());
 }
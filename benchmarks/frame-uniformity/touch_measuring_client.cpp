@@ -31,15 +31,15 @@ namespace
 
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wdeprecated-declarations"
-MirWindow *create_window(MirConnection *connection)
+MirWindow *create_window(MirConnection *connection, mir::geometry::Size const& size, char const* name)
 {
     MirPixelFormat pixel_format;
     unsigned int valid_formats;
     mir_connection_get_available_surface_formats(connection, &pixel_format, 1, &valid_formats);
 
-    auto const spec = mir_create_normal_window_spec(connection, 1024, 1024);
+    auto const spec = mir_create_normal_window_spec(connection, size.width.as_int(), size.height.as_int());
     mir_window_spec_set_pixel_format(spec, pixel_format);
-    mir_window_spec_set_name(spec, "frame-uniformity-test");
+    mir_window_spec_set_name(spec, name);
     mir_window_spec_set_buffer_usage(spec, mir_buffer_usage_hardware);
 
     auto window = mir_create_window_sync(spec);
@@ -80,8 +80,10 @@ void collect_input_and_frame_timing(MirWindow *surface, mt::Barrier& client_read
 }
 
 TouchMeasuringClient::TouchMeasuringClient(mt::Barrier& client_ready,
+    mir::geometry::Size const& window_size,
     std::chrono::high_resolution_clock::duration const& touch_duration)
     : client_ready(client_ready),
+      window_size(window_size),
       touch_duration(touch_duration),
       results_(std::make_shared<TouchSamples>())
 {
@@ -92,11 +94,10 @@ namespace
 void null_lifecycle_callback(MirConnection*, MirLifecycleState, void*)
 {
 }
-}
 
-void TouchMeasuringClient::run(std::string const& connect_string)
+MirConnection* connect(std::string const& connect_string, char const* name)
 {
-    auto connection = mir_connect_sync(connect_string.c_str(), "frame-uniformity-test");
+    auto connection = mir_connect_sync(connect_string.c_str(), name);
     if (!mir_connection_is_valid(connection))
     {
         std::cerr << "Connection to Mir failed: " << mir_connection_get_error_message(connection) << std::endl;
@@ -108,8 +109,15 @@ void TouchMeasuringClient::run(std::string const& connect_string)
      * (default callback raises SIGHUP).
      */
     mir_connection_set_lifecycle_event_callback(connection, null_lifecycle_callback, nullptr);
-    
-    auto window = create_window(connection);
+
+    return connection;
+}
+}
+
+void TouchMeasuringClient::run(std::string const& connect_string)
+{
+    auto connection = connect(connect_string, "frame-uniformity-test");
+    auto window = create_window(connection, window_size, "frame-uniformity-test");
 
     collect_input_and_frame_timing(window, client_ready, touch_duration, results_);
     
@@ -121,3 +129,29 @@ std::shared_ptr<TouchSamples> TouchMeasuringClient::results()
 {
     return results_;
 }
+
+RenderingClient::RenderingClient(mt::Barrier& window_ready,
+    mir::geometry::Size const& window_size,
+    std::atomic<bool> const& stop)
+    : window_ready(window_ready),
+      window_size(window_size),
+      stop(stop)
+{
+}
+
+void RenderingClient::run(std::string const& connect_string)
+{
+    auto connection = connect(connect_string, "frame-uniformity-load");
+    auto window = create_window(connection, window_size, "frame-uniformity-load");
+
+    window_ready.ready();
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wdeprecated-declarations"
+    while (!stop)
+        mir_buffer_stream_swap_buffers_sync(mir_window_get_buffer_stream(window));
+#pragma GCC diagnostic pop
+
+    mir_window_release_sync(window);
+    mir_connection_release(connection);
+}
@@ -22,14 +22,18 @@
 #include "touch_samples.h"
 
 #include "mir/test/barrier.h"
+#include "mir/geometry/size.h"
 
+#include <atomic>
 #include <chrono>
 #include <memory>
+#include <string>
 
 class TouchMeasuringClient
 {
 public:
     TouchMeasuringClient(mir::test::Barrier& client_ready,
+        mir::geometry::Size const& window_size,
         std::chrono::high_resolution_clock::duration const& touch_duration);
     
     void run(std::string const& connect_string);
@@ -38,10 +42,30 @@ public:
 
 private:
     mir::test::Barrier& client_ready;
+
+    mir::geometry::Size const window_size;
     
     std::chrono::high_resolution_clock::duration const touch_duration;
     
     std::shared_ptr<TouchSamples> results_;
 };
 
+// Renders as fast as it is allowed to, to load the server while another client is measured
+class RenderingClient
+{
+public:
+    RenderingClient(mir::test::Barrier& window_ready,
+        mir::geometry::Size const& window_size,
+        std::atomic<bool> const& stop);
+
+    void run(std::string const& connect_string);
+
+private:
+    mir::test::Barrier& window_ready;
+
+    mir::geometry::Size const window_size;
+
+    std::atomic<bool> const& stop;
+};
+
 #endif // TOUCH_MEASURING_CLIENT_H_
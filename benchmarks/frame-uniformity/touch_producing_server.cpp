@@ -35,12 +35,15 @@ namespace mtf = mir_test_framework;
 
 TouchProducingServer::TouchProducingServer(geom::Rectangle screen_dimensions, geom::Point touch_start,
     geom::Point touch_end, std::chrono::high_resolution_clock::duration touch_duration,
-    mt::Barrier &client_ready)
+    int vsync_rate_in_hz, int input_rate_in_hz, mt::Barrier &client_ready)
     : FakeInputServerConfiguration({screen_dimensions}),
       screen_dimensions(screen_dimensions),
       touch_start(touch_start),
       touch_end(touch_end),
       touch_duration(touch_duration),
+      vsync_rate_in_hz(vsync_rate_in_hz),
+      pause_between_events(std::chrono::duration_cast<std::chrono::high_resolution_clock::duration>(
+          std::chrono::seconds(1)) / input_rate_in_hz),
       client_ready(client_ready),
       touch_screen(mtf::add_fake_input_device(mi::InputDeviceInfo{
                                               "touch screen", "touch-screen-uid", mi::DeviceCapability::touchscreen | mi::DeviceCapability::multitouch}))
@@ -56,11 +59,8 @@ TouchProducingServer::~TouchProducingServer()
 
 std::shared_ptr<mg::Platform> TouchProducingServer::the_graphics_platform()
 {
-    // TODO: Support configuration
-    int const refresh_rate_in_hz = 60;
-
     if (!graphics_platform)
-        graphics_platform = std::make_shared<VsyncSimulatingPlatform>(screen_dimensions.size, refresh_rate_in_hz);
+        graphics_platform = std::make_shared<VsyncSimulatingPlatform>(screen_dimensions.size, vsync_rate_in_hz);
     
     return graphics_platform;
 }
@@ -82,9 +82,6 @@ void TouchProducingServer::synthesize_event_at(geom::Point const& point)
 
 void TouchProducingServer::thread_function()
 {
-    // We could make the touch sampling rate customizable
-    std::chrono::milliseconds const pause_between_events{10};
-
     client_ready.ready();
     
     auto start = std::chrono::high_resolution_clock::now();
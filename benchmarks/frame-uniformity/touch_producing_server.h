@@ -31,7 +31,7 @@
 class TouchProducingServer : public mir_test_framework::FakeInputServerConfiguration
 {
 public:
-    TouchProducingServer(mir::geometry::Rectangle screen_dimensions, mir::geometry::Point touch_start, mir::geometry::Point touch_end, std::chrono::high_resolution_clock::duration touch_duration, mir::test::Barrier& client_ready);
+    TouchProducingServer(mir::geometry::Rectangle screen_dimensions, mir::geometry::Point touch_start, mir::geometry::Point touch_end, std::chrono::high_resolution_clock::duration touch_duration, int vsync_rate_in_hz, int input_rate_in_hz, mir::test::Barrier& client_ready);
     
     struct TouchTimings {
         std::chrono::high_resolution_clock::time_point touch_start;
@@ -48,6 +48,8 @@ private:
     mir::geometry::Point const touch_start;
     mir::geometry::Point const touch_end;
     std::chrono::high_resolution_clock::duration const touch_duration;
+    int const vsync_rate_in_hz;
+    std::chrono::high_resolution_clock::duration const pause_between_events;
 
     mir::test::Barrier& client_ready;
     
@@ -56,8 +56,11 @@ struct StubDisplaySyncGroup : mg::DisplaySyncGroup
         auto next_sync = last_sync + std::chrono::seconds(1) / vsync_rate_in_hz;
         
         if (now < next_sync)
+        {
             std::this_thread::sleep_for(next_sync - now);
-        
+            now = std::chrono::high_resolution_clock::now();
+        }
+
         last_sync = now;
     }
 
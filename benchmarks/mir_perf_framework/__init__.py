@@ -5,3 +5,4 @@ This modules provides a framework to facilitate writing Mir performance tests
 from .server import Server
 from .client import Client
 from .performance_test import PerformanceTest
+from .touch_screen import TouchScreen
@@ -0,0 +1,53 @@
+import evdev
+import subprocess
+
+class TouchScreen:
+    def __init__(self, name="autopilot-finger"):
+        """ Creates a uinput touch screen covering the whole framebuffer.
+
+        Args:
+            name (str): The device name reported to the server.
+        """
+        res = self.get_resolution()
+
+        allowed_events = {
+            evdev.ecodes.EV_ABS : (
+                (evdev.ecodes.ABS_MT_POSITION_X, (0, res[0], 0, 0)),
+                (evdev.ecodes.ABS_MT_POSITION_Y, (0, res[1], 0, 0)),
+                (evdev.ecodes.ABS_MT_TOUCH_MAJOR, (0, 30, 0, 0)),
+                (evdev.ecodes.ABS_MT_TRACKING_ID, (0, 65535, 0, 0)),
+                (evdev.ecodes.ABS_MT_PRESSURE, (0, 255, 0, 0)),
+                (evdev.ecodes.ABS_MT_SLOT, (0, 9, 0, 0))
+                ),
+            evdev.ecodes.EV_KEY: [
+                evdev.ecodes.BTN_TOUCH,
+                ]
+        }
+
+        self.ui = evdev.UInput(events=allowed_events, name=name)
+
+    def get_resolution(self):
+        out = subprocess.check_output(["fbset", "-s"])
+        out_list = out.split()
+        geometry = out_list.index(b"geometry")
+        return (int(out_list[geometry + 1]), int(out_list[geometry + 2]))
+
+    def finger_down_at(self, xy):
+        self.ui.write(evdev.ecodes.EV_ABS, evdev.ecodes.ABS_MT_SLOT, 0)
+        self.ui.write(evdev.ecodes.EV_ABS, evdev.ecodes.ABS_MT_TRACKING_ID, 0)
+        self.ui.write(evdev.ecodes.EV_KEY, evdev.ecodes.BTN_TOUCH, 1)
+        self.ui.write(evdev.ecodes.EV_ABS, evdev.ecodes.ABS_MT_POSITION_X, xy[0])
+        self.ui.write(evdev.ecodes.EV_ABS, evdev.ecodes.ABS_MT_POSITION_Y, xy[1])
+        self.ui.write(evdev.ecodes.EV_ABS, evdev.ecodes.ABS_MT_PRESSURE, 50)
+        self.ui.write(evdev.ecodes.EV_ABS, evdev.ecodes.ABS_MT_TOUCH_MAJOR, 4)
+        self.ui.syn()
+
+    def finger_up(self):
+        self.ui.write(evdev.ecodes.EV_ABS, evdev.ecodes.ABS_MT_TRACKING_ID, -1)
+        self.ui.syn()
+
+    def finger_move_to(self, xy):
+        self.ui.write(evdev.ecodes.EV_ABS, evdev.ecodes.ABS_MT_SLOT, 0)
+        self.ui.write(evdev.ecodes.EV_ABS, evdev.ecodes.ABS_MT_POSITION_X, xy[0])
+        self.ui.write(evdev.ecodes.EV_ABS, evdev.ecodes.ABS_MT_POSITION_Y, xy[1])
+        self.ui.syn()
@@ -1,59 +1,8 @@
 #!/usr/bin/python3
 
-from mir_perf_framework import PerformanceTest, Server, Client
+from mir_perf_framework import PerformanceTest, Server, Client, TouchScreen
 import time
-import evdev
 import statistics
-import subprocess
-
-###### Helper classes ######
-
-class TouchScreen:
-    def __init__(self):
-        res = self.get_resolution()
-
-        allowed_events = {
-            evdev.ecodes.EV_ABS : (
-                (evdev.ecodes.ABS_MT_POSITION_X, (0, res[0], 0, 0)),
-                (evdev.ecodes.ABS_MT_POSITION_Y, (0, res[1], 0, 0)),
-                (evdev.ecodes.ABS_MT_TOUCH_MAJOR, (0, 30, 0, 0)),
-                (evdev.ecodes.ABS_MT_TRACKING_ID, (0, 65535, 0, 0)),
-                (evdev.ecodes.ABS_MT_PRESSURE, (0, 255, 0, 0)),
-                (evdev.ecodes.ABS_MT_SLOT, (0, 9, 0, 0))
-                ),
-            evdev.ecodes.EV_KEY: [
-                evdev.ecodes.BTN_TOUCH,
-                ]
-        }
-        
-        self.ui = evdev.UInput(events=allowed_events, name="autopilot-finger")
-
-    def get_resolution(self):
-        out = subprocess.check_output(["fbset", "-s"])
-        out_list = out.split()
-        geometry = out_list.index(b"geometry")
-        return (int(out_list[geometry + 1]), int(out_list[geometry + 2]))
-
-    def finger_down_at(self, xy):
-        self.ui.write(evdev.ecodes.EV_ABS, evdev.ecodes.ABS_MT_SLOT, 0)
-        self.ui.write(evdev.ecodes.EV_ABS, evdev.ecodes.ABS_MT_TRACKING_ID, 0)
-        self.ui.write(evdev.ecodes.EV_KEY, evdev.ecodes.BTN_TOUCH, 1)
-        self.ui.write(evdev.ecodes.EV_ABS, evdev.ecodes.ABS_MT_POSITION_X, xy[0])
-        self.ui.write(evdev.ecodes.EV_ABS, evdev.ecodes.ABS_MT_POSITION_Y, xy[1])
-        self.ui.write(evdev.ecodes.EV_ABS, evdev.ecodes.ABS_MT_PRESSURE, 50)
-        self.ui.write(evdev.ecodes.EV_ABS, evdev.ecodes.ABS_MT_TOUCH_MAJOR, 4)
-        self.ui.syn()
-
-    def finger_up(self):
-        self.ui.write(evdev.ecodes.EV_ABS, evdev.ecodes.ABS_MT_TRACKING_ID, -1)
-        self.ui.syn()
-
-    def finger_move_to(self, xy):
-        self.ui.write(evdev.ecodes.EV_ABS, evdev.ecodes.ABS_MT_SLOT, 0)
-        self.ui.write(evdev.ecodes.EV_ABS, evdev.ecodes.ABS_MT_POSITION_X, xy[0])
-        self.ui.write(evdev.ecodes.EV_ABS, evdev.ecodes.ABS_MT_POSITION_Y, xy[1])
-        self.ui.syn()
-
 
 ####### TEST #######
 
@@ -500,6 +500,29 @@ void mir_connection_enumerate_extensions(
     void* context,
     void (*enumerator)(void* context, char const* extension, int version));
 
+/**
+ * Starts holding back the buffer submissions and window modifications made
+ * on the calling thread, so that they reach the server together.
+ *
+ * Until the matching mir_connection_commit_transaction() their callbacks
+ * are not called, so neither mir_buffer_stream_swap_buffers_sync() nor
+ * waiting on the callback of a held back call may be used in between.
+ * Transactions nest; only the outermost commit sends anything.
+ *
+ * \param [in] connection  The connection
+ */
+void mir_connection_begin_transaction(MirConnection* connection);
+
+/**
+ * Sends what the calling thread held back since
+ * mir_connection_begin_transaction() to the server in one message, which
+ * applies the window modifications and then the buffer submissions, in the
+ * order they were made, before it handles anything else from this client.
+ *
+ * \param [in] connection  The connection
+ */
+void mir_connection_commit_transaction(MirConnection* connection);
+
 #ifdef __cplusplus
 }
 /**@}*/
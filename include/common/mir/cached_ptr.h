@@ -19,14 +19,73 @@
 #ifndef MIR_CACHED_PTR_H_
 #define MIR_CACHED_PTR_H_
 
+#include "mir/startup_profiler.h"
+
 #include <functional>
 #include <memory>
+#include <mutex>
 
 namespace mir
 {
+namespace detail
+{
+inline bool& is_speculative_thread()
+{
+    static thread_local bool speculative{false};
+    return speculative;
+}
+}
+
+/**
+ * Thrown to a speculative construction that requests an object being constructed on another thread.
+ *
+ * This deliberately isn't a std::exception: it is not an error and must pass
+ * through the handlers that turn construction failures into error reports.
+ * Code that catches everything on a construction path rethrows it.
+ */
+struct ConstructionInProgress
+{
+};
+
+/**
+ * Marks the constructions on this thread as speculative while in scope.
+ *
+ * A speculative construction never waits for another thread: requesting an
+ * object that is being constructed elsewhere throws ConstructionInProgress
+ * instead. As only one side of any wait can then be blocked, speculative
+ * threads cannot deadlock with the threads that need their objects.
+ */
+class SpeculativeConstruction
+{
+public:
+    SpeculativeConstruction() : previous{detail::is_speculative_thread()}
+    {
+        detail::is_speculative_thread() = true;
+    }
+
+    ~SpeculativeConstruction()
+    {
+        detail::is_speculative_thread() = previous;
+    }
+
+private:
+    SpeculativeConstruction(SpeculativeConstruction const&) = delete;
+    SpeculativeConstruction& operator=(SpeculativeConstruction const&) = delete;
+
+    bool const previous;
+};
+
+/**
+ * Holds a weak reference to a lazily constructed object.
+ *
+ * Construction is serialised, so the object may be requested from more than
+ * one thread and is only constructed once. The lock is recursive, as a
+ * make() that wraps the object may request it again on the same thread.
+ */
 template<typename Type>
 class CachedPtr
 {
+    std::recursive_mutex mutex;
     std::weak_ptr<Type> cache;
     CachedPtr(CachedPtr const&) = delete;
     CachedPtr& operator=(CachedPtr const&) = delete;
@@ -35,10 +94,19 @@ public:
 
     std::shared_ptr<Type> operator()(std::function<std::shared_ptr<Type>()> make)
     {
+        std::unique_lock<std::recursive_mutex> lock{mutex, std::try_to_lock};
+        if (!lock.owns_lock())
+        {
+            if (detail::is_speculative_thread())
+                throw ConstructionInProgress{};
+            lock.lock();
+        }
+
         auto result = cache.lock();
         if (!result)
         {
-                cache = result = make();
+            StartupPhase const phase{typeid(std::shared_ptr<Type>)};
+            cache = result = make();
         }
         return result;
     }
@@ -65,6 +65,15 @@ protected:
 void log(Severity severity, const std::string& message, const std::string& component);
 void set_logger(std::shared_ptr<Logger> const& new_logger);
 
+/// Messages more verbose than this are dropped before they are formatted
+void set_max_severity(Severity severity);
+Severity max_severity();
+
+inline bool is_logged(Severity severity)
+{
+    return severity <= max_severity();
+}
+
 }
 }
 
@@ -0,0 +1,64 @@
+/*
+ * Copyright © 2017 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MIR_STARTUP_PROFILER_H_
+#define MIR_STARTUP_PROFILER_H_
+
+#include <iosfwd>
+#include <typeinfo>
+
+namespace mir
+{
+/**
+ * Starts recording the time spent in each StartupPhase.
+ *
+ * Every object built through a CachedPtr is a phase, named after its type,
+ * so this records how long each component of the server took to construct
+ * and which components it constructed along the way.
+ */
+void enable_startup_profile();
+bool startup_profile_enabled();
+
+/**
+ * Writes the time spent in each phase so far, in microseconds.
+ *
+ * Each line is a stack of nested phases separated by ';' followed by the time
+ * spent in the innermost phase itself, the "collapsed stack" format read by
+ * flamegraph.pl and speedscope. Phases that ran on other threads are separate
+ * stacks.
+ */
+void write_startup_profile(std::ostream& out);
+
+/// Logs the time since profiling was enabled, the first time each milestone is reached
+void startup_milestone(char const* name);
+
+class StartupPhase
+{
+public:
+    explicit StartupPhase(char const* name);
+    /// A phase named after the type, with any std::shared_ptr<> removed
+    explicit StartupPhase(std::type_info const& type);
+    ~StartupPhase();
+
+private:
+    StartupPhase(StartupPhase const&) = delete;
+    StartupPhase& operator=(StartupPhase const&) = delete;
+
+    bool const recording;
+};
+}
+
+#endif /* MIR_STARTUP_PROFILER_H_ */
@@ -0,0 +1,55 @@
+/*
+ * Copyright © 2017 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 or 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MIRAL_FRAME_RATE_LIMITS_H
+#define MIRAL_FRAME_RATE_LIMITS_H
+
+#include <mir_toolkit/common.h>
+
+#include <memory>
+
+namespace mir { class Server; }
+
+namespace miral
+{
+/// Limit the frame rate of windows that don't have focus or can't be seen.
+/// The clients of limited windows are paced to the limit, so they don't spend
+/// CPU and GPU time on frames that would never be shown.
+/// Focused windows are never limited. By default occluded windows are held to
+/// their queued frames and unfocused windows that are on screen are unlimited.
+class FrameRateLimits
+{
+public:
+    FrameRateLimits();
+    ~FrameRateLimits();
+    FrameRateLimits(FrameRateLimits const&);
+    auto operator=(FrameRateLimits const&) -> FrameRateLimits&;
+
+    /// Limit unfocused, visible windows of the given type (0 for no limit)
+    auto unfocused(MirWindowType type, unsigned frames_per_second) -> FrameRateLimits&;
+
+    /// Limit occluded windows of the given type (0 for no limit)
+    auto occluded(MirWindowType type, unsigned frames_per_second) -> FrameRateLimits&;
+
+    void operator()(mir::Server& server) const;
+
+private:
+    struct Self;
+    std::shared_ptr<Self> self;
+};
+}
+
+#endif //MIRAL_FRAME_RATE_LIMITS_H
@@ -20,6 +20,7 @@
 #define MIR_GRAPHICS_DISPLAY_REPORT_H_
 
 #include <EGL/egl.h>
+#include <chrono>
 
 namespace mir
 {
@@ -44,6 +45,12 @@ public:
     virtual void report_vt_switch_away_failure() = 0;
     virtual void report_vt_switch_back_failure() = 0;
 
+    /* How long a frame took to render, against how long it was predicted to */
+    virtual void report_render_time(
+        unsigned int output_id,
+        std::chrono::microseconds predicted,
+        std::chrono::microseconds actual) = 0;
+
 protected:
     DisplayReport() = default;
     virtual ~DisplayReport() = default;
@@ -0,0 +1,62 @@
+/*
+ * Copyright © 2017 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MIR_SCENE_FRAME_RATE_POLICY_H_
+#define MIR_SCENE_FRAME_RATE_POLICY_H_
+
+#include "mir_toolkit/common.h"
+
+#include <chrono>
+
+namespace mir
+{
+namespace scene
+{
+
+/**
+ * Decides how often the compositor takes a new frame from a surface.
+ *
+ * The policy is consulted whenever a surface's type, focus or visibility
+ * changes. A limited surface's client is paced to the limit (its frames are
+ * queued, not dropped) and is woken for frame callbacks no faster than that.
+ * A surface the compositor has yet to show is reported as exposed.
+ */
+class FrameRatePolicy
+{
+public:
+    virtual ~FrameRatePolicy() = default;
+
+    /**
+     * \param [in] type        The type of the surface
+     * \param [in] focus       Whether the surface has input focus
+     * \param [in] visibility  Whether any part of the surface is on screen
+     * \return                 The minimum interval between frames, or zero for no limit
+     */
+    virtual std::chrono::milliseconds frame_interval_for(
+        MirWindowType type,
+        MirWindowFocusState focus,
+        MirWindowVisibility visibility) const = 0;
+
+protected:
+    FrameRatePolicy() = default;
+    FrameRatePolicy(FrameRatePolicy const&) = delete;
+    FrameRatePolicy& operator=(FrameRatePolicy const&) = delete;
+};
+
+}
+}
+
+#endif // MIR_SCENE_FRAME_RATE_POLICY_H_
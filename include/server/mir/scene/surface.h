@@ -25,6 +25,7 @@
 #include "mir/compositor/compositor_id.h"
 #include "mir/optional_value.h"
 
+#include <chrono>
 #include <vector>
 #include <list>
 
@@ -85,6 +86,8 @@ public:
      * set_input_region({Rectangle{}}).
      */
     virtual void set_input_region(std::vector<geometry::Rectangle> const& region) = 0;
+    /// The smallest rectangle containing both the surface and its custom input region
+    virtual geometry::Rectangle input_region_bounds() const = 0;
     virtual void resize(geometry::Size const& size) = 0;
     virtual void set_transformation(glm::mat4 const& t) = 0;
     virtual void set_alpha(float alpha) = 0;
@@ -116,6 +119,9 @@ public:
 
     virtual void placed_relative(geometry::Rectangle const& placement) = 0;
     virtual void start_drag_and_drop(std::vector<uint8_t> const& handle) = 0;
+
+    /// Limits how often the compositor takes a new frame from the surface's streams (zero for no limit)
+    virtual void set_frame_interval(std::chrono::milliseconds interval) = 0;
 };
 }
 }
@@ -66,6 +66,7 @@ class SessionListener;
 class SessionCoordinator;
 class SurfaceFactory;
 class CoordinateTranslator;
+class FrameRatePolicy;
 }
 namespace input
 {
@@ -307,6 +308,9 @@ public:
     /// Sets an override functor for creating the persistent_surface_store
     void override_the_persistent_surface_store(Builder<shell::PersistentSurfaceStore> const& persistent_surface_store);
 
+    /// Sets an override functor for creating the policy limiting the frame rate of surfaces.
+    void override_the_frame_rate_policy(Builder<scene::FrameRatePolicy> const& frame_rate_policy_builder);
+
     /// Each of the wrap functions takes a wrapper functor of the same form
     template<typename T> using Wrapper = std::function<std::shared_ptr<T>(std::shared_ptr<T> const&)>;
 
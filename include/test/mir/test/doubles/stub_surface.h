@@ -42,6 +42,7 @@ struct StubSurface : scene::Surface
     void resize(geometry::Size const& size) override;
     geometry::Point top_left() const override;
     geometry::Rectangle input_bounds() const override;
+    geometry::Rectangle input_region_bounds() const override;
     bool input_area_contains(geometry::Point const& point) const override;
     void consume(MirEvent const* event) override;
     void set_alpha(float alpha) override;
@@ -70,6 +71,7 @@ struct StubSurface : scene::Surface
     MirPointerConfinementState confine_pointer_state() const override;
     void placed_relative(geometry::Rectangle const& placement) override;
     void start_drag_and_drop(std::vector<uint8_t> const& handle) override;
+    void set_frame_interval(std::chrono::milliseconds interval) override;
 };
 }
 }
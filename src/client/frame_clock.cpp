@@ -34,6 +34,7 @@ FrameClock::FrameClock(FrameClock::GetCurrentTime gct)
     , phase{0}
     , period{0}
     , resync_callback{std::bind(&FrameClock::fallback_resync_callback, this)}
+    , have_vsync{false}
 {
 }
 
@@ -51,8 +52,23 @@ void FrameClock::set_resync_callback(ResyncCallback cb)
     config_changed = true;
 }
 
+void FrameClock::set_vsync(PosixTimestamp vsync)
+{
+    Lock lock(mutex);
+    last_vsync = vsync;
+    have_vsync = true;
+    if (period != period.zero())
+        phase = vsync % period;
+}
+
 PosixTimestamp FrameClock::fallback_resync_callback() const
 {
+    {
+        Lock lock(mutex);
+        if (have_vsync)
+            return last_vsync;
+    }
+
     auto const now = get_current_time(PosixTimestamp().clock_id);
     Lock lock(mutex);
     /*
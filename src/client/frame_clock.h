@@ -50,6 +50,13 @@ public:
      */
     void set_resync_callback(ResyncCallback);
 
+    /**
+     * Provide a recent hardware vsync timestamp, such as one pushed by the
+     * server. From then on the clock stays in phase with it without any
+     * resync, and the default resync callback returns it.
+     */
+    void set_vsync(time::PosixTimestamp);
+
     /**
      * Return the next timestamp to sleep_until, which comes after the last one
      * that was slept till (or more generally after time 'when'). On the first
@@ -67,6 +74,8 @@ private:
     mutable std::chrono::nanoseconds phase;
     std::chrono::nanoseconds period;
     ResyncCallback resync_callback;
+    time::PosixTimestamp last_vsync;
+    bool have_vsync;
 };
 
 }} // namespace mir::client
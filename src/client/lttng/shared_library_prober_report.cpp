@@ -48,3 +48,21 @@ void mcl::lttng::SharedLibraryProberReport::loading_failed(boost::filesystem::pa
     mir_tracepoint(mir_client_shared_library_prober, loading_failed,
                    filename.string().c_str(), error.what());
 }
+
+void mcl::lttng::SharedLibraryProberReport::loading_finished(boost::filesystem::path const& path, std::chrono::nanoseconds elapsed)
+{
+    mir_tracepoint(mir_client_shared_library_prober, loading_finished,
+                   path.string().c_str(), elapsed.count());
+}
+
+void mcl::lttng::SharedLibraryProberReport::probed_module(boost::filesystem::path const& filename, std::chrono::nanoseconds elapsed)
+{
+    mir_tracepoint(mir_client_shared_library_prober, probed_module,
+                   filename.string().c_str(), elapsed.count());
+}
+
+void mcl::lttng::SharedLibraryProberReport::selected_module(boost::filesystem::path const& filename, bool from_cache, std::chrono::nanoseconds elapsed)
+{
+    mir_tracepoint(mir_client_shared_library_prober, selected_module,
+                   filename.string().c_str(), from_cache, elapsed.count());
+}
@@ -601,6 +601,8 @@ void MirConnection::connected(MirConnectedCallback callback, void * context)
 
         connect_done = true;
 
+        server.set_transactions_supported(connect_result->transactions_supported());
+
         translation_ext = MirExtensionWindowCoordinateTranslationV1{ translate_coordinates };
         graphics_module_extension = MirExtensionGraphicsModuleV1 { get_graphics_module };
 
@@ -664,6 +666,8 @@ MirWaitHandle* MirConnection::connect(
         std::lock_guard<decltype(mutex)> lock(mutex);
 
         connect_parameters->set_application_name(app_name);
+        if (getenv("MIR_CLIENT_IMMEDIATE_EVENTS"))
+            connect_parameters->set_immediate_events(true);
         connect_wait_handle.expect_result();
     }
 
@@ -453,3 +453,25 @@ catch (std::exception const& ex)
     MIR_LOG_UNCAUGHT_EXCEPTION(ex);
 }
 
+
+void mir_connection_begin_transaction(MirConnection* connection)
+try
+{
+    mir::require(mir_connection_is_valid(connection));
+    connection->display_server().begin_transaction();
+}
+catch (std::exception const& ex)
+{
+    MIR_LOG_UNCAUGHT_EXCEPTION(ex);
+}
+
+void mir_connection_commit_transaction(MirConnection* connection)
+try
+{
+    mir::require(mir_connection_is_valid(connection));
+    connection->display_server().commit_transaction();
+}
+catch (std::exception const& ex)
+{
+    MIR_LOG_UNCAUGHT_EXCEPTION(ex);
+}
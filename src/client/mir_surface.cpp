@@ -230,11 +230,12 @@ void MirSurface::configure_frame_clock()
 {
     /*
      * TODO: Implement frame_clock->set_resync_callback(...) when IPC to get
-     *       timestamps from the server exists.
-     *       Until we do, client-side vsync will perform suboptimally (it is
-     *       randomly up to one frame out of phase with the real display).
-     *       However even while it's suboptimal it's dramatically lower latency
-     *       than the old approach and still totally eliminates nesting lag.
+     *       timestamps from the server on demand exists.
+     *       Until then the server pushes the vblank timestamps of the output
+     *       a surface is on while it posts frames (see the vsync_event
+     *       handling in MirProtobufRpcChannel), and the default resync uses
+     *       the latest of those. Before the first one arrives client-side
+     *       vsync is randomly up to one frame out of phase with the display.
      */
 }
 
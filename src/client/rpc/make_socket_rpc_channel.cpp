@@ -20,6 +20,7 @@
 #include "mir_protobuf_rpc_channel.h"
 #include "stream_socket_transport.h"
 
+#include <cstdlib>
 #include <cstring>
 
 namespace mcl = mir::client;
@@ -54,15 +55,17 @@ mclr::make_rpc_channel(
     std::shared_ptr<mcl::ErrorHandler> const& error_handler,
     std::shared_ptr<mcl::EventSink> const& event_sink)
 {
+    bool const share_memory{getenv("MIR_CLIENT_SHM_TRANSPORT") != nullptr};
+
     std::unique_ptr<mclr::StreamTransport> transport;
     if (fd_prefix.is_start_of(name))
     {
         auto const fd = atoi(name.c_str()+fd_prefix.size);
-        transport = std::make_unique<mclr::StreamSocketTransport>(mir::Fd{fd});
+        transport = std::make_unique<mclr::StreamSocketTransport>(mir::Fd{fd}, share_memory);
     }
     else
     {
-        transport = std::make_unique<mclr::StreamSocketTransport>(name);
+        transport = std::make_unique<mclr::StreamSocketTransport>(name, share_memory);
     }
     return std::make_shared<MirProtobufRpcChannel>(
         std::move(transport), map, buffer_factory, disp_conf,
@@ -54,6 +54,14 @@ void mclr::DisplayServer::modify_surface(
     mir::protobuf::Void* response,
     google::protobuf::Closure* done)
 {
+    if (auto const transaction = transaction_on_this_thread())
+    {
+        *transaction->request.add_modifications() = *request;
+        transaction->calls.push_back(
+            {true, transaction->request.modifications_size() - 1, response, done});
+        return;
+    }
+
     channel->call_method(std::string(__func__), request, response, done);
 }
 void mclr::DisplayServer::release_surface(
@@ -193,6 +201,21 @@ void mclr::DisplayServer::submit_buffer(
     mir::protobuf::BufferRequest const* request,
     mir::protobuf::Void* response,
     google::protobuf::Closure* done)
+{
+    if (auto const transaction = transaction_on_this_thread())
+    {
+        *transaction->request.add_submissions() = *request;
+        transaction->calls.push_back(
+            {false, transaction->request.submissions_size() - 1, response, done});
+        return;
+    }
+
+    channel->call_method(std::string(__func__), request, response, done);
+}
+void mclr::DisplayServer::submit_transaction(
+    mir::protobuf::Transaction const* request,
+    mir::protobuf::Void* response,
+    google::protobuf::Closure* done)
 {
     channel->call_method(std::string(__func__), request, response, done);
 }
@@ -253,3 +276,93 @@ void mclr::DisplayServer::set_base_input_configuration(
 {
     channel->call_method(std::string(__func__), request, response, done);
 }
+
+auto mclr::DisplayServer::transaction_on_this_thread() -> OpenTransaction*
+{
+    // Spare the lock for the usual case of nobody batching anything
+    if (!open_transactions)
+        return nullptr;
+
+    std::lock_guard<decltype(transactions_mutex)> lock{transactions_mutex};
+    auto const t = transactions.find(std::this_thread::get_id());
+
+    // Only this thread erases its transaction, so the pointer stays valid for it
+    return t != transactions.end() ? &t->second : nullptr;
+}
+
+void mclr::DisplayServer::begin_transaction()
+{
+    std::lock_guard<decltype(transactions_mutex)> lock{transactions_mutex};
+    if (transactions[std::this_thread::get_id()].depth++ == 0)
+        ++open_transactions;
+}
+
+namespace
+{
+struct HeldReplies
+{
+    mir::protobuf::Void reply;
+    std::vector<std::pair<mir::protobuf::Void*, google::protobuf::Closure*>> calls;
+};
+
+void transaction_done(HeldReplies* held)
+{
+    std::unique_ptr<HeldReplies> const owner{held};
+
+    for (auto const& call : held->calls)
+    {
+        if (held->reply.has_error())
+            call.first->set_error(held->reply.error());
+        call.second->Run();
+    }
+}
+}
+
+void mclr::DisplayServer::commit_transaction()
+{
+    OpenTransaction transaction;
+    {
+        std::lock_guard<decltype(transactions_mutex)> lock{transactions_mutex};
+        auto const t = transactions.find(std::this_thread::get_id());
+        if (t == transactions.end() || --t->second.depth > 0)
+            return;
+
+        transaction = std::move(t->second);
+        transactions.erase(t);
+        --open_transactions;
+    }
+
+    if (transaction.calls.empty())
+        return;
+
+    // The channel serialises each request before returning, so they needn't outlive this
+    if (!transactions_supported)
+    {
+        for (auto const& call : transaction.calls)
+        {
+            if (call.is_modification)
+            {
+                channel->call_method(
+                    "modify_surface", &transaction.request.modifications(call.index), call.response, call.done);
+            }
+            else
+            {
+                channel->call_method(
+                    "submit_buffer", &transaction.request.submissions(call.index), call.response, call.done);
+            }
+        }
+        return;
+    }
+
+    auto const held = new HeldReplies;
+    for (auto const& call : transaction.calls)
+        held->calls.emplace_back(call.response, call.done);
+
+    submit_transaction(
+        &transaction.request, &held->reply, google::protobuf::NewCallback(&transaction_done, held));
+}
+
+void mclr::DisplayServer::set_transactions_supported(bool supported)
+{
+    transactions_supported = supported;
+}
@@ -20,7 +20,13 @@
 #define MIR_CLIENT_RPC_DISPLAY_SERVER_H_
 
 #include <mir/protobuf/display_server.h>
+
+#include <atomic>
 #include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
 
 namespace mir
 {
@@ -131,6 +137,10 @@ public:
         mir::protobuf::BufferRequest const* request,
         mir::protobuf::Void* response,
         google::protobuf::Closure* done) override;
+    void submit_transaction(
+        mir::protobuf::Transaction const* request,
+        mir::protobuf::Void* response,
+        google::protobuf::Closure* done) override;
     void allocate_buffers(
         mir::protobuf::BufferAllocation const* request,
         mir::protobuf::Void* response,
@@ -163,8 +173,43 @@ public:
         mir::protobuf::InputConfigurationRequest const* request,
         mir::protobuf::Void* response,
         google::protobuf::Closure* done) override;
+
+    /**
+     * Holds back the buffer submissions and surface modifications made on the
+     * calling thread until the matching commit_transaction(), which sends
+     * them to the server in a single submit_transaction(). Transactions nest;
+     * only the outermost commit sends anything.
+     */
+    void begin_transaction();
+    void commit_transaction();
+
+    /// Servers that don't accept submit_transaction() get the calls one by one
+    void set_transactions_supported(bool supported);
+
 private:
+    struct HeldCall
+    {
+        bool is_modification;
+        int index;  ///< Into the transaction's modifications or submissions
+        mir::protobuf::Void* response;
+        google::protobuf::Closure* done;
+    };
+
+    struct OpenTransaction
+    {
+        int depth{0};
+        mir::protobuf::Transaction request;
+        std::vector<HeldCall> calls;    ///< In the order they were made
+    };
+
+    OpenTransaction* transaction_on_this_thread();
+
     std::shared_ptr<mir::client::rpc::MirBasicRpcChannel> const channel;
+
+    std::atomic<bool> transactions_supported{false};
+    std::atomic<int> open_transactions{0};
+    std::mutex transactions_mutex;
+    std::unordered_map<std::thread::id, OpenTransaction> transactions;
 };
 }
 }
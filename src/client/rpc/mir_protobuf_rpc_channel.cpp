@@ -233,8 +233,29 @@ void mclr::MirProtobufRpcChannel::call_method(
         for (auto& fd : request->fd())
             fds.emplace_back(mir::Fd{IntOwnedFd{fd}});
     }
+    else if (parameters->GetTypeName() == "mir.protobuf.Transaction")
+    {
+        // In order of submission, as the server hands them out that way
+        auto const* transaction = reinterpret_cast<mir::protobuf::Transaction const*>(parameters);
+        for (auto& submission : transaction->submissions())
+            for (auto& fd : submission.buffer().fd())
+                fds.emplace_back(mir::Fd{IntOwnedFd{fd}});
+    }
+
+    std::vector<mir::Fd> shared_memory_offer;
+    if (method_name == "connect")
+    {
+        shared_memory_offer = transport->offer_shared_memory();
+        fds.insert(fds.end(), shared_memory_offer.begin(), shared_memory_offer.end());
+    }
+
+    auto invocation = invocation_for(method_name, parameters, fds.size());
 
-    auto const& invocation = invocation_for(method_name, parameters, fds.size());
+    if (!shared_memory_offer.empty())
+    {
+        invocation.set_shm_transport(true);
+        awaiting_shared_memory_answer = true;
+    }
 
     rpc_report->invocation_requested(invocation);
 
@@ -316,6 +337,15 @@ void mclr::MirProtobufRpcChannel::process_event_sequence(std::string const& even
         (*ping_handler)(seq.ping_event().serial());
     }
 
+    if (seq.has_vsync_event())
+    {
+        auto const& vsync = seq.vsync_event();
+        if (auto map = surface_map.lock())
+            if (auto surf = map->surface(mf::SurfaceId(vsync.surface_id().value())))
+                surf->get_frame_clock()->set_vsync(mir::time::PosixTimestamp(
+                    static_cast<clockid_t>(vsync.clock_id()), std::chrono::nanoseconds{vsync.ust()}));
+    }
+
     if (seq.has_structured_error())
     {
         auto const error = MirError{
@@ -500,6 +530,16 @@ void mclr::MirProtobufRpcChannel::on_data_available()
         throw;
     }
 
+    if (awaiting_shared_memory_answer)
+    {
+        // An older server won't acknowledge, and will just reply to "connect"
+        awaiting_shared_memory_answer = false;
+        transport->shared_memory_offer_answered(result->shm_transport());
+
+        if (result->shm_transport())
+            return;
+    }
+
     try
     {
         for (int i = 0; i != result->events_size(); ++i)
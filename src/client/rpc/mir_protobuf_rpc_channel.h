@@ -145,6 +145,8 @@ private:
     std::atomic<bool> disconnected;
     std::mutex read_mutex;
     std::mutex write_mutex;
+    // Until the server answers, by acknowledging or by replying to "connect"
+    std::atomic<bool> awaiting_shared_memory_answer{false};
 
     bool prioritise_next_request{false};
     std::experimental::optional<uint32_t> id_to_wait_for;
@@ -20,10 +20,13 @@
 #include "mir/variable_length_array.h"
 #include "mir/thread_name.h"
 #include "mir/fd_socket_transmission.h"
+#include "mir/shm_ring.h"
 
+#include <chrono>
 #include <system_error>
 
 #include <errno.h>
+#include <poll.h>
 #include <sys/epoll.h>
 #include <sys/types.h>
 #include <sys/socket.h>
@@ -35,6 +38,12 @@
 namespace mclr = mir::client::rpc;
 namespace md = mir::dispatch;
 
+namespace
+{
+// Room for at least one of the largest messages the 16-bit length allows
+size_t const ring_capacity{128 * 1024};
+}
+
 void mclr::TransportObservers::on_data_available()
 {
     for_each([](auto observer) { observer->on_data_available(); });
@@ -45,16 +54,33 @@ void mclr::TransportObservers::on_disconnected()
     for_each([](auto observer) { observer->on_disconnected(); });
 }
 
-mclr::StreamSocketTransport::StreamSocketTransport(mir::Fd const& fd)
-    : socket_fd{fd}
+mclr::StreamSocketTransport::StreamSocketTransport(mir::Fd const& fd, bool share_memory)
+    : socket_fd{fd},
+      share_memory{share_memory},
+      epoll_fd{share_memory ? mir::Fd{epoll_create1(EPOLL_CLOEXEC)} : mir::Fd{}}
 {
+    if (share_memory)
+    {
+        epoll_event socket_event{};
+        socket_event.events = EPOLLIN | EPOLLRDHUP;
+
+        if (epoll_fd == mir::Fd::invalid ||
+            epoll_ctl(epoll_fd, EPOLL_CTL_ADD, socket_fd, &socket_event))
+        {
+            BOOST_THROW_EXCEPTION((std::system_error{errno,
+                                                     std::system_category(),
+                                                     "Failed to create epoll monitor for transport"}));
+        }
+    }
 }
 
-mclr::StreamSocketTransport::StreamSocketTransport(std::string const& socket_path)
-    : StreamSocketTransport(open_socket(socket_path))
+mclr::StreamSocketTransport::StreamSocketTransport(std::string const& socket_path, bool share_memory)
+    : StreamSocketTransport(open_socket(socket_path), share_memory)
 {
 }
 
+mclr::StreamSocketTransport::~StreamSocketTransport() = default;
+
 void mclr::StreamSocketTransport::register_observer(std::shared_ptr<Observer> const& observer)
 {
     observers.add(observer);
@@ -78,6 +104,11 @@ void mclr::StreamSocketTransport::receive_data(void* buffer, size_t bytes_reques
     {
         BOOST_THROW_EXCEPTION(std::logic_error("Attempted to receive 0 bytes"));
     }
+    if (reading_from_ring)
+    {
+        receive_from_ring(buffer, bytes_requested);
+        return;
+    }
     size_t bytes_read{0};
     while(bytes_read < bytes_requested)
     {
@@ -145,6 +176,34 @@ catch (socket_disconnected_error &e)
 void mclr::StreamSocketTransport::send_message(
     std::vector<uint8_t> const& buffer,
     std::vector<mir::Fd> const& fds)
+{
+    std::lock_guard<decltype(shared_memory_mutex)> lock{shared_memory_mutex};
+
+    switch (shared_memory)
+    {
+    case SharedMemory::unused:
+        send_to_socket(buffer, fds);
+        break;
+
+    case SharedMemory::offered:
+        send_to_socket(buffer, fds);
+        shared_memory = SharedMemory::awaiting_answer;
+        break;
+
+    case SharedMemory::awaiting_answer:
+        // The server might already be reading the ring, or might never do so
+        held_back.emplace_back(buffer, fds);
+        break;
+
+    case SharedMemory::in_use:
+        send_to_ring(buffer, fds);
+        break;
+    }
+}
+
+void mclr::StreamSocketTransport::send_to_socket(
+    std::vector<uint8_t> const& buffer,
+    std::vector<mir::Fd> const& fds)
 {
     size_t bytes_written{0};
     while (bytes_written < buffer.size())
@@ -178,13 +237,133 @@ void mclr::StreamSocketTransport::send_message(
         mir::send_fds(socket_fd, fds);
 }
 
+void mclr::StreamSocketTransport::send_to_ring(
+    std::vector<uint8_t> const& buffer,
+    std::vector<mir::Fd> const& fds)
+{
+    // The fds go first, so that they are waiting when the server reads the message
+    if (!fds.empty())
+        mir::send_fds(socket_fd, fds);
+
+    // There's no doorbell for the server to say it has made room, but it
+    // only falls this far behind if it is stalled anyway
+    while (!to_server->write(buffer.data(), buffer.size()))
+    {
+        throw_if_server_hung_up();
+        std::this_thread::sleep_for(std::chrono::milliseconds{1});
+    }
+}
+
+void mclr::StreamSocketTransport::receive_from_ring(void* buffer, size_t bytes_requested)
+{
+    while (!from_server->read(buffer, bytes_requested))
+    {
+        if (!from_server->prepare_to_wait(bytes_requested))
+            continue;
+
+        pollfd wake[]{{from_server->doorbell_fd(), POLLIN, 0}, {socket_fd, POLLRDHUP, 0}};
+        if (poll(wake, 2, -1) < 0 && errno != EINTR)
+        {
+            BOOST_THROW_EXCEPTION(
+                        boost::enable_error_info(socket_error("Failed to wait for message from server"))
+                        << boost::errinfo_errno(errno));
+        }
+
+        from_server->clear_doorbell();
+
+        if (wake[1].revents && from_server->available() < bytes_requested)
+            throw_if_server_hung_up();
+    }
+}
+
+void mclr::StreamSocketTransport::throw_if_server_hung_up()
+{
+    if (socket_events() & (md::FdEvent::remote_closed | md::FdEvent::error))
+    {
+        observers.on_disconnected();
+        BOOST_THROW_EXCEPTION(socket_disconnected_error("Failed to read message from server: server has shutdown"));
+    }
+}
+
+std::vector<mir::Fd> mclr::StreamSocketTransport::offer_shared_memory()
+{
+    std::lock_guard<decltype(shared_memory_mutex)> lock{shared_memory_mutex};
+
+    if (!share_memory || shared_memory != SharedMemory::unused || to_server)
+        return {};
+
+    try
+    {
+        to_server = std::make_unique<ShmRing>(ring_capacity);
+        from_server = std::make_unique<ShmRing>(ring_capacity);
+    }
+    catch (std::exception const&)
+    {
+        // Perhaps memfd_create() isn't supported; the socket will do
+        to_server.reset();
+        from_server.reset();
+        return {};
+    }
+
+    shared_memory = SharedMemory::offered;
+    return {to_server->memory_fd(), to_server->doorbell_fd(), from_server->memory_fd(), from_server->doorbell_fd()};
+}
+
+void mclr::StreamSocketTransport::shared_memory_offer_answered(bool accepted)
+{
+    std::lock_guard<decltype(shared_memory_mutex)> lock{shared_memory_mutex};
+
+    if (shared_memory != SharedMemory::awaiting_answer)
+        return;
+
+    if (accepted)
+    {
+        // From now on the socket only carries fds, which we read when told to
+        epoll_event socket_event{};
+        socket_event.events = EPOLLRDHUP;
+        epoll_event doorbell_event{};
+        doorbell_event.events = EPOLLIN;
+
+        if (epoll_ctl(epoll_fd, EPOLL_CTL_MOD, socket_fd, &socket_event) ||
+            epoll_ctl(epoll_fd, EPOLL_CTL_ADD, from_server->doorbell_fd(), &doorbell_event))
+        {
+            BOOST_THROW_EXCEPTION((std::system_error{errno,
+                                                     std::system_category(),
+                                                     "Failed to monitor shared memory ring"}));
+        }
+
+        shared_memory = SharedMemory::in_use;
+        reading_from_ring = true;
+    }
+    else
+    {
+        shared_memory = SharedMemory::unused;
+    }
+
+    for (auto const& message : held_back)
+    {
+        if (accepted)
+            send_to_ring(message.first, message.second);
+        else
+            send_to_socket(message.first, message.second);
+    }
+    held_back.clear();
+}
+
 mir::Fd mclr::StreamSocketTransport::watch_fd() const
 {
-    return socket_fd;
+    return share_memory ? epoll_fd : socket_fd;
 }
 
 bool mclr::StreamSocketTransport::dispatch(md::FdEvents events)
 {
+    if (reading_from_ring)
+        return dispatch_from_ring();
+
+    // The epoll fd is only readable, so see what is really up with the socket
+    if (share_memory)
+        events = socket_events();
+
     if (events & (md::FdEvent::remote_closed | md::FdEvent::error))
     {
         if (events & md::FdEvent::readable)
@@ -206,10 +385,51 @@ bool mclr::StreamSocketTransport::dispatch(md::FdEvents events)
     else if (events & md::FdEvent::readable)
     {
         observers.on_data_available();
+
+        // That might have been the server accepting our offer, and the
+        // messages after it won't ring the doorbell unless we wait
+        if (reading_from_ring)
+            return dispatch_from_ring();
     }
     return true;
 }
 
+bool mclr::StreamSocketTransport::dispatch_from_ring()
+{
+    from_server->clear_doorbell();
+
+    // Messages are written whole, so anything there is at least one
+    do
+    {
+        while (from_server->available() > 0)
+            observers.on_data_available();
+    }
+    while (!from_server->prepare_to_wait(1));
+
+    if (socket_events() & (md::FdEvent::remote_closed | md::FdEvent::error))
+    {
+        observers.on_disconnected();
+        return false;
+    }
+    return true;
+}
+
+md::FdEvents mclr::StreamSocketTransport::socket_events() const
+{
+    pollfd socket_state{socket_fd, POLLIN | POLLRDHUP, 0};
+    if (poll(&socket_state, 1, 0) != 1)
+        return 0;
+
+    md::FdEvents events{0};
+    if (socket_state.revents & POLLIN)
+        events |= md::FdEvent::readable;
+    if (socket_state.revents & (POLLRDHUP | POLLHUP))
+        events |= md::FdEvent::remote_closed;
+    if (socket_state.revents & POLLERR)
+        events |= md::FdEvent::error;
+    return events;
+}
+
 md::FdEvents mclr::StreamSocketTransport::relevant_events() const
 {
     return md::FdEvent::readable | md::FdEvent::remote_closed;
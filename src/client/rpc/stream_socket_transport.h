@@ -26,9 +26,12 @@
 
 #include <thread>
 #include <mutex>
+#include <utility>
 
 namespace mir
 {
+class ShmRing;
+
 namespace client
 {
 namespace rpc
@@ -48,8 +51,9 @@ public:
 class StreamSocketTransport : public StreamTransport
 {
 public:
-    StreamSocketTransport(Fd const& fd);
-    StreamSocketTransport(std::string const& socket_path);
+    StreamSocketTransport(Fd const& fd, bool share_memory = false);
+    StreamSocketTransport(std::string const& socket_path, bool share_memory = false);
+    ~StreamSocketTransport();
 
     void register_observer(std::shared_ptr<Observer> const& observer) override;
     void unregister_observer(std::shared_ptr<Observer> const& observer) override;
@@ -58,13 +62,37 @@ public:
     void receive_data(void* buffer, size_t bytes_requested, std::vector<Fd>& fds) override;
     void send_message(std::vector<uint8_t> const& buffer, std::vector<mir::Fd> const& fds) override;
 
+    std::vector<Fd> offer_shared_memory() override;
+    void shared_memory_offer_answered(bool accepted) override;
+
     Fd watch_fd() const override;
     bool dispatch(mir::dispatch::FdEvents event) override;
     mir::dispatch::FdEvents relevant_events() const override;
 private:
     Fd open_socket(std::string const& path);
 
+    void send_to_socket(std::vector<uint8_t> const& buffer, std::vector<mir::Fd> const& fds);
+    void send_to_ring(std::vector<uint8_t> const& buffer, std::vector<mir::Fd> const& fds);
+    void receive_from_ring(void* buffer, size_t bytes_requested);
+    bool dispatch_from_ring();
+    mir::dispatch::FdEvents socket_events() const;
+    void throw_if_server_hung_up();
+
     Fd const socket_fd;
+    bool const share_memory;
+    // What watch_fd() returns if sharing memory: the socket, then the
+    // doorbell of the ring from the server (and only hangups on the socket)
+    Fd const epoll_fd;
+
+    enum class SharedMemory { unused, offered, awaiting_answer, in_use };
+
+    std::mutex shared_memory_mutex;
+    SharedMemory shared_memory{SharedMemory::unused};
+    std::vector<std::pair<std::vector<uint8_t>, std::vector<mir::Fd>>> held_back;
+    std::unique_ptr<ShmRing> to_server;
+    std::unique_ptr<ShmRing> from_server;
+    // Only touched by the reading thread
+    bool reading_from_ring{false};
 
     TransportObservers observers;
 };
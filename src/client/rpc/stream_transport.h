@@ -151,6 +151,23 @@ public:
      *         of buffer to the server.
      */
     virtual void send_message(std::vector<uint8_t> const& buffer, std::vector<Fd> const& fds) = 0;
+
+    /**
+     * \brief Offer the server shared memory rings to carry messages instead
+     * \return The fds to send with the next message, or none if there's
+     *         nothing to offer. Until the offer is answered, messages after
+     *         that one are held back.
+     *
+     * \note File descriptors always travel on the underlying stream.
+     */
+    virtual std::vector<Fd> offer_shared_memory() = 0;
+
+    /**
+     * \brief Called with the server's answer to the offer
+     * \param [in] accepted  Whether the server moved to the rings; if so,
+     *                       all further data is read from them.
+     */
+    virtual void shared_memory_offer_answered(bool accepted) = 0;
 };
 
 }
@@ -70,9 +70,18 @@ mir::EventUPtr MirEvent::deserialize(std::string const& bytes)
 std::string MirEvent::serialize(MirEvent const* event)
 {
     std::string output;
-    auto flat_event = ::capnp::messageToFlatArray(const_cast<MirEvent*>(event)->message);
+    serialize(event, output);
+    return output;
+}
+
+void MirEvent::serialize(MirEvent const* event, std::string& output)
+{
+    // Copy the segments once, into output, rather than via a flat array
+    auto const segments = const_cast<MirEvent*>(event)->message.getSegmentsForOutput();
+    output.resize(::capnp::computeSerializedSizeInWords(segments) * sizeof(::capnp::word));
 
-    return {reinterpret_cast<char*>(flat_event.asBytes().begin()), flat_event.asBytes().size()};
+    kj::ArrayOutputStream stream{kj::arrayPtr(reinterpret_cast<kj::byte*>(&output[0]), output.size())};
+    ::capnp::writeMessage(stream, segments);
 }
 
 MirEventType MirEvent::type() const
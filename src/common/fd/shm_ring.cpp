@@ -0,0 +1,254 @@
+/*
+ * Copyright © 2017 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "mir/shm_ring.h"
+
+#include <boost/exception/errinfo_errno.hpp>
+#include <boost/throw_exception.hpp>
+
+#include <atomic>
+#include <algorithm>
+#include <cstring>
+#include <new>
+#include <stdexcept>
+#include <system_error>
+
+#include <fcntl.h>
+#include <linux/memfd.h>
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+static_assert(ATOMIC_LLONG_LOCK_FREE == 2, "Shared memory rings need lock-free 64 bit atomics");
+
+struct mir::ShmRing::Header
+{
+    // Each index is only advanced by one side, so they don't share a cache line
+    alignas(64) std::atomic<uint64_t> head;     ///< Bytes ever written
+    alignas(64) std::atomic<uint64_t> tail;     ///< Bytes ever read
+    alignas(64) std::atomic<uint32_t> consumer_waiting;
+};
+
+namespace
+{
+size_t const min_capacity{4096};
+int const required_seals{F_SEAL_SHRINK | F_SEAL_GROW};
+
+size_t round_up_to_power_of_two(size_t size)
+{
+    size_t result{min_capacity};
+    while (result < size)
+        result *= 2;
+    return result;
+}
+
+mir::Fd create_memory(size_t size)
+{
+    mir::Fd fd{static_cast<int>(syscall(SYS_memfd_create, "mir-shm-ring", MFD_CLOEXEC | MFD_ALLOW_SEALING))};
+    if (fd < 0)
+    {
+        BOOST_THROW_EXCEPTION((std::system_error{errno, std::system_category(), "Failed to create ring memory"}));
+    }
+
+    if (ftruncate(fd, size) < 0 ||
+        fcntl(fd, F_ADD_SEALS, required_seals | F_SEAL_SEAL) < 0)
+    {
+        BOOST_THROW_EXCEPTION((std::system_error{errno, std::system_category(), "Failed to size ring memory"}));
+    }
+
+    return fd;
+}
+
+mir::Fd create_doorbell()
+{
+    mir::Fd fd{eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK)};
+    if (fd < 0)
+    {
+        BOOST_THROW_EXCEPTION((std::system_error{errno, std::system_category(), "Failed to create ring doorbell"}));
+    }
+    return fd;
+}
+
+size_t checked_size_of(mir::Fd const& memory, size_t header_size)
+{
+    if ((fcntl(memory, F_GET_SEALS) & required_seals) != required_seals)
+        BOOST_THROW_EXCEPTION(std::runtime_error("Ring memory can be resized"));
+
+    struct stat info;
+    if (fstat(memory, &info) < 0)
+    {
+        BOOST_THROW_EXCEPTION((std::system_error{errno, std::system_category(), "Failed to query ring memory"}));
+    }
+
+    auto const size = static_cast<size_t>(info.st_size);
+    if (size <= header_size || round_up_to_power_of_two(size - header_size) != size - header_size)
+        BOOST_THROW_EXCEPTION(std::runtime_error("Ring memory has the wrong size"));
+
+    return size;
+}
+
+void* map_memory(mir::Fd const& memory, size_t size)
+{
+    auto const address = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, memory, 0);
+    if (address == MAP_FAILED)
+    {
+        BOOST_THROW_EXCEPTION((std::system_error{errno, std::system_category(), "Failed to map ring memory"}));
+    }
+    return address;
+}
+}
+
+mir::ShmRing::ShmRing(size_t capacity) :
+    memory{create_memory(sizeof(Header) + round_up_to_power_of_two(capacity))},
+    doorbell{create_doorbell()},
+    mapped_size{sizeof(Header) + round_up_to_power_of_two(capacity)},
+    header{new (map_memory(memory, mapped_size)) Header{}},
+    data{reinterpret_cast<unsigned char*>(header + 1)},
+    mask{round_up_to_power_of_two(capacity) - 1}
+{
+}
+
+mir::ShmRing::ShmRing(Fd const& memory, Fd const& doorbell) :
+    memory{memory},
+    doorbell{doorbell},
+    mapped_size{checked_size_of(memory, sizeof(Header))},
+    header{static_cast<Header*>(map_memory(memory, mapped_size))},
+    data{reinterpret_cast<unsigned char*>(header + 1)},
+    mask{mapped_size - sizeof(Header) - 1}
+{
+}
+
+mir::ShmRing::~ShmRing()
+{
+    munmap(header, mapped_size);
+}
+
+mir::Fd mir::ShmRing::memory_fd() const
+{
+    return memory;
+}
+
+mir::Fd mir::ShmRing::doorbell_fd() const
+{
+    return doorbell;
+}
+
+size_t mir::ShmRing::capacity() const
+{
+    return mask + 1;
+}
+
+size_t mir::ShmRing::free_space() const
+{
+    auto const used = header->head.load(std::memory_order_relaxed) - header->tail.load(std::memory_order_acquire);
+
+    // A consumer that has moved the tail past the head gets no more data
+    return used > capacity() ? 0 : capacity() - used;
+}
+
+bool mir::ShmRing::write(std::initializer_list<Span> spans)
+{
+    size_t total{0};
+    for (auto const& span : spans)
+        total += span.size;
+
+    if (total > free_space())
+        return false;
+
+    auto head = header->head.load(std::memory_order_relaxed);
+
+    for (auto const& span : spans)
+    {
+        auto const offset = head & mask;
+        auto const first = std::min(span.size, capacity() - offset);
+        auto const bytes = static_cast<unsigned char const*>(span.data);
+
+        memcpy(data + offset, bytes, first);
+        memcpy(data, bytes + first, span.size - first);
+        head += span.size;
+    }
+
+    // Sequentially consistent, so that either we see the consumer waiting or
+    // it sees the new head
+    header->head.store(head);
+    if (header->consumer_waiting.exchange(0))
+    {
+        uint64_t const ring{1};
+        if (::write(doorbell, &ring, sizeof ring) < 0 && errno != EAGAIN)
+        {
+            BOOST_THROW_EXCEPTION((std::system_error{errno, std::system_category(), "Failed to ring doorbell"}));
+        }
+    }
+
+    return true;
+}
+
+bool mir::ShmRing::write(void const* data, size_t size)
+{
+    return write({Span{data, size}});
+}
+
+size_t mir::ShmRing::available() const
+{
+    auto const used = header->head.load() - header->tail.load(std::memory_order_relaxed);
+
+    if (used > capacity())
+        BOOST_THROW_EXCEPTION(std::runtime_error("Ring has been corrupted"));
+
+    return used;
+}
+
+bool mir::ShmRing::read(void* buffer, size_t size)
+{
+    if (available() < size)
+        return false;
+
+    auto const tail = header->tail.load(std::memory_order_relaxed);
+    auto const offset = tail & mask;
+    auto const first = std::min(size, capacity() - offset);
+    auto const bytes = static_cast<unsigned char*>(buffer);
+
+    memcpy(bytes, data + offset, first);
+    memcpy(bytes + first, data, size - first);
+
+    header->tail.store(tail + size, std::memory_order_release);
+    return true;
+}
+
+bool mir::ShmRing::prepare_to_wait(size_t bytes_needed)
+{
+    header->consumer_waiting.store(1);
+
+    if (available() >= bytes_needed)
+    {
+        header->consumer_waiting.store(0);
+        return false;
+    }
+
+    return true;
+}
+
+void mir::ShmRing::clear_doorbell()
+{
+    uint64_t rings;
+    if (::read(doorbell, &rings, sizeof rings) < 0 && errno != EAGAIN)
+    {
+        BOOST_THROW_EXCEPTION((std::system_error{errno, std::system_category(), "Failed to clear doorbell"}));
+    }
+}
@@ -28,6 +28,9 @@ namespace mir {
 void logv(logging::Severity sev, char const* component,
           char const* fmt, va_list va)
 {
+    if (!logging::is_logged(sev))
+        return;
+
     char message[1024];
     int max = sizeof(message) - 1;
     int len = vsnprintf(message, max, fmt, va);
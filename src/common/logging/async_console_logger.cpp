@@ -0,0 +1,307 @@
+/*
+ * Copyright © 2017 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "mir/logging/async_console_logger.h"
+
+#include <atomic>
+#include <array>
+#include <chrono>
+#include <condition_variable>
+#include <cstdarg>
+#include <cstring>
+#include <ctime>
+#include <mutex>
+#include <string>
+#include <thread>
+
+namespace ml = mir::logging;
+
+namespace
+{
+size_t const ring_size{1024};   // Must be a power of two
+size_t const component_size{32};
+size_t const message_size{960};
+
+std::chrono::milliseconds const idle_timeout{100};
+
+char const* const severity_prefix[] =
+{
+    "<CRITICAL> ",
+    "<ERROR> ",
+    "<WARNING> ",
+    "",
+    "<DEBUG> "
+};
+
+struct Record
+{
+    std::atomic<size_t> sequence;
+    ml::Severity severity;
+    struct timespec time;
+    char component[component_size];
+    char message[message_size];
+};
+
+void copy_truncated(char* dest, size_t size, char const* source)
+{
+    strncpy(dest, source, size - 1);
+    dest[size - 1] = '\0';
+}
+}
+
+/*
+ * The ring is a bounded multiple producer, single consumer queue: producers
+ * claim a record by advancing claim_position, and the sequence number of each
+ * record tells the writer whether it has been filled in yet.
+ */
+class ml::AsyncConsoleLogger::Writer
+{
+public:
+    Writer(std::FILE* out, std::FILE* err) :
+        out{out},
+        err{err}
+    {
+        for (size_t i = 0; i != ring_size; ++i)
+            ring[i].sequence.store(i, std::memory_order_relaxed);
+
+        thread = std::thread{[this] { run(); }};
+    }
+
+    ~Writer()
+    {
+        {
+            std::lock_guard<std::mutex> lock{mutex};
+            stopping = true;
+        }
+        wakeup.notify_one();
+        thread.join();
+    }
+
+    template<typename Fill>
+    void post(Severity severity, char const* component, Fill const& fill)
+    {
+        auto position = claim_position.load(std::memory_order_relaxed);
+        Record* record;
+
+        for (;;)
+        {
+            record = &ring[position % ring_size];
+            auto const sequence = record->sequence.load(std::memory_order_acquire);
+            auto const lag = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position);
+
+            if (lag == 0)
+            {
+                if (claim_position.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+                    break;
+            }
+            else if (lag < 0)
+            {
+                if (severity != Severity::critical)
+                {
+                    // The writer hasn't caught up: drop rather than block the caller
+                    dropped.fetch_add(1, std::memory_order_relaxed);
+                    return;
+                }
+
+                // The process may be about to die, so wait for room instead
+                flush();
+                position = claim_position.load(std::memory_order_relaxed);
+            }
+            else
+            {
+                position = claim_position.load(std::memory_order_relaxed);
+            }
+        }
+
+        record->severity = severity;
+        clock_gettime(CLOCK_REALTIME, &record->time);
+        copy_truncated(record->component, component_size, component);
+        fill(record->message, message_size);
+        record->sequence.store(position + 1, std::memory_order_release);
+
+        if (severity == Severity::critical)
+            flush();
+        else if (idle.load())
+            wake();
+    }
+
+    void flush()
+    {
+        auto const target = claim_position.load();
+
+        wake();
+
+        std::unique_lock<std::mutex> lock{mutex};
+        written_up_to.wait(lock, [&] { return written_position >= target; });
+    }
+
+private:
+    void wake()
+    {
+        // Taking the lock ensures the writer is either waiting or yet to
+        // check for new records
+        { std::lock_guard<std::mutex> lock{mutex}; }
+        wakeup.notify_one();
+    }
+
+    bool pending() const
+    {
+        auto const& record = ring[write_position % ring_size];
+        return record.sequence.load(std::memory_order_acquire) == write_position + 1;
+    }
+
+    // Records are written in the order logged, so a batch only holds
+    // consecutive records bound for the same stream
+    void switch_to(std::FILE* stream)
+    {
+        if (stream != batch_stream)
+        {
+            write_batch();
+            batch_stream = stream;
+        }
+    }
+
+    void format(Record const& record)
+    {
+        switch_to(record.severity < Severity::informational ? err : out);
+
+        struct tm local;
+        localtime_r(&record.time.tv_sec, &local);
+        char now[32];
+        auto offset = strftime(now, sizeof(now), "%F %T", &local);
+        snprintf(now+offset, sizeof(now)-offset, ".%06ld", record.time.tv_nsec / 1000);
+
+        batch += "[";
+        batch += now;
+        batch += "] ";
+        batch += severity_prefix[static_cast<int>(record.severity)];
+        batch += record.component;
+        batch += ": ";
+        batch += record.message;
+        batch += "\n";
+    }
+
+    void report_dropped()
+    {
+        if (auto const lost = dropped.exchange(0))
+        {
+            switch_to(err);
+            batch += "<WARNING> logging: ";
+            batch += std::to_string(lost);
+            batch += " messages dropped\n";
+        }
+    }
+
+    void write_batch()
+    {
+        if (!batch.empty())
+        {
+            std::fwrite(batch.data(), 1, batch.size(), batch_stream);
+            std::fflush(batch_stream);
+            batch.clear();
+        }
+    }
+
+    void run()
+    {
+        for (;;)
+        {
+            while (pending())
+            {
+                auto& record = ring[write_position % ring_size];
+                format(record);
+                record.sequence.store(write_position + ring_size, std::memory_order_release);
+                ++write_position;
+            }
+
+            report_dropped();
+            write_batch();
+
+            std::unique_lock<std::mutex> lock{mutex};
+            written_position = write_position;
+            written_up_to.notify_all();
+
+            if (pending())
+                continue;
+
+            if (stopping)
+                return;
+
+            idle = true;
+            wakeup.wait_for(lock, idle_timeout, [this] { return stopping || pending(); });
+            idle = false;
+        }
+    }
+
+    std::FILE* const out;
+    std::FILE* const err;
+
+    std::array<Record, ring_size> ring{};
+    std::atomic<size_t> claim_position{0};
+    std::atomic<uint64_t> dropped{0};
+    std::atomic<bool> idle{false};
+
+    // Only touched by the writer thread
+    size_t write_position{0};
+    std::string batch;
+    std::FILE* batch_stream{nullptr};
+
+    std::mutex mutex;
+    std::condition_variable wakeup;
+    std::condition_variable written_up_to;
+    size_t written_position{0};
+    bool stopping{false};
+
+    std::thread thread;
+};
+
+ml::AsyncConsoleLogger::AsyncConsoleLogger() :
+    AsyncConsoleLogger(stdout, stderr)
+{
+}
+
+ml::AsyncConsoleLogger::AsyncConsoleLogger(std::FILE* out, std::FILE* err) :
+    writer{std::make_unique<Writer>(out, err)}
+{
+}
+
+ml::AsyncConsoleLogger::~AsyncConsoleLogger() = default;
+
+void ml::AsyncConsoleLogger::log(Severity severity, std::string const& message, std::string const& component)
+{
+    if (!is_logged(severity))
+        return;
+
+    writer->post(severity, component.c_str(),
+        [&](char* buffer, size_t size) { copy_truncated(buffer, size, message.c_str()); });
+}
+
+void ml::AsyncConsoleLogger::log(char const* component, Severity severity, char const* format, ...)
+{
+    if (!is_logged(severity))
+        return;
+
+    va_list va;
+    va_start(va, format);
+    writer->post(severity, component,
+        [&](char* buffer, size_t size) { vsnprintf(buffer, size, format, va); });
+    va_end(va);
+}
+
+void ml::AsyncConsoleLogger::flush()
+{
+    writer->flush();
+}
@@ -19,7 +19,7 @@
 #include "mir/logging/dumb_console_logger.h"
 #include "mir/logging/logger.h"
 
-#include <mutex>
+#include <atomic>
 #include <cstdarg>
 #include <cstdio>
 
@@ -27,6 +27,9 @@ namespace ml = mir::logging;
 
 void ml::Logger::log(char const* component, Severity severity, char const* format, ...)
 {
+    if (!is_logged(severity))
+        return;
+
     auto const bufsize = 4096;
     va_list va;
     va_start(va, format);
@@ -40,22 +43,31 @@ void ml::Logger::log(char const* component, Severity severity, char const* forma
 
 namespace
 {
-std::mutex log_mutex;
 std::shared_ptr<ml::Logger> the_logger;
+std::atomic<ml::Severity> the_max_severity{ml::Severity::debug};
 
 std::shared_ptr<ml::Logger> get_logger()
 {
-    std::lock_guard<decltype(log_mutex)> lock{log_mutex};
+    auto logger = std::atomic_load(&the_logger);
+
+    if (!logger)
+    {
+        std::shared_ptr<ml::Logger> const default_logger = std::make_shared<ml::DumbConsoleLogger>();
 
-    if (!the_logger)
-        the_logger = std::make_shared<ml::DumbConsoleLogger>();
+        // If another thread got here first use the logger it installed
+        if (std::atomic_compare_exchange_strong(&the_logger, &logger, default_logger))
+            logger = default_logger;
+    }
 
-    return the_logger;
+    return logger;
 }
 }
 
 void ml::log(ml::Severity severity, const std::string& message, const std::string& component)
 {
+    if (!is_logged(severity))
+        return;
+
     auto const logger = get_logger();
 
     logger->log(severity, message, component);
@@ -64,10 +76,17 @@ void ml::log(ml::Severity severity, const std::string& message, const std::strin
 void ml::set_logger(std::shared_ptr<Logger> const& new_logger)
 {
     if (new_logger)
-    {
-        std::lock_guard<decltype(log_mutex)> lock{log_mutex};
-        the_logger = new_logger;
-    }
+        std::atomic_store(&the_logger, new_logger);
+}
+
+void ml::set_max_severity(Severity severity)
+{
+    the_max_severity.store(severity, std::memory_order_relaxed);
+}
+
+auto ml::max_severity() -> Severity
+{
+    return the_max_severity.load(std::memory_order_relaxed);
 }
 
 namespace mir
@@ -57,3 +57,36 @@ void ml::SharedLibraryProberReport::loading_failed(boost::filesystem::path const
                 " (error was:" + error.what() + ")",
                 MIR_LOG_COMPONENT);
 }
+
+namespace
+{
+std::string in_milliseconds(std::chrono::nanoseconds elapsed)
+{
+    char buffer[32];
+    snprintf(buffer, sizeof buffer, "%.3fms", elapsed.count() / 1e6);
+    return buffer;
+}
+}
+
+void ml::SharedLibraryProberReport::loading_finished(boost::filesystem::path const& path, std::chrono::nanoseconds elapsed)
+{
+    logger->log(ml::Severity::informational,
+                std::string("Loaded modules from: ") + path.string() + " in " + in_milliseconds(elapsed),
+                MIR_LOG_COMPONENT);
+}
+
+void ml::SharedLibraryProberReport::probed_module(boost::filesystem::path const& filename, std::chrono::nanoseconds elapsed)
+{
+    logger->log(ml::Severity::debug,
+                std::string("Probed module: ") + filename.string() + " in " + in_milliseconds(elapsed),
+                MIR_LOG_COMPONENT);
+}
+
+void ml::SharedLibraryProberReport::selected_module(
+    boost::filesystem::path const& filename, bool from_cache, std::chrono::nanoseconds elapsed)
+{
+    logger->log(ml::Severity::informational,
+                std::string("Selected module: ") + filename.string() +
+                (from_cache ? " from cached probe results" : "") + " after probing for " + in_milliseconds(elapsed),
+                MIR_LOG_COMPONENT);
+}
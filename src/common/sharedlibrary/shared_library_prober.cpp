@@ -21,6 +21,7 @@
 
 #include <boost/filesystem.hpp>
 
+#include <chrono>
 #include <system_error>
 #include <cstring>
 
@@ -68,6 +69,10 @@ void mir::select_libraries_for_path(
     std::function<Selection(std::shared_ptr<mir::SharedLibrary> const&)> const& selector,
     mir::SharedLibraryProberReport& report)
 {
+    auto const start = std::chrono::steady_clock::now();
+    auto const finished = [&]
+        { report.loading_finished(path, std::chrono::steady_clock::now() - start); };
+
     report.probing_path(path);
     // We use the error_code overload because we want to throw a std::system_error
     boost::system::error_code ec;
@@ -97,13 +102,18 @@ void mir::select_libraries_for_path(
             auto const shared_lib = std::make_shared<mir::SharedLibrary>(lib.string());
 
             if (selector(shared_lib) == Selection::quit)
+            {
+                finished();
                 return;
+            }
         }
         catch (std::runtime_error const& err)
         {
             report.loading_failed(lib, err);
         }
     }
+
+    finished();
 }
 
 std::vector<std::shared_ptr<mir::SharedLibrary>>
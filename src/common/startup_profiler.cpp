@@ -0,0 +1,144 @@
+/*
+ * Copyright © 2017 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "mir/startup_profiler.h"
+#include "mir/log.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <set>
+#include <string>
+#include <vector>
+
+#include <cxxabi.h>
+
+namespace
+{
+using Clock = std::chrono::steady_clock;
+
+struct Frame
+{
+    std::string name;
+    Clock::time_point start;
+    Clock::duration nested;
+};
+
+std::atomic<bool> enabled{false};
+Clock::time_point enabled_at;
+
+std::mutex mutex;
+std::map<std::string, Clock::duration> self_time;
+std::set<std::string> milestones_reached;
+
+thread_local std::vector<Frame> stack;
+
+std::string name_of(std::type_info const& type)
+{
+    int status{0};
+    std::unique_ptr<char, void(*)(void*)> const demangled{
+        abi::__cxa_demangle(type.name(), nullptr, nullptr, &status),
+        &std::free};
+
+    std::string name{status == 0 ? demangled.get() : type.name()};
+
+    std::string const shared_ptr{"std::shared_ptr<"};
+    if (name.compare(0, shared_ptr.size(), shared_ptr) == 0 && name.back() == '>')
+        name = name.substr(shared_ptr.size(), name.size() - shared_ptr.size() - 1);
+
+    return name;
+}
+
+bool push(std::string&& name)
+{
+    stack.push_back({std::move(name), Clock::now(), Clock::duration::zero()});
+    return true;
+}
+}
+
+void mir::enable_startup_profile()
+{
+    std::lock_guard<std::mutex> lock{mutex};
+
+    if (!enabled)
+    {
+        enabled_at = Clock::now();
+        enabled = true;
+    }
+}
+
+bool mir::startup_profile_enabled()
+{
+    return enabled;
+}
+
+void mir::write_startup_profile(std::ostream& out)
+{
+    std::lock_guard<std::mutex> lock{mutex};
+
+    for (auto const& entry : self_time)
+        out << entry.first << ' ' << std::chrono::duration_cast<std::chrono::microseconds>(entry.second).count() << '\n';
+}
+
+void mir::startup_milestone(char const* name)
+{
+    if (!enabled)
+        return;
+
+    std::lock_guard<std::mutex> lock{mutex};
+
+    if (milestones_reached.insert(name).second)
+    {
+        std::chrono::duration<double, std::milli> const elapsed = Clock::now() - enabled_at;
+        mir::log_info("Startup profile: %s after %.1fms", name, elapsed.count());
+    }
+}
+
+mir::StartupPhase::StartupPhase(char const* name) :
+    recording{enabled && push(name)}
+{
+}
+
+mir::StartupPhase::StartupPhase(std::type_info const& type) :
+    recording{enabled && push(name_of(type))}
+{
+}
+
+mir::StartupPhase::~StartupPhase()
+{
+    if (!recording)
+        return;
+
+    auto const frame = std::move(stack.back());
+    stack.pop_back();
+
+    auto const total = Clock::now() - frame.start;
+
+    std::string path;
+    for (auto const& outer : stack)
+        path += outer.name + ';';
+    path += frame.name;
+
+    if (!stack.empty())
+        stack.back().nested += total;
+
+    std::lock_guard<std::mutex> lock{mutex};
+    self_time[path] += total - frame.nested;
+}
@@ -72,11 +72,16 @@ struct MirEvent
 
     static mir::EventUPtr deserialize(std::string const& bytes);
     static std::string serialize(MirEvent const* event);
+    /// Writes the event straight into output, reusing its storage
+    static void serialize(MirEvent const* event, std::string& output);
 
 protected:
     MirEvent() = default;
 
-    ::capnp::MallocMessageBuilder message;
+    // Room for any input event, rather than capnp's default of 8KiB
+    static unsigned const first_segment_words{128};
+
+    ::capnp::MallocMessageBuilder message{first_segment_words};
     mir::capnp::Event::Builder event{message.initRoot<mir::capnp::Event>()};
 };
 
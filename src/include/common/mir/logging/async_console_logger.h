@@ -0,0 +1,62 @@
+/*
+ * Copyright © 2017 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MIR_LOGGING_ASYNC_CONSOLE_LOGGER_H_
+#define MIR_LOGGING_ASYNC_CONSOLE_LOGGER_H_
+
+#include "mir/logging/logger.h"
+
+#include <cstdio>
+#include <memory>
+
+namespace mir
+{
+namespace logging
+{
+/**
+ * A console logger that keeps formatting and I/O off the caller's thread.
+ *
+ * Messages more verbose than max_severity() are dropped before they are
+ * formatted. The rest are copied into a fixed size lock-free ring and
+ * written out in batches by a background thread. If the ring is full the
+ * message is dropped, and the number dropped is logged later.
+ *
+ * Critical messages are never dropped and are written out before log()
+ * returns, as the process may be about to die. If the ring is full they wait
+ * for the writer to make room.
+ */
+class AsyncConsoleLogger : public Logger
+{
+public:
+    AsyncConsoleLogger();
+    AsyncConsoleLogger(std::FILE* out, std::FILE* err);
+    ~AsyncConsoleLogger();
+
+    void log(Severity severity, const std::string& message, const std::string& component) override;
+    void log(char const* component, Severity severity, char const* format, ...) override
+        __attribute__ ((format (printf, 4, 5)));
+
+    /// Waits until every message logged so far has been written
+    void flush();
+
+private:
+    class Writer;
+    std::unique_ptr<Writer> const writer;
+};
+}
+}
+
+#endif // MIR_LOGGING_ASYNC_CONSOLE_LOGGER_H_
@@ -127,6 +127,10 @@ public:
         mir::protobuf::BufferRequest const* request,
         mir::protobuf::Void* response,
         google::protobuf::Closure* done) = 0;
+    virtual void submit_transaction(
+        mir::protobuf::Transaction const* request,
+        mir::protobuf::Void* response,
+        google::protobuf::Closure* done) = 0;
     virtual void allocate_buffers(
         mir::protobuf::BufferAllocation const* request,
         mir::protobuf::Void* response,
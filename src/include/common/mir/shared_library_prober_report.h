@@ -21,6 +21,8 @@
 
 #include <boost/filesystem.hpp>
 
+#include <chrono>
+
 namespace mir
 {
 class SharedLibraryProberReport
@@ -32,6 +34,10 @@ public:
     virtual void probing_failed(boost::filesystem::path const& path, std::exception const& error) = 0;
     virtual void loading_library(boost::filesystem::path const& filename) = 0;
     virtual void loading_failed(boost::filesystem::path const& filename, std::exception const& error) = 0;
+    virtual void loading_finished(boost::filesystem::path const& path, std::chrono::nanoseconds elapsed) = 0;
+    virtual void probed_module(boost::filesystem::path const& filename, std::chrono::nanoseconds elapsed) = 0;
+    virtual void selected_module(
+        boost::filesystem::path const& filename, bool from_cache, std::chrono::nanoseconds elapsed) = 0;
 
 protected:
     SharedLibraryProberReport() = default;
@@ -0,0 +1,106 @@
+/*
+ * Copyright © 2017 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef MIR_SHM_RING_H_
+#define MIR_SHM_RING_H_
+
+#include "mir/fd.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+
+namespace mir
+{
+/**
+ * A single-producer, single-consumer byte stream between two processes,
+ * in a shared memory file, with an eventfd "doorbell" to wake the consumer.
+ *
+ * One process creates the ring and passes memory_fd() and doorbell_fd() to
+ * the other, which maps the same ring with the second constructor. Which
+ * end produces and which consumes is up to them.
+ *
+ * The producer only rings the doorbell if the consumer has said it is about
+ * to wait, so a busy consumer costs the producer no system calls.
+ *
+ * Both processes see the ring's indices, and either might be hostile, so the
+ * ring never trusts them to stay in bounds. The memory file is sealed against
+ * resizing, and the mapping process checks that it is.
+ */
+class ShmRing
+{
+public:
+    /// Creates a ring holding up to capacity bytes (rounded up to a power of two)
+    explicit ShmRing(size_t capacity);
+
+    /// Maps a ring created by another process
+    /// \throws std::runtime_error if memory isn't a sealed ring
+    ShmRing(Fd const& memory, Fd const& doorbell);
+
+    ~ShmRing();
+
+    Fd memory_fd() const;
+    Fd doorbell_fd() const;
+
+    size_t capacity() const;
+
+    struct Span
+    {
+        void const* data;
+        size_t size;
+    };
+
+    /// Producer: the number of bytes that can be written (none if the consumer has corrupted the ring)
+    size_t free_space() const;
+
+    /// Producer: appends all of the spans, or none of them if there isn't room
+    bool write(std::initializer_list<Span> spans);
+    bool write(void const* data, size_t size);
+
+    /// Consumer: the number of bytes that can be read
+    /// \throws std::runtime_error if the producer has corrupted the ring
+    size_t available() const;
+
+    /// Consumer: removes size bytes, or nothing if there aren't that many
+    bool read(void* data, size_t size);
+
+    /**
+     * Consumer: announces that it will wait for doorbell_fd() to be readable
+     * until there are at least the bytes it needs.
+     * \return false if they arrived in the meantime, so it shouldn't wait
+     */
+    bool prepare_to_wait(size_t bytes_needed);
+
+    /// Consumer: resets the doorbell after waking up
+    void clear_doorbell();
+
+    ShmRing(ShmRing const&) = delete;
+    ShmRing& operator=(ShmRing const&) = delete;
+
+private:
+    struct Header;
+
+    Fd const memory;
+    Fd const doorbell;
+    size_t const mapped_size;
+    Header* const header;
+    unsigned char* const data;
+    size_t const mask;
+};
+}
+
+#endif // MIR_SHM_RING_H_
@@ -26,6 +26,8 @@
 
 namespace mir
 {
+class SharedLibraryProberReport;
+
 namespace graphics
 {
 class Platform;
@@ -34,6 +36,18 @@ std::shared_ptr<SharedLibrary> module_for_device(
          std::vector<std::shared_ptr<SharedLibrary>> const& modules,
          options::ProgramOption const& options);
 
+/**
+ * Selects the graphics platform module best suited to the system.
+ *
+ * The modules are probed one at a time. If options::platform_probe_cache_opt
+ * is set the result is saved to that file, and on later calls with the same
+ * modules and devices only the previously selected module is probed again.
+ */
+std::shared_ptr<SharedLibrary> module_for_device(
+         std::vector<std::shared_ptr<SharedLibrary>> const& modules,
+         options::ProgramOption const& options,
+         SharedLibraryProberReport& report);
+
 }
 }
 
@@ -38,6 +38,8 @@ extern char const* const msg_processor_report_opt;
 extern char const* const shared_library_prober_report_opt;
 extern char const* const shell_report_opt;
 extern char const* const compositor_report_opt;
+extern char const* const buffer_lifetime_report_opt;
+extern char const* const memory_report_opt;
 extern char const* const display_report_opt;
 extern char const* const legacy_input_report_opt;
 extern char const* const connector_report_opt;
@@ -53,6 +55,13 @@ extern char const* const fatal_except_opt;
 extern char const* const debug_opt;
 extern char const* const composite_delay_opt;
 extern char const* const enable_key_repeat_opt;
+extern char const* const seat_dispatch_thread_opt;
+extern char const* const log_severity_opt;
+extern char const* const async_logging_opt;
+extern char const* const metrics_socket_opt;
+extern char const* const startup_profile_opt;
+extern char const* const parallel_startup_opt;
+extern char const* const event_batch_delay_opt;
 
 extern char const* const name_opt;
 extern char const* const offscreen_opt;
@@ -62,10 +71,12 @@ extern char const* const enable_key_repeat_opt;
 extern char const* const off_opt_value;
 extern char const* const log_opt_value;
 extern char const* const lttng_opt_value;
+extern char const* const metrics_opt_value;
 
 extern char const* const platform_graphics_lib;
 extern char const* const platform_input_lib;
 extern char const* const platform_path;
+extern char const* const platform_probe_cache_opt;
 
 class Configuration
 {
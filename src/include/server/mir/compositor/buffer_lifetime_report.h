@@ -0,0 +1,66 @@
+/*
+ * Copyright © 2017 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MIR_COMPOSITOR_BUFFER_LIFETIME_REPORT_H_
+#define MIR_COMPOSITOR_BUFFER_LIFETIME_REPORT_H_
+
+#include <chrono>
+#include <cstdint>
+
+#include "mir/compositor/compositor_id.h"
+#include "mir/graphics/buffer_id.h"
+
+namespace mir
+{
+namespace compositor
+{
+
+/**
+ * Traces the life of each client buffer as it passes through a buffer stream:
+ *
+ *   submitted -> acquired (once per compositor) -> released -> submitted...
+ *
+ * "released" is the moment the server drops its last reference to the buffer
+ * and the buffer is handed back to the client; the round trip to the next
+ * "submitted" of the same buffer is the client's turnaround time.
+ *
+ * While a stream's frame rate is limited, a buffer submitted before the
+ * current frame interval has elapsed is "deferred": the compositor is not
+ * woken for it until the interval expires.
+ */
+class BufferLifetimeReport
+{
+public:
+    typedef void const* StreamId;
+
+    virtual void buffer_submitted(StreamId stream, graphics::BufferID buffer) = 0;
+    virtual void buffer_acquired(StreamId stream, graphics::BufferID buffer, CompositorID compositor) = 0;
+    virtual void buffer_released(StreamId stream, graphics::BufferID buffer) = 0;
+    virtual void stream_destroyed(StreamId stream) = 0;
+    virtual void frame_interval_changed(StreamId stream, std::chrono::milliseconds interval) = 0;
+    virtual void buffer_deferred(StreamId stream, graphics::BufferID buffer) = 0;
+
+protected:
+    BufferLifetimeReport() = default;
+    virtual ~BufferLifetimeReport() = default;
+    BufferLifetimeReport(BufferLifetimeReport const&) = delete;
+    BufferLifetimeReport& operator=(BufferLifetimeReport const&) = delete;
+};
+
+}
+}
+
+#endif /* MIR_COMPOSITOR_BUFFER_LIFETIME_REPORT_H_ */
@@ -25,6 +25,7 @@
 #include "mir_toolkit/common.h"
 #include "mir/graphics/buffer_id.h"
 
+#include <chrono>
 #include <memory>
 
 namespace mir
@@ -49,6 +50,13 @@ public:
     virtual void drop_old_buffers() = 0;
     virtual bool has_submitted_buffer() const = 0;
     virtual bool framedropping() const = 0;
+
+    /**
+     * Limit how often the compositor takes a new frame from this stream.
+     * While limited, the stream queues frames rather than dropping them so
+     * the client is paced by the limit. A zero interval removes the limit.
+     */
+    virtual void set_frame_interval(std::chrono::milliseconds interval) = 0;
 };
 
 }
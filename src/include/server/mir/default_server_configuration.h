@@ -54,6 +54,7 @@ class Drawer;
 class DisplayBufferCompositorFactory;
 class Compositor;
 class CompositorReport;
+class BufferLifetimeReport;
 }
 namespace frontend
 {
@@ -104,9 +105,11 @@ class SessionCoordinator;
 class SnapshotStrategy;
 class SurfaceStack;
 class SceneReport;
+class MemoryReport;
 class PromptSessionListener;
 class PromptSessionManager;
 class CoordinateTranslator;
+class FrameRatePolicy;
 }
 namespace graphics
 {
@@ -158,6 +161,7 @@ namespace report
 {
 class ReportFactory;
 class Reports;
+namespace metrics { class Registry; class Endpoint; }
 }
 
 namespace renderer
@@ -230,6 +234,7 @@ public:
      * configurable interfaces for modifying compositor
      *  @{ */
     virtual std::shared_ptr<compositor::CompositorReport> the_compositor_report();
+    virtual std::shared_ptr<compositor::BufferLifetimeReport> the_buffer_lifetime_report();
     virtual std::shared_ptr<compositor::DisplayBufferCompositorFactory> the_display_buffer_compositor_factory();
     virtual std::shared_ptr<compositor::DisplayBufferCompositorFactory> wrap_display_buffer_compositor_factory(
         std::shared_ptr<compositor::DisplayBufferCompositorFactory> const& wrapped);
@@ -301,6 +306,7 @@ public:
      *  @{ */
     virtual std::shared_ptr<scene::BufferStreamFactory> the_buffer_stream_factory();
     virtual std::shared_ptr<scene::SceneReport>      the_scene_report();
+    virtual std::shared_ptr<scene::MemoryReport>     the_memory_report();
     /** @} */
 
     /** @name scene configuration - services
@@ -308,6 +314,7 @@ public:
      *  @{ */
     virtual std::shared_ptr<scene::SessionCoordinator>  the_session_coordinator();
     virtual std::shared_ptr<scene::CoordinateTranslator> the_coordinate_translator();
+    virtual std::shared_ptr<scene::FrameRatePolicy> the_frame_rate_policy();
     /** @} */
 
 
@@ -340,6 +347,8 @@ public:
     /** @} */
 
     virtual std::shared_ptr<time::Clock> the_clock();
+    /// The metrics recorded by reports set to "metrics"
+    virtual std::shared_ptr<report::metrics::Registry> the_metrics_registry();
     virtual std::shared_ptr<ServerActionQueue> the_server_action_queue();
     virtual std::shared_ptr<SharedLibraryProberReport>  the_shared_library_prober_report();
 
@@ -412,6 +421,7 @@ protected:
     CachedPtr<scene::SurfaceStack> scene_surface_stack;
     CachedPtr<shell::SurfaceStack> surface_stack;
     CachedPtr<scene::SceneReport> scene_report;
+    CachedPtr<scene::MemoryReport> memory_report;
 
     CachedPtr<scene::SurfaceFactory> surface_factory;
     CachedPtr<scene::SessionContainer>  session_container;
@@ -422,6 +432,7 @@ protected:
     CachedPtr<compositor::DisplayBufferCompositorFactory> display_buffer_compositor_factory;
     CachedPtr<compositor::Compositor> compositor;
     CachedPtr<compositor::CompositorReport> compositor_report;
+    CachedPtr<compositor::BufferLifetimeReport> buffer_lifetime_report;
     CachedPtr<logging::Logger> logger;
     CachedPtr<graphics::DisplayReport> display_report;
     CachedPtr<time::Clock> clock;
@@ -435,6 +446,7 @@ protected:
     CachedPtr<scene::PromptSessionManager> prompt_session_manager;
     CachedPtr<scene::SessionCoordinator> session_coordinator;
     CachedPtr<scene::CoordinateTranslator> coordinate_translator;
+    CachedPtr<scene::FrameRatePolicy> frame_rate_policy;
     CachedPtr<EmergencyCleanup> emergency_cleanup;
     CachedPtr<shell::HostLifecycleEventListener> host_lifecycle_event_listener;
     CachedPtr<shell::PersistentSurfaceStore> persistent_surface_store;
@@ -454,6 +466,8 @@ private:
         seat_observer_multiplexer;
     CachedPtr<ObserverMultiplexer<frontend::SessionMediatorObserver>>
         session_mediator_observer_multiplexer;
+    CachedPtr<report::metrics::Registry> metrics_registry;
+    std::shared_ptr<report::metrics::Endpoint> metrics_endpoint;
     std::shared_ptr<report::Reports> const reports;
 
     virtual std::string the_socket_file() const;
@@ -21,6 +21,7 @@
 
 #include "mir_toolkit/event.h"
 #include "mir/frontend/buffer_sink.h"
+#include "mir/frontend/surface_id.h"
 
 #include <vector>
 
@@ -32,6 +33,7 @@ namespace graphics
 {
 class DisplayConfiguration;
 class Buffer;
+struct Frame;
 }
 namespace frontend
 {
@@ -46,6 +48,7 @@ public:
     virtual void send_ping(int32_t serial) = 0;
     virtual void handle_input_config_change(MirInputConfig const& config) = 0;
     virtual void handle_error(ClientVisibleError const& error) = 0;
+    virtual void send_vsync(SurfaceId id, uint32_t output_id, graphics::Frame const& frame) = 0;
 
 protected:
     EventSink() = default;
@@ -23,10 +23,12 @@
 #include "mir/frontend/connections.h"
 
 #include <atomic>
+#include <chrono>
 
 namespace mir
 {
 namespace graphics { class PlatformIpcOperations; }
+namespace time { class AlarmFactory; }
 namespace frontend
 {
 class MessageProcessorReport;
@@ -49,6 +51,14 @@ public:
         std::shared_ptr<SessionAuthorizer> const& session_authorizer,
         std::shared_ptr<graphics::PlatformIpcOperations> const& operations,
         std::shared_ptr<MessageProcessorReport> const& report);
+    /// Surface events to clients are batched for up to event_batch_delay
+    ProtobufConnectionCreator(
+        std::shared_ptr<ProtobufIpcFactory> const& ipc_factory,
+        std::shared_ptr<SessionAuthorizer> const& session_authorizer,
+        std::shared_ptr<graphics::PlatformIpcOperations> const& operations,
+        std::shared_ptr<MessageProcessorReport> const& report,
+        std::shared_ptr<time::AlarmFactory> const& alarm_factory,
+        std::chrono::milliseconds event_batch_delay);
     ~ProtobufConnectionCreator() noexcept;
 
     void create_connection_for(
@@ -67,6 +77,8 @@ private:
     std::shared_ptr<SessionAuthorizer> const session_authorizer;
     std::shared_ptr<graphics::PlatformIpcOperations> const operations;
     std::shared_ptr<MessageProcessorReport> const report;
+    std::shared_ptr<time::AlarmFactory> const alarm_factory;
+    std::chrono::milliseconds const event_batch_delay;
     std::atomic<int> next_session_id;
     std::shared_ptr<detail::Connections<detail::SocketConnection>> const connections;
 };
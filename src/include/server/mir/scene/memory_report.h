@@ -0,0 +1,66 @@
+/*
+ * Copyright © 2017 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MIR_SCENE_MEMORY_REPORT_H_
+#define MIR_SCENE_MEMORY_REPORT_H_
+
+#include <cstddef>
+#include <string>
+
+namespace mir
+{
+namespace scene
+{
+
+/**
+ * Attributes the memory the server holds on behalf of clients to the
+ * sessions that caused it to be allocated.
+ *
+ * Memory is reported against an owner: a session, or something belonging
+ * to one (such as a buffer stream, whose pointer is also the id of the
+ * renderables showing it). An owner created with a parent is accounted to
+ * the parent's session; memory reported against an owner that was never
+ * created is "unattributed".
+ */
+class MemoryReport
+{
+public:
+    typedef void const* Owner;
+
+    enum class Category
+    {
+        client_buffers, ///< Buffers allocated for a client and cached by its session
+        textures,       ///< GL textures the renderers hold for a renderable
+        snapshots       ///< Pixels read back from buffers for snapshots
+    };
+
+    virtual void owner_created(Owner owner, Owner parent, std::string const& name) = 0;
+    virtual void owner_destroyed(Owner owner) = 0;
+
+    virtual void allocated(Owner owner, Category category, size_t bytes) = 0;
+    virtual void released(Owner owner, Category category, size_t bytes) = 0;
+
+protected:
+    MemoryReport() = default;
+    virtual ~MemoryReport() = default;
+    MemoryReport(MemoryReport const&) = delete;
+    MemoryReport& operator=(MemoryReport const&) = delete;
+};
+
+}
+}
+
+#endif // MIR_SCENE_MEMORY_REPORT_H_
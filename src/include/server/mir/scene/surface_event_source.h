@@ -22,11 +22,14 @@
 #include "mir/scene/null_surface_observer.h"
 #include "mir/frontend/surface_id.h"
 #include "mir/frontend/event_sink.h"
+#include "mir/graphics/frame.h"
 
 #include <memory>
+#include <mutex>
 
 namespace mir
 {
+namespace graphics { class Display; }
 namespace scene
 {
 class Surface;
@@ -42,6 +45,15 @@ public:
         OutputPropertiesCache const& outputs,
         std::shared_ptr<frontend::EventSink> const& event_sink);
 
+    /// Also sends the client the occasional vblank timestamp of the output
+    /// the surface is on, while it is posting frames
+    SurfaceEventSource(
+        frontend::SurfaceId id,
+        Surface const& surface,
+        OutputPropertiesCache const& outputs,
+        std::shared_ptr<frontend::EventSink> const& event_sink,
+        std::shared_ptr<graphics::Display const> const& display);
+
     void attrib_changed(Surface const* surf, MirWindowAttrib attrib, int value) override;
     void resized_to(Surface const* surf, geometry::Size const& size) override;
     void moved_to(Surface const* surf, geometry::Point const& top_left) override;
@@ -57,13 +69,19 @@ public:
     void placed_relative(Surface const* surf, geometry::Rectangle const& placement) override;
     void input_consumed(Surface const* surf, MirEvent const* event) override;
     void start_drag_and_drop(Surface const* surf, std::vector<uint8_t> const& handle) override;
+    void frame_posted(Surface const* surf, int frames_available, geometry::Rectangle const& damage) override;
 
 private:
     frontend::SurfaceId const id;
     Surface const& surface;
     OutputPropertiesCache const& outputs;
-    std::weak_ptr<OutputProperties const> last_output;
     std::shared_ptr<frontend::EventSink> const event_sink;
+    std::shared_ptr<graphics::Display const> const display;
+
+    std::mutex mutex;
+    std::weak_ptr<OutputProperties const> last_output;
+    int vsync_output_id{-1};
+    graphics::Frame last_vsync;
 };
 }
 }
@@ -0,0 +1,112 @@
+/*
+ * Copyright © 2017 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 or 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "miral/frame_rate_limits.h"
+
+#include <mir/server.h>
+#include <mir/scene/frame_rate_policy.h>
+
+#include <map>
+
+namespace
+{
+auto interval_for(unsigned frames_per_second) -> std::chrono::milliseconds
+{
+    if (!frames_per_second)
+        return std::chrono::milliseconds::zero();
+
+    return std::chrono::milliseconds{(1000 + frames_per_second - 1) / frames_per_second};
+}
+
+// Matches the server's default: any limit keeps occluded clients from rendering frames that are dropped
+auto const default_occluded_interval = std::chrono::milliseconds{1000};
+
+using Intervals = std::map<MirWindowType, std::chrono::milliseconds>;
+
+class Policy : public mir::scene::FrameRatePolicy
+{
+public:
+    Policy(Intervals const& unfocused, Intervals const& occluded) :
+        unfocused{unfocused},
+        occluded{occluded}
+    {
+    }
+
+    auto frame_interval_for(
+        MirWindowType type,
+        MirWindowFocusState focus,
+        MirWindowVisibility visibility) const -> std::chrono::milliseconds override
+    {
+        if (focus == mir_window_focus_state_focused)
+            return std::chrono::milliseconds::zero();
+
+        if (visibility == mir_window_visibility_occluded)
+        {
+            auto const limit = occluded.find(type);
+            return limit != occluded.end() ? limit->second : default_occluded_interval;
+        }
+
+        if (focus == mir_window_focus_state_unfocused)
+        {
+            auto const limit = unfocused.find(type);
+            return limit != unfocused.end() ? limit->second : std::chrono::milliseconds::zero();
+        }
+
+        return std::chrono::milliseconds::zero();
+    }
+
+private:
+    Intervals const unfocused;
+    Intervals const occluded;
+};
+}
+
+struct miral::FrameRateLimits::Self
+{
+    Intervals unfocused;
+    Intervals occluded;
+};
+
+miral::FrameRateLimits::FrameRateLimits() :
+    self{std::make_shared<Self>()}
+{
+}
+
+miral::FrameRateLimits::~FrameRateLimits() = default;
+miral::FrameRateLimits::FrameRateLimits(FrameRateLimits const&) = default;
+auto miral::FrameRateLimits::operator=(FrameRateLimits const&) -> FrameRateLimits& = default;
+
+auto miral::FrameRateLimits::unfocused(MirWindowType type, unsigned frames_per_second) -> FrameRateLimits&
+{
+    self->unfocused[type] = interval_for(frames_per_second);
+    return *this;
+}
+
+auto miral::FrameRateLimits::occluded(MirWindowType type, unsigned frames_per_second) -> FrameRateLimits&
+{
+    self->occluded[type] = interval_for(frames_per_second);
+    return *this;
+}
+
+void miral::FrameRateLimits::operator()(mir::Server& server) const
+{
+    // The server gets its own copy, so later changes to these limits can't race with it
+    server.override_the_frame_rate_policy(
+        [unfocused=self->unfocused, occluded=self->occluded]
+        {
+            return std::make_shared<Policy>(unfocused, occluded);
+        });
+}
@@ -897,3 +897,70 @@ xcursor_load_theme(const char *theme, int size,
 	if (inherits)
 		free(inherits);
 }
+
+/** Load one cursor of a theme
+ *
+ * This function searches a given theme, and then the themes it inherits,
+ * for the named cursor and loads the first one found. Unlike
+ * xcursor_load_theme() it only reads the one file, so it is cheap enough
+ * to call when a cursor is first needed.
+ *
+ * \param theme The name of theme that should be searched
+ * \param name The name of the cursor (e.g. "arrow")
+ * \param size The desired size of the cursor images
+ * \return The XcursorImages object representing the cursor, to be
+ * destroyed by the caller with XcursorImagesDestroy(), or NULL if the
+ * theme has no such cursor.
+ */
+XcursorImages *
+xcursor_load_cursor(const char *theme, const char *name, int size)
+{
+	char *full, *dir;
+	char *inherits = NULL;
+	const char *path, *i;
+	FILE *f;
+	XcursorImages *images = NULL;
+
+	if (!theme)
+		theme = "default";
+
+	for (path = XcursorLibraryPath();
+	     path && !images;
+	     path = _XcursorNextPath(path)) {
+		dir = _XcursorBuildThemeDir(path, theme);
+		if (!dir)
+			continue;
+
+		full = _XcursorBuildFullname(dir, "cursors", name);
+
+		if (full) {
+			f = fopen(full, "r");
+			if (f) {
+				images = XcursorFileLoadImages(f, size);
+				fclose(f);
+			}
+			free(full);
+		}
+
+		if (!inherits) {
+			full = _XcursorBuildFullname(dir, "", "index.theme");
+			if (full) {
+				inherits = _XcursorThemeInherits(full);
+				free(full);
+			}
+		}
+
+		free(dir);
+	}
+
+	for (i = inherits; i && !images; i = _XcursorNextPath(i))
+		images = xcursor_load_cursor(i, name, size);
+
+	if (inherits)
+		free(inherits);
+
+	if (images)
+		XcursorImagesSetName(images, name);
+
+	return images;
+}
@@ -22,6 +22,7 @@
 
 #include <boost/throw_exception.hpp>
 #include <stdexcept>
+#include <vector>
 
 #include <string.h>
 
@@ -44,34 +45,48 @@ namespace
 class XCursorImage : public mg::CursorImage
 {
 public:
-    XCursorImage(_XcursorImage *image, std::shared_ptr<_XcursorImages> const& save_resource)
-        : image(image),
-          save_resource(save_resource)
-    {
-    }
-
-    ~XCursorImage()
+    XCursorImage(_XcursorImage const* image) :
+        pixels(image->pixels, image->pixels + image->width*image->height),
+        size_{image->width, image->height},
+        hotspot_{image->xhot, image->yhot}
     {
     }
 
     void const* as_argb_8888() const override
     {
-        return image->pixels;
+        return pixels.data();
     }
     geom::Size size() const override
     {
-        return {image->width, image->height};
+        return size_;
     }
     geom::Displacement hotspot() const override
     {
-        return {image->xhot, image->yhot};
+        return hotspot_;
     }
 
 private:
-    _XcursorImage *image;
-    std::shared_ptr<_XcursorImages> const save_resource;
+    std::vector<XcursorPixel> const pixels;
+    geom::Size const size_;
+    geom::Displacement const hotspot_;
 };
 
+// Each XcursorImages represents images for the different sizes of a given symbolic cursor.
+_XcursorImage const* appropriately_sized_image(_XcursorImages const* images)
+{
+    for (int i = 0; i < images->nimage; i++)
+    {
+        _XcursorImage const* candidate = images->images[i];
+        if (candidate->width == mi::default_cursor_size.width.as_uint32_t() &&
+            candidate->height == mi::default_cursor_size.height.as_uint32_t())
+        {
+            return candidate;
+        }
+    }
+
+    return images->images[0];
+}
+
 std::string const
 xcursor_name_for_mir_cursor(std::string const& mir_cursor_name)
 {
@@ -142,56 +157,47 @@ xcursor_name_for_mir_cursor(std::string const& mir_cursor_name)
 }
 }
 
-miral::XCursorLoader::XCursorLoader()
+miral::XCursorLoader::XCursorLoader() :
+    XCursorLoader("default")
 {
-    load_cursor_theme("default");
 }
 
-miral::XCursorLoader::XCursorLoader(std::string const& theme)
+miral::XCursorLoader::XCursorLoader(std::string const& theme) :
+    theme_name{theme}
 {
-    load_cursor_theme(theme);
 }
 
-// Each XcursorImages represents images for the different sizes of a given symbolic cursor.
-void miral::XCursorLoader::load_appropriately_sized_image(_XcursorImages *images)
+std::shared_ptr<mg::CursorImage> miral::XCursorLoader::load_image(std::string const& xcursor_name)
 {
-    // We would rather take this lock in load_cursor_theme but the Xcursor lib style
-    // makes it difficult to use our standard 'pass the lg around to _locked members' pattern
-    std::lock_guard<std::mutex> lg(guard);
+    // Cursor names come from clients, so must not be allowed to name a file outside the theme
+    if (xcursor_name.empty() || xcursor_name.find('/') != std::string::npos || xcursor_name[0] == '.')
+        return nullptr;
 
-    // We have to save all the images as XCursor expects us to free them.
-    // This contains the actual image data though, so we need to ensure they stay alive
-    // with the lifetime of the mg::CursorImage instance which refers to them.
-    auto saved_xcursor_library_resource = std::shared_ptr<_XcursorImages>(images, [](_XcursorImages *images)
-        {
-            XcursorImagesDestroy(images);
-        });
+    // Cursors are named by their square dimension...called the nominal size in XCursor terminology, so we just look up by width.
+    // Later we verify the actual size.
+    std::unique_ptr<_XcursorImages, void(*)(_XcursorImages*)> const images{
+        xcursor_load_cursor(theme_name.c_str(), xcursor_name.c_str(), mi::default_cursor_size.width.as_uint32_t()),
+        &XcursorImagesDestroy};
 
-    for (int i = 0; i < images->nimage; i++)
-    {
-        _XcursorImage *candidate = images->images[i];
-        if (candidate->width == mi::default_cursor_size.width.as_uint32_t() &&
-            candidate->height == mi::default_cursor_size.height.as_uint32_t())
-        {
-            loaded_images[std::string(images->name)] = std::make_shared<XCursorImage>(candidate, saved_xcursor_library_resource);
-            return;
-        }
-    }
+    if (!images || images->nimage < 1)
+        return nullptr;
 
-    loaded_images[std::string(images->name)] = std::make_shared<XCursorImage>(images->images[0], saved_xcursor_library_resource);
+    // Only keep a copy of the size we use, the rest are freed with images
+    return std::make_shared<XCursorImage>(appropriately_sized_image(images.get()));
 }
 
-void miral::XCursorLoader::load_cursor_theme(std::string const& theme_name)
+std::shared_ptr<mg::CursorImage> miral::XCursorLoader::image_locked(std::string const& xcursor_name)
 {
-    // Cursors are named by their square dimension...called the nominal size in XCursor terminology, so we just look up by width.
-    // Later we verify the actual size.
-    xcursor_load_theme(theme_name.c_str(), mi::default_cursor_size.width.as_uint32_t(),
-        [](XcursorImages* images, void *this_ptr)  -> void
-        {
-            // Can't use lambda capture as this lambda is thunked to a C function ptr
-            auto p = static_cast<miral::XCursorLoader*>(this_ptr);
-            p->load_appropriately_sized_image(images);
-        }, this);
+    auto const it = loaded_images.find(xcursor_name);
+    if (it != loaded_images.end())
+        return it->second;
+
+    // Misses aren't cached: the names come from clients, so the cache would grow without bound
+    auto const image = load_image(xcursor_name);
+    if (image)
+        loaded_images.emplace(xcursor_name, image);
+
+    return image;
 }
 
 std::shared_ptr<mg::CursorImage> miral::XCursorLoader::image(
@@ -202,14 +208,9 @@ std::shared_ptr<mg::CursorImage> miral::XCursorLoader::image(
 
     std::lock_guard<std::mutex> lg(guard);
 
-    auto it = loaded_images.find(xcursor_name);
-    if (it != loaded_images.end())
-        return it->second;
+    if (auto const image = image_locked(xcursor_name))
+        return image;
 
     // Fall back
-    it = loaded_images.find("arrow");
-    if (it != loaded_images.end())
-        return it->second;
-
-    return nullptr;
+    return image_locked("arrow");
 }
@@ -53,12 +53,15 @@ protected:
     XCursorLoader& operator=(XCursorLoader const&) = delete;
 
 private:
+    std::string const theme_name;
+
     std::mutex guard;
 
+    // Cursors are loaded when first asked for. Those the theme lacks are remembered as nullptr.
     std::map<std::string, std::shared_ptr<mir::graphics::CursorImage>> loaded_images;
 
-    void load_cursor_theme(std::string const& theme_name);
-    void load_appropriately_sized_image(_XcursorImages *images);
+    std::shared_ptr<mir::graphics::CursorImage> image_locked(std::string const& xcursor_name);
+    std::shared_ptr<mir::graphics::CursorImage> load_image(std::string const& xcursor_name);
 };
 }
 
@@ -19,45 +19,353 @@
 #include "mir/log.h"
 #include "mir/graphics/platform.h"
 #include "mir/graphics/platform_probe.h"
+#include "mir/options/configuration.h"
+#include "mir/logging/null_shared_library_prober_report.h"
+#include "mir/shared_library_prober_report.h"
 
+#include <boost/filesystem.hpp>
 #include <boost/throw_exception.hpp>
 
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <sstream>
+
+namespace mg = mir::graphics;
+namespace fs = boost::filesystem;
+
+extern char** environ;
+
+namespace
+{
+struct ProbeResult
+{
+    mg::PlatformPriority priority{mg::unsupported};
+    mir::ModuleProperties const* description{nullptr};
+    std::chrono::nanoseconds elapsed{0};
+};
+
+ProbeResult probe(mir::SharedLibrary const& module, mir::options::ProgramOption const& options)
+{
+    auto const start = std::chrono::steady_clock::now();
+    ProbeResult result;
+
+    try
+    {
+        auto probe = module.load_function<mg::PlatformProbe>(
+             "probe_graphics_platform",
+             MIR_SERVER_GRAPHICS_PLATFORM_VERSION);
+
+        result.priority = probe(options);
+
+        auto describe = module.load_function<mg::DescribeModule>(
+            "describe_graphics_module",
+            MIR_SERVER_GRAPHICS_PLATFORM_VERSION);
+        result.description = describe();
+    }
+    catch (std::runtime_error const&)
+    {
+    }
+
+    result.elapsed = std::chrono::steady_clock::now() - start;
+    return result;
+}
+
+mir::ModuleProperties const* describe(mir::SharedLibrary const& module)
+{
+    try
+    {
+        return module.load_function<mg::DescribeModule>(
+            "describe_graphics_module",
+            MIR_SERVER_GRAPHICS_PLATFORM_VERSION)();
+    }
+    catch (std::runtime_error const&)
+    {
+        return nullptr;
+    }
+}
+
+void log_found(mir::ModuleProperties const* description)
+{
+    if (description)
+    {
+        mir::log_info("Found graphics driver: %s (version %d.%d.%d)",
+                      description->name,
+                      description->major_version,
+                      description->minor_version,
+                      description->micro_version);
+    }
+}
+
+/*
+ * The probe cache.
+ *
+ * Probing a platform can be slow (it may open devices and initialise EGL),
+ * and on a given machine the answer rarely changes. So we record the
+ * priority each graphics module reported, along with enough about the
+ * system to tell when the answer might have changed:
+ *  - the modules themselves (file, modification time and size);
+ *  - a fingerprint of the DRM devices, the display environment and the
+ *    command line the probes were given.
+ * If any of these differ the cache is ignored. Even when they match, the
+ * previously selected module is probed again and the cache only trusted if
+ * it reports the same priority, as some probes depend on state (such as
+ * being able to become DRM master) that no fingerprint can capture.
+ */
+char const* const cache_header = "mir-platform-probe-cache 1";
+
+struct CacheEntry
+{
+    mg::PlatformPriority priority;
+    std::time_t mtime;
+    uintmax_t size;
+    std::string file;
+};
+
+bool operator==(CacheEntry const& lhs, CacheEntry const& rhs)
+{
+    return lhs.mtime == rhs.mtime && lhs.size == rhs.size && lhs.file == rhs.file;
+}
+
+std::string read_file(fs::path const& path)
+{
+    std::ifstream in{path.string()};
+    return {std::istreambuf_iterator<char>{in}, std::istreambuf_iterator<char>{}};
+}
+
+std::string fingerprint()
+{
+    std::ostringstream description;
+
+    boost::system::error_code ec;
+    std::vector<fs::path> devices;
+    for (fs::directory_iterator i{"/sys/class/drm", ec}, end; !ec && i != end; i.increment(ec))
+    {
+        auto const name = i->path().filename().string();
+
+        // Connectors (e.g. "card0-HDMI-A-1") come and go without affecting probing
+        if ((name.find("card") == 0 || name.find("renderD") == 0) && name.find('-') == std::string::npos)
+            devices.push_back(i->path());
+    }
+    std::sort(devices.begin(), devices.end());
+
+    for (auto const& device : devices)
+    {
+        description << device.filename().string() << ' '
+                    << fs::canonical(device, ec).string() << ' '
+                    << read_file(device / "device" / "vendor")
+                    << read_file(device / "device" / "device")
+                    << read_file(device / "dev") << '\n';
+    }
+
+    for (auto var = environ; var && *var; ++var)
+    {
+        if (strncmp(*var, "MIR_SERVER_", 11) == 0 ||
+            strncmp(*var, "DISPLAY=", 8) == 0 ||
+            strncmp(*var, "WAYLAND_DISPLAY=", 16) == 0)
+        {
+            description << *var << '\n';
+        }
+    }
+
+    description << read_file("/proc/self/cmdline");
+
+    std::ostringstream result;
+    result << std::hex << std::hash<std::string>{}(description.str());
+    return result.str();
+}
+
+bool entry_for(mir::SharedLibrary const& module, CacheEntry& entry)
+{
+    auto const description = describe(module);
+    if (!description || !description->file)
+        return false;
+
+    boost::system::error_code ec;
+    entry.file = description->file;
+    entry.mtime = fs::last_write_time(entry.file, ec);
+    if (!ec)
+        entry.size = fs::file_size(entry.file, ec);
+
+    return !ec;
+}
+
+bool read_cache(std::string const& filename, std::string const& expected_fingerprint, std::vector<CacheEntry>& entries)
+{
+    std::ifstream in{filename};
+    std::string line;
+
+    if (!std::getline(in, line) || line != cache_header)
+        return false;
+
+    if (!std::getline(in, line) || line != "fingerprint " + expected_fingerprint)
+        return false;
+
+    while (std::getline(in, line))
+    {
+        std::istringstream fields{line};
+        int priority;
+        CacheEntry entry;
+
+        if (!(fields >> priority >> entry.mtime >> entry.size) || !std::getline(fields >> std::ws, entry.file))
+            return false;
+
+        entry.priority = static_cast<mg::PlatformPriority>(priority);
+        entries.push_back(entry);
+    }
+
+    return true;
+}
+
+void write_cache(std::string const& filename, std::string const& fingerprint, std::vector<CacheEntry> const& entries)
+{
+    auto const temporary = filename + ".tmp";
+
+    {
+        std::ofstream out{temporary, std::ios::trunc};
+        out << cache_header << '\n' << "fingerprint " << fingerprint << '\n';
+        for (auto const& entry : entries)
+            out << entry.priority << ' ' << entry.mtime << ' ' << entry.size << ' ' << entry.file << '\n';
+
+        out.flush();
+        if (!out)
+        {
+            mir::log_warning("Failed to write platform probe cache: %s", temporary.c_str());
+            return;
+        }
+    }
+
+    // Replace the cache atomically, so a concurrent reader never sees half of it
+    if (std::rename(temporary.c_str(), filename.c_str()) != 0)
+    {
+        mir::log_warning("Failed to write platform probe cache %s: %s", filename.c_str(), std::strerror(errno));
+        std::remove(temporary.c_str());
+    }
+}
+
+/// The module the cache says to use, or nullptr if the cache doesn't apply
+std::shared_ptr<mir::SharedLibrary> cached_module_for_device(
+    std::vector<std::shared_ptr<mir::SharedLibrary>> const& modules,
+    mir::options::ProgramOption const& options,
+    std::vector<CacheEntry> const& cached,
+    mir::SharedLibraryProberReport& report)
+{
+    std::vector<CacheEntry> current;
+    std::vector<std::shared_ptr<mir::SharedLibrary>> graphics_modules;
+    for (auto const& module : modules)
+    {
+        CacheEntry entry;
+        if (entry_for(*module, entry))
+        {
+            current.push_back(entry);
+            graphics_modules.push_back(module);
+        }
+    }
+
+    if (current != cached)
+        return nullptr;
+
+    auto const best = std::max_element(cached.begin(), cached.end(),
+        [](CacheEntry const& lhs, CacheEntry const& rhs) { return lhs.priority < rhs.priority; });
+
+    if (best == cached.end() || best->priority <= mg::unsupported)
+        return nullptr;
+
+    // Ties go to the first module, as when probing; max_element keeps the first maximum
+    auto const& module = graphics_modules[best - cached.begin()];
+    auto const result = probe(*module, options);
+    report.probed_module(best->file, result.elapsed);
+
+    if (result.priority != best->priority)
+        return nullptr;
+
+    log_found(result.description);
+    return module;
+}
+}
+
 std::shared_ptr<mir::SharedLibrary>
 mir::graphics::module_for_device(std::vector<std::shared_ptr<SharedLibrary>> const& modules, mir::options::ProgramOption const& options)
 {
-    mir::graphics::PlatformPriority best_priority_so_far = mir::graphics::unsupported;
-    std::shared_ptr<mir::SharedLibrary> best_module_so_far;
-    for (auto& module : modules)
+    mir::logging::NullSharedLibraryProberReport report;
+    return module_for_device(modules, options, report);
+}
+
+std::shared_ptr<mir::SharedLibrary>
+mir::graphics::module_for_device(
+    std::vector<std::shared_ptr<SharedLibrary>> const& modules,
+    mir::options::ProgramOption const& options,
+    mir::SharedLibraryProberReport& report)
+{
+    auto const start = std::chrono::steady_clock::now();
+    auto const cache_file = options.is_set(mir::options::platform_probe_cache_opt) ?
+        options.get<std::string>(mir::options::platform_probe_cache_opt) : std::string{};
+    auto const current_fingerprint = cache_file.empty() ? std::string{} : fingerprint();
+
+    if (!cache_file.empty())
     {
-        try
+        std::vector<CacheEntry> cached;
+        if (read_cache(cache_file, current_fingerprint, cached))
         {
-            auto probe = module->load_function<PlatformProbe>(
-                 "probe_graphics_platform",
-                 MIR_SERVER_GRAPHICS_PLATFORM_VERSION);
-
-            auto module_priority = probe(options);
-            if (module_priority > best_priority_so_far)
+            if (auto const module = cached_module_for_device(modules, options, cached, report))
             {
-                best_priority_so_far = module_priority;
-                best_module_so_far = module;
+                if (auto const description = describe(*module))
+                    report.selected_module(description->file, true, std::chrono::steady_clock::now() - start);
+                return module;
             }
+        }
+    }
+
+    // Probes one at a time: several probes take DRM master on the same
+    // devices, so they would see each other if run concurrently
+    std::vector<ProbeResult> results;
+    for (auto const& module : modules)
+        results.push_back(probe(*module, options));
+
+    mir::graphics::PlatformPriority best_priority_so_far = mir::graphics::unsupported;
+    std::shared_ptr<mir::SharedLibrary> best_module_so_far;
+    mir::ModuleProperties const* best_description{nullptr};
+    std::vector<CacheEntry> entries;
+
+    for (auto i = 0u; i != modules.size(); ++i)
+    {
+        auto const& result = results[i];
 
-            auto describe = module->load_function<DescribeModule>(
-                "describe_graphics_module",
-                MIR_SERVER_GRAPHICS_PLATFORM_VERSION);
-            auto desc = describe();
-            mir::log_info("Found graphics driver: %s (version %d.%d.%d)",
-                          desc->name,
-                          desc->major_version,
-                          desc->minor_version,
-                          desc->micro_version);
+        if (result.description)
+        {
+            report.probed_module(result.description->file ? result.description->file : result.description->name,
+                                 result.elapsed);
+            log_found(result.description);
         }
-        catch (std::runtime_error const&)
+
+        if (result.priority > best_priority_so_far)
+        {
+            best_priority_so_far = result.priority;
+            best_module_so_far = modules[i];
+            best_description = result.description;
+        }
+
+        CacheEntry entry;
+        if (!cache_file.empty() && entry_for(*modules[i], entry))
         {
+            entry.priority = result.priority;
+            entries.push_back(entry);
         }
     }
+
     if (best_priority_so_far > mir::graphics::unsupported)
     {
+        if (!cache_file.empty())
+            write_cache(cache_file, current_fingerprint, entries);
+
+        if (best_description && best_description->file)
+            report.selected_module(best_description->file, false, std::chrono::steady_clock::now() - start);
+
         return best_module_so_far;
     }
     BOOST_THROW_EXCEPTION((std::runtime_error{"Failed to find platform for current system"}));
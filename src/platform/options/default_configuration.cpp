@@ -36,6 +36,8 @@ char const* const mo::enable_input_opt            = "enable-input,i";
 char const* const mo::session_mediator_report_opt = "session-mediator-report";
 char const* const mo::msg_processor_report_opt    = "msg-processor-report";
 char const* const mo::compositor_report_opt       = "compositor-report";
+char const* const mo::buffer_lifetime_report_opt  = "buffer-lifetime-report";
+char const* const mo::memory_report_opt           = "memory-report";
 char const* const mo::display_report_opt          = "display-report";
 char const* const mo::legacy_input_report_opt     = "legacy-input-report";
 char const* const mo::connector_report_opt        = "connector-report";
@@ -55,14 +57,23 @@ char const* const mo::fatal_except_opt            = "on-fatal-error-except";
 char const* const mo::debug_opt                   = "debug";
 char const* const mo::composite_delay_opt         = "composite-delay";
 char const* const mo::enable_key_repeat_opt       = "enable-key-repeat";
+char const* const mo::seat_dispatch_thread_opt    = "seat-dispatch-thread";
+char const* const mo::log_severity_opt            = "log-severity";
+char const* const mo::async_logging_opt           = "async-logging";
+char const* const mo::metrics_socket_opt          = "metrics-socket";
+char const* const mo::startup_profile_opt         = "startup-profile";
+char const* const mo::parallel_startup_opt        = "parallel-startup";
+char const* const mo::event_batch_delay_opt       = "event-batch-delay";
 
 char const* const mo::off_opt_value = "off";
 char const* const mo::log_opt_value = "log";
 char const* const mo::lttng_opt_value = "lttng";
+char const* const mo::metrics_opt_value = "metrics";
 
 char const* const mo::platform_graphics_lib = "platform-graphics-lib";
 char const* const mo::platform_input_lib = "platform-input-lib";
 char const* const mo::platform_path = "platform-path";
+char const* const mo::platform_probe_cache_opt = "platform-probe-cache";
 
 namespace
 {
@@ -155,24 +166,32 @@ mo::DefaultConfiguration::DefaultConfiguration(
             "Library to use for platform input support (default: input-stub.so)")
         (platform_path, po::value<std::string>()->default_value(MIR_SERVER_PLATFORM_PATH),
             "Directory to look for platform libraries (default: " MIR_SERVER_PLATFORM_PATH ")")
+        (platform_probe_cache_opt, po::value<std::string>(),
+            "File in which to cache the result of probing the graphics platforms, "
+            "so later starts on the same hardware can skip probing (default: no cache)")
         (enable_input_opt, po::value<bool>()->default_value(enable_input_default),
             "Enable input.")
         (compositor_report_opt, po::value<std::string>()->default_value(off_opt_value),
-            "Compositor reporting [{log,lttng,off}]")
+            "Compositor reporting [{log,lttng,metrics,off}]")
+        (buffer_lifetime_report_opt, po::value<std::string>()->default_value(off_opt_value),
+            "How to handle the BufferLifetime report. [{log,lttng,off}]")
+        (memory_report_opt, po::value<std::string>()->default_value(off_opt_value),
+            "How to handle the Memory report, which attributes server memory "
+            "to client sessions. [{log,lttng,metrics,off}]")
         (connector_report_opt, po::value<std::string>()->default_value(off_opt_value),
             "How to handle the Connector report. [{log,lttng,off}]")
         (display_report_opt, po::value<std::string>()->default_value(off_opt_value),
             "How to handle the Display report. [{log,lttng,off}]")
         (input_report_opt, po::value<std::string>()->default_value(off_opt_value),
-            "How to handle to Input report. [{log,lttng,off}]")
+            "How to handle to Input report. [{log,lttng,metrics,off}]")
         (legacy_input_report_opt, po::value<std::string>()->default_value(off_opt_value),
             "How to handle the Legacy Input report. [{log,off}]")
         (seat_report_opt, po::value<std::string>()->default_value(off_opt_value),
-            "How to handle to Seat report. [{log,off}]")
+            "How to handle to Seat report. [{log,metrics,off}]")
         (session_mediator_report_opt, po::value<std::string>()->default_value(off_opt_value),
             "How to handle the SessionMediator report. [{log,lttng,off}]")
         (msg_processor_report_opt, po::value<std::string>()->default_value(off_opt_value),
-            "How to handle the MessageProcessor report. [{log,lttng,off}]")
+            "How to handle the MessageProcessor report. [{log,lttng,metrics,off}]")
         (scene_report_opt, po::value<std::string>()->default_value(off_opt_value),
             "How to handle the scene report. [{log,lttng,off}]")
         (shared_library_prober_report_opt, po::value<std::string>()->default_value(log_opt_value),
@@ -184,6 +203,11 @@ mo::DefaultConfiguration::DefaultConfiguration(
             "frames from clients before compositing). Higher values result in "
             "lower latency but risk causing frame skipping. "
             "Default: A negative value means decide automatically.")
+        (event_batch_delay_opt, po::value<int>()->default_value(0),
+            "How long in milliseconds to hold back pointer motion and touch "
+            "move events so they reach a client together in one message. "
+            "Other traffic to the client sends any held events at once. "
+            "0 sends every event as it arrives.")
         (name_opt, po::value<std::string>(),
             "When nested, the name Mir uses when registering with the host.")
         (nested_passthrough_opt, po::value<bool>()->default_value(true),
@@ -198,6 +222,21 @@ mo::DefaultConfiguration::DefaultConfiguration(
             "Cursor (mouse pointer) to use [{auto,software}]")
         (enable_key_repeat_opt, po::value<bool>()->default_value(true),
              "Enable server generated key repeat")
+        (seat_dispatch_thread_opt, po::value<bool>()->default_value(false),
+             "Process the input events of the seat on a dedicated thread, "
+             "separate from the thread reading the input devices")
+        (metrics_socket_opt, po::value<std::string>(),
+            "Socket on which to serve the metrics recorded by reports set to \"metrics\"")
+        (log_severity_opt, po::value<std::string>()->default_value("debug"),
+            "Most verbose severity of message to log [{critical,error,warning,informational,debug}]")
+        (async_logging_opt, po::value<bool>()->default_value(false),
+            "Format and write log messages on a background thread")
+        (startup_profile_opt, po::value<std::string>(),
+            "File to which to write the time taken to construct each server component, "
+            "in the collapsed stack format read by flamegraph.pl, when the server exits")
+        (parallel_startup_opt, po::value<bool>()->default_value(false),
+            "Construct the input platform and the client connectors on startup threads "
+            "while the graphics platform and display are initialised")
         (fatal_except_opt, "On \"fatal error\" conditions [e.g. drivers behaving "
             "in unexpected ways] throw an exception (instead of a core dump)")
         (debug_opt, "Enable extra development debugging. "
@@ -217,8 +256,12 @@ void mo::DefaultConfiguration::add_platform_options()
         (platform_path,
          po::value<std::string>()->default_value(MIR_SERVER_PLATFORM_PATH),
         "");
+    program_options.add_options()
+        (platform_probe_cache_opt,
+         po::value<std::string>(), "");
     mo::ProgramOption options;
     options.parse_arguments(program_options, argc, argv);
+    options.parse_environment(program_options, "MIR_SERVER_");
 
     // TODO: We should just load all the platform plugins we can and present their options.
     auto env_libname = ::getenv("MIR_SERVER_PLATFORM_GRAPHICS_LIB");
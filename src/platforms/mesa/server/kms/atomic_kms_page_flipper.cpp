@@ -0,0 +1,185 @@
+/*
+ * Copyright © 2017 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "atomic_kms_page_flipper.h"
+#include "kms-utils/drm_mode_resources.h"
+#include "mir/log.h"
+
+#include <xf86drm.h>
+#include <xf86drmMode.h>
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace mgm = mir::graphics::mesa;
+namespace mgk = mir::graphics::kms;
+
+namespace
+{
+typedef std::unique_ptr<drmModeAtomicReq, void(*)(drmModeAtomicReqPtr)> AtomicRequestUPtr;
+
+bool kernel_identifies_crtc_in_events(int drm_fd)
+{
+#if defined(DRM_CAP_CRTC_IN_VBLANK_EVENT) && DRM_EVENT_CONTEXT_VERSION >= 3
+    uint64_t value{0};
+    return drmGetCap(drm_fd, DRM_CAP_CRTC_IN_VBLANK_EVENT, &value) == 0 && value;
+#else
+    (void)drm_fd;
+    return false;
+#endif
+}
+
+std::vector<uint32_t> crtcs_of(std::vector<mgm::PageFlipper::Flip> const& flips)
+{
+    std::vector<uint32_t> crtcs;
+    for (auto const& flip : flips)
+        crtcs.push_back(flip.crtc_id);
+
+    std::sort(crtcs.begin(), crtcs.end());
+    return crtcs;
+}
+}
+
+mgm::AtomicKMSPageFlipper::AtomicKMSPageFlipper(
+    int drm_fd,
+    std::shared_ptr<DisplayReport> const& report) :
+    KMSPageFlipper{drm_fd, report},
+    events_identify_crtc{kernel_identifies_crtc_in_events(drm_fd)},
+    group_event_data{0, 0, this}
+{
+}
+
+/* This method should be called with the 'pf_mutex' locked */
+bool mgm::AtomicKMSPageFlipper::submit_flips(std::vector<Flip> const& flips)
+{
+    if (flips.size() > 1 && !events_identify_crtc)
+    {
+        /* We couldn't tell the flip events apart, so commit each CRTC on its own */
+        bool any_scheduled{false};
+        for (auto const& flip : flips)
+        {
+            if (submit_flips({flip}))
+                any_scheduled = true;
+        }
+        return any_scheduled;
+    }
+
+    if (!validate(flips))
+        return KMSPageFlipper::submit_flips(flips);
+
+    void* const event_data = flips.size() == 1 ?
+        static_cast<void*>(&pending_page_flips[flips.front().crtc_id]) :
+        static_cast<void*>(&group_event_data);
+
+    if (commit(flips, DRM_MODE_ATOMIC_NONBLOCK | DRM_MODE_PAGE_FLIP_EVENT, event_data))
+        return true;
+
+    /* Whatever changed since it was validated, check it again next time */
+    validated.erase(crtcs_of(flips));
+
+    for (auto const& flip : flips)
+        pending_page_flips.erase(flip.crtc_id);
+
+    return false;
+}
+
+bool mgm::AtomicKMSPageFlipper::commit(std::vector<Flip> const& flips, uint32_t flags, void* event_data)
+{
+    AtomicRequestUPtr request{drmModeAtomicAlloc(), &drmModeAtomicFree};
+    if (!request)
+        return false;
+
+    for (auto const& flip : flips)
+    {
+        auto const plane = primary_plane_for(flip.crtc_id);
+        if (!plane ||
+            drmModeAtomicAddProperty(request.get(), plane->plane_id, plane->fb_id_property, flip.fb_id) < 0 ||
+            drmModeAtomicAddProperty(request.get(), plane->plane_id, plane->crtc_id_property, flip.crtc_id) < 0)
+        {
+            return false;
+        }
+    }
+
+    return drmModeAtomicCommit(drm_fd, request.get(), flags, event_data) == 0;
+}
+
+bool mgm::AtomicKMSPageFlipper::validate(std::vector<Flip> const& flips)
+{
+    auto const crtcs = crtcs_of(flips);
+
+    if (validated.count(crtcs))
+        return true;
+
+    if (rejected.count(crtcs))
+        return false;
+
+    if (commit(flips, DRM_MODE_ATOMIC_TEST_ONLY, nullptr))
+    {
+        validated.insert(crtcs);
+        return true;
+    }
+
+    mir::log_info("Atomic page flip of %zu CRTC(s) rejected; using legacy page flips for them",
+                  crtcs.size());
+    rejected.insert(crtcs);
+    return false;
+}
+
+auto mgm::AtomicKMSPageFlipper::primary_plane_for(uint32_t crtc_id) -> PrimaryPlane const*
+{
+    auto const cached = primary_planes.find(crtc_id);
+    if (cached != primary_planes.end())
+        return &cached->second;
+
+    try
+    {
+        mgk::DRMModeResources resources{drm_fd};
+
+        int crtc_index{0};
+        auto crtc = resources.crtcs().begin();
+        for (; crtc != resources.crtcs().end() && (*crtc)->crtc_id != crtc_id; ++crtc)
+            ++crtc_index;
+
+        if (crtc == resources.crtcs().end())
+            return nullptr;
+
+        mgk::PlaneResources plane_resources{drm_fd};
+
+        for (auto& plane : plane_resources.planes())
+        {
+            if (!(plane->possible_crtcs & (1u << crtc_index)) ||
+                (plane->crtc_id && plane->crtc_id != crtc_id))
+            {
+                continue;
+            }
+
+            mgk::ObjectProperties const properties{drm_fd, plane->plane_id, DRM_MODE_OBJECT_PLANE};
+            if (properties.has_property("type") && properties["type"] == DRM_PLANE_TYPE_PRIMARY)
+            {
+                return &(primary_planes[crtc_id] = PrimaryPlane{
+                    plane->plane_id,
+                    properties.id_for("FB_ID"),
+                    properties.id_for("CRTC_ID")});
+            }
+        }
+    }
+    catch (std::exception const& error)
+    {
+        mir::log_warning("Failed to find the primary plane of CRTC %u: %s", crtc_id, error.what());
+    }
+
+    return nullptr;
+}
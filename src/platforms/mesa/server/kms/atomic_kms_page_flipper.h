@@ -0,0 +1,73 @@
+/*
+ * Copyright © 2017 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MIR_GRAPHICS_MESA_ATOMIC_KMS_PAGE_FLIPPER_H_
+#define MIR_GRAPHICS_MESA_ATOMIC_KMS_PAGE_FLIPPER_H_
+
+#include "kms_page_flipper.h"
+
+#include <set>
+
+namespace mir
+{
+namespace graphics
+{
+namespace mesa
+{
+
+/**
+ * Flips with atomic commits to the CRTCs' primary planes, so that outputs
+ * flipped together (e.g. clones) change on the same vblank.
+ *
+ * Each combination of CRTCs is checked with a test-only commit the first time
+ * it is flipped; any the driver rejects, or whose primary planes can't be
+ * found, are flipped the legacy way instead.
+ *
+ * The DRM fd must have DRM_CLIENT_CAP_ATOMIC set.
+ */
+class AtomicKMSPageFlipper : public KMSPageFlipper
+{
+public:
+    AtomicKMSPageFlipper(int drm_fd, std::shared_ptr<DisplayReport> const& report);
+
+private:
+    struct PrimaryPlane
+    {
+        uint32_t plane_id;
+        uint32_t fb_id_property;
+        uint32_t crtc_id_property;
+    };
+
+    bool submit_flips(std::vector<Flip> const& flips) override;
+    bool commit(std::vector<Flip> const& flips, uint32_t flags, void* event_data);
+    bool validate(std::vector<Flip> const& flips);
+    PrimaryPlane const* primary_plane_for(uint32_t crtc_id);
+
+    /* Whether the kernel tells us which CRTC each flip event is for */
+    bool const events_identify_crtc;
+    /* Event data for commits of several CRTCs; the CRTC comes with each event */
+    PageFlipEventData group_event_data;
+
+    std::unordered_map<uint32_t, PrimaryPlane> primary_planes;
+    std::set<std::vector<uint32_t>> validated;
+    std::set<std::vector<uint32_t>> rejected;
+};
+
+}
+}
+}
+
+#endif /* MIR_GRAPHICS_MESA_ATOMIC_KMS_PAGE_FLIPPER_H_ */
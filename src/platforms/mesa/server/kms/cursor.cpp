@@ -290,17 +290,35 @@ void mgm::Cursor::show(CursorImage const& cursor_image)
 {
     std::lock_guard<std::mutex> lg(guard);
 
-    size = cursor_image.size();
+    auto const new_size = cursor_image.size();
+    auto const new_bytes = new_size.width.as_uint32_t() * new_size.height.as_uint32_t() * 4;
 
-    argb8888.resize(size.width.as_uint32_t() * size.height.as_uint32_t() * 4);
-    memcpy(argb8888.data(), cursor_image.as_argb_8888(), argb8888.size());
+    // Clients often set the same image again (e.g. on each surface they enter),
+    // so don't rewrite the cursor buffers when nothing has changed.
+    bool const unchanged = new_size == size && new_bytes == argb8888.size() &&
+        memcmp(argb8888.data(), cursor_image.as_argb_8888(), new_bytes) == 0;
 
+    size = new_size;
     hotspot = cursor_image.hotspot();
+
+    if (!unchanged)
     {
-        auto locked_buffers = buffers.lock();
-        for (auto& pair : *locked_buffers)
+        argb8888.resize(new_bytes);
+        memcpy(argb8888.data(), cursor_image.as_argb_8888(), argb8888.size());
+
+        try
+        {
+            auto locked_buffers = buffers.lock();
+            for (auto& pair : *locked_buffers)
+            {
+                pad_and_write_image_data_locked(lg, pair.second);
+            }
+        }
+        catch (...)
         {
-            pad_and_write_image_data_locked(lg, pair.second);
+            // The buffers may not hold this image, so don't skip writing it next time
+            argb8888.clear();
+            throw;
         }
     }
 
@@ -23,6 +23,7 @@
 #include "kms_display_configuration.h"
 #include "kms_output.h"
 #include "kms_page_flipper.h"
+#include "atomic_kms_page_flipper.h"
 #include "virtual_terminal.h"
 #include "mir/graphics/overlapping_output_grouping.h"
 #include "mir/graphics/event_handler_register.h"
@@ -46,6 +47,7 @@
 #include <stdexcept>
 #include <algorithm>
 #include <unordered_map>
+#include <cstdlib>
 
 namespace mgm = mir::graphics::mesa;
 namespace mg = mir::graphics;
@@ -54,6 +56,27 @@ namespace geom = mir::geometry;
 namespace
 {
 
+char const* const mir_mesa_kms_atomic = "MIR_MESA_KMS_ATOMIC";
+
+std::shared_ptr<mgm::KMSPageFlipper> create_page_flipper(
+    int drm_fd,
+    std::shared_ptr<mg::DisplayReport> const& listener)
+{
+    // Atomic page flips are opt-in until they've been tried on more drivers
+    if (getenv(mir_mesa_kms_atomic))
+    {
+        if (drmSetClientCap(drm_fd, DRM_CLIENT_CAP_ATOMIC, 1) == 0)
+        {
+            mir::log_info("Using atomic KMS page flips");
+            return std::make_shared<mgm::AtomicKMSPageFlipper>(drm_fd, listener);
+        }
+
+        mir::log_info("Atomic KMS is not supported by the driver; using legacy page flips");
+    }
+
+    return std::make_shared<mgm::KMSPageFlipper>(drm_fd, listener);
+}
+
 int errno_from_exception(std::exception const& e)
 {
     auto errno_ptr = boost::get_error_info<boost::errinfo_errno>(e);
@@ -193,7 +216,7 @@ mgm::Display::Display(std::vector<std::shared_ptr<helpers::DRMHelper>> const& dr
                   auto& flipper = flippers[drm_fd];
                   if (!flipper)
                   {
-                      flipper = std::make_shared<KMSPageFlipper>(drm_fd, listener);
+                      flipper = create_page_flipper(drm_fd, listener);
                   }
                   return flipper;
               })},
@@ -438,9 +461,19 @@ bool mgm::Display::apply_if_configuration_preserves_display_buffers(
 
 mg::Frame mgm::Display::last_frame_on(unsigned output_id) const
 {
-    auto output = current_display_configuration.get_output_for(
-        DisplayConfigurationOutputId{static_cast<int>(output_id)});
-    return output->last_frame();
+    std::lock_guard<std::mutex> lg{configuration_mutex};
+
+    try
+    {
+        auto output = current_display_configuration.get_output_for(
+            DisplayConfigurationOutputId{static_cast<int>(output_id)});
+        return output->last_frame();
+    }
+    catch (std::out_of_range const&)
+    {
+        // The output has been unplugged since the caller last saw it
+        return {};
+    }
 }
 
 namespace
@@ -18,6 +18,7 @@
 
 #include "display_buffer.h"
 #include "kms_output.h"
+#include "page_flipper.h"
 #include "mir/graphics/display_report.h"
 #include "mir/graphics/transformation.h"
 #include "bypass.h"
@@ -39,6 +40,7 @@
 #include <chrono>
 #include <thread>
 #include <algorithm>
+#include <cstring>
 
 namespace mg = mir::graphics;
 namespace mgm = mir::graphics::mesa;
@@ -164,6 +166,29 @@ bool needs_bounce_buffer(mgm::KMSOutput const& destination, gbm_bo* source)
     return destination.buffer_requires_migration(source);
 }
 
+bool has_egl_extension(EGLDisplay dpy, char const* extension)
+{
+    auto const extensions = eglQueryString(dpy, EGL_EXTENSIONS);
+    if (!extensions)
+        return false;
+
+    auto const length = strlen(extension);
+    for (auto found = strstr(extensions, extension); found; found = strstr(found + length, extension))
+    {
+        auto const end = found[length];
+        if ((found == extensions || found[-1] == ' ') && (end == '\0' || end == ' '))
+            return true;
+    }
+
+    return false;
+}
+
+// What we predict for composited frames until we've measured some
+std::chrono::microseconds const render_time_ceiling{50000};
+
+// Don't wait for ever on a GPU that's hung; it will have missed the frame anyway
+EGLTimeKHR const render_fence_timeout_ns{100000000};
+
 const GLchar* const vshader =
     {
         "attribute vec4 position;\n"
@@ -497,7 +522,8 @@ mgm::DisplayBuffer::DisplayBuffer(
       area(area),
       transform{transformation},
       needs_set_crtc{false},
-      page_flips_pending{false}
+      page_flips_pending{false},
+      render_time{render_time_ceiling}
 {
     listener->report_successful_setup_of_native_resources();
 
@@ -505,6 +531,17 @@ mgm::DisplayBuffer::DisplayBuffer(
 
     listener->report_successful_egl_make_current_on_construction();
 
+    fence_display = eglGetCurrentDisplay();
+    if (has_egl_extension(fence_display, "EGL_KHR_fence_sync"))
+    {
+        create_sync = reinterpret_cast<PFNEGLCREATESYNCKHRPROC>(eglGetProcAddress("eglCreateSyncKHR"));
+        client_wait_sync = reinterpret_cast<PFNEGLCLIENTWAITSYNCKHRPROC>(eglGetProcAddress("eglClientWaitSyncKHR"));
+        destroy_sync = reinterpret_cast<PFNEGLDESTROYSYNCKHRPROC>(eglGetProcAddress("eglDestroySyncKHR"));
+
+        if (!create_sync || !client_wait_sync || !destroy_sync)
+            create_sync = nullptr;
+    }
+
     glClear(GL_COLOR_BUFFER_BIT);
 
     surface.swap_buffers();
@@ -561,6 +598,8 @@ mgm::DisplayBuffer::DisplayBuffer(
 
 mgm::DisplayBuffer::~DisplayBuffer()
 {
+    if (render_fence != EGL_NO_SYNC_KHR)
+        destroy_sync(fence_display, render_fence);
 }
 
 geom::Rectangle mgm::DisplayBuffer::view_area() const
@@ -581,6 +620,8 @@ void mgm::DisplayBuffer::set_transformation(glm::mat2 const& t, geometry::Rectan
 
 bool mgm::DisplayBuffer::overlay(RenderableList const& renderable_list)
 {
+    frame_start = std::chrono::steady_clock::now();
+
     glm::mat2 static const no_transformation(1);
     if (transform == no_transformation &&
        (bypass_option == mgm::BypassOption::allowed))
@@ -618,6 +659,9 @@ void mgm::DisplayBuffer::for_each_display_buffer(
 
 void mgm::DisplayBuffer::swap_buffers()
 {
+    if (create_sync && render_fence == EGL_NO_SYNC_KHR)
+        render_fence = create_sync(fence_display, EGL_SYNC_FENCE_KHR, nullptr);
+
     surface.swap_buffers();
     bypass_buf = nullptr;
     bypass_bufobj = nullptr;
@@ -684,7 +728,7 @@ void mgm::DisplayBuffer::post()
     using namespace std;  // For operator""ms()
 
     // Predicted worst case render time for the next frame...
-    auto predicted_render_time = 50ms;
+    chrono::microseconds predicted_render_time = render_time.predicted();
 
     if (bypass_buf)
     {
@@ -712,16 +756,30 @@ void mgm::DisplayBuffer::post()
          * buffering that clone mode requires).
          */
         if (outputs.size() == 1)
+        {
+            /*
+             * The page flip can't complete before the GPU has finished the
+             * frame, so waiting for it here to measure the render time costs
+             * us nothing.
+             */
+            auto const actual_render_time = measure_render_time();
+            if (actual_render_time > chrono::microseconds::zero())
+            {
+                listener->report_render_time(outputs.front()->id(), predicted_render_time, actual_render_time);
+                render_time.record(actual_render_time);
+                predicted_render_time = render_time.predicted();
+            }
+
             wait_for_page_flip();
+        }
+    }
 
-        /*
-         * TODO: If you're optimistic about your GPU performance and/or
-         *       measure it carefully you may wish to set predicted_render_time
-         *       to a lower value here for lower latency.
-         *
-         *predicted_render_time = 9ms; // e.g. about the same as Weston
-         */
+    if (render_fence != EGL_NO_SYNC_KHR)
+    {
+        destroy_sync(fence_display, render_fence);
+        render_fence = EGL_NO_SYNC_KHR;
     }
+    frame_start = {};
 
     // Buffer lifetimes are managed exclusively by scheduled*/visible* now
     bypass_buf = nullptr;
@@ -731,12 +789,26 @@ void mgm::DisplayBuffer::post()
     if (outputs.size() == 1)
     {
         auto const& output = outputs.front();
-        auto const min_frame_interval = 1000ms / output->max_refresh_rate();
+        auto const min_frame_interval = chrono::microseconds{1000000} / output->max_refresh_rate();
         if (predicted_render_time < min_frame_interval)
-            recommend_sleep = min_frame_interval - predicted_render_time;
+            recommend_sleep = chrono::duration_cast<chrono::milliseconds>(min_frame_interval - predicted_render_time);
     }
 }
 
+std::chrono::microseconds mgm::DisplayBuffer::measure_render_time()
+{
+    // Frames we didn't see start (not composited by us) can't be measured
+    if (frame_start == std::chrono::steady_clock::time_point{})
+        return std::chrono::microseconds::zero();
+
+    if (render_fence != EGL_NO_SYNC_KHR)
+        client_wait_sync(fence_display, render_fence, 0, render_fence_timeout_ns);
+
+    return std::max(
+        std::chrono::microseconds{1},
+        std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - frame_start));
+}
+
 std::chrono::milliseconds mgm::DisplayBuffer::recommended_sleep() const
 {
     return recommend_sleep;
@@ -748,12 +820,29 @@ bool mgm::DisplayBuffer::schedule_page_flip(FBHandle const& bufobj)
      * Schedule the current front buffer object for display. Note that
      * the page flip is asynchronous and synchronized with vertical refresh.
      */
-    for (auto& output : outputs)
+    if (outputs.size() == 1)
     {
-        if (output->schedule_page_flip(bufobj))
+        if (outputs.front()->schedule_page_flip(bufobj))
             page_flips_pending = true;
+
+        return page_flips_pending;
+    }
+
+    /*
+     * Clones are flipped as a group, so that (with atomic KMS) they change
+     * on the same vblank rather than one after the other.
+     */
+    PageFlipGroup group;
+    bool any_output_flippable{false};
+    for (auto& output : outputs)
+    {
+        if (output->add_page_flip_to(group, bufobj))
+            any_output_flippable = true;
     }
 
+    if (any_output_flippable && group.schedule())
+        page_flips_pending = true;
+
     return page_flips_pending;
 }
 
@@ -25,10 +25,14 @@
 #include "display_helpers.h"
 #include "egl_helper.h"
 #include "platform_common.h"
+#include "render_time_predictor.h"
+
+#include <EGL/eglext.h>
 
 #include <vector>
 #include <memory>
 #include <atomic>
+#include <chrono>
 
 namespace mir
 {
@@ -129,6 +133,7 @@ public:
 private:
     bool schedule_page_flip(FBHandle const& bufobj);
     void set_crtc(FBHandle const&);
+    std::chrono::microseconds measure_render_time();
 
     std::shared_ptr<graphics::Buffer> visible_bypass_frame, scheduled_bypass_frame;
     std::shared_ptr<Buffer> bypass_buf{nullptr};
@@ -155,6 +160,19 @@ private:
     std::atomic<bool> needs_set_crtc;
     std::chrono::milliseconds recommend_sleep{0};
     bool page_flips_pending;
+
+    /*
+     * Composited frames are timed from overlay() until the GPU has finished
+     * them, using an EGL fence if we have EGL_KHR_fence_sync or until post()
+     * if not. The predicted render time determines recommend_sleep.
+     */
+    RenderTimePredictor render_time;
+    std::chrono::steady_clock::time_point frame_start;
+    EGLDisplay fence_display{EGL_NO_DISPLAY};
+    EGLSyncKHR render_fence{EGL_NO_SYNC_KHR};
+    PFNEGLCREATESYNCKHRPROC create_sync{nullptr};
+    PFNEGLCLIENTWAITSYNCKHRPROC client_wait_sync{nullptr};
+    PFNEGLDESTROYSYNCKHRPROC destroy_sync{nullptr};
 };
 
 }
@@ -40,6 +40,7 @@ namespace mesa
 {
 
 class FBHandle;
+class PageFlipGroup;
 
 class KMSOutput
 {
@@ -67,6 +68,13 @@ public:
     virtual bool set_crtc(FBHandle const& fb) = 0;
     virtual void clear_crtc() = 0;
     virtual bool schedule_page_flip(FBHandle const& fb) = 0;
+    /**
+     * Adds this output's flip to fb to a group scheduled by the caller, so
+     * that outputs showing the same buffer flip together.
+     *
+     * \return false if the output can't flip (e.g. it has no CRTC).
+     */
+    virtual bool add_page_flip_to(PageFlipGroup& group, FBHandle const& fb) = 0;
     virtual void wait_for_page_flip() = 0;
 
     virtual bool set_cursor(gbm_bo* buffer) = 0;
@@ -44,14 +44,32 @@ void page_flip_handler(int /*fd*/, unsigned int seq,
                                               seq, ns);
 }
 
+#if DRM_EVENT_CONTEXT_VERSION >= 3
+void page_flip_handler2(int /*fd*/, unsigned int seq,
+                        unsigned int sec, unsigned int usec,
+                        unsigned int crtc_id, void* data)
+{
+    auto page_flip_data = static_cast<mgm::PageFlipEventData*>(data);
+    std::chrono::nanoseconds ns{sec*1000000000LL + usec*1000LL};
+
+    /*
+     * An atomic commit flipping several CRTCs sends an event for each with
+     * the same data, so we need the CRTC from the event. Kernels before 4.12
+     * don't supply it, but then we only ever have one CRTC per event data.
+     */
+    page_flip_data->flipper->notify_page_flip(crtc_id ? crtc_id : page_flip_data->crtc_id,
+                                              seq, ns);
+}
+#endif
+
 }
 
 mgm::KMSPageFlipper::KMSPageFlipper(
     int drm_fd,
     std::shared_ptr<DisplayReport> const& report) :
     drm_fd{drm_fd},
-    report{report},
     pending_page_flips(),
+    report{report},
     worker_tid()
 {
     uint64_t mono = 0;
@@ -64,36 +82,61 @@ mgm::KMSPageFlipper::KMSPageFlipper(
 bool mgm::KMSPageFlipper::schedule_flip(uint32_t crtc_id,
                                         uint32_t fb_id,
                                         uint32_t connector_id)
+{
+    return schedule_flips({Flip{crtc_id, fb_id, connector_id}});
+}
+
+bool mgm::KMSPageFlipper::schedule_flips(std::vector<Flip> const& flips)
 {
     std::unique_lock<std::mutex> lock{pf_mutex};
 
-    if (pending_page_flips.find(crtc_id) != pending_page_flips.end())
-        BOOST_THROW_EXCEPTION(std::logic_error("Page flip for crtc_id is already scheduled"));
+    for (auto const& flip : flips)
+    {
+        if (pending_page_flips.find(flip.crtc_id) != pending_page_flips.end())
+            BOOST_THROW_EXCEPTION(std::logic_error("Page flip for crtc_id is already scheduled"));
+    }
 
-    pending_page_flips[crtc_id] = PageFlipEventData{crtc_id, connector_id, this};
+    for (auto const& flip : flips)
+        pending_page_flips[flip.crtc_id] = PageFlipEventData{flip.crtc_id, flip.connector_id, this};
 
-    /*
-     * It appears we can't tell the difference between flipping being
-     * unsupported or failing for other reasons. On VirtualBox this always
-     * fails with -22 (Invalid argument) despite the arguments being
-     * apparently valid.
-     */
-    auto ret = drmModePageFlip(drm_fd, crtc_id, fb_id,
-                               DRM_MODE_PAGE_FLIP_EVENT,
-                               &pending_page_flips[crtc_id]);
+    return submit_flips(flips);
+}
 
-    if (ret)
-        pending_page_flips.erase(crtc_id);
+bool mgm::KMSPageFlipper::submit_flips(std::vector<Flip> const& flips)
+{
+    bool any_scheduled{false};
+
+    for (auto const& flip : flips)
+    {
+        /*
+         * It appears we can't tell the difference between flipping being
+         * unsupported or failing for other reasons. On VirtualBox this always
+         * fails with -22 (Invalid argument) despite the arguments being
+         * apparently valid.
+         */
+        auto ret = drmModePageFlip(drm_fd, flip.crtc_id, flip.fb_id,
+                                   DRM_MODE_PAGE_FLIP_EVENT,
+                                   &pending_page_flips[flip.crtc_id]);
+
+        if (ret)
+            pending_page_flips.erase(flip.crtc_id);
+        else
+            any_scheduled = true;
+    }
 
-    return (ret == 0);
+    return any_scheduled;
 }
 
 mg::Frame mgm::KMSPageFlipper::wait_for_flip(uint32_t crtc_id)
 {
     drmEventContext evctx;
     memset(&evctx, 0, sizeof evctx);
-    evctx.version = 2;  // We only support the old v2 page_flip_handler
+    evctx.version = 2;
     evctx.page_flip_handler = &page_flip_handler;
+#if DRM_EVENT_CONTEXT_VERSION >= 3
+    evctx.version = 3;
+    evctx.page_flip_handler2 = &page_flip_handler2;
+#endif
 
     static std::thread::id const invalid_tid;
 
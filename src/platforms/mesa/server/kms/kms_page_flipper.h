@@ -53,17 +53,28 @@ public:
     KMSPageFlipper(int drm_fd, std::shared_ptr<DisplayReport> const& report);
 
     bool schedule_flip(uint32_t crtc_id, uint32_t fb_id, uint32_t connector_id) override;
+    bool schedule_flips(std::vector<Flip> const& flips) override;
     Frame wait_for_flip(uint32_t crtc_id) override;
 
     std::thread::id debug_get_worker_tid();
 
     void notify_page_flip(uint32_t crtc_id, int64_t msc, std::chrono::nanoseconds ust);
+
+protected:
+    /*
+     * Asks the driver for the flips, each of which already has its event
+     * data in pending_page_flips. Flips that can't be scheduled must be
+     * removed from pending_page_flips. Called with pf_mutex locked.
+     */
+    virtual bool submit_flips(std::vector<Flip> const& flips);
+
+    int const drm_fd;
+    std::unordered_map<uint32_t,PageFlipEventData> pending_page_flips;
+
 private:
     bool page_flip_is_done(uint32_t crtc_id);
 
-    int const drm_fd;
     std::shared_ptr<DisplayReport> const report;
-    std::unordered_map<uint32_t,PageFlipEventData> pending_page_flips;
     std::unordered_map<uint32_t,Frame> completed_page_flips;
     std::mutex pf_mutex;
     std::condition_variable pf_cv;
@@ -21,6 +21,9 @@
 
 #include "mir/graphics/frame.h"
 #include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
 
 namespace mir
 {
@@ -32,9 +35,22 @@ namespace mesa
 class PageFlipper
 {
 public:
+    struct Flip
+    {
+        uint32_t crtc_id;
+        uint32_t fb_id;
+        uint32_t connector_id;
+    };
+
     virtual ~PageFlipper() {}
 
     virtual bool schedule_flip(uint32_t crtc_id, uint32_t fb_id, uint32_t connector_id) = 0;
+    /*
+     * Schedules flips on several CRTCs, to take effect on the same vblank
+     * where the driver allows it. Returns whether any of them were scheduled;
+     * each one that was must still be waited for.
+     */
+    virtual bool schedule_flips(std::vector<Flip> const& flips) = 0;
     virtual Frame wait_for_flip(uint32_t crtc_id) = 0;
 
 protected:
@@ -43,6 +59,45 @@ protected:
     PageFlipper& operator=(PageFlipper const&) = delete;
 };
 
+/*
+ * The flips of outputs cloning one buffer, collected so that each flipper
+ * (i.e. DRM device) schedules its share of them together.
+ */
+class PageFlipGroup
+{
+public:
+    void add(std::shared_ptr<PageFlipper> const& flipper, PageFlipper::Flip const& flip)
+    {
+        for (auto& batch : batches)
+        {
+            if (batch.first == flipper)
+            {
+                batch.second.push_back(flip);
+                return;
+            }
+        }
+
+        batches.emplace_back(flipper, std::vector<PageFlipper::Flip>{flip});
+    }
+
+    /* Returns false only if there were flips and none could be scheduled */
+    bool schedule()
+    {
+        bool any_scheduled{batches.empty()};
+
+        for (auto const& batch : batches)
+        {
+            if (batch.first->schedule_flips(batch.second))
+                any_scheduled = true;
+        }
+
+        return any_scheduled;
+    }
+
+private:
+    std::vector<std::pair<std::shared_ptr<PageFlipper>, std::vector<PageFlipper::Flip>>> batches;
+};
+
 }
 }
 }
@@ -226,6 +226,23 @@ bool mgm::RealKMSOutput::schedule_page_flip(FBHandle const& fb)
         connector->connector_id);
 }
 
+bool mgm::RealKMSOutput::add_page_flip_to(PageFlipGroup& group, FBHandle const& fb)
+{
+    std::unique_lock<std::mutex> lg(power_mutex);
+    if (power_mode != mir_power_mode_on)
+        return true;
+    if (!current_crtc)
+    {
+        mir::log_error("Output %s has no associated CRTC to schedule page flips on",
+                       mgk::connector_name(connector).c_str());
+        return false;
+    }
+    group.add(
+        page_flipper,
+        {current_crtc->crtc_id, fb.get_drm_fb_id(), connector->connector_id});
+    return true;
+}
+
 void mgm::RealKMSOutput::wait_for_page_flip()
 {
     std::unique_lock<std::mutex> lg(power_mutex);
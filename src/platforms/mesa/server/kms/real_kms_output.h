@@ -54,6 +54,7 @@ public:
     bool set_crtc(FBHandle const& fb) override;
     void clear_crtc() override;
     bool schedule_page_flip(FBHandle const& fb) override;
+    bool add_page_flip_to(PageFlipGroup& group, FBHandle const& fb) override;
     void wait_for_page_flip() override;
 
     bool set_cursor(gbm_bo* buffer) override;
@@ -0,0 +1,68 @@
+/*
+ * Copyright © 2017 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "render_time_predictor.h"
+
+#include <algorithm>
+
+namespace mgm = mir::graphics::mesa;
+
+namespace
+{
+// Allow for the scene snapshot and occlusion before the measurement starts,
+// and for scheduling jitter when waking up
+std::chrono::microseconds const fixed_margin{1000};
+}
+
+mgm::RenderTimePredictor::RenderTimePredictor(Duration ceiling)
+    : ceiling{ceiling}
+{
+    recent.fill(Duration::zero());
+}
+
+auto mgm::RenderTimePredictor::predicted() const -> Duration
+{
+    if (recorded < window)
+        return ceiling;
+
+    auto const slowest = slowest_recent();
+    auto const margin = frames_to_recover ? slowest : slowest / 4;
+
+    return std::min(ceiling, slowest + margin + fixed_margin);
+}
+
+bool mgm::RenderTimePredictor::record(Duration actual)
+{
+    auto const missed = actual > predicted();
+
+    recent[recorded++ % window] = actual;
+
+    // Keep the count bounded, but never below the window once it's full
+    if (recorded == 2 * window)
+        recorded = window;
+
+    if (missed)
+        frames_to_recover = recovery_frames;
+    else if (frames_to_recover)
+        --frames_to_recover;
+
+    return missed;
+}
+
+auto mgm::RenderTimePredictor::slowest_recent() const -> Duration
+{
+    return *std::max_element(begin(recent), end(recent));
+}
@@ -0,0 +1,67 @@
+/*
+ * Copyright © 2017 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MIR_GRAPHICS_MESA_RENDER_TIME_PREDICTOR_H_
+#define MIR_GRAPHICS_MESA_RENDER_TIME_PREDICTOR_H_
+
+#include <array>
+#include <chrono>
+
+namespace mir
+{
+namespace graphics
+{
+namespace mesa
+{
+
+/**
+ * Predicts how long the next composited frame will take to render, from the
+ * render times of recent frames. The prediction is the slowest recent frame
+ * plus a safety margin, and never exceeds the given ceiling.
+ *
+ * Until enough frames have been measured the ceiling is predicted. After a
+ * frame takes longer than predicted the margin is doubled for a while, so a
+ * single slow frame doesn't turn into a run of missed frames.
+ */
+class RenderTimePredictor
+{
+public:
+    typedef std::chrono::microseconds Duration;
+
+    explicit RenderTimePredictor(Duration ceiling);
+
+    Duration predicted() const;
+
+    /// Returns whether the frame took longer than was predicted
+    bool record(Duration actual);
+
+private:
+    static size_t const window{16};
+    static int const recovery_frames{60};
+
+    Duration slowest_recent() const;
+
+    Duration const ceiling;
+    std::array<Duration, window> recent;
+    size_t recorded{0};
+    int frames_to_recover{0};
+};
+
+}
+}
+}
+
+#endif /* MIR_GRAPHICS_MESA_RENDER_TIME_PREDICTOR_H_ */
@@ -28,6 +28,7 @@
 #include "mir/gl/texture_cache.h"
 #include "mir/gl/texture.h"
 #include "mir/log.h"
+#include "mir/scene/memory_report.h"
 #include "mir/report_exception.h"
 
 #define GLM_FORCE_RADIANS
@@ -42,8 +43,98 @@
 namespace mg = mir::graphics;
 namespace mgl = mir::gl;
 namespace mrg = mir::renderer::gl;
+namespace ms = mir::scene;
 namespace geom = mir::geometry;
 
+namespace
+{
+/// Reports the textures of a cache that drops those unused since the previous drop_unused()
+class AccountedTextureCache : public mgl::TextureCache
+{
+public:
+    AccountedTextureCache(
+        std::unique_ptr<mgl::TextureCache> wrapped,
+        std::shared_ptr<ms::MemoryReport> const& memory_report) :
+        wrapped{std::move(wrapped)},
+        memory_report{memory_report}
+    {
+    }
+
+    ~AccountedTextureCache()
+    {
+        for (auto const& entry : entries)
+            memory_report->released(entry.first, category, entry.second.bytes);
+    }
+
+    std::shared_ptr<mgl::Texture> load(mg::Renderable const& renderable) override
+    {
+        auto const texture = wrapped->load(renderable);
+
+        auto const& buffer = renderable.buffer();
+        size_t const bytes = size_t{buffer->size().width.as_uint32_t()} *
+            buffer->size().height.as_uint32_t() * MIR_BYTES_PER_PIXEL(buffer->pixel_format());
+
+        auto& entry = entries[renderable.id()];
+        if (entry.bytes != bytes)
+        {
+            memory_report->released(renderable.id(), category, entry.bytes);
+            memory_report->allocated(renderable.id(), category, bytes);
+            entry.bytes = bytes;
+        }
+        entry.used = true;
+
+        return texture;
+    }
+
+    void invalidate() override
+    {
+        wrapped->invalidate();
+    }
+
+    void drop_unused() override
+    {
+        wrapped->drop_unused();
+
+        for (auto entry = entries.begin(); entry != entries.end();)
+        {
+            if (entry->second.used)
+            {
+                entry->second.used = false;
+                ++entry;
+            }
+            else
+            {
+                memory_report->released(entry->first, category, entry->second.bytes);
+                entry = entries.erase(entry);
+            }
+        }
+    }
+
+private:
+    static constexpr ms::MemoryReport::Category category{ms::MemoryReport::Category::textures};
+
+    struct Entry
+    {
+        size_t bytes{0};
+        bool used{true};
+    };
+
+    std::unique_ptr<mgl::TextureCache> const wrapped;
+    std::shared_ptr<ms::MemoryReport> const memory_report;
+    std::unordered_map<mg::Renderable::ID, Entry> entries;
+};
+
+std::unique_ptr<mgl::TextureCache> accounted(
+    std::unique_ptr<mgl::TextureCache> cache,
+    std::shared_ptr<ms::MemoryReport> const& memory_report)
+{
+    if (!memory_report)
+        return cache;
+
+    return std::make_unique<AccountedTextureCache>(std::move(cache), memory_report);
+}
+}
+
 mrg::CurrentRenderTarget::CurrentRenderTarget(mg::DisplayBuffer* display_buffer)
     : render_target{
         dynamic_cast<renderer::gl::RenderTarget*>(display_buffer->native_display_buffer())}
@@ -132,11 +223,18 @@ mrg::Renderer::Program::Program(GLuint program_id)
 }
 
 mrg::Renderer::Renderer(graphics::DisplayBuffer& display_buffer)
+    : Renderer(display_buffer, nullptr)
+{
+}
+
+mrg::Renderer::Renderer(
+    graphics::DisplayBuffer& display_buffer,
+    std::shared_ptr<ms::MemoryReport> const& memory_report)
     : render_target(&display_buffer),
       clear_color{0.0f, 0.0f, 0.0f, 0.0f},
       default_program(family.add_program(vshader, default_fshader)),
       alpha_program(family.add_program(vshader, alpha_fshader)),
-      texture_cache(mgl::DefaultProgramFactory().create_texture_cache()),
+      texture_cache(accounted(mgl::DefaultProgramFactory().create_texture_cache(), memory_report)),
       display_transform(1)
 {
     eglBindAPI(MIR_SERVER_EGL_OPENGL_API);
@@ -37,6 +37,7 @@ namespace mir
 {
 namespace gl { class TextureCache; }
 namespace graphics { class DisplayBuffer; }
+namespace scene { class MemoryReport; }
 namespace renderer
 {
 namespace gl
@@ -60,6 +61,10 @@ class Renderer : public renderer::Renderer
 {
 public:
     Renderer(graphics::DisplayBuffer& display_buffer);
+    /// Also reports the memory of the textures it holds for each renderable
+    Renderer(
+        graphics::DisplayBuffer& display_buffer,
+        std::shared_ptr<scene::MemoryReport> const& memory_report);
     virtual ~Renderer();
 
     // These are called with a valid GL context:
@@ -22,9 +22,14 @@
 
 namespace mrg = mir::renderer::gl;
 
+mrg::RendererFactory::RendererFactory(std::shared_ptr<scene::MemoryReport> const& memory_report) :
+    memory_report{memory_report}
+{
+}
+
 std::unique_ptr<mir::renderer::Renderer>
 mrg::RendererFactory::create_renderer_for(
     graphics::DisplayBuffer& display_buffer)
 {
-    return std::make_unique<Renderer>(display_buffer);
+    return std::make_unique<Renderer>(display_buffer, memory_report);
 }
@@ -23,6 +23,7 @@
 
 namespace mir
 {
+namespace scene { class MemoryReport; }
 namespace renderer
 {
 namespace gl
@@ -31,8 +32,14 @@ namespace gl
 class RendererFactory : public renderer::RendererFactory
 {
 public:
+    RendererFactory() = default;
+    RendererFactory(std::shared_ptr<scene::MemoryReport> const& memory_report);
+
     std::unique_ptr<renderer::Renderer> create_renderer_for(
         graphics::DisplayBuffer& display_buffer) override;
+
+private:
+    std::shared_ptr<scene::MemoryReport> const memory_report;
 };
 
 }
@@ -34,7 +34,11 @@ namespace mg = mir::graphics;
 namespace ms = mir::scene;
 namespace mf = mir::frontend;
 
-mc::BufferStreamFactory::BufferStreamFactory()
+mc::BufferStreamFactory::BufferStreamFactory(
+    std::shared_ptr<BufferLifetimeReport> const& report,
+    std::shared_ptr<time::AlarmFactory> const& alarm_factory) :
+    report{report},
+    alarm_factory{alarm_factory}
 {
 }
 
@@ -51,5 +55,5 @@ std::shared_ptr<mc::BufferStream> mc::BufferStreamFactory::create_buffer_stream(
     mg::BufferProperties const& buffer_properties)
 {
     return std::make_shared<mc::Stream>(
-        buffer_properties.size, buffer_properties.format);
+        report, alarm_factory, buffer_properties.size, buffer_properties.format);
 }
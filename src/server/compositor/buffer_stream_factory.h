@@ -31,13 +31,20 @@ namespace graphics
 {
 class GraphicBufferAllocator;
 }
+namespace time
+{
+class AlarmFactory;
+}
 namespace compositor
 {
+class BufferLifetimeReport;
 
 class BufferStreamFactory : public scene::BufferStreamFactory
 {
 public:
-    BufferStreamFactory();
+    BufferStreamFactory(
+        std::shared_ptr<BufferLifetimeReport> const& report,
+        std::shared_ptr<time::AlarmFactory> const& alarm_factory);
 
     virtual ~BufferStreamFactory() {}
 
@@ -48,6 +55,10 @@ public:
     virtual std::shared_ptr<BufferStream> create_buffer_stream(
         frontend::BufferStreamId,
         graphics::BufferProperties const&) override;
+
+private:
+    std::shared_ptr<BufferLifetimeReport> const report;
+    std::shared_ptr<time::AlarmFactory> const alarm_factory;
 };
 
 }
@@ -39,9 +39,9 @@ std::shared_ptr<ms::BufferStreamFactory>
 mir::DefaultServerConfiguration::the_buffer_stream_factory()
 {
     return buffer_stream_factory(
-        []()
+        [this]()
         {
-            return std::make_shared<mc::BufferStreamFactory>();
+            return std::make_shared<mc::BufferStreamFactory>(the_buffer_lifetime_report(), the_main_loop());
         });
 }
 
@@ -88,7 +88,7 @@ std::shared_ptr<mir::renderer::RendererFactory> mir::DefaultServerConfiguration:
     return renderer_factory(
         []()
         {
-            return std::make_shared<mir::renderer::gl::RendererFactory>();
+            return std::make_shared<mir::renderer::gl::RendererFactory>(the_memory_report());
         });
 }
 
@@ -90,12 +90,10 @@ void mc::DefaultDisplayBufferCompositor::composite(mc::SceneElementSequence&& sc
          * This is used for the 'early release' optimization to release buffers
          * we did use back to clients before starting on the potentially slow
          * post() call.
-         * FIXME: This clear() call is blocking a little because we drive IPC
-         *        here (LP: #1395421). However if the early release
-         *        optimization is disabled or absent (LP: #1561418) then this
-         *        clear() doesn't contribute anything. In that case the
-         *        problematic IPC (LP: #1395421) will instead occur in buffer
-         *        acquisition calls when we composite the next frame.
+         * Dropping the last reference to a client buffer only queues its
+         * return on the frontend's buffer-return executor, so the IPC itself
+         * (LP: #1395421) no longer happens on this thread. The release time
+         * of each buffer is visible through the BufferLifetimeReport.
          */
         renderable_list.clear();
     }
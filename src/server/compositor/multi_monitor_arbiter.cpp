@@ -22,7 +22,6 @@
 #include "mir/frontend/event_sink.h"
 #include "schedule.h"
 #include <boost/throw_exception.hpp>
-#include <algorithm>
 
 namespace mg = mir::graphics;
 namespace mc = mir::compositor;
@@ -32,71 +31,172 @@ mc::MultiMonitorArbiter::MultiMonitorArbiter(
     std::shared_ptr<Schedule> const& schedule) :
     schedule(schedule)
 {
+    for (auto& slot : compositor_slots)
+        slot = nullptr;
 }
 
 mc::MultiMonitorArbiter::~MultiMonitorArbiter()
 {
 }
 
+namespace
+{
+uint64_t sequence_of(uint64_t state)
+{
+    return state >> 32;
+}
+
+uint64_t with_sequence(uint64_t sequence)
+{
+    return sequence << 32;
+}
+}
+
 std::shared_ptr<mg::Buffer> mc::MultiMonitorArbiter::compositor_acquire(compositor::CompositorID id)
 {
+    // Without the mutex, for a compositor picking up a buffer it has not yet
+    // seen: the usual case for all but the first of several outputs to show
+    // a frame. The exchange only succeeds if the buffer was not swapped
+    // since we read the state, so the buffer we read goes with it.
+    if (auto const bit = user_bit_for(id))
+    {
+        auto state = current_buffer_state.load();
+        while (!(sequence_of(state) & 1) && !(state & bit))
+        {
+            auto const buffer = std::atomic_load(&current_buffer);
+            if (!buffer)
+                break;
+
+            if (current_buffer_state.compare_exchange_weak(state, state | bit))
+                return buffer;
+        }
+    }
+
+    // Moving on to the next buffer in the schedule stays serialized, so that
+    // racing compositors don't take a buffer each and skip a frame.
     std::lock_guard<decltype(mutex)> lk(mutex);
 
-    if (!current_buffer && !schedule->num_scheduled())
+    auto const current_schedule = std::atomic_load(&schedule);
+    auto buffer = std::atomic_load(&current_buffer);
+    if (!buffer && !current_schedule->num_scheduled())
         BOOST_THROW_EXCEPTION(std::logic_error("no buffer to give to compositor"));
 
-    if (current_buffer_users.find(id) != current_buffer_users.end() || !current_buffer)
+    auto const bit = register_user(id, lk);
+    auto const state = current_buffer_state.load();
+    if (((state & bit) || !buffer) && current_schedule->num_scheduled())
     {
-        if (schedule->num_scheduled())
-            current_buffer = schedule->next_buffer();
-        current_buffer_users.clear();
+        buffer = current_schedule->next_buffer();
+        swap_current_buffer(buffer, lk);
     }
-    current_buffer_users.insert(id);
 
-    return current_buffer;
+    // The swap (if any) has cleared the other users. Compositors that have
+    // picked up the new buffer without the mutex since may already have set
+    // their bits, so only ever add ours.
+    current_buffer_state |= bit;
+
+    return buffer;
 }
 
 std::shared_ptr<mg::Buffer> mc::MultiMonitorArbiter::snapshot_acquire()
 {
+    if (auto const buffer = std::atomic_load(&current_buffer))
+        return buffer;
+
     std::lock_guard<decltype(mutex)> lk(mutex);
 
-    if (!current_buffer && !schedule->num_scheduled())
+    auto const current_schedule = std::atomic_load(&schedule);
+    auto buffer = std::atomic_load(&current_buffer);
+    if (!buffer && !current_schedule->num_scheduled())
         BOOST_THROW_EXCEPTION(std::logic_error("no buffer to give to snapshotter"));
 
-    if (!current_buffer)
+    if (!buffer)
     {
-        if (schedule->num_scheduled())
-            current_buffer = schedule->next_buffer();
+        buffer = current_schedule->next_buffer();
+        swap_current_buffer(buffer, lk);
     }
 
-    return current_buffer;
+    return buffer;
 }
 
 void mc::MultiMonitorArbiter::set_schedule(std::shared_ptr<Schedule> const& new_schedule)
 {
     std::lock_guard<decltype(mutex)> lk(mutex);
-    schedule = new_schedule;
+    std::atomic_store(&schedule, new_schedule);
 }
 
 bool mc::MultiMonitorArbiter::buffer_ready_for(mc::CompositorID id)
 {
-    std::lock_guard<decltype(mutex)> lk(mutex);
-    return schedule->num_scheduled() ||
-       ((current_buffer_users.find(id) == current_buffer_users.end()) && current_buffer);
+    return std::atomic_load(&schedule)->num_scheduled() ||
+       (has_current_buffer && !(current_buffer_state & user_bit_for(id)));
 }
 
 bool mc::MultiMonitorArbiter::has_buffer()
 {
-    std::lock_guard<decltype(mutex)> lk(mutex);
-    return static_cast<bool>(current_buffer);
+    return has_current_buffer;
 }
 
 void mc::MultiMonitorArbiter::advance_schedule()
 {
     std::lock_guard<decltype(mutex)> lk(mutex);
-    if (schedule->num_scheduled())
+    auto const current_schedule = std::atomic_load(&schedule);
+    if (current_schedule->num_scheduled())
     {
-        current_buffer = schedule->next_buffer();
-        current_buffer_users.clear();
+        swap_current_buffer(current_schedule->next_buffer(), lk);
     } 
 }
+
+void mc::MultiMonitorArbiter::swap_current_buffer(
+    std::shared_ptr<mg::Buffer> const& buffer, std::lock_guard<std::mutex> const&)
+{
+    // An odd sequence number sends compositors to the mutex while the buffer
+    // is swapped; the new even one fails any exchange begun before the swap.
+    auto const sequence = sequence_of(current_buffer_state.load()) + 1;
+    current_buffer_state = with_sequence(sequence);
+    std::atomic_store(&current_buffer, buffer);
+    current_buffer_state = with_sequence(sequence + 1);
+    has_current_buffer = true;
+}
+
+mc::MultiMonitorArbiter::UserMask mc::MultiMonitorArbiter::user_bit_for(mc::CompositorID id) const
+{
+    for (size_t i = 0; i != compositor_slots.size(); ++i)
+    {
+        if (compositor_slots[i] == id)
+            return UserMask{1} << i;
+    }
+    return 0;
+}
+
+mc::MultiMonitorArbiter::UserMask mc::MultiMonitorArbiter::register_user(
+    mc::CompositorID id, std::lock_guard<std::mutex> const&)
+{
+    if (auto const bit = user_bit_for(id))
+        return bit;
+
+    // Prefer an empty slot, but compositor ids come and go (e.g. screencasts)
+    // so fall back to recycling one that hasn't seen the current buffer.
+    // Failing that, evict a user: at worst it is handed the current buffer
+    // again. Readers racing with a recycled slot can likewise only get a
+    // stale "ready" hint, or be handed the current buffer once more.
+    UserMask const users = static_cast<UserMask>(current_buffer_state.load());
+    size_t recyclable = compositor_slots.size();
+    for (size_t i = 0; i != compositor_slots.size(); ++i)
+    {
+        if (compositor_slots[i] == nullptr)
+        {
+            compositor_slots[i] = id;
+            return UserMask{1} << i;
+        }
+        if (recyclable == compositor_slots.size() && !(users & (UserMask{1} << i)))
+            recyclable = i;
+    }
+
+    if (recyclable == compositor_slots.size())
+    {
+        recyclable = 0;
+        current_buffer_state &= ~uint64_t{1};
+    }
+
+    compositor_slots[recyclable] = id;
+    return UserMask{1} << recyclable;
+}
@@ -21,10 +21,11 @@
 #include "mir/compositor/compositor_id.h"
 #include "mir/graphics/buffer_id.h"
 #include "buffer_acquisition.h"
+#include <array>
+#include <atomic>
+#include <cstdint>
 #include <memory>
 #include <mutex>
-#include <deque>
-#include <set>
 
 namespace mir
 {
@@ -49,10 +50,25 @@ public:
     void advance_schedule();
 
 private:
-    std::mutex mutable mutex;
-    std::shared_ptr<graphics::Buffer> current_buffer;
-    std::set<compositor::CompositorID> current_buffer_users;
-    std::shared_ptr<Schedule> schedule;
+    typedef uint32_t UserMask;
+    static size_t const max_tracked_compositors = 32;
+
+    UserMask user_bit_for(compositor::CompositorID id) const;
+    UserMask register_user(compositor::CompositorID id, std::lock_guard<std::mutex> const&);
+    void swap_current_buffer(std::shared_ptr<graphics::Buffer> const& buffer, std::lock_guard<std::mutex> const&);
+
+    std::mutex mutable mutex; // Serializes changes to current_buffer
+    std::shared_ptr<graphics::Buffer> current_buffer; // Accessed with std::atomic_{load,store}
+    std::shared_ptr<Schedule> schedule; // Accessed with std::atomic_{load,store}
+
+    // The compositors that have seen current_buffer are a bitmask over a
+    // small table of compositor ids, so the frequently polled
+    // buffer_ready_for() and has_buffer() need not take the mutex, and
+    // neither need a compositor acquiring a buffer it hasn't seen yet.
+    // The high half of the state counts buffer swaps (odd during one).
+    std::array<std::atomic<compositor::CompositorID>, max_tracked_compositors> compositor_slots;
+    std::atomic<uint64_t> current_buffer_state{0};
+    std::atomic<bool> has_current_buffer{false};
 };
 
 }
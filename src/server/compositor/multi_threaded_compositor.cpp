@@ -29,6 +29,7 @@
 #include "mir/scene/surface.h"
 #include "mir/terminate_with_current_exception.h"
 #include "mir/raii.h"
+#include "mir/startup_profiler.h"
 #include "mir/unwind_helpers.h"
 #include "mir/thread_name.h"
 
@@ -110,6 +111,8 @@ public:
 
         started.set_value();
 
+        bool posted_first_frame{false};
+
         try
         {
             std::unique_lock<std::mutex> lock{run_mutex};
@@ -142,6 +145,12 @@ public:
                     }
                     group.post();
 
+                    if (!posted_first_frame)
+                    {
+                        mir::startup_milestone("first frame");
+                        posted_first_frame = true;
+                    }
+
                     /*
                      * "Predictive bypass" optimization: If the last frame was
                      * bypassed/overlayed or you simply have a fast GPU, it is
@@ -20,7 +20,10 @@
 #include "stream.h"
 #include "queueing_schedule.h"
 #include "dropping_schedule.h"
+#include "mir/compositor/buffer_lifetime_report.h"
 #include "mir/graphics/buffer.h"
+#include "mir/time/alarm.h"
+#include "mir/time/alarm_factory.h"
 #include <boost/throw_exception.hpp>
 
 namespace mc = mir::compositor;
@@ -35,30 +38,69 @@ enum class mc::Stream::ScheduleMode {
 };
 
 mc::Stream::Stream(
-    geom::Size size, MirPixelFormat pf) :
+    std::shared_ptr<BufferLifetimeReport> const& report,
+    std::shared_ptr<time::AlarmFactory> const& alarm_factory,
+    geom::Size size,
+    MirPixelFormat pf) :
+    report(report),
     schedule_mode(ScheduleMode::Queueing),
+    dropping_allowed(false),
+    frame_interval(0),
+    last_frame(),
     schedule(std::make_shared<mc::QueueingSchedule>()),
     arbiter(std::make_shared<mc::MultiMonitorArbiter>(schedule)),
     size(size),
     pf(pf),
     first_frame_posted(false),
-    frame_callback{[](auto){}}
+    frame_callback{[](auto){}},
+    frame_deferred(false),
+    frame_interval_alarm{alarm_factory->create_alarm([this] { post_deferred_frame(); })}
 {
 }
 
-mc::Stream::~Stream() = default;
+mc::Stream::~Stream()
+{
+    report->stream_destroyed(this);
+}
 
 void mc::Stream::submit_buffer(std::shared_ptr<mg::Buffer> const& buffer)
 {
     if (!buffer)
         BOOST_THROW_EXCEPTION(std::invalid_argument("cannot submit null buffer"));
 
+    report->buffer_submitted(this, buffer->id());
+
+    // The buffer goes back to the client when the last reference to it is
+    // dropped; share ownership through a deleter so that moment gets reported.
+    std::shared_ptr<mg::Buffer> const tracked{
+        buffer.get(),
+        [buffer, report = report, stream = static_cast<void const*>(this)](mg::Buffer*)
+        {
+            report->buffer_released(stream, buffer->id());
+        }};
+
     {
         std::lock_guard<decltype(mutex)> lk(mutex); 
         first_frame_posted = true;
         pf = buffer->pixel_format();
-        schedule->schedule(buffer);
+        schedule->schedule(tracked);
     }
+
+    if (within_frame_interval())
+    {
+        // Don't wake the compositor for a frame it isn't going to take yet
+        report->buffer_deferred(this, buffer->id());
+        {
+            std::lock_guard<decltype(callback_mutex)> lock{callback_mutex};
+            deferred_frame_size = buffer->size();
+        }
+        frame_deferred = true;
+
+        // The interval may have expired while the frame was being deferred
+        if (!within_frame_interval())
+            post_deferred_frame();
+    }
+    else
     {
         std::lock_guard<decltype(callback_mutex)> lock{callback_mutex};
         frame_callback(buffer->size());
@@ -86,7 +128,27 @@ void mc::Stream::set_frame_posted_callback(
 
 std::shared_ptr<mg::Buffer> mc::Stream::lock_compositor_buffer(void const* id)
 {
-    return arbiter->compositor_acquire(id);
+    // Within the frame interval the compositor keeps getting the frame it
+    // already has; newer frames wait until the interval expires.
+    if (within_frame_interval())
+        return arbiter->snapshot_acquire();
+
+    auto const buffer = arbiter->compositor_acquire(id);
+    report->buffer_acquired(this, buffer->id(), id);
+
+    std::chrono::milliseconds interval;
+    bool new_frame;
+    {
+        std::lock_guard<decltype(mutex)> lk(mutex);
+        interval = frame_interval;
+        new_frame = buffer->id() != last_frame;
+        last_frame = buffer->id();
+    }
+
+    if (new_frame && interval.count())
+        frame_interval_alarm->reschedule_in(interval);
+
+    return buffer;
 }
 
 geom::Size mc::Stream::stream_size()
@@ -105,6 +167,42 @@ void mc::Stream::resize(geom::Size const& new_size)
 void mc::Stream::allow_framedropping(bool dropping)
 {
     std::lock_guard<decltype(mutex)> lk(mutex); 
+    dropping_allowed = dropping;
+    update_schedule_mode(lk);
+}
+
+bool mc::Stream::framedropping() const
+{
+    std::lock_guard<decltype(mutex)> lk(mutex);
+    return dropping_allowed;
+}
+
+void mc::Stream::set_frame_interval(std::chrono::milliseconds interval)
+{
+    {
+        std::lock_guard<decltype(mutex)> lk(mutex);
+        if (interval == frame_interval)
+            return;
+
+        frame_interval = interval;
+        update_schedule_mode(lk);
+    }
+
+    report->frame_interval_changed(this, interval);
+
+    if (!interval.count())
+    {
+        frame_interval_alarm->cancel();
+        post_deferred_frame();
+    }
+}
+
+void mc::Stream::update_schedule_mode(std::lock_guard<std::mutex> const& lk)
+{
+    // A frame rate limit only paces the client if its frames are queued;
+    // dropping would let it keep rendering frames that are never shown.
+    bool const dropping = dropping_allowed && !frame_interval.count();
+
     if (dropping && schedule_mode == ScheduleMode::Queueing)
     {
         transition_schedule(std::make_shared<mc::DroppingSchedule>(), lk);
@@ -117,9 +215,18 @@ void mc::Stream::allow_framedropping(bool dropping)
     }
 }
 
-bool mc::Stream::framedropping() const
+bool mc::Stream::within_frame_interval() const
+{
+    return frame_interval_alarm->state() == time::Alarm::pending;
+}
+
+void mc::Stream::post_deferred_frame()
 {
-    return schedule_mode == ScheduleMode::Dropping;
+    if (frame_deferred.exchange(false))
+    {
+        std::lock_guard<decltype(callback_mutex)> lock{callback_mutex};
+        frame_callback(deferred_frame_size);
+    }
 }
 
 void mc::Stream::transition_schedule(
@@ -136,8 +243,7 @@ void mc::Stream::transition_schedule(
 
 int mc::Stream::buffers_ready_for_compositor(void const* id) const
 {
-    std::lock_guard<decltype(mutex)> lk(mutex); 
-    if (arbiter->buffer_ready_for(id))
+    if (!within_frame_interval() && arbiter->buffer_ready_for(id))
         return 1;
     return 0;
 }
@@ -26,6 +26,7 @@
 #include "mir/lockable_callback.h"
 #include "mir/geometry/size.h"
 #include "multi_monitor_arbiter.h"
+#include <atomic>
 #include <mutex>
 #include <memory>
 #include <set>
@@ -33,13 +34,19 @@
 namespace mir
 {
 namespace frontend { class ClientBuffers; }
+namespace time { class Alarm; class AlarmFactory; }
 namespace compositor
 {
 class Schedule;
+class BufferLifetimeReport;
 class Stream : public BufferStream
 {
 public:
-    Stream(geometry::Size sz, MirPixelFormat format);
+    Stream(
+        std::shared_ptr<BufferLifetimeReport> const& report,
+        std::shared_ptr<time::AlarmFactory> const& alarm_factory,
+        geometry::Size sz,
+        MirPixelFormat format);
     ~Stream();
 
     void submit_buffer(std::shared_ptr<graphics::Buffer> const& buffer) override;
@@ -53,6 +60,7 @@ public:
     void resize(geometry::Size const& size) override;
     void allow_framedropping(bool) override;
     bool framedropping() const override;
+    void set_frame_interval(std::chrono::milliseconds interval) override;
     int buffers_ready_for_compositor(void const* user_id) const override;
     void drop_old_buffers() override;
     bool has_submitted_buffer() const override;
@@ -61,9 +69,16 @@ public:
 private:
     enum class ScheduleMode;
     void transition_schedule(std::shared_ptr<Schedule>&& new_schedule, std::lock_guard<std::mutex> const&);
+    void update_schedule_mode(std::lock_guard<std::mutex> const&);
+    bool within_frame_interval() const;
+    void post_deferred_frame();
 
+    std::shared_ptr<BufferLifetimeReport> const report;
     std::mutex mutable mutex;
     ScheduleMode schedule_mode;
+    bool dropping_allowed;
+    std::chrono::milliseconds frame_interval;
+    graphics::BufferID last_frame;
     std::shared_ptr<Schedule> schedule;
     std::shared_ptr<MultiMonitorArbiter> const arbiter;
     geometry::Size size; 
@@ -72,6 +87,12 @@ private:
 
     std::mutex callback_mutex;
     std::function<void(geometry::Size const&)> frame_callback;
+    geometry::Size deferred_frame_size;
+
+    // Set when a frame arrives before the frame interval has expired; the
+    // frame is posted to the compositor when the interval alarm fires.
+    std::atomic<bool> frame_deferred;
+    std::unique_ptr<time::Alarm> const frame_interval_alarm;
 };
 }
 }
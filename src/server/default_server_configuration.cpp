@@ -26,6 +26,7 @@
 #include "mir/default_configuration.h"
 #include "mir/cookie/authority.h"
 
+#include "mir/logging/async_console_logger.h"
 #include "mir/logging/dumb_console_logger.h"
 #include "mir/options/program_option.h"
 #include "mir/frontend/session_credentials.h"
@@ -225,8 +226,13 @@ auto mir::DefaultServerConfiguration::the_logger()
     -> std::shared_ptr<ml::Logger>
 {
     return logger(
-        []() -> std::shared_ptr<ml::Logger>
+        [this]() -> std::shared_ptr<ml::Logger>
         {
+            auto const opts = the_options();
+
+            if (opts->is_set(options::async_logging_opt) && opts->get<bool>(options::async_logging_opt))
+                return std::make_shared<ml::AsyncConsoleLogger>();
+
             return std::make_shared<ml::DumbConsoleLogger>();
         });
 }
@@ -31,6 +31,7 @@
 #include "mir/input/input_manager.h"
 #include "mir/input/input_dispatcher.h"
 #include "mir/log.h"
+#include "mir/startup_profiler.h"
 #include "mir/unwind_helpers.h"
 
 #include <stdexcept>
@@ -201,14 +202,19 @@ void mir::DisplayServer::run()
 
     auto const& server = *p.load();
 
-    server.compositor->start();
-    server.input_manager->start();
-    server.input_dispatcher->start();
-    server.prompt_connector->start();
-    server.connector->start();
-    server.wayland_connector->start();
+    {
+        StartupPhase const phase{"mir::DisplayServer::run"};
+
+        server.compositor->start();
+        server.input_manager->start();
+        server.input_dispatcher->start();
+        server.prompt_connector->start();
+        server.connector->start();
+        server.wayland_connector->start();
 
-    server.server_status_listener->started();
+        server.server_status_listener->started();
+    }
+    startup_milestone("started");
 
     server.main_loop->run();
 
@@ -23,6 +23,7 @@
 #include "published_socket_connector.h"
 #include "session_mediator_observer_multiplexer.h"
 
+#include "mir/main_loop.h"
 #include "mir/graphics/platform.h"
 #include "mir/graphics/platform_ipc_operations.h"
 #include "mir/frontend/protobuf_connection_creator.h"
@@ -44,7 +45,9 @@ mir::DefaultServerConfiguration::the_connection_creator()
                 new_ipc_factory(session_authorizer),
                 session_authorizer,
                 the_graphics_platform()->make_ipc_operations(),
-                the_message_processor_report());
+                the_message_processor_report(),
+                the_main_loop(),
+                std::chrono::milliseconds{the_options()->get<int>(options::event_batch_delay_opt)});
         });
 }
 
@@ -168,7 +171,8 @@ mir::DefaultServerConfiguration::new_ipc_factory(
                 the_application_not_responding_detector(),
                 the_cookie_authority(),
                 the_input_configuration_changer(),
-                the_extensions());
+                the_extensions(),
+                the_memory_report());
 }
 
 std::shared_ptr<mf::SessionMediatorObserver>
@@ -45,6 +45,7 @@ namespace scene
 {
 class ApplicationNotRespondingDetector;
 class CoordinateTranslator;
+class MemoryReport;
 }
 
 namespace frontend
@@ -73,7 +74,8 @@ public:
         std::shared_ptr<scene::ApplicationNotRespondingDetector> const& anr_detector,
         std::shared_ptr<cookie::Authority> const& cookie_authority,
         std::shared_ptr<InputConfigurationChanger> const& input_Changer,
-        std::vector<mir::ExtensionDescription> const& extensions);
+        std::vector<mir::ExtensionDescription> const& extensions,
+        std::shared_ptr<scene::MemoryReport> const& memory_report);
 
     std::shared_ptr<detail::DisplayServer> make_ipc_server(
         SessionCredentials const &creds,
@@ -112,6 +114,7 @@ private:
     std::shared_ptr<cookie::Authority> const cookie_authority;
     std::shared_ptr<InputConfigurationChanger> const input_changer;
     std::vector<mir::ExtensionDescription> const extensions;
+    std::shared_ptr<scene::MemoryReport> const memory_report;
     std::shared_ptr<mir::Executor> const execution_queue;
 };
 }
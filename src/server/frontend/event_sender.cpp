@@ -18,6 +18,8 @@
 
 #include "event_sender.h"
 #include "mir/events/event.h"
+#include "mir/events/event_builders.h"
+#include "mir/events/pointer_event.h"
 #include "mir/frontend/client_constants.h"
 #include "mir/graphics/display_configuration.h"
 #include "mir/variable_length_array.h"
@@ -31,7 +33,11 @@
 #include "protobuf_buffer_packer.h"
 
 #include "mir/graphics/buffer.h"
+#include "mir/graphics/frame.h"
 #include "mir/client_visible_error.h"
+#include "mir/lockable_callback.h"
+#include "mir/time/alarm.h"
+#include "mir/time/alarm_factory.h"
 
 #include "mir_protobuf_wire.pb.h"
 #include "mir_protobuf.pb.h"
@@ -46,19 +52,176 @@ mfd::EventSender::EventSender(
     std::shared_ptr<MessageSender> const& socket_sender,
     std::shared_ptr<mg::PlatformIpcOperations> const& buffer_packer) :
     sender(socket_sender),
-    buffer_packer(buffer_packer)
+    buffer_packer(buffer_packer),
+    batch_delay{0}
 {
 }
 
+class mfd::EventSender::FlushBatch : public mir::LockableCallback
+{
+public:
+    explicit FlushBatch(EventSender* self) : self{self} {}
+
+    void operator()() override { self->flush_batch(); }
+    void lock() override { self->batch_mutex.lock(); }
+    void unlock() override { self->batch_mutex.unlock(); }
+
+private:
+    EventSender* const self;
+};
+
+mfd::EventSender::EventSender(
+    std::shared_ptr<MessageSender> const& socket_sender,
+    std::shared_ptr<mg::PlatformIpcOperations> const& buffer_packer,
+    mir::time::AlarmFactory& alarm_factory,
+    std::chrono::milliseconds batch_delay) :
+    sender(socket_sender),
+    buffer_packer(buffer_packer),
+    batch_delay{batch_delay},
+    batch_alarm{alarm_factory.create_alarm(std::make_unique<FlushBatch>(this))}
+{
+}
+
+mfd::EventSender::~EventSender()
+{
+    // Once the alarm is gone its callback can't be running
+    batch_alarm.reset();
+
+    std::lock_guard<std::mutex> lock{batch_mutex};
+    flush_batch();
+}
+
+namespace
+{
+// Events that arrive in streams, so the client loses nothing if a few of
+// them wait a little to be sent together
+bool can_batch(MirEvent const& e)
+{
+    if (mir_event_get_type(&e) != mir_event_type_input)
+        return false;
+
+    auto const input_event = mir_event_get_input_event(&e);
+
+    switch (mir_input_event_get_type(input_event))
+    {
+    case mir_input_event_type_pointer:
+        return mir_pointer_event_action(mir_input_event_get_pointer_event(input_event)) ==
+            mir_pointer_action_motion;
+
+    case mir_input_event_type_touch:
+    {
+        auto const touch_event = mir_input_event_get_touch_event(input_event);
+        for (auto i = 0u; i != mir_touch_event_point_count(touch_event); ++i)
+        {
+            if (mir_touch_event_action(touch_event, i) != mir_touch_action_change)
+                return false;
+        }
+        return true;
+    }
+
+    default:
+        return false;
+    }
+}
+
+// Enough to cover a frame of a 1kHz device, without letting a message grow unbounded
+int const max_batched_events{64};
+
+MirPointerEvent const* as_pointer_motion(MirEvent const& e)
+{
+    if (e.type() != mir_event_type_input || e.to_input()->input_type() != mir_input_event_type_pointer)
+        return nullptr;
+
+    auto const pointer = e.to_input()->to_pointer();
+    return pointer->action() == mir_pointer_action_motion ? pointer : nullptr;
+}
+}
+
 void mfd::EventSender::handle_event(MirEvent const& e)
 {
-    // In future we might send multiple events, or insert them into messages
-    // containing other responses, but for now we send them individually.
-    mp::EventSequence seq;
-    mp::Event *ev = seq.add_event();
-    ev->set_raw(MirEvent::serialize(&e));
+    std::lock_guard<std::mutex> lock{batch_mutex};
 
-    send_event_sequence(seq, {});
+    if (!batch)
+        batch = std::make_unique<mp::EventSequence>();
+
+    if (batch_alarm && coalesce(e))
+        return;
+
+    MirEvent::serialize(&e, *batch->add_event()->mutable_raw());
+
+    if (batch_alarm && can_batch(e) && batch->event_size() < max_batched_events)
+    {
+        if (batch_alarm->state() != mir::time::Alarm::pending)
+            batch_alarm->reschedule_in(batch_delay);
+    }
+    else
+    {
+        flush_batch();
+    }
+}
+
+/*
+ * Folds pointer motion into the motion held from the same device to the same
+ * window, taking the position, buttons and time of the newer event and adding
+ * up the relative motion and scrolling. The merged event moves to the end of
+ * the batch, so the batch stays in time order. Anything that isn't motion (a
+ * button press, a key, ...) sends the batch first, so nothing is merged
+ * across it.
+ * Clients that want every sample connect with immediate events, and are never
+ * batched.
+ */
+bool mfd::EventSender::coalesce(MirEvent const& e)
+{
+    auto const pointer = as_pointer_motion(e);
+    if (!pointer)
+        return false;
+
+    auto const key = std::make_pair(pointer->device_id(), pointer->window_id());
+    auto const held = held_motion.find(key);
+
+    if (held != held_motion.end())
+    {
+        auto const previous = held->second.event->to_input()->to_pointer();
+
+        if (previous->buttons() == pointer->buttons() && previous->modifiers() == pointer->modifiers())
+        {
+            auto merged = mev::clone_event(e);
+            auto const merged_pointer = merged->to_input()->to_pointer();
+            merged_pointer->set_dx(previous->dx() + pointer->dx());
+            merged_pointer->set_dy(previous->dy() + pointer->dy());
+            merged_pointer->set_vscroll(previous->vscroll() + pointer->vscroll());
+            merged_pointer->set_hscroll(previous->hscroll() + pointer->hscroll());
+
+            auto const index = held->second.index;
+            batch->mutable_event()->DeleteSubrange(index, 1);
+            for (auto& other : held_motion)
+            {
+                if (other.second.index > index)
+                    --other.second.index;
+            }
+
+            held->second.index = batch->event_size();
+            MirEvent::serialize(merged.get(), *batch->add_event()->mutable_raw());
+            held->second.event = std::move(merged);
+            return true;
+        }
+    }
+
+    held_motion.erase(key);
+    held_motion.emplace(key, HeldMotion{batch->event_size(), mev::clone_event(e)});
+    return false;
+}
+
+void mfd::EventSender::flush_batch()
+{
+    held_motion.clear();
+
+    // A pending alarm is left to fire on an empty batch: it may be what called us
+    if (batch && batch->event_size() > 0)
+    {
+        auto const seq = std::move(batch);
+        send(*seq, {});
+    }
 }
 
 void mfd::EventSender::handle_display_config_change(
@@ -93,6 +256,20 @@ void mfd::EventSender::send_ping(int32_t serial)
     send_event_sequence(seq, {});
 }
 
+void mfd::EventSender::send_vsync(SurfaceId id, uint32_t output_id, mg::Frame const& frame)
+{
+    mp::EventSequence seq;
+
+    auto protobuf_vsync_event = seq.mutable_vsync_event();
+    protobuf_vsync_event->mutable_surface_id()->set_value(id.as_value());
+    protobuf_vsync_event->set_output_id(output_id);
+    protobuf_vsync_event->set_msc(frame.msc);
+    protobuf_vsync_event->set_ust(frame.ust.nanoseconds.count());
+    protobuf_vsync_event->set_clock_id(frame.ust.clock_id);
+
+    send_event_sequence(seq, {});
+}
+
 void mfd::EventSender::handle_input_config_change(MirInputConfig const& config)
 {
     mp::EventSequence seq;
@@ -103,14 +280,20 @@ void mfd::EventSender::handle_input_config_change(MirInputConfig const& config)
 
 void mfd::EventSender::send_event_sequence(mp::EventSequence& seq, FdSets const& fds)
 {
-    mir::VariableLengthArray<frontend::serialization_buffer_size>
-        send_buffer{static_cast<size_t>(seq.ByteSize())};
+    std::lock_guard<std::mutex> lock{batch_mutex};
 
-    seq.SerializeWithCachedSizesToArray(send_buffer.data());
+    // Held back events are older than whatever we're sending now
+    flush_batch();
+    send(seq, fds);
+}
 
+void mfd::EventSender::send(mp::EventSequence& seq, FdSets const& fds)
+{
     mir::protobuf::wire::Result result;
-    result.add_events(send_buffer.data(), send_buffer.size());
-    send_buffer.resize(result.ByteSize());
+    seq.SerializeToString(result.add_events());
+
+    mir::VariableLengthArray<frontend::serialization_buffer_size>
+        send_buffer{static_cast<size_t>(result.ByteSize())};
     result.SerializeWithCachedSizesToArray(send_buffer.data());
 
     try
@@ -21,11 +21,17 @@
 
 #include "mir/frontend/event_sink.h"
 #include "mir/frontend/fd_sets.h"
+
+#include <chrono>
+#include <map>
 #include <memory>
+#include <mutex>
+#include <utility>
 
 namespace mir
 {
 namespace graphics { class PlatformIpcOperations; }
+namespace time { class Alarm; class AlarmFactory; }
 namespace protobuf
 {
 class EventSequence;
@@ -43,23 +49,59 @@ public:
     explicit EventSender(
         std::shared_ptr<MessageSender> const& socket_sender,
         std::shared_ptr<graphics::PlatformIpcOperations> const& buffer_packer);
+
+    /// Holds back pointer motion and touch move events for up to batch_delay
+    /// and sends them together in one message. Anything else sent through
+    /// this sink sends them first, so the order of events sent through it is
+    /// unchanged.
+    /// Each surface has its own sink, so messages sent through the session's
+    /// sink (pings, lifecycle and configuration changes, buffers) are not
+    /// ordered against held events and can overtake them by up to batch_delay.
+    /// Pointer motion from one device to one surface that arrives while
+    /// motion is held is merged into it.
+    EventSender(
+        std::shared_ptr<MessageSender> const& socket_sender,
+        std::shared_ptr<graphics::PlatformIpcOperations> const& buffer_packer,
+        time::AlarmFactory& alarm_factory,
+        std::chrono::milliseconds batch_delay);
+    ~EventSender();
+
     void handle_event(MirEvent const& e) override;
     void handle_lifecycle_event(MirLifecycleState state) override;
     void handle_display_config_change(graphics::DisplayConfiguration const& config) override;
     void handle_error(ClientVisibleError const& error) override;
     void handle_input_config_change(MirInputConfig const& config) override;
     void send_ping(int32_t serial) override;
+    void send_vsync(SurfaceId id, uint32_t output_id, graphics::Frame const& frame) override;
     void send_buffer(frontend::BufferStreamId id, graphics::Buffer& buffer, graphics::BufferIpcMsgType) override;
     void add_buffer(graphics::Buffer&) override;
     void error_buffer(geometry::Size, MirPixelFormat, std::string const&) override;
     void update_buffer(graphics::Buffer&) override;
 
 private:
+    class FlushBatch;
+
     void send_event_sequence(protobuf::EventSequence&, FdSets const&);
     void send_buffer(protobuf::EventSequence&, graphics::Buffer&, graphics::BufferIpcMsgType);
+    void send(protobuf::EventSequence&, FdSets const&);
+    void flush_batch();
+    bool coalesce(MirEvent const& e);
 
     std::shared_ptr<MessageSender> const sender;
     std::shared_ptr<graphics::PlatformIpcOperations> const buffer_packer;
+    std::chrono::milliseconds const batch_delay;
+
+    std::mutex batch_mutex;
+    std::unique_ptr<protobuf::EventSequence> batch;
+    std::unique_ptr<time::Alarm> batch_alarm;
+
+    struct HeldMotion
+    {
+        int index;  ///< Of the event in the batch
+        std::unique_ptr<MirEvent, void(*)(MirEvent*)> event;
+    };
+    // Keyed by device and window
+    std::map<std::pair<MirInputDeviceId, int>, HeldMotion> held_motion;
 };
 
 }
@@ -39,6 +39,14 @@ public:
 
     virtual std::unique_ptr<EventSink>
         create_sink(std::shared_ptr<MessageSender> const& sender) = 0;
+
+    /// A sink that may hold back input events briefly to send several together.
+    /// Held events are only ordered against other events sent through the same sink.
+    virtual std::unique_ptr<EventSink>
+        create_batching_sink(std::shared_ptr<MessageSender> const& sender)
+    {
+        return create_sink(sender);
+    }
 };
 
 }
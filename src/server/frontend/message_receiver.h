@@ -19,6 +19,8 @@
 #define MIR_FRONTEND_MESSAGE_RECEIVER_H_
 
 #include <functional>
+#include <string>
+#include <vector>
 #include <boost/asio.hpp>
 #include <mir/fd.h>
 
@@ -40,6 +42,16 @@ public:
     virtual SessionCredentials client_creds() = 0;
     virtual void receive_fds(std::vector<Fd>& fds) = 0;
 
+    /**
+     * Moves the messages in both directions onto the shared memory rings the
+     * client offered, after sending it acknowledgement on the socket. Fds
+     * still go over the socket.
+     * \param [in] fds the memory and doorbell of the ring to the server, then
+     *                  of the ring to the client
+     * \return false (and stays on the socket) if the rings are unusable
+     */
+    virtual bool use_shared_memory(std::vector<Fd> const& fds, std::string const& acknowledgement) = 0;
+
 protected:
     MessageReceiver() = default;
     virtual ~MessageReceiver() = default;
@@ -28,6 +28,7 @@
 
 #include "protobuf_ipc_factory.h"
 #include "mir/frontend/session_authorizer.h"
+#include "mir/time/alarm_factory.h"
 
 namespace mf = mir::frontend;
 namespace mfd = mir::frontend::detail;
@@ -38,10 +39,23 @@ mf::ProtobufConnectionCreator::ProtobufConnectionCreator(
     std::shared_ptr<SessionAuthorizer> const& session_authorizer,
     std::shared_ptr<mir::graphics::PlatformIpcOperations> const& operations,
     std::shared_ptr<MessageProcessorReport> const& report)
+:   ProtobufConnectionCreator(ipc_factory, session_authorizer, operations, report, {}, std::chrono::milliseconds{0})
+{
+}
+
+mf::ProtobufConnectionCreator::ProtobufConnectionCreator(
+    std::shared_ptr<ProtobufIpcFactory> const& ipc_factory,
+    std::shared_ptr<SessionAuthorizer> const& session_authorizer,
+    std::shared_ptr<mir::graphics::PlatformIpcOperations> const& operations,
+    std::shared_ptr<MessageProcessorReport> const& report,
+    std::shared_ptr<mir::time::AlarmFactory> const& alarm_factory,
+    std::chrono::milliseconds event_batch_delay)
 :   ipc_factory(ipc_factory),
     session_authorizer(session_authorizer),
     operations(operations),
     report(report),
+    alarm_factory(alarm_factory),
+    event_batch_delay(event_batch_delay),
     next_session_id(0),
     connections(std::make_shared<mfd::Connections<mfd::SocketConnection>>())
 {
@@ -62,8 +76,13 @@ namespace
 class ProtobufEventFactory : public mf::EventSinkFactory
 {
 public:
-    ProtobufEventFactory(std::shared_ptr<mir::graphics::PlatformIpcOperations> const& operations)
-        : ops{operations}
+    ProtobufEventFactory(
+        std::shared_ptr<mir::graphics::PlatformIpcOperations> const& operations,
+        std::shared_ptr<mir::time::AlarmFactory> const& alarm_factory,
+        std::chrono::milliseconds batch_delay)
+        : ops{operations},
+          alarm_factory{alarm_factory},
+          batch_delay{batch_delay}
     {
     }
 
@@ -72,8 +91,19 @@ public:
     {
         return std::make_unique<mf::detail::EventSender>(messenger, ops);
     };
+
+    std::unique_ptr<mf::EventSink>
+    create_batching_sink(std::shared_ptr<mf::MessageSender> const& messenger)
+    {
+        if (!alarm_factory || batch_delay <= std::chrono::milliseconds::zero())
+            return create_sink(messenger);
+
+        return std::make_unique<mf::detail::EventSender>(messenger, ops, *alarm_factory, batch_delay);
+    };
 private:
     std::shared_ptr<mir::graphics::PlatformIpcOperations> const ops;
+    std::shared_ptr<mir::time::AlarmFactory> const alarm_factory;
+    std::chrono::milliseconds const batch_delay;
 };
 }
 
@@ -95,7 +125,7 @@ void mf::ProtobufConnectionCreator::create_connection_for(
             message_sender,
             ipc_factory->make_ipc_server(
                 creds,
-                std::make_shared<ProtobufEventFactory>(operations),
+                std::make_shared<ProtobufEventFactory>(operations, alarm_factory, event_batch_delay),
                 messenger,
                 connection_context),
             report);
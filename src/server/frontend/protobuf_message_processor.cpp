@@ -27,6 +27,8 @@
 
 #include "mir_protobuf_wire.pb.h"
 
+#include <algorithm>
+
 namespace mfd = mir::frontend::detail;
 
 namespace
@@ -215,6 +217,22 @@ bool mfd::ProtobufMessageProcessor::dispatch(
                 request.mutable_buffer()->add_fd(fd);
             invoke(shared_from_this(), display_server.get(), &DisplayServer::submit_buffer, invocation.id(), &request);
         }
+        else if ("submit_transaction" == invocation.method_name())
+        {
+            auto request = parse_parameter<mir::protobuf::Transaction>(invocation);
+
+            // Each submission takes as many of the fds as it says it sent
+            auto fd = side_channel_fds.begin();
+            for (auto& submission : *request.mutable_submissions())
+            {
+                auto const buffer = submission.mutable_buffer();
+                auto const count = std::min<size_t>(buffer->fd_size(), side_channel_fds.end() - fd);
+                buffer->clear_fd();
+                for (auto const end = fd + count; fd != end; ++fd)
+                    buffer->add_fd(*fd);
+            }
+            invoke(shared_from_this(), display_server.get(), &DisplayServer::submit_transaction, invocation.id(), &request);
+        }
         else if ("allocate_buffers" == invocation.method_name())
         {
             invoke(this, display_server.get(), &DisplayServer::allocate_buffers, invocation);
@@ -28,6 +28,7 @@
 #include "mir/scene/surface_creation_parameters.h"
 #include "mir/scene/coordinate_translator.h"
 #include "mir/scene/application_not_responding_detector.h"
+#include "mir/scene/memory_report.h"
 #include "mir/frontend/display_changer.h"
 #include "resource_cache.h"
 #include "mir_toolkit/common.h"
@@ -114,6 +115,7 @@ mf::SessionMediator::SessionMediator(
     std::shared_ptr<mf::InputConfigurationChanger> const& input_changer,
     std::vector<mir::ExtensionDescription> const& extensions,
     std::shared_ptr<mg::GraphicBufferAllocator> const& allocator,
+    std::shared_ptr<ms::MemoryReport> const& memory_report,
     mir::Executor& executor) :
     client_pid_(0),
     shell(shell),
@@ -134,6 +136,7 @@ mf::SessionMediator::SessionMediator(
     input_changer(input_changer),
     extensions(extensions),
     allocator{allocator},
+    memory_report{memory_report},
     executor{executor}
 {
 }
@@ -143,6 +146,7 @@ mf::SessionMediator::~SessionMediator() noexcept
     if (auto session = weak_session.lock())
     {
         observer->session_error(session->name(), __PRETTY_FUNCTION__, "connection dropped without disconnect");
+        memory_report->owner_destroyed(session.get());
         shell->close_session(session);
     }
     destroy_screencast_sessions();
@@ -162,6 +166,8 @@ void mf::SessionMediator::connect(
 
     auto const session = shell->open_session(client_pid_, request->application_name(), event_sink);
     weak_session = session;
+    immediate_events = request->immediate_events();
+    memory_report->owner_created(session.get(), nullptr, session->name());
     connection_context.handle_client_connect(session);
 
     auto ipc_package = ipc_operations->connection_ipc_package();
@@ -193,6 +199,8 @@ void mf::SessionMediator::connect(
     for (auto pf : surface_pixel_formats)
         response->add_surface_pixel_format(static_cast<::google::protobuf::uint32>(pf));
 
+    response->set_transactions_supported(true);
+
     resource_cache->save_resource(response, ipc_package);
 
     for ( auto const& ext : extensions )
@@ -334,6 +342,8 @@ void mf::SessionMediator::create_surface(
             {params.size, params.pixel_format, params.buffer_usage});
         legacy_stream = session->get_buffer_stream(buffer_stream_id);
         params.content_id = buffer_stream_id;
+        memory_report->owner_created(
+            legacy_stream.get(), session.get(), "buffer stream " + std::to_string(buffer_stream_id.as_value()));
     }
 
     if (request->has_min_aspect())
@@ -345,7 +355,9 @@ void mf::SessionMediator::create_surface(
     params.input_shape = extract_input_shape_from(request);
 
     auto buffering_sender = std::make_shared<mf::ReorderingMessageSender>(message_sender);
-    std::shared_ptr<mf::EventSink> sink = sink_factory->create_sink(buffering_sender);
+    std::shared_ptr<mf::EventSink> sink = immediate_events ?
+        sink_factory->create_sink(buffering_sender) :
+        sink_factory->create_batching_sink(buffering_sender);
 
     auto const surf_id = shell->create_surface(session, params, sink);
 
@@ -447,19 +459,42 @@ void mf::SessionMediator::submit_buffer(
 {
     auto const session = weak_session.lock();
     if (!session) BOOST_THROW_EXCEPTION(std::logic_error("Invalid application session"));
-    observer->session_submit_buffer_called(session->name());
+    submit_buffer_to_stream(*session, *request);
+
+    done->Run();
+}
+
+void mf::SessionMediator::submit_transaction(
+    mir::protobuf::Transaction const* request,
+    mir::protobuf::Void*,
+    google::protobuf::Closure* done)
+{
+    auto const session = weak_session.lock();
+    if (!session) BOOST_THROW_EXCEPTION(std::logic_error("Invalid application session"));
+
+    for (auto const& modifications : request->modifications())
+        apply_surface_modifications(session, modifications);
+
+    // Back to back, so that a compositor is unlikely to see only some of them
+    for (auto const& submission : request->submissions())
+        submit_buffer_to_stream(*session, submission);
+
+    done->Run();
+}
+
+void mf::SessionMediator::submit_buffer_to_stream(Session& session, mir::protobuf::BufferRequest const& request)
+{
+    observer->session_submit_buffer_called(session.name());
     
-    mf::BufferStreamId const stream_id{request->id().value()};
-    mg::BufferID const buffer_id{static_cast<uint32_t>(request->buffer().buffer_id())};
-    auto stream = session->get_buffer_stream(stream_id);
+    mf::BufferStreamId const stream_id{request.id().value()};
+    mg::BufferID const buffer_id{static_cast<uint32_t>(request.buffer().buffer_id())};
+    auto stream = session.get_buffer_stream(stream_id);
 
-    mfd::ProtobufBufferPacker request_msg{const_cast<mir::protobuf::Buffer*>(&request->buffer())};
+    mfd::ProtobufBufferPacker request_msg{const_cast<mir::protobuf::Buffer*>(&request.buffer())};
     auto b = buffer_cache.at(buffer_id);
     ipc_operations->unpack_buffer(request_msg, *b);
 
     stream->submit_buffer(std::make_shared<AutoSendBuffer>(b, executor, event_sink));
-
-    done->Run();
 }
 
 namespace
@@ -538,7 +573,7 @@ void mf::SessionMediator::allocate_buffers(
             }
 
             // TODO: Throw if insert fails (duplicate ID)?
-            buffer_cache.insert(std::make_pair(buffer->id(), buffer));
+            cache_buffer(*session, buffer);
             event_sink->add_buffer(*buffer);
         }
         catch (std::exception const& err)
@@ -590,7 +625,7 @@ void mf::SessionMediator::release_buffers(
     }
     for (auto const& buffer_id : to_release)
     {
-        buffer_cache.erase(buffer_id);
+        uncache_buffer(*session, buffer_id);
     }
    done->Run();
 }
@@ -614,6 +649,7 @@ void mf::SessionMediator::release_surface(
     auto it = legacy_default_stream_map.find(id);
     if (it != legacy_default_stream_map.end())
     {
+        memory_report->owner_destroyed(session->get_buffer_stream(it->second).get());
         session->destroy_buffer_stream(it->second);
         legacy_default_stream_map.erase(it);
     }
@@ -635,6 +671,7 @@ void mf::SessionMediator::disconnect(
 
         observer->session_disconnect_called(session->name());
 
+        memory_report->owner_destroyed(session.get());
         shell->close_session(session);
         destroy_screencast_sessions();
     }
@@ -675,12 +712,21 @@ void mf::SessionMediator::modify_surface(
     mir::protobuf::Void* /*response*/,
     google::protobuf::Closure* done)
 {
-    auto const& surface_specification = request->surface_specification();
-
     auto const session = weak_session.lock();
     if (!session)
         BOOST_THROW_EXCEPTION(std::logic_error("Invalid application session"));
 
+    apply_surface_modifications(session, *request);
+
+    done->Run();
+}
+
+void mf::SessionMediator::apply_surface_modifications(
+    std::shared_ptr<Session> const& session,
+    mir::protobuf::SurfaceModifications const& request)
+{
+    auto const& surface_specification = request.surface_specification();
+
     msh::SurfaceSpecification mods;
 
 #define COPY_IF_SET(name)\
@@ -786,11 +832,9 @@ void mf::SessionMediator::modify_surface(
     if (surface_specification.input_shape_size() > 0)
         mods.input_shape = extract_input_shape_from(&surface_specification);
 
-    auto const id = mf::SurfaceId(request->surface_id().value());
+    auto const id = mf::SurfaceId(request.surface_id().value());
 
     shell->modify_surface(session, id, mods);
-
-    done->Run();
 }
 
 void mf::SessionMediator::configure_display(
@@ -1011,6 +1055,8 @@ void mf::SessionMediator::create_buffer_stream(
     
     auto const buffer_stream_id = session->create_buffer_stream(props);
     auto stream = session->get_buffer_stream(buffer_stream_id);
+    memory_report->owner_created(
+        stream.get(), session.get(), "buffer stream " + std::to_string(buffer_stream_id.as_value()));
     
     response->mutable_id()->set_value(buffer_stream_id.as_value());
     response->set_pixel_format(stream->pixel_format());
@@ -1034,12 +1080,13 @@ void mf::SessionMediator::release_buffer_stream(
 
     auto const id = BufferStreamId(request->value());
 
+    memory_report->owner_destroyed(session->get_buffer_stream(id).get());
     session->destroy_buffer_stream(id);
 
     auto const associated_range = stream_associated_buffers.equal_range(id) ;
     for (auto match = associated_range.first; match != associated_range.second; ++match)
     {
-        buffer_cache.erase(match->second);
+        uncache_buffer(*session, match->second);
     }
     stream_associated_buffers.erase(id);
 
@@ -1431,6 +1478,31 @@ void mf::SessionMediator::destroy_screencast_sessions()
         screencast_buffer_tracker.remove_session(id);
 }
 
+namespace
+{
+size_t bytes_of(mg::Buffer const& buffer)
+{
+    auto const size = buffer.size();
+    return size_t{size.width.as_uint32_t()} * size.height.as_uint32_t() * MIR_BYTES_PER_PIXEL(buffer.pixel_format());
+}
+}
+
+void mf::SessionMediator::cache_buffer(Session const& session, std::shared_ptr<mg::Buffer> const& buffer)
+{
+    if (buffer_cache.insert(std::make_pair(buffer->id(), buffer)).second)
+        memory_report->allocated(&session, ms::MemoryReport::Category::client_buffers, bytes_of(*buffer));
+}
+
+void mf::SessionMediator::uncache_buffer(Session const& session, mg::BufferID id)
+{
+    auto const cached = buffer_cache.find(id);
+    if (cached == buffer_cache.end())
+        return;
+
+    memory_report->released(&session, ms::MemoryReport::Category::client_buffers, bytes_of(*cached->second));
+    buffer_cache.erase(cached);
+}
+
 auto mf::detail::PromptSessionStore::insert(std::shared_ptr<PromptSession> const& session) -> PromptSessionId
 {
     std::lock_guard<decltype(mutex)> lock{mutex};
@@ -61,6 +61,7 @@ namespace scene
 {
 class CoordinateTranslator;
 class ApplicationNotRespondingDetector;
+class MemoryReport;
 }
 
 /// Frontend interface. Mediates the interaction between client
@@ -130,6 +131,7 @@ public:
         std::shared_ptr<InputConfigurationChanger> const& input_changer,
         std::vector<mir::ExtensionDescription> const& extensions,
         std::shared_ptr<graphics::GraphicBufferAllocator> const& allocator,
+        std::shared_ptr<scene::MemoryReport> const& memory_report,
         mir::Executor& executor);
 
     ~SessionMediator() noexcept;
@@ -232,6 +234,10 @@ public:
         mir::protobuf::BufferRequest const* request,
         mir::protobuf::Void* response,
         google::protobuf::Closure* done) override;
+    void submit_transaction(
+        mir::protobuf::Transaction const* request,
+        mir::protobuf::Void* response,
+        google::protobuf::Closure* done) override;
     void allocate_buffers(
         mir::protobuf::BufferAllocation const* request,
         mir::protobuf::Void* response,
@@ -284,6 +290,14 @@ private:
 
     void destroy_screencast_sessions();
 
+    void submit_buffer_to_stream(Session& session, mir::protobuf::BufferRequest const& request);
+    void apply_surface_modifications(
+        std::shared_ptr<Session> const& session,
+        mir::protobuf::SurfaceModifications const& request);
+
+    void cache_buffer(Session const& session, std::shared_ptr<graphics::Buffer> const& buffer);
+    void uncache_buffer(Session const& session, graphics::BufferID id);
+
     pid_t client_pid_;
     std::shared_ptr<Shell> const shell;
     std::shared_ptr<graphics::PlatformIpcOperations> const ipc_operations;
@@ -307,11 +321,13 @@ private:
     std::unordered_map<graphics::BufferID, std::shared_ptr<graphics::Buffer>> buffer_cache;
     std::unordered_multimap<BufferStreamId, graphics::BufferID> stream_associated_buffers;
     std::shared_ptr<graphics::GraphicBufferAllocator> const allocator;
+    std::shared_ptr<scene::MemoryReport> const memory_report;
     mir::Executor& executor;
 
     ScreencastBufferTracker screencast_buffer_tracker;
 
     std::weak_ptr<Session> weak_session;
+    bool immediate_events{false};
     detail::PromptSessionStore prompt_sessions;
 
     std::map<frontend::SurfaceId, frontend::BufferStreamId> legacy_default_stream_map;
@@ -114,6 +114,18 @@ try
         message_receiver->receive_fds(fds);
     }
 
+    if (invocation.shm_transport() && invocation.method_name() == "connect" && fds.size() >= shm_fds)
+    {
+        std::vector<mir::Fd> const ring_fds{fds.end() - shm_fds, fds.end()};
+        fds.resize(fds.size() - shm_fds);
+
+        mir::protobuf::wire::Result acknowledgement;
+        acknowledgement.set_shm_transport(true);
+
+        if (!message_receiver->use_shared_memory(ring_fds, acknowledgement.SerializeAsString()))
+            mir::log_warning("Client offered unusable shared memory rings; staying on its socket");
+    }
+
     if (!client_pid)
     {
         client_pid = message_receiver->client_creds().pid();
@@ -60,6 +60,9 @@ private:
     std::shared_ptr<Connections<SocketConnection>> const connections;
     std::shared_ptr<MessageProcessor> processor;
 
+    // A ring is a memory fd and a doorbell fd, and there's one each way
+    static size_t const shm_fds = 4;
+
     static size_t const header_size = 2;
     char header[header_size];
     std::vector<char> body;
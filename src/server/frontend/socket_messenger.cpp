@@ -17,16 +17,18 @@
  */
 
 #include "socket_messenger.h"
-#include "mir/frontend/client_constants.h"
-#include "mir/variable_length_array.h"
 #include "mir/fd_socket_transmission.h"
+#include "mir/shm_ring.h"
 #include "mir/raii.h"
 
 #include <boost/throw_exception.hpp>
 
 #include <errno.h>
 #include <string.h>
+#include <poll.h>
+#include <sys/epoll.h>
 
+#include <array>
 #include <stdexcept>
 
 namespace mf = mir::frontend;
@@ -48,6 +50,8 @@ mfd::SocketMessenger::SocketMessenger(std::shared_ptr<ba::local::stream_protocol
     socket->set_option(option);
 }
 
+mfd::SocketMessenger::~SocketMessenger() = default;
+
 mf::SessionCredentials mfd::SocketMessenger::creator_creds() const
 {
     struct ucred cr;
@@ -73,30 +77,63 @@ mf::SessionCredentials mfd::SocketMessenger::client_creds()
 
 void mfd::SocketMessenger::send(char const* data, size_t length, FdSets const& fd_set)
 {
-    static size_t const header_size{2};
-    mir::VariableLengthArray<mf::serialization_buffer_size> whole_message{header_size + length};
+    std::unique_lock<std::mutex> lg(message_lock);
 
-    whole_message.data()[0] = static_cast<unsigned char>((length >> 8) & 0xff);
-    whole_message.data()[1] = static_cast<unsigned char>((length >> 0) & 0xff);
-    std::copy(data, data + length, whole_message.data() + header_size);
+    if (outgoing)
+    {
+        std::array<unsigned char, 2> const header{{
+            static_cast<unsigned char>((length >> 8) & 0xff),
+            static_cast<unsigned char>((length >> 0) & 0xff)}};
 
-    std::unique_lock<std::mutex> lg(message_lock);
+        // Like the non-blocking socket, we don't wait for a client that has stopped reading.
+        // That is checked before sending any fds, so they are never sent without their message.
+        // Only we write to the ring (under message_lock), so the room can only grow meanwhile.
+        if (outgoing->free_space() < header.size() + length)
+            BOOST_THROW_EXCEPTION(std::runtime_error("Client is not reading its shared memory ring"));
+
+        // The fds go first, so that they are waiting when the client reads the message
+        for (auto const& fds : fd_set)
+            mir::send_fds(socket_fd, fds);
+
+        outgoing->write({{header.data(), header.size()}, {data, length}});
+        return;
+    }
 
     // TODO: This should be asynchronous, but we are not making sure
     // that a potential call to send_fds is executed _after_ this
     // function has completed (if it would be executed asynchronously.
     // NOTE: we rely on this synchronous behavior as per the comment in
     // mf::SessionMediator::create_surface
-    ba::write(*socket, ba::buffer(whole_message.data(), whole_message.size()));
+    write_to_socket(data, length);
 
     for (auto const& fds : fd_set)
         mir::send_fds(socket_fd, fds);
 }
 
+void mfd::SocketMessenger::write_to_socket(char const* data, size_t length)
+{
+    std::array<unsigned char, 2> const header{{
+        static_cast<unsigned char>((length >> 8) & 0xff),
+        static_cast<unsigned char>((length >> 0) & 0xff)}};
+
+    // Gathered by a single sendmsg(), so the message isn't copied to prepend the header
+    std::array<ba::const_buffer, 2> const whole_message{{
+        ba::buffer(header),
+        ba::buffer(data, length)}};
+
+    ba::write(*socket, whole_message);
+}
+
 void mfd::SocketMessenger::async_receive_msg(
     MirReadHandler const& handler,
     ba::mutable_buffers_1 const& buffer)
 {
+    if (incoming)
+    {
+        async_receive_from_ring(handler, buffer);
+        return;
+    }
+
     boost::asio::async_read(
          *socket,
          buffer,
@@ -104,9 +141,99 @@ void mfd::SocketMessenger::async_receive_msg(
          handler);
 }
 
+void mfd::SocketMessenger::async_receive_from_ring(
+    MirReadHandler const& handler,
+    ba::mutable_buffers_1 const& buffer)
+{
+    auto const size = ba::buffer_size(buffer);
+    auto& io_service = socket->get_io_service();
+    std::weak_ptr<SocketMessenger> const weak_self{shared_from_this()};
+
+    // The ring throws if the client has corrupted it, which the handler
+    // is told about like any other read error. (In all cases the handler
+    // is posted, as it is likely to ask for the next message.)
+    try
+    {
+        if (incoming->read(ba::buffer_cast<void*>(buffer), size))
+        {
+            io_service.post([handler, size] { handler(bs::error_code{}, size); });
+        }
+        else if (!incoming->prepare_to_wait(size))
+        {
+            io_service.post([weak_self, handler, buffer]
+                {
+                    if (auto const self = weak_self.lock())
+                        self->async_receive_from_ring(handler, buffer);
+                });
+        }
+        else
+        {
+            incoming_watch->async_read_some(ba::null_buffers(),
+                [weak_self, handler, buffer](bs::error_code const& error, size_t)
+                {
+                    if (error)
+                    {
+                        handler(error, 0);
+                        return;
+                    }
+
+                    if (auto const self = weak_self.lock())
+                        self->on_incoming_ready(handler, buffer);
+                });
+        }
+    }
+    catch (std::runtime_error const&)
+    {
+        io_service.post([handler] { handler(ba::error::fault, 0); });
+    }
+}
+
+void mfd::SocketMessenger::on_incoming_ready(
+    MirReadHandler const& handler,
+    ba::mutable_buffers_1 const& buffer)
+{
+    bool hung_up;
+    try
+    {
+        incoming->clear_doorbell();
+        hung_up = incoming->available() < ba::buffer_size(buffer) && client_hung_up();
+    }
+    catch (std::runtime_error const&)
+    {
+        handler(ba::error::fault, 0);
+        return;
+    }
+
+    if (hung_up)
+        handler(ba::error::eof, 0);
+    else
+        async_receive_from_ring(handler, buffer);
+}
+
+bool mfd::SocketMessenger::client_hung_up() const
+{
+    pollfd socket_events{socket_fd, POLLRDHUP, 0};
+    return poll(&socket_events, 1, 0) == 1 &&
+        (socket_events.revents & (POLLRDHUP | POLLHUP | POLLERR));
+}
+
 bs::error_code mfd::SocketMessenger::receive_msg(
     ba::mutable_buffers_1 const& buffer)
 {
+    if (incoming)
+    {
+        // The client writes each message whole, so it's all there or it's malformed
+        try
+        {
+            if (incoming->read(ba::buffer_cast<void*>(buffer), ba::buffer_size(buffer)))
+                return {};
+        }
+        catch (std::runtime_error const&)
+        {
+        }
+        return ba::error::fault;
+    }
+
     bs::error_code e;
     size_t nread = 0;
 
@@ -137,11 +264,69 @@ size_t mfd::SocketMessenger::available_bytes()
     if (session_creds.pid() == 0)
         update_session_creds();
 
+    if (incoming)
+    {
+        try
+        {
+            return incoming->available();
+        }
+        catch (std::runtime_error const&)
+        {
+            // Nothing can be read from a corrupted ring: the next read reports it
+            return 0;
+        }
+    }
+
     boost::asio::socket_base::bytes_readable command{true};
     socket->io_control(command);
     return command.get();
 }
 
+bool mfd::SocketMessenger::use_shared_memory(std::vector<Fd> const& fds, std::string const& acknowledgement)
+{
+    if (fds.size() != 4)
+        return false;
+
+    std::unique_ptr<ShmRing> from_client;
+    std::unique_ptr<ShmRing> to_client;
+    try
+    {
+        from_client = std::make_unique<ShmRing>(fds[0], fds[1]);
+        to_client = std::make_unique<ShmRing>(fds[2], fds[3]);
+    }
+    catch (std::runtime_error const&)
+    {
+        return false;
+    }
+
+    auto const epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+    if (epoll_fd < 0)
+        return false;
+
+    auto watch = std::make_unique<ba::posix::stream_descriptor>(socket->get_io_service(), epoll_fd);
+
+    epoll_event doorbell_event{};
+    doorbell_event.events = EPOLLIN;
+    epoll_event hangup_event{};
+    hangup_event.events = EPOLLRDHUP;
+
+    if (epoll_ctl(epoll_fd, EPOLL_CTL_ADD, from_client->doorbell_fd(), &doorbell_event) ||
+        epoll_ctl(epoll_fd, EPOLL_CTL_ADD, socket_fd, &hangup_event))
+    {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lg(message_lock);
+
+    // The last message on the socket: the client reads the rings once it sees this
+    write_to_socket(acknowledgement.data(), acknowledgement.size());
+
+    incoming = std::move(from_client);
+    outgoing = std::move(to_client);
+    incoming_watch = std::move(watch);
+    return true;
+}
+
 void mfd::SocketMessenger::set_passcred(int opt)
 {
     if (setsockopt(socket_fd, SOL_SOCKET, SO_PASSCRED, &opt, sizeof(opt)) == -1)
@@ -21,19 +21,24 @@
 #include "message_sender.h"
 #include "message_receiver.h"
 #include "mir/frontend/session_credentials.h"
+#include <memory>
 #include <mutex>
 
 namespace mir
 {
+class ShmRing;
+
 namespace frontend
 {
 namespace detail
 {
 class SocketMessenger : public MessageSender,
-                        public MessageReceiver
+                        public MessageReceiver,
+                        public std::enable_shared_from_this<SocketMessenger>
 {
 public:
     SocketMessenger(std::shared_ptr<boost::asio::local::stream_protocol::socket> const& socket);
+    ~SocketMessenger();
 
     void send(char const* data, size_t length, FdSets const& fds) override;
 
@@ -42,17 +47,29 @@ public:
     size_t available_bytes() override;
     SessionCredentials client_creds() override;
     void receive_fds(std::vector<Fd>& fds) override;
+    bool use_shared_memory(std::vector<Fd> const& fds, std::string const& acknowledgement) override;
 
 private:
     void set_passcred(int opt);
     void update_session_creds();
     SessionCredentials creator_creds() const;
 
+    void write_to_socket(char const* data, size_t length);
+    void async_receive_from_ring(MirReadHandler const& handler, boost::asio::mutable_buffers_1 const& buffer);
+    void on_incoming_ready(MirReadHandler const& handler, boost::asio::mutable_buffers_1 const& buffer);
+    bool client_hung_up() const;
+
     std::shared_ptr<boost::asio::local::stream_protocol::socket> socket;
     mir::Fd socket_fd;
 
     std::mutex message_lock;
     SessionCredentials session_creds{0, 0, 0};
+
+    // Set once the client's shared memory offer is accepted
+    std::unique_ptr<ShmRing> incoming;
+    std::unique_ptr<ShmRing> outgoing;
+    // Readable when the incoming doorbell rings or the client hangs up
+    std::unique_ptr<boost::asio::posix::stream_descriptor> incoming_watch;
 };
 }
 }
@@ -64,4 +64,8 @@ void mf::NullEventSink::error_buffer(mir::geometry::Size, MirPixelFormat, std::s
 
 void mf::NullEventSink::update_buffer(mir::graphics::Buffer&)
 {
-}
\ No newline at end of file
+}
+
+void mf::NullEventSink::send_vsync(SurfaceId, uint32_t, mir::graphics::Frame const&)
+{
+}
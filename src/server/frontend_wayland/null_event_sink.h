@@ -44,6 +44,8 @@ public:
 
     void handle_error(ClientVisibleError const&) override;
 
+    void send_vsync(SurfaceId, uint32_t, graphics::Frame const&) override;
+
     void add_buffer(graphics::Buffer&) override;
 
     void error_buffer(geometry::Size, MirPixelFormat, std::string const&) override;
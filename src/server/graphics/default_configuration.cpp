@@ -109,7 +109,10 @@ std::shared_ptr<mg::Platform> mir::DefaultServerConfiguration::the_graphics_plat
                         auto msg = "Failed to find any platform plugins in: " + path;
                         throw std::runtime_error(msg.c_str());
                     }
-                    platform_library = mir::graphics::module_for_device(platforms, dynamic_cast<mir::options::ProgramOption&>(*the_options()));
+                    platform_library = mir::graphics::module_for_device(
+                        platforms,
+                        dynamic_cast<mir::options::ProgramOption&>(*the_options()),
+                        *the_shared_library_prober_report());
                 }
                 auto create_host_platform = platform_library->load_function<mg::CreateHostPlatform>(
                     "create_host_platform",
@@ -126,6 +129,10 @@ std::shared_ptr<mg::Platform> mir::DefaultServerConfiguration::the_graphics_plat
 
                 return create_host_platform(the_options(), the_emergency_cleanup(), the_display_report(), the_logger());
             }
+            catch (mir::ConstructionInProgress const&)
+            {
+                throw;
+            }
             catch(...)
             {
                 // access exception information before platform library gets unloaded
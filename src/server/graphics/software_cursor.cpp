@@ -26,6 +26,8 @@
 #include "mir/renderer/sw/pixel_source.h"
 
 #include <boost/throw_exception.hpp>
+#include <algorithm>
+#include <cstring>
 #include <stdexcept>
 #include <mutex>
 
@@ -53,6 +55,22 @@ MirPixelFormat get_8888_format(std::vector<MirPixelFormat> const& formats)
     return mir_pixel_format_invalid;
 }
 
+// Cursors flick between a handful of images, so that's all we keep
+size_t const max_converted_images{8};
+
+std::vector<unsigned char> convert(unsigned char const* argb_8888, size_t size, MirPixelFormat format)
+{
+    std::vector<unsigned char> result(argb_8888, argb_8888 + size);
+
+    // In memory (little endian) argb_8888 is B,G,R,A and abgr_8888 is R,G,B,A
+    if (format == mir_pixel_format_abgr_8888)
+    {
+        for (size_t i = 0; i + 3 < size; i += 4)
+            std::swap(result[i], result[i + 2]);
+    }
+
+    return result;
+}
 }
 
 class mg::detail::CursorRenderable : public mg::Renderable
@@ -176,6 +194,13 @@ void mg::SoftwareCursor::show(CursorImage const& cursor_image)
 
 std::shared_ptr<mg::detail::CursorRenderable>
 mg::SoftwareCursor::create_renderable_for(CursorImage const& cursor_image, geom::Point position)
+{
+    return std::make_shared<detail::CursorRenderable>(
+        buffer_for(cursor_image),
+        position + hotspot - cursor_image.hotspot());
+}
+
+std::shared_ptr<mg::Buffer> mg::SoftwareCursor::buffer_for(CursorImage const& cursor_image)
 {
     size_t const pixels_size =
         cursor_image.size().width.as_uint32_t() *
@@ -185,19 +210,38 @@ mg::SoftwareCursor::create_renderable_for(CursorImage const& cursor_image, geom:
     if (pixels_size == 0)
         BOOST_THROW_EXCEPTION(std::logic_error("zero sized software cursor image is invalid"));
 
-    auto new_renderable = std::make_shared<detail::CursorRenderable>(
-        allocator->alloc_buffer({cursor_image.size(), format, mg::BufferUsage::software}),
-        position + hotspot - cursor_image.hotspot());
+    auto const argb_8888 = static_cast<unsigned char const*>(cursor_image.as_argb_8888());
+
+    auto const converted = std::find_if(converted_images.begin(), converted_images.end(),
+        [&](ConvertedImage const& candidate)
+        {
+            return candidate.size == cursor_image.size() &&
+                   memcmp(candidate.argb_8888.data(), argb_8888, pixels_size) == 0;
+        });
+
+    if (converted != converted_images.end())
+    {
+        std::rotate(converted_images.begin(), converted, converted + 1);
+        return converted_images.front().buffer;
+    }
+
+    auto const buffer = allocator->alloc_buffer({cursor_image.size(), format, mg::BufferUsage::software});
 
-    // TODO: The buffer pixel format may not be argb_8888, leading to
-    // incorrect cursor colors. We need to transform the data to match
-    // the buffer pixel format.
-    auto pixel_source = dynamic_cast<mrs::PixelSource*>(new_renderable->buffer()->native_buffer_base());
+    auto pixel_source = dynamic_cast<mrs::PixelSource*>(buffer->native_buffer_base());
     if (pixel_source)
-        pixel_source->write(static_cast<unsigned char const*>(cursor_image.as_argb_8888()), pixels_size);
+        pixel_source->write(convert(argb_8888, pixels_size, format).data(), pixels_size);
     else
         BOOST_THROW_EXCEPTION(std::logic_error("could not write to buffer for software cursor"));
-    return new_renderable;
+
+    // A buffer may still be in use by the compositor after the cursor changes (lp: #1413211),
+    // so rather than rewrite one we keep it for the next time its image is shown
+    if (converted_images.size() == max_converted_images)
+        converted_images.pop_back();
+    converted_images.insert(
+        converted_images.begin(),
+        ConvertedImage{cursor_image.size(), {argb_8888, argb_8888 + pixels_size}, buffer});
+
+    return buffer;
 }
 
 void mg::SoftwareCursor::hide()
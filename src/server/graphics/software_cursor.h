@@ -22,13 +22,16 @@
 #include "mir/graphics/cursor.h"
 #include "mir_toolkit/client_types.h"
 #include "mir/geometry/displacement.h"
+#include "mir/geometry/size.h"
 #include <mutex>
+#include <vector>
 
 namespace mir
 {
 namespace input { class Scene; }
 namespace graphics
 {
+class Buffer;
 class GraphicBufferAllocator;
 class Renderable;
 
@@ -53,6 +56,15 @@ public:
 private:
     std::shared_ptr<detail::CursorRenderable> create_renderable_for(
         CursorImage const& cursor_image, geometry::Point position);
+    std::shared_ptr<Buffer> buffer_for(CursorImage const& cursor_image);
+
+    /// An image already converted to the buffer format. Buffers are never rewritten.
+    struct ConvertedImage
+    {
+        geometry::Size size;
+        std::vector<unsigned char> argb_8888;
+        std::shared_ptr<Buffer> buffer;
+    };
 
     std::shared_ptr<GraphicBufferAllocator> const allocator;
     std::shared_ptr<input::Scene> const scene;
@@ -61,6 +73,7 @@ private:
     std::shared_ptr<detail::CursorRenderable> renderable;
     bool visible;
     geometry::Displacement hotspot;
+    std::vector<ConvertedImage> converted_images; // Most recently shown first
 };
 
 }
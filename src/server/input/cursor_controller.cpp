@@ -48,19 +48,19 @@ struct UpdateCursorOnSurfaceChanges : ms::NullSurfaceObserver
     {
         // Attribute changing alone wont trigger a cursor update
     }
-    void resized_to(ms::Surface const*, geom::Size const&) override
+    void resized_to(ms::Surface const* surface, geom::Size const&) override
     {
-        cursor_controller->update_cursor_image();
+        cursor_controller->surface_changed(surface);
     }
-    void moved_to(ms::Surface const*, geom::Point const&) override
+    void moved_to(ms::Surface const* surface, geom::Point const&) override
     {
-        cursor_controller->update_cursor_image();
+        cursor_controller->surface_changed(surface);
     }
-    void hidden_set_to(ms::Surface const*, bool) override
+    void hidden_set_to(ms::Surface const* surface, bool) override
     {
-        cursor_controller->update_cursor_image();
+        cursor_controller->surface_changed(surface);
     }
-    void frame_posted(ms::Surface const*, int, geom::Size const&) override
+    void frame_posted(ms::Surface const* surface, int, geom::Rectangle const&) override
     {
         // The first frame posted will trigger a cursor update, since it
         // changes the visibility status of the surface, and can thus affect
@@ -68,28 +68,32 @@ struct UpdateCursorOnSurfaceChanges : ms::NullSurfaceObserver
         if (!first_frame_posted)
         {
             first_frame_posted = true;
-            cursor_controller->update_cursor_image();
+            cursor_controller->surface_changed(surface);
         }
     }
-    void alpha_set_to(ms::Surface const*, float) override
+    void alpha_set_to(ms::Surface const* surface, float) override
     {
-        cursor_controller->update_cursor_image();
+        cursor_controller->surface_changed(surface);
     }
-    void transformation_set_to(ms::Surface const*, glm::mat4 const&) override
+    void transformation_set_to(ms::Surface const* surface, glm::mat4 const&) override
     {
-        cursor_controller->update_cursor_image();
+        cursor_controller->surface_changed(surface);
     }
-    void reception_mode_set_to(ms::Surface const*, mi::InputReceptionMode) override
+    void reception_mode_set_to(ms::Surface const* surface, mi::InputReceptionMode) override
     {
-        cursor_controller->update_cursor_image();
+        cursor_controller->surface_changed(surface);
     }
-    void cursor_image_set_to(ms::Surface const*, const mir::graphics::CursorImage&) override
+    void input_region_set_to(ms::Surface const* surface, std::vector<geom::Rectangle> const&) override
     {
-        cursor_controller->update_cursor_image();
+        cursor_controller->surface_changed(surface);
     }
-    void cursor_image_removed(ms::Surface const*) override
+    void cursor_image_set_to(ms::Surface const* surface, const mir::graphics::CursorImage&) override
     {
-        cursor_controller->update_cursor_image();
+        cursor_controller->surface_cursor_image_changed(surface);
+    }
+    void cursor_image_removed(ms::Surface const* surface) override
+    {
+        cursor_controller->surface_cursor_image_changed(surface);
     }
     void orientation_set_to(ms::Surface const*, MirOrientation) override
     {
@@ -125,7 +129,7 @@ struct UpdateCursorOnSceneChanges : ms::Observer
     void surface_added(ms::Surface *surface)
     {
         add_surface_observer(surface);
-        cursor_controller->update_cursor_image();
+        cursor_controller->surface_changed(surface);
     }
     void surface_removed(ms::Surface *surface)
     {
@@ -138,7 +142,7 @@ struct UpdateCursorOnSceneChanges : ms::Observer
                 surface_observers.erase(it);
             }
         }
-        cursor_controller->update_cursor_image();
+        cursor_controller->surface_removed(surface);
     }
     void surfaces_reordered()
     {
@@ -147,13 +151,14 @@ struct UpdateCursorOnSceneChanges : ms::Observer
 
     void scene_changed()
     {
-        cursor_controller->update_cursor_image();
+        // Only input visualizations (such as the cursor itself) change the
+        // scene without a surface event, and they can't be under the cursor.
     }
 
     void surface_exists(ms::Surface *surface)
     {
         add_surface_observer(surface);
-        cursor_controller->update_cursor_image();
+        cursor_controller->surface_changed(surface);
     }
 
     void end_observation()
@@ -178,14 +183,7 @@ private:
 std::shared_ptr<mi::Surface> topmost_surface_containing_point(
     std::shared_ptr<mi::Scene> const& targets, geom::Point const& point)
 {
-    std::shared_ptr<mi::Surface> top_surface_at_point;
-    targets->for_each([&top_surface_at_point, &point]
-        (std::shared_ptr<mi::Surface> const& surface) 
-        {
-            if (surface->input_area_contains(point))
-                top_surface_at_point = surface;
-        });
-    return top_surface_at_point;
+    return targets->input_surface_at(point);
 }
 
 bool is_empty(std::shared_ptr<mg::CursorImage> const& image)
@@ -243,6 +241,7 @@ void mi::CursorController::set_cursor_image_locked(std::unique_lock<std::mutex>&
 void mi::CursorController::update_cursor_image_locked(std::unique_lock<std::mutex>& lock)
 {
     auto surface = topmost_surface_containing_point(input_targets, cursor_location);
+    surface_under_cursor = surface.get();
     if (surface)
     {
         set_cursor_image_locked(lock, surface->cursor_image());
@@ -259,6 +258,33 @@ void mi::CursorController::update_cursor_image()
     update_cursor_image_locked(lock);
 }
 
+void mi::CursorController::surface_changed(mi::Surface const* surface)
+{
+    std::unique_lock<std::mutex> lock(cursor_state_guard);
+
+    // A surface that neither was nor is under the cursor can't have changed
+    // which surface is topmost there: if it had been above the surface under
+    // the cursor it would have been the one under the cursor.
+    if (surface == surface_under_cursor || surface->input_area_contains(cursor_location))
+        update_cursor_image_locked(lock);
+}
+
+void mi::CursorController::surface_removed(mi::Surface const* surface)
+{
+    std::unique_lock<std::mutex> lock(cursor_state_guard);
+
+    if (surface == surface_under_cursor)
+        update_cursor_image_locked(lock);
+}
+
+void mi::CursorController::surface_cursor_image_changed(mi::Surface const* surface)
+{
+    std::unique_lock<std::mutex> lock(cursor_state_guard);
+
+    if (surface == surface_under_cursor)
+        set_cursor_image_locked(lock, surface->cursor_image());
+}
+
 void mi::CursorController::cursor_moved_to(float abs_x, float abs_y)
 {
     auto const new_location = geom::Point{geom::X{abs_x}, geom::Y{abs_y}};
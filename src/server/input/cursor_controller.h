@@ -40,6 +40,7 @@ class Observer;
 namespace input
 {
 class Scene;
+class Surface;
 
 class CursorController : public CursorListener
 {
@@ -55,6 +56,12 @@ public:
     // in response to scene changes.
     void update_cursor_image();
 
+    // Cheaper updates for when we know which surface changed: the image only
+    // changes if the surface is (or has become) the one under the cursor.
+    void surface_changed(Surface const* surface);
+    void surface_removed(Surface const* surface);
+    void surface_cursor_image_changed(Surface const* surface);
+
 private:
     std::shared_ptr<Scene> const input_targets;
     std::shared_ptr<graphics::Cursor> const cursor;
@@ -63,9 +70,11 @@ private:
     std::mutex cursor_state_guard;
     geometry::Point cursor_location;
     std::shared_ptr<graphics::CursorImage> current_cursor;
+    // Only compared, never dereferenced: it may have been destroyed
+    Surface const* surface_under_cursor{nullptr};
 
     std::weak_ptr<scene::Observer> observer;
-    
+
 
     void update_cursor_image_locked(std::unique_lock<std::mutex>&);
     void set_cursor_image_locked(std::unique_lock<std::mutex>&, std::shared_ptr<graphics::CursorImage> const& image);
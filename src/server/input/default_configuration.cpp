@@ -31,6 +31,7 @@
 #include "default_input_manager.h"
 #include "surface_input_dispatcher.h"
 #include "basic_seat.h"
+#include "threaded_seat.h"
 #include "seat_observer_multiplexer.h"
 #include "../graphics/nested/input_platform.h"
 
@@ -248,9 +249,9 @@ mir::DefaultServerConfiguration::the_input_reading_multiplexer()
 std::shared_ptr<mi::Seat> mir::DefaultServerConfiguration::the_seat()
 {
     return seat(
-        [this]()
+        [this]() -> std::shared_ptr<mi::Seat>
         {
-            return std::make_shared<mi::BasicSeat>(
+            auto const seat = std::make_shared<mi::BasicSeat>(
                     the_input_dispatcher(),
                     the_touch_visualizer(),
                     the_cursor_listener(),
@@ -258,6 +259,11 @@ std::shared_ptr<mi::Seat> mir::DefaultServerConfiguration::the_seat()
                     the_key_mapper(),
                     the_clock(),
                     the_seat_observer());
+
+            if (the_options()->get<bool>(options::seat_dispatch_thread_opt))
+                return std::make_shared<mi::ThreadedSeat>(seat, "Mir/Seat");
+
+            return seat;
         });
 }
 
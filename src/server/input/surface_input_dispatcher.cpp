@@ -96,7 +96,7 @@ struct InputDispatcherSceneObserver :
         // TODO: Do we need to listen to this?
     }
 
-    void frame_posted(ms::Surface const*, int, mir::geometry::Size const&) override
+    void frame_posted(ms::Surface const*, int, mir::geometry::Rectangle const&) override
     {
 
     }
@@ -158,6 +158,10 @@ struct InputDispatcherSceneObserver :
     {
     }
 
+    void input_region_set_to(ms::Surface const*, std::vector<mir::geometry::Rectangle> const&) override
+    {
+    }
+
     std::function<void(ms::Surface*)> const on_removed;
     std::function<void(ms::Surface const*)> const on_surface_moved;
     std::function<void()> const on_surface_resized;
@@ -512,12 +516,7 @@ bool is_gesture_terminator(MirPointerEvent const* pev)
 
 std::shared_ptr<mi::Surface> mi::SurfaceInputDispatcher::find_target_surface(geom::Point const& point)
 {
-    std::shared_ptr<mi::Surface> top_target = nullptr;
-    scene->for_each([&top_target, &point](std::shared_ptr<mi::Surface> const& target) {
-            if (target->input_area_contains(point))
-                top_target = target;
-    });
-    return top_target;
+    return scene->input_surface_at(point);
 }
 
 void mi::SurfaceInputDispatcher::send_enter_exit_event(std::shared_ptr<mi::Surface> const& surface,
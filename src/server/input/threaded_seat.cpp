@@ -0,0 +1,271 @@
+/*
+ * Copyright © 2017 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "threaded_seat.h"
+
+#include "mir/input/device.h"
+#include "mir/input/input_sink.h"
+#include "mir/dispatch/dispatchable.h"
+#include "mir/dispatch/threaded_dispatcher.h"
+#include "mir/terminate_with_current_exception.h"
+
+#include <boost/throw_exception.hpp>
+
+#include <atomic>
+#include <functional>
+#include <future>
+#include <system_error>
+#include <thread>
+
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+namespace mi = mir::input;
+namespace md = mir::dispatch;
+
+/*
+ * A multiple producer, single consumer queue. Producers push onto an atomic
+ * list head; the consumer takes the whole list in one exchange and reverses
+ * it to recover the order in which the entries were pushed. The eventfd is
+ * only written when the list was empty, so a burst of events costs a single
+ * wakeup of the seat thread.
+ */
+class mi::ThreadedSeat::EventQueue : public md::Dispatchable
+{
+public:
+    EventQueue(std::shared_ptr<Seat> const& seat)
+        : seat{seat},
+          wakeup{eventfd(0, EFD_CLOEXEC|EFD_NONBLOCK)}
+    {
+        if (wakeup < 0)
+            BOOST_THROW_EXCEPTION((std::system_error{errno,
+                                                     std::system_category(),
+                                                     "Failed to create event fd for seat dispatch"}));
+    }
+
+    ~EventQueue()
+    {
+        discard(head.exchange(nullptr));
+    }
+
+    void push(std::shared_ptr<MirEvent> const& event, std::function<void()> const& then)
+    {
+        auto const node = new Node{event, then, nullptr};
+        auto previous = head.load(std::memory_order_relaxed);
+
+        // Once pushed the node belongs to the consumer, so only "previous" may
+        // be inspected afterwards.
+        do
+        {
+            node->next = previous;
+        }
+        while (!head.compare_exchange_weak(previous, node, std::memory_order_release, std::memory_order_relaxed));
+
+        if (!previous)
+            wake();
+    }
+
+    bool on_dispatch_thread() const
+    {
+        return dispatch_thread.load() == std::this_thread::get_id();
+    }
+
+    mir::Fd watch_fd() const override
+    {
+        return wakeup;
+    }
+
+    bool dispatch(md::FdEvents events) override
+    {
+        if (events & md::FdEvent::error)
+            return false;
+
+        if (!consume())
+            return true;
+
+        dispatch_thread = std::this_thread::get_id();
+
+        Node* ordered = nullptr;
+        for (auto node = head.exchange(nullptr, std::memory_order_acquire); node;)
+        {
+            auto const next = node->next;
+            node->next = ordered;
+            ordered = node;
+            node = next;
+        }
+
+        try
+        {
+            while (ordered)
+            {
+                std::unique_ptr<Node> const node{ordered};
+                ordered = node->next;
+
+                if (node->event)
+                    seat->dispatch_event(node->event);
+                if (node->then)
+                    node->then();
+            }
+        }
+        catch (...)
+        {
+            discard(ordered);
+            throw;
+        }
+
+        return true;
+    }
+
+    md::FdEvents relevant_events() const override
+    {
+        return md::FdEvent::readable;
+    }
+
+private:
+    struct Node
+    {
+        std::shared_ptr<MirEvent> event;
+        std::function<void()> then;
+        Node* next;
+    };
+
+    static void discard(Node* node)
+    {
+        while (node)
+        {
+            std::unique_ptr<Node> const doomed{node};
+            node = doomed->next;
+        }
+    }
+
+    bool consume()
+    {
+        uint64_t pending;
+        if (read(wakeup, &pending, sizeof pending) != sizeof pending)
+        {
+            if (errno == EAGAIN)
+                return false;
+
+            BOOST_THROW_EXCEPTION((std::system_error{errno,
+                                                     std::system_category(),
+                                                     "Failed to consume seat dispatch notification"}));
+        }
+        return true;
+    }
+
+    void wake()
+    {
+        uint64_t one{1};
+        if (write(wakeup, &one, sizeof one) != sizeof one)
+            BOOST_THROW_EXCEPTION((std::system_error{errno,
+                                                     std::system_category(),
+                                                     "Failed to wake seat dispatch"}));
+    }
+
+    std::shared_ptr<Seat> const seat;
+    mir::Fd const wakeup;
+    std::atomic<Node*> head{nullptr};
+    std::atomic<std::thread::id> dispatch_thread{};
+};
+
+mi::ThreadedSeat::ThreadedSeat(std::shared_ptr<Seat> const& seat, std::string const& thread_name)
+    : seat{seat},
+      queue{std::make_shared<EventQueue>(seat)},
+      dispatch_thread{std::make_unique<md::ThreadedDispatcher>(
+          thread_name,
+          queue,
+          []() { mir::terminate_with_current_exception(); })}
+{
+}
+
+mi::ThreadedSeat::~ThreadedSeat() = default;
+
+void mi::ThreadedSeat::flush()
+{
+    if (queue->on_dispatch_thread())
+        return;
+
+    std::promise<void> flushed;
+    queue->push(nullptr, [&flushed] { flushed.set_value(); });
+    flushed.get_future().wait();
+}
+
+void mi::ThreadedSeat::in_order(std::function<void()> const& change)
+{
+    // From the seat thread (e.g. an event filter) the change is already in order
+    if (queue->on_dispatch_thread())
+        change();
+    else
+        queue->push(nullptr, change);
+}
+
+void mi::ThreadedSeat::add_device(Device const& device)
+{
+    seat->add_device(device);
+}
+
+void mi::ThreadedSeat::remove_device(Device const& device)
+{
+    flush();
+    seat->remove_device(device);
+}
+
+void mi::ThreadedSeat::dispatch_event(std::shared_ptr<MirEvent> const& event)
+{
+    queue->push(event, {});
+}
+
+mir::EventUPtr mi::ThreadedSeat::create_device_state()
+{
+    flush();
+    return seat->create_device_state();
+}
+
+// The device outlives the call: remove_device() flushes the queue first
+void mi::ThreadedSeat::set_key_state(Device const& dev, std::vector<uint32_t> const& scan_codes)
+{
+    in_order([seat = seat, &dev, scan_codes] { seat->set_key_state(dev, scan_codes); });
+}
+
+void mi::ThreadedSeat::set_pointer_state(Device const& dev, MirPointerButtons buttons)
+{
+    in_order([seat = seat, &dev, buttons] { seat->set_pointer_state(dev, buttons); });
+}
+
+void mi::ThreadedSeat::set_cursor_position(float cursor_x, float cursor_y)
+{
+    in_order([seat = seat, cursor_x, cursor_y] { seat->set_cursor_position(cursor_x, cursor_y); });
+}
+
+void mi::ThreadedSeat::set_confinement_regions(geometry::Rectangles const& regions)
+{
+    in_order([seat = seat, regions] { seat->set_confinement_regions(regions); });
+}
+
+void mi::ThreadedSeat::reset_confinement_regions()
+{
+    in_order([seat = seat] { seat->reset_confinement_regions(); });
+}
+
+mir::geometry::Rectangle mi::ThreadedSeat::bounding_rectangle() const
+{
+    return seat->bounding_rectangle();
+}
+
+mi::OutputInfo mi::ThreadedSeat::output_info(uint32_t output_id) const
+{
+    return seat->output_info(output_id);
+}
@@ -0,0 +1,82 @@
+/*
+ * Copyright © 2017 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MIR_INPUT_THREADED_SEAT_H_
+#define MIR_INPUT_THREADED_SEAT_H_
+
+#include "mir/input/seat.h"
+
+#include <functional>
+#include <memory>
+#include <string>
+
+namespace mir
+{
+namespace dispatch
+{
+class ThreadedDispatcher;
+}
+namespace input
+{
+
+/**
+ * Runs the event processing of a seat on a dedicated thread.
+ *
+ * Events are handed over from the input reading thread through a lock-free
+ * queue, so a slow seat (hit testing, event filters, key repeat) no longer
+ * holds up reading from the devices of other seats. Events are processed in
+ * the order they were dispatched, so the ordering per device is preserved.
+ *
+ * Changes to the seat's state (key and pointer state, cursor position and
+ * confinement) are queued along with the events, so they apply after the
+ * events dispatched before them. Removing a device and creating a device
+ * state event wait for what is already queued: the seat rejects events of
+ * devices it does not know about, and the state should reflect them.
+ */
+class ThreadedSeat : public Seat
+{
+public:
+    ThreadedSeat(std::shared_ptr<Seat> const& seat, std::string const& thread_name);
+    ~ThreadedSeat();
+
+    void add_device(Device const& device) override;
+    void remove_device(Device const& device) override;
+    void dispatch_event(std::shared_ptr<MirEvent> const& event) override;
+    EventUPtr create_device_state() override;
+
+    void set_key_state(Device const& dev, std::vector<uint32_t> const& scan_codes) override;
+    void set_pointer_state(Device const& dev, MirPointerButtons buttons) override;
+    void set_cursor_position(float cursor_x, float cursor_y) override;
+    void set_confinement_regions(geometry::Rectangles const& regions) override;
+    void reset_confinement_regions() override;
+
+    geometry::Rectangle bounding_rectangle() const override;
+    input::OutputInfo output_info(uint32_t output_id) const override;
+
+private:
+    void flush();
+    void in_order(std::function<void()> const& change);
+
+    class EventQueue;
+    std::shared_ptr<Seat> const seat;
+    std::shared_ptr<EventQueue> const queue;
+    std::unique_ptr<dispatch::ThreadedDispatcher> const dispatch_thread;
+};
+
+}
+}
+
+#endif
@@ -23,6 +23,9 @@
 #include "lttng_report_factory.h"
 #include "logging_report_factory.h"
 #include "null_report_factory.h"
+#include "metrics_report_factory.h"
+#include "metrics/registry.h"
+#include "metrics/endpoint.h"
 
 #include "mir/abnormal_exit.h"
 
@@ -44,6 +47,10 @@ std::unique_ptr<mir::report::ReportFactory> mir::DefaultServerConfiguration::rep
     {
         return std::make_unique<report::LttngReportFactory>();
     }
+    else if (opt == options::metrics_opt_value)
+    {
+        return std::make_unique<report::MetricsReportFactory>(the_metrics_registry(), the_clock());
+    }
     else if (opt == options::off_opt_value)
     {
         return std::make_unique<report::NullReportFactory>();
@@ -52,12 +59,29 @@ std::unique_ptr<mir::report::ReportFactory> mir::DefaultServerConfiguration::rep
     {
         throw AbnormalExit(std::string("Invalid ") + report_opt + " option: " + opt + " (valid options are: \"" +
             options::off_opt_value + "\" and \"" + options::log_opt_value +
-                           "\" and \"" + options::lttng_opt_value + "\")");
+                           "\" and \"" + options::lttng_opt_value +
+                           "\" and \"" + options::metrics_opt_value + "\")");
     }
 }
 
+auto mir::DefaultServerConfiguration::the_metrics_registry() -> std::shared_ptr<report::metrics::Registry>
+{
+    return metrics_registry(
+        []()
+        {
+            return std::make_shared<report::metrics::Registry>();
+        });
+}
+
 std::shared_ptr<mir::report::Reports> mir::DefaultServerConfiguration::initialise_reports()
 {
+    // The endpoint serves whatever is registered, whichever reports use metrics
+    if (the_options()->is_set(options::metrics_socket_opt))
+    {
+        metrics_endpoint = std::make_shared<report::metrics::Endpoint>(
+            the_options()->get<std::string>(options::metrics_socket_opt), the_metrics_registry());
+    }
+
     return std::make_unique<report::Reports>(*this, *the_options());
 }
 
@@ -70,6 +94,15 @@ auto mir::DefaultServerConfiguration::the_compositor_report() -> std::shared_ptr
         });
 }
 
+auto mir::DefaultServerConfiguration::the_buffer_lifetime_report() -> std::shared_ptr<mc::BufferLifetimeReport>
+{
+    return buffer_lifetime_report(
+        [this]()->std::shared_ptr<mc::BufferLifetimeReport>
+        {
+            return report_factory(options::buffer_lifetime_report_opt)->create_buffer_lifetime_report();
+        });
+}
+
 auto mir::DefaultServerConfiguration::the_connector_report() -> std::shared_ptr<mf::ConnectorReport>
 {
     return connector_report(
@@ -106,6 +139,15 @@ auto mir::DefaultServerConfiguration::the_input_report() -> std::shared_ptr<mi::
         });
 }
 
+auto mir::DefaultServerConfiguration::the_memory_report() -> std::shared_ptr<ms::MemoryReport>
+{
+    return memory_report(
+        [this]()->std::shared_ptr<ms::MemoryReport>
+        {
+            return report_factory(options::memory_report_opt)->create_memory_report();
+        });
+}
+
 auto mir::DefaultServerConfiguration::the_scene_report() -> std::shared_ptr<ms::SceneReport>
 {
     return scene_report(
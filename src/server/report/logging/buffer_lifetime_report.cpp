@@ -0,0 +1,251 @@
+/*
+ * Copyright © 2017 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "buffer_lifetime_report.h"
+#include "mir/logging/logger.h"
+
+#include <cstdio>
+#include <cstring>
+
+namespace ml = mir::logging;
+namespace mrl = mir::report::logging;
+
+namespace
+{
+char const* const component = "buffer-lifetime";
+auto const min_report_interval = std::chrono::seconds(1);
+
+std::chrono::microseconds since(mir::time::Timestamp from, mir::time::Timestamp to)
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(to - from);
+}
+}
+
+void mrl::BufferLifetimeReport::Histogram::record(std::chrono::microseconds sample)
+{
+    auto const us = sample.count();
+    size_t bucket = 0;
+    while (bucket < buckets.size() - 1 && (1L << bucket) <= us)
+        ++bucket;
+
+    ++buckets[bucket];
+    ++total;
+}
+
+long mrl::BufferLifetimeReport::Histogram::percentile_us(int percent) const
+{
+    if (!total)
+        return 0;
+
+    // Report the upper bound of the bucket containing the requested rank
+    long const rank = (total * percent + 99) / 100;
+    long seen = 0;
+    for (size_t bucket = 0; bucket != buckets.size(); ++bucket)
+    {
+        seen += buckets[bucket];
+        if (seen >= rank)
+            return 1L << bucket;
+    }
+
+    return 1L << (buckets.size() - 1);
+}
+
+void mrl::BufferLifetimeReport::Histogram::clear()
+{
+    buckets.fill(0);
+    total = 0;
+}
+
+mrl::BufferLifetimeReport::BufferLifetimeReport(
+    std::shared_ptr<ml::Logger> const& logger,
+    std::shared_ptr<time::Clock> const& clock) :
+    logger{logger},
+    clock{clock},
+    last_report{clock->now()}
+{
+}
+
+void mrl::BufferLifetimeReport::buffer_submitted(StreamId stream, graphics::BufferID buffer)
+{
+    auto const now = clock->now();
+    std::vector<std::string> summaries;
+
+    {
+        std::lock_guard<std::mutex> lock{mutex};
+        auto& s = streams[stream];
+        auto& b = s.buffers[buffer.as_value()];
+
+        if (b.released_since_submit)
+            s.turnaround.record(since(b.released, now));
+
+        b.submitted = now;
+        b.acquired_since_submit = false;
+        b.released_since_submit = false;
+
+        if (++s.queue_depth > s.max_queue_depth)
+            s.max_queue_depth = s.queue_depth;
+
+        summaries = summarise_if_due(now);
+    }
+
+    log(summaries);
+}
+
+void mrl::BufferLifetimeReport::buffer_acquired(
+    StreamId stream, graphics::BufferID buffer, compositor::CompositorID)
+{
+    auto const now = clock->now();
+    std::vector<std::string> summaries;
+
+    {
+        std::lock_guard<std::mutex> lock{mutex};
+        auto& s = streams[stream];
+        auto& b = s.buffers[buffer.as_value()];
+
+        // Only the first compositor to see a buffer takes it off the queue
+        if (!b.acquired_since_submit)
+        {
+            b.acquired = now;
+            b.acquired_since_submit = true;
+            s.queued.record(since(b.submitted, now));
+            if (s.queue_depth > 0)
+                --s.queue_depth;
+        }
+
+        summaries = summarise_if_due(now);
+    }
+
+    log(summaries);
+}
+
+void mrl::BufferLifetimeReport::buffer_released(StreamId stream, graphics::BufferID buffer)
+{
+    auto const now = clock->now();
+    std::vector<std::string> summaries;
+
+    {
+        std::lock_guard<std::mutex> lock{mutex};
+        auto const s = streams.find(stream);
+        if (s == streams.end())
+            return;
+
+        auto& b = s->second.buffers[buffer.as_value()];
+
+        if (b.acquired_since_submit)
+        {
+            s->second.held.record(since(b.acquired, now));
+        }
+        else if (s->second.queue_depth > 0)
+        {
+            // Dropped without ever reaching a compositor
+            --s->second.queue_depth;
+        }
+
+        b.released = now;
+        b.released_since_submit = true;
+
+        summaries = summarise_if_due(now);
+    }
+
+    log(summaries);
+}
+
+void mrl::BufferLifetimeReport::stream_destroyed(StreamId stream)
+{
+    std::lock_guard<std::mutex> lock{mutex};
+    streams.erase(stream);
+}
+
+void mrl::BufferLifetimeReport::frame_interval_changed(StreamId stream, std::chrono::milliseconds interval)
+{
+    char msg[128];
+    if (interval.count())
+        snprintf(msg, sizeof msg, "Stream %p: frame rate limited to one frame per %ld ms",
+                 stream, static_cast<long>(interval.count()));
+    else
+        snprintf(msg, sizeof msg, "Stream %p: frame rate unlimited", stream);
+
+    logger->log(ml::Severity::informational, msg, component);
+}
+
+void mrl::BufferLifetimeReport::buffer_deferred(StreamId stream, graphics::BufferID)
+{
+    auto const now = clock->now();
+    std::vector<std::string> summaries;
+
+    {
+        std::lock_guard<std::mutex> lock{mutex};
+        ++streams[stream].deferred;
+
+        summaries = summarise_if_due(now);
+    }
+
+    log(summaries);
+}
+
+auto mrl::BufferLifetimeReport::summarise_if_due(TimePoint now) -> std::vector<std::string>
+{
+    std::vector<std::string> summaries;
+
+    if (now - last_report < min_report_interval)
+        return summaries;
+
+    last_report = now;
+
+    for (auto& s : streams)
+        s.second.summarise(s.first, summaries);
+
+    return summaries;
+}
+
+void mrl::BufferLifetimeReport::log(std::vector<std::string> const& summaries) const
+{
+    for (auto const& summary : summaries)
+        logger->log(ml::Severity::informational, summary, component);
+}
+
+void mrl::BufferLifetimeReport::StreamState::summarise(StreamId id, std::vector<std::string>& summaries)
+{
+    if (queued.count() || held.count() || turnaround.count() || deferred)
+    {
+        char msg[320];
+        snprintf(msg, sizeof msg, "Stream %p: %ld frames, "
+                 "queued p50/p99 %ld/%ld us, "
+                 "held p50/p99 %ld/%ld us, "
+                 "client turnaround p50/p99 %ld/%ld us, "
+                 "max queue depth %d",
+                 id,
+                 queued.count(),
+                 queued.percentile_us(50), queued.percentile_us(99),
+                 held.percentile_us(50), held.percentile_us(99),
+                 turnaround.percentile_us(50), turnaround.percentile_us(99),
+                 max_queue_depth);
+
+        if (deferred)
+        {
+            auto const len = strlen(msg);
+            snprintf(msg + len, sizeof msg - len, ", %ld deferred by frame rate limit", deferred);
+        }
+
+        summaries.emplace_back(msg);
+    }
+
+    queued.clear();
+    held.clear();
+    turnaround.clear();
+    max_queue_depth = queue_depth;
+    deferred = 0;
+}
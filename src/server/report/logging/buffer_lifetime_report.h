@@ -0,0 +1,121 @@
+/*
+ * Copyright © 2017 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MIR_REPORT_LOGGING_BUFFER_LIFETIME_REPORT_H_
+#define MIR_REPORT_LOGGING_BUFFER_LIFETIME_REPORT_H_
+
+#include "mir/compositor/buffer_lifetime_report.h"
+#include "mir/time/clock.h"
+
+#include <array>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace mir
+{
+namespace logging
+{
+class Logger;
+}
+namespace report
+{
+namespace logging
+{
+
+/**
+ * Accumulates per-stream histograms of buffer latencies and logs their
+ * percentiles at most once a second:
+ *  - queued:     submit -> first compositor acquire
+ *  - held:       first compositor acquire -> release to the client
+ *  - turnaround: release to the client -> next submit of the same buffer
+ *
+ * Changes to a stream's frame rate limit are logged as they happen, and the
+ * periodic summary counts the frames that limit deferred.
+ */
+class BufferLifetimeReport : public compositor::BufferLifetimeReport
+{
+public:
+    BufferLifetimeReport(
+        std::shared_ptr<mir::logging::Logger> const& logger,
+        std::shared_ptr<time::Clock> const& clock);
+
+    void buffer_submitted(StreamId stream, graphics::BufferID buffer) override;
+    void buffer_acquired(StreamId stream, graphics::BufferID buffer, compositor::CompositorID compositor) override;
+    void buffer_released(StreamId stream, graphics::BufferID buffer) override;
+    void stream_destroyed(StreamId stream) override;
+    void frame_interval_changed(StreamId stream, std::chrono::milliseconds interval) override;
+    void buffer_deferred(StreamId stream, graphics::BufferID buffer) override;
+
+private:
+    typedef time::Timestamp TimePoint;
+
+    // Power-of-two microsecond buckets; the last bucket catches everything >= 2^30us
+    class Histogram
+    {
+    public:
+        void record(std::chrono::microseconds sample);
+        long percentile_us(int percent) const;
+        long count() const { return total; }
+        void clear();
+
+    private:
+        std::array<long, 31> buckets{};
+        long total = 0;
+    };
+
+    struct BufferState
+    {
+        TimePoint submitted;
+        TimePoint acquired;
+        TimePoint released;
+        bool acquired_since_submit = false;
+        bool released_since_submit = false;
+    };
+
+    struct StreamState
+    {
+        std::unordered_map<uint32_t, BufferState> buffers;
+        int queue_depth = 0;
+        int max_queue_depth = 0;
+        long deferred = 0;
+        Histogram queued;
+        Histogram held;
+        Histogram turnaround;
+
+        // Appends the summary since the last report (if any) and starts afresh
+        void summarise(StreamId id, std::vector<std::string>& summaries);
+    };
+
+    // Called with the mutex held: the summaries are logged once it is released
+    auto summarise_if_due(TimePoint now) -> std::vector<std::string>;
+    void log(std::vector<std::string> const& summaries) const;
+
+    std::shared_ptr<mir::logging::Logger> const logger;
+    std::shared_ptr<time::Clock> const clock;
+
+    std::mutex mutex; // Protects the following...
+    std::unordered_map<StreamId, StreamState> streams;
+    TimePoint last_report;
+};
+
+}
+}
+}
+
+#endif // MIR_REPORT_LOGGING_BUFFER_LIFETIME_REPORT_H_
@@ -192,3 +192,20 @@ void mrl::DisplayReport::report_vsync(unsigned int output_id,
     }
     prev_frame[output_id] = frame;
 }
+
+void mrl::DisplayReport::report_render_time(
+    unsigned int output_id,
+    std::chrono::microseconds predicted,
+    std::chrono::microseconds actual)
+{
+    // long long to match printf format on all architectures
+    long long const predicted_us = predicted.count(),
+                    actual_us = actual.count();
+
+    logger->log(component(), ml::Severity::informational,
+        "render time on %u: %lld.%03lldms, predicted %lld.%03lldms%s",
+        output_id,
+        actual_us/1000, actual_us%1000,
+        predicted_us/1000, predicted_us%1000,
+        actual > predicted ? " (missed)" : "");
+}
@@ -56,6 +56,10 @@ class DisplayReport : public graphics::DisplayReport
     virtual void report_successful_drm_mode_set_crtc_on_construction() override;
     virtual void report_successful_display_construction() override;
     virtual void report_vsync(unsigned int output_id, graphics::Frame const&) override;
+    virtual void report_render_time(
+        unsigned int output_id,
+        std::chrono::microseconds predicted,
+        std::chrono::microseconds actual) override;
     virtual void report_drm_master_failure(int error) override;
     virtual void report_vt_switch_away_failure() override;
     virtual void report_vt_switch_back_failure() override;
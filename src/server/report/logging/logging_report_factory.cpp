@@ -19,10 +19,12 @@
 #include "../logging_report_factory.h"
 
 #include "compositor_report.h"
+#include "buffer_lifetime_report.h"
 #include "connector_report.h"
 #include "display_report.h"
 #include "message_processor_report.h"
 #include "scene_report.h"
+#include "memory_report.h"
 #include "session_mediator_report.h"
 #include "shell_report.h"
 #include "input_report.h"
@@ -45,6 +47,11 @@ std::shared_ptr<mir::compositor::CompositorReport> mr::LoggingReportFactory::cre
     return std::make_shared<logging::CompositorReport>(logger, clock);
 }
 
+std::shared_ptr<mir::compositor::BufferLifetimeReport> mr::LoggingReportFactory::create_buffer_lifetime_report()
+{
+    return std::make_shared<logging::BufferLifetimeReport>(logger, clock);
+}
+
 std::shared_ptr<mir::graphics::DisplayReport> mr::LoggingReportFactory::create_display_report()
 {
     return std::make_shared<logging::DisplayReport>(logger);
@@ -55,6 +62,11 @@ std::shared_ptr<mir::scene::SceneReport> mr::LoggingReportFactory::create_scene_
     return std::make_shared<logging::SceneReport>(logger);
 }
 
+std::shared_ptr<mir::scene::MemoryReport> mr::LoggingReportFactory::create_memory_report()
+{
+    return std::make_shared<logging::MemoryReport>(logger, clock);
+}
+
 std::shared_ptr<mir::frontend::ConnectorReport> mr::LoggingReportFactory::create_connector_report()
 {
     return std::make_shared<logging::ConnectorReport>(logger);
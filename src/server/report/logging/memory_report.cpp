@@ -0,0 +1,113 @@
+/*
+ * Copyright © 2017 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "memory_report.h"
+#include "mir/logging/logger.h"
+
+#include <cstdio>
+
+namespace ml = mir::logging;
+namespace mrl = mir::report::logging;
+
+namespace
+{
+char const* const component = "memory";
+auto const min_report_interval = std::chrono::seconds(1);
+
+unsigned long in_kib(size_t bytes)
+{
+    return (bytes + 1023) / 1024;
+}
+}
+
+mrl::MemoryReport::MemoryReport(
+    std::shared_ptr<ml::Logger> const& logger,
+    std::shared_ptr<time::Clock> const& clock) :
+    logger{logger},
+    clock{clock},
+    last_report{clock->now()}
+{
+}
+
+void mrl::MemoryReport::owner_created(Owner owner, Owner parent, std::string const& name)
+{
+    std::lock_guard<std::mutex> lock{mutex};
+    update(usage.owner_created(owner, parent, name));
+}
+
+void mrl::MemoryReport::owner_destroyed(Owner owner)
+{
+    std::lock_guard<std::mutex> lock{mutex};
+    update(usage.owner_destroyed(owner));
+}
+
+void mrl::MemoryReport::allocated(Owner owner, Category category, size_t bytes)
+{
+    std::lock_guard<std::mutex> lock{mutex};
+    update(usage.allocated(owner, category, bytes));
+}
+
+void mrl::MemoryReport::released(Owner owner, Category category, size_t bytes)
+{
+    std::lock_guard<std::mutex> lock{mutex};
+    update(usage.released(owner, category, bytes));
+}
+
+void mrl::MemoryReport::update(MemoryUsage::Usage const* changed)
+{
+    if (changed)
+    {
+        if (changed->closed)
+        {
+            changed_since_report.erase(changed->id);
+            log(*changed, "closed");
+        }
+        else
+        {
+            changed_since_report.insert(changed->id);
+        }
+    }
+
+    auto const now = clock->now();
+    if (changed_since_report.empty() || now - last_report < min_report_interval)
+        return;
+
+    last_report = now;
+
+    usage.for_each([this](MemoryUsage::Usage const& session)
+        {
+            if (changed_since_report.count(session.id))
+                log(session, "holds");
+        });
+
+    changed_since_report.clear();
+}
+
+void mrl::MemoryReport::log(MemoryUsage::Usage const& session, char const* event)
+{
+    using Category = MemoryUsage::Category;
+
+    char msg[256];
+    snprintf(msg, sizeof msg, "\"%s\" (#%u) %s %lu KiB: "
+             "%lu KiB client buffers, %lu KiB textures, %lu KiB snapshots",
+             session.name.c_str(), session.id, event,
+             in_kib(session.total()),
+             in_kib(session.bytes[static_cast<size_t>(Category::client_buffers)]),
+             in_kib(session.bytes[static_cast<size_t>(Category::textures)]),
+             in_kib(session.bytes[static_cast<size_t>(Category::snapshots)]));
+
+    logger->log(ml::Severity::informational, msg, component);
+}
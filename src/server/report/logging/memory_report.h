@@ -0,0 +1,72 @@
+/*
+ * Copyright © 2017 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MIR_REPORT_LOGGING_MEMORY_REPORT_H_
+#define MIR_REPORT_LOGGING_MEMORY_REPORT_H_
+
+#include "mir/scene/memory_report.h"
+#include "mir/time/clock.h"
+#include "../memory_usage.h"
+
+#include <memory>
+#include <mutex>
+#include <unordered_set>
+
+namespace mir
+{
+namespace logging
+{
+class Logger;
+}
+namespace report
+{
+namespace logging
+{
+
+/**
+ * Logs, at most once a second, the memory held for each session whose usage
+ * has changed since it was last logged.
+ */
+class MemoryReport : public scene::MemoryReport
+{
+public:
+    MemoryReport(
+        std::shared_ptr<mir::logging::Logger> const& logger,
+        std::shared_ptr<time::Clock> const& clock);
+
+    void owner_created(Owner owner, Owner parent, std::string const& name) override;
+    void owner_destroyed(Owner owner) override;
+    void allocated(Owner owner, Category category, size_t bytes) override;
+    void released(Owner owner, Category category, size_t bytes) override;
+
+private:
+    void update(MemoryUsage::Usage const* changed);
+    void log(MemoryUsage::Usage const& session, char const* event);
+
+    std::shared_ptr<mir::logging::Logger> const logger;
+    std::shared_ptr<time::Clock> const clock;
+
+    std::mutex mutex; // Protects the following...
+    MemoryUsage usage;
+    std::unordered_set<unsigned> changed_since_report;
+    time::Timestamp last_report;
+};
+
+}
+}
+}
+
+#endif // MIR_REPORT_LOGGING_MEMORY_REPORT_H_
@@ -41,8 +41,10 @@ public:
     LoggingReportFactory(std::shared_ptr<mir::logging::Logger> const& logger,
                          std::shared_ptr<time::Clock> const& clock);
     std::shared_ptr<compositor::CompositorReport> create_compositor_report() override;
+    std::shared_ptr<compositor::BufferLifetimeReport> create_buffer_lifetime_report() override;
     std::shared_ptr<graphics::DisplayReport> create_display_report() override;
     std::shared_ptr<scene::SceneReport> create_scene_report() override;
+    std::shared_ptr<scene::MemoryReport> create_memory_report() override;
     std::shared_ptr<frontend::ConnectorReport> create_connector_report() override;
     std::shared_ptr<frontend::SessionMediatorObserver> create_session_mediator_report() override;
     std::shared_ptr<frontend::MessageProcessorReport> create_message_processor_report() override;
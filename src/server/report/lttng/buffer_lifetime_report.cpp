@@ -0,0 +1,56 @@
+/*
+ * Copyright © 2017 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "buffer_lifetime_report.h"
+
+#include "mir/report/lttng/mir_tracepoint.h"
+
+#define TRACEPOINT_DEFINE
+#define TRACEPOINT_PROBE_DYNAMIC_LINKAGE
+#include "buffer_lifetime_report_tp.h"
+
+namespace mrl = mir::report::lttng;
+
+void mrl::BufferLifetimeReport::buffer_submitted(StreamId stream, graphics::BufferID buffer)
+{
+    mir_tracepoint(mir_server_buffer_lifetime, buffer_submitted, stream, buffer.as_value());
+}
+
+void mrl::BufferLifetimeReport::buffer_acquired(
+    StreamId stream, graphics::BufferID buffer, compositor::CompositorID compositor)
+{
+    mir_tracepoint(mir_server_buffer_lifetime, buffer_acquired, stream, buffer.as_value(), compositor);
+}
+
+void mrl::BufferLifetimeReport::buffer_released(StreamId stream, graphics::BufferID buffer)
+{
+    mir_tracepoint(mir_server_buffer_lifetime, buffer_released, stream, buffer.as_value());
+}
+
+void mrl::BufferLifetimeReport::stream_destroyed(StreamId stream)
+{
+    mir_tracepoint(mir_server_buffer_lifetime, stream_destroyed, stream);
+}
+
+void mrl::BufferLifetimeReport::frame_interval_changed(StreamId stream, std::chrono::milliseconds interval)
+{
+    mir_tracepoint(mir_server_buffer_lifetime, frame_interval_changed, stream, interval.count());
+}
+
+void mrl::BufferLifetimeReport::buffer_deferred(StreamId stream, graphics::BufferID buffer)
+{
+    mir_tracepoint(mir_server_buffer_lifetime, buffer_deferred, stream, buffer.as_value());
+}
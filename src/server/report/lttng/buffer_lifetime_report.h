@@ -0,0 +1,49 @@
+/*
+ * Copyright © 2017 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MIR_REPORT_LTTNG_BUFFER_LIFETIME_REPORT_H_
+#define MIR_REPORT_LTTNG_BUFFER_LIFETIME_REPORT_H_
+
+#include "server_tracepoint_provider.h"
+
+#include "mir/compositor/buffer_lifetime_report.h"
+
+namespace mir
+{
+namespace report
+{
+namespace lttng
+{
+
+class BufferLifetimeReport : public compositor::BufferLifetimeReport
+{
+public:
+    void buffer_submitted(StreamId stream, graphics::BufferID buffer) override;
+    void buffer_acquired(StreamId stream, graphics::BufferID buffer, compositor::CompositorID compositor) override;
+    void buffer_released(StreamId stream, graphics::BufferID buffer) override;
+    void stream_destroyed(StreamId stream) override;
+    void frame_interval_changed(StreamId stream, std::chrono::milliseconds interval) override;
+    void buffer_deferred(StreamId stream, graphics::BufferID buffer) override;
+
+private:
+    ServerTracepointProvider tp_provider;
+};
+
+}
+}
+}
+
+#endif // MIR_REPORT_LTTNG_BUFFER_LIFETIME_REPORT_H_
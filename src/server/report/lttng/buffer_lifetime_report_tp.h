@@ -0,0 +1,91 @@
+/*
+ * Copyright © 2017 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#undef TRACEPOINT_PROVIDER
+#define TRACEPOINT_PROVIDER mir_server_buffer_lifetime
+
+#undef TRACEPOINT_INCLUDE
+#define TRACEPOINT_INCLUDE "./buffer_lifetime_report_tp.h"
+
+#if !defined(MIR_LTTNG_BUFFER_LIFETIME_REPORT_TP_H_) || defined(TRACEPOINT_HEADER_MULTI_READ)
+#define MIR_LTTNG_BUFFER_LIFETIME_REPORT_TP_H_
+
+#include "lttng_utils.h"
+
+TRACEPOINT_EVENT_CLASS(
+    mir_server_buffer_lifetime,
+    stream_buffer_event,
+    TP_ARGS(void const*, stream, uint32_t, buffer_id),
+    TP_FIELDS(
+        ctf_integer_hex(uintptr_t, stream, (uintptr_t)(stream))
+        ctf_integer(uint32_t, buffer_id, buffer_id)
+    )
+)
+
+TRACEPOINT_EVENT_INSTANCE(
+    mir_server_buffer_lifetime,
+    stream_buffer_event,
+    buffer_submitted,
+    TP_ARGS(void const*, stream, uint32_t, buffer_id)
+)
+
+TRACEPOINT_EVENT_INSTANCE(
+    mir_server_buffer_lifetime,
+    stream_buffer_event,
+    buffer_released,
+    TP_ARGS(void const*, stream, uint32_t, buffer_id)
+)
+
+TRACEPOINT_EVENT_INSTANCE(
+    mir_server_buffer_lifetime,
+    stream_buffer_event,
+    buffer_deferred,
+    TP_ARGS(void const*, stream, uint32_t, buffer_id)
+)
+
+TRACEPOINT_EVENT(
+    mir_server_buffer_lifetime,
+    buffer_acquired,
+    TP_ARGS(void const*, stream, uint32_t, buffer_id, void const*, compositor),
+    TP_FIELDS(
+        ctf_integer_hex(uintptr_t, stream, (uintptr_t)(stream))
+        ctf_integer(uint32_t, buffer_id, buffer_id)
+        ctf_integer_hex(uintptr_t, compositor, (uintptr_t)(compositor))
+    )
+)
+
+TRACEPOINT_EVENT(
+    mir_server_buffer_lifetime,
+    stream_destroyed,
+    TP_ARGS(void const*, stream),
+    TP_FIELDS(
+        ctf_integer_hex(uintptr_t, stream, (uintptr_t)(stream))
+    )
+)
+
+TRACEPOINT_EVENT(
+    mir_server_buffer_lifetime,
+    frame_interval_changed,
+    TP_ARGS(void const*, stream, long, interval_ms),
+    TP_FIELDS(
+        ctf_integer_hex(uintptr_t, stream, (uintptr_t)(stream))
+        ctf_integer(long, interval_ms, interval_ms)
+    )
+)
+
+#endif /* MIR_LTTNG_BUFFER_LIFETIME_REPORT_TP_H_ */
+
+#include <lttng/tracepoint-event.h>
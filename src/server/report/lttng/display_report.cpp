@@ -52,3 +52,11 @@ void mir::report::lttng::DisplayReport::report_vsync(unsigned int output_id,
 {
     mir_tracepoint(mir_server_display, report_vsync, output_id);
 }
+
+void mir::report::lttng::DisplayReport::report_render_time(
+    unsigned int output_id,
+    std::chrono::microseconds predicted,
+    std::chrono::microseconds actual)
+{
+    mir_tracepoint(mir_server_display, report_render_time, output_id, predicted.count(), actual.count());
+}
@@ -46,6 +46,10 @@ public:
     virtual void report_vt_switch_away_failure() override;
     virtual void report_vt_switch_back_failure() override;
     virtual void report_vsync(unsigned int output_id, graphics::Frame const&) override;
+    virtual void report_render_time(
+        unsigned int output_id,
+        std::chrono::microseconds predicted,
+        std::chrono::microseconds actual) override;
 
 private:
     ServerTracepointProvider tp_provider;
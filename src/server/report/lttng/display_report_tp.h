@@ -71,6 +71,17 @@ TRACEPOINT_EVENT(
      )
 )
 
+TRACEPOINT_EVENT(
+    mir_server_display,
+    report_render_time,
+    TP_ARGS(int, id, int64_t, predicted_us, int64_t, actual_us),
+    TP_FIELDS(
+        ctf_integer(int, id, id)
+        ctf_integer(int64_t, predicted_us, predicted_us)
+        ctf_integer(int64_t, actual_us, actual_us)
+     )
+)
+
 #endif /* MIR_LTTNG_DISPLAY_REPORT_TP_H_ */
 
 #include <lttng/tracepoint-event.h>
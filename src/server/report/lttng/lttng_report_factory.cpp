@@ -19,11 +19,13 @@
 #include "../lttng_report_factory.h"
 
 #include "compositor_report.h"
+#include "buffer_lifetime_report.h"
 #include "connector_report.h"
 #include "display_report.h"
 #include "input_report.h"
 #include "message_processor_report.h"
 #include "scene_report.h"
+#include "memory_report.h"
 #include "session_mediator_report.h"
 #include "shared_library_prober_report.h"
 
@@ -32,6 +34,11 @@ std::shared_ptr<mir::compositor::CompositorReport> mir::report::LttngReportFacto
     return std::make_shared<lttng::CompositorReport>();
 }
 
+std::shared_ptr<mir::compositor::BufferLifetimeReport> mir::report::LttngReportFactory::create_buffer_lifetime_report()
+{
+    return std::make_shared<lttng::BufferLifetimeReport>();
+}
+
 std::shared_ptr<mir::graphics::DisplayReport> mir::report::LttngReportFactory::create_display_report()
 {
     return std::make_shared<lttng::DisplayReport>();
@@ -42,6 +49,11 @@ std::shared_ptr<mir::scene::SceneReport> mir::report::LttngReportFactory::create
     return std::make_shared<lttng::SceneReport>();
 }
 
+std::shared_ptr<mir::scene::MemoryReport> mir::report::LttngReportFactory::create_memory_report()
+{
+    return std::make_shared<lttng::MemoryReport>();
+}
+
 std::shared_ptr<mir::frontend::ConnectorReport> mir::report::LttngReportFactory::create_connector_report()
 {
     return std::make_shared<lttng::ConnectorReport>();
@@ -0,0 +1,45 @@
+/*
+ * Copyright © 2017 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "memory_report.h"
+
+#include "mir/report/lttng/mir_tracepoint.h"
+
+#define TRACEPOINT_DEFINE
+#define TRACEPOINT_PROBE_DYNAMIC_LINKAGE
+#include "memory_report_tp.h"
+
+namespace mrl = mir::report::lttng;
+
+void mrl::MemoryReport::owner_created(Owner owner, Owner parent, std::string const& name)
+{
+    mir_tracepoint(mir_server_memory, owner_created, owner, parent, name.c_str());
+}
+
+void mrl::MemoryReport::owner_destroyed(Owner owner)
+{
+    mir_tracepoint(mir_server_memory, owner_destroyed, owner);
+}
+
+void mrl::MemoryReport::allocated(Owner owner, Category category, size_t bytes)
+{
+    mir_tracepoint(mir_server_memory, allocated, owner, static_cast<int>(category), bytes);
+}
+
+void mrl::MemoryReport::released(Owner owner, Category category, size_t bytes)
+{
+    mir_tracepoint(mir_server_memory, released, owner, static_cast<int>(category), bytes);
+}
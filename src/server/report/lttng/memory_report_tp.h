@@ -0,0 +1,75 @@
+/*
+ * Copyright © 2017 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#undef TRACEPOINT_PROVIDER
+#define TRACEPOINT_PROVIDER mir_server_memory
+
+#undef TRACEPOINT_INCLUDE
+#define TRACEPOINT_INCLUDE "./memory_report_tp.h"
+
+#if !defined(MIR_LTTNG_MEMORY_REPORT_TP_H_) || defined(TRACEPOINT_HEADER_MULTI_READ)
+#define MIR_LTTNG_MEMORY_REPORT_TP_H_
+
+#include "lttng_utils.h"
+
+TRACEPOINT_EVENT(
+    mir_server_memory,
+    owner_created,
+    TP_ARGS(void const*, owner, void const*, parent, char const*, name),
+    TP_FIELDS(
+        ctf_integer_hex(uintptr_t, owner, (uintptr_t)(owner))
+        ctf_integer_hex(uintptr_t, parent, (uintptr_t)(parent))
+        ctf_string(name, name)
+    )
+)
+
+TRACEPOINT_EVENT(
+    mir_server_memory,
+    owner_destroyed,
+    TP_ARGS(void const*, owner),
+    TP_FIELDS(
+        ctf_integer_hex(uintptr_t, owner, (uintptr_t)(owner))
+    )
+)
+
+TRACEPOINT_EVENT_CLASS(
+    mir_server_memory,
+    memory_event,
+    TP_ARGS(void const*, owner, int, category, uint64_t, bytes),
+    TP_FIELDS(
+        ctf_integer_hex(uintptr_t, owner, (uintptr_t)(owner))
+        ctf_integer(int, category, category)
+        ctf_integer(uint64_t, bytes, bytes)
+    )
+)
+
+TRACEPOINT_EVENT_INSTANCE(
+    mir_server_memory,
+    memory_event,
+    allocated,
+    TP_ARGS(void const*, owner, int, category, uint64_t, bytes)
+)
+
+TRACEPOINT_EVENT_INSTANCE(
+    mir_server_memory,
+    memory_event,
+    released,
+    TP_ARGS(void const*, owner, int, category, uint64_t, bytes)
+)
+
+#endif /* MIR_LTTNG_MEMORY_REPORT_TP_H_ */
+
+#include <lttng/tracepoint-event.h>
@@ -50,3 +50,21 @@ void mrl::SharedLibraryProberReport::loading_failed(bf::path const& filename, st
     mir_tracepoint(mir_server_shared_library_prober, loading_failed,
                    filename.string().c_str(), error.what());
 }
+
+void mrl::SharedLibraryProberReport::loading_finished(bf::path const& path, std::chrono::nanoseconds elapsed)
+{
+    mir_tracepoint(mir_server_shared_library_prober, loading_finished,
+                   path.string().c_str(), elapsed.count());
+}
+
+void mrl::SharedLibraryProberReport::probed_module(bf::path const& filename, std::chrono::nanoseconds elapsed)
+{
+    mir_tracepoint(mir_server_shared_library_prober, probed_module,
+                   filename.string().c_str(), elapsed.count());
+}
+
+void mrl::SharedLibraryProberReport::selected_module(bf::path const& filename, bool from_cache, std::chrono::nanoseconds elapsed)
+{
+    mir_tracepoint(mir_server_shared_library_prober, selected_module,
+                   filename.string().c_str(), from_cache, elapsed.count());
+}
@@ -36,6 +36,10 @@ public:
     void probing_failed(boost::filesystem::path const& path, std::exception const& error) override;
     void loading_library(boost::filesystem::path const& filename) override;
     void loading_failed(boost::filesystem::path const& filename, std::exception const& error) override;
+    void loading_finished(boost::filesystem::path const& path, std::chrono::nanoseconds elapsed) override;
+    void probed_module(boost::filesystem::path const& filename, std::chrono::nanoseconds elapsed) override;
+    void selected_module(
+        boost::filesystem::path const& filename, bool from_cache, std::chrono::nanoseconds elapsed) override;
 
 private:
     ServerTracepointProvider tp_provider;
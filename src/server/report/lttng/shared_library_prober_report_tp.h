@@ -65,6 +65,37 @@ TRACEPOINT_EVENT(
     )
 )
 
+TRACEPOINT_EVENT(
+    mir_server_shared_library_prober,
+    loading_finished,
+    TP_ARGS(const char*, path, int64_t, elapsed_ns),
+    TP_FIELDS(
+        ctf_string(path, path)
+        ctf_integer(int64_t, elapsed_ns, elapsed_ns)
+    )
+)
+
+TRACEPOINT_EVENT(
+    mir_server_shared_library_prober,
+    probed_module,
+    TP_ARGS(const char*, path, int64_t, elapsed_ns),
+    TP_FIELDS(
+        ctf_string(path, path)
+        ctf_integer(int64_t, elapsed_ns, elapsed_ns)
+    )
+)
+
+TRACEPOINT_EVENT(
+    mir_server_shared_library_prober,
+    selected_module,
+    TP_ARGS(const char*, path, int, from_cache, int64_t, elapsed_ns),
+    TP_FIELDS(
+        ctf_string(path, path)
+        ctf_integer(int, from_cache, from_cache)
+        ctf_integer(int64_t, elapsed_ns, elapsed_ns)
+    )
+)
+
 #endif /* MIR_LTTNG_SHARED_LIBRARY_PROBER_REPORT_TP_H_ */
 
 #include <lttng/tracepoint-event.h>
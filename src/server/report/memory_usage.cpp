@@ -0,0 +1,146 @@
+/*
+ * Copyright © 2017 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "memory_usage.h"
+
+#include <algorithm>
+
+namespace mr = mir::report;
+
+char const* mr::MemoryUsage::name_of(Category category)
+{
+    switch (category)
+    {
+    case Category::client_buffers: return "client_buffers";
+    case Category::textures: return "textures";
+    case Category::snapshots: return "snapshots";
+    }
+
+    return "unknown";
+}
+
+size_t mr::MemoryUsage::Usage::total() const
+{
+    size_t result{0};
+    for (auto const b : bytes)
+        result += b;
+    return result;
+}
+
+mr::MemoryUsage::MemoryUsage() :
+    unattributed{"unattributed", 0, {}, false}
+{
+}
+
+auto mr::MemoryUsage::owner_created(Owner owner, Owner parent, std::string const& name) -> Usage const*
+{
+    // The owner's address may have been reused without us hearing it was destroyed
+    owner_destroyed(owner);
+
+    auto const p = parent ? owners.find(parent) : owners.end();
+
+    if (p != owners.end())
+    {
+        owners[owner] = OwnerState{p->second.session, {}, false};
+        return nullptr;
+    }
+
+    owners[owner] = OwnerState{owner, {}, false};
+    auto& usage = sessions[owner];
+    usage = Usage{name, next_id++, {}, false};
+    return &usage;
+}
+
+auto mr::MemoryUsage::owner_destroyed(Owner owner) -> Usage const*
+{
+    auto const o = owners.find(owner);
+    if (o == owners.end())
+        return nullptr;
+
+    if (o->second.session != owner)
+    {
+        // Whatever it still holds is no longer the session's doing
+        auto& usage = usage_of(o->second);
+        for (size_t c = 0; c != category_count; ++c)
+            usage.bytes[c] -= std::min(usage.bytes[c], o->second.bytes[c]);
+
+        owners.erase(o);
+        return &usage;
+    }
+
+    for (auto i = owners.begin(); i != owners.end();)
+    {
+        if (i->second.session == owner)
+            i = owners.erase(i);
+        else
+            ++i;
+    }
+
+    auto const s = sessions.find(owner);
+    last_closed = std::move(s->second);
+    last_closed.closed = true;
+    sessions.erase(s);
+    return &last_closed;
+}
+
+auto mr::MemoryUsage::allocated(Owner owner, Category category, size_t bytes) -> Usage const*
+{
+    auto o = owners.find(owner);
+    if (o == owners.end())
+        o = owners.emplace(owner, OwnerState{nullptr, {}, true}).first;
+
+    auto const c = static_cast<size_t>(category);
+    o->second.bytes[c] += bytes;
+
+    auto& usage = usage_of(o->second);
+    usage.bytes[c] += bytes;
+    return &usage;
+}
+
+auto mr::MemoryUsage::released(Owner owner, Category category, size_t bytes) -> Usage const*
+{
+    auto const o = owners.find(owner);
+    if (o == owners.end())
+        return nullptr;
+
+    auto const c = static_cast<size_t>(category);
+    auto const freed = std::min(bytes, o->second.bytes[c]);
+    o->second.bytes[c] -= freed;
+
+    auto& usage = usage_of(o->second);
+    usage.bytes[c] -= std::min(usage.bytes[c], freed);
+
+    if (o->second.implicit &&
+        std::all_of(begin(o->second.bytes), end(o->second.bytes), [](size_t b) { return b == 0; }))
+    {
+        owners.erase(o);
+    }
+
+    return &usage;
+}
+
+void mr::MemoryUsage::for_each(std::function<void(Usage const&)> const& f) const
+{
+    f(unattributed);
+    for (auto const& session : sessions)
+        f(session.second);
+}
+
+auto mr::MemoryUsage::usage_of(OwnerState const& owner) -> Usage&
+{
+    auto const s = owner.session ? sessions.find(owner.session) : sessions.end();
+    return s != sessions.end() ? s->second : unattributed;
+}
@@ -0,0 +1,89 @@
+/*
+ * Copyright © 2017 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MIR_REPORT_MEMORY_USAGE_H_
+#define MIR_REPORT_MEMORY_USAGE_H_
+
+#include "mir/scene/memory_report.h"
+
+#include <array>
+#include <functional>
+#include <string>
+#include <unordered_map>
+
+namespace mir
+{
+namespace report
+{
+
+/**
+ * The bookkeeping behind the MemoryReport handlers: rolls the memory reported
+ * against each owner up to its session (or to "unattributed").
+ *
+ * Not thread safe; the handlers serialise calls.
+ */
+class MemoryUsage
+{
+public:
+    typedef scene::MemoryReport::Owner Owner;
+    typedef scene::MemoryReport::Category Category;
+
+    static size_t const category_count{3};
+    static char const* name_of(Category category);
+
+    struct Usage
+    {
+        std::string name;
+        unsigned id;    ///< Distinguishes sessions with the same name
+        std::array<size_t, category_count> bytes{};
+        bool closed{false};
+
+        size_t total() const;
+    };
+
+    MemoryUsage();
+
+    // Each of these returns the usage that changed, if any. The pointer is
+    // only valid until the next call. When a session is destroyed its final
+    // usage is returned with "closed" set, and it is no longer tracked.
+    Usage const* owner_created(Owner owner, Owner parent, std::string const& name);
+    Usage const* owner_destroyed(Owner owner);
+    Usage const* allocated(Owner owner, Category category, size_t bytes);
+    Usage const* released(Owner owner, Category category, size_t bytes);
+
+    void for_each(std::function<void(Usage const&)> const& f) const;
+
+private:
+    struct OwnerState
+    {
+        Owner session;
+        std::array<size_t, category_count> bytes{};
+        bool implicit;  ///< Never created, so forgotten once it holds nothing
+    };
+
+    Usage& usage_of(OwnerState const& owner);
+
+    std::unordered_map<Owner, OwnerState> owners;
+    std::unordered_map<Owner, Usage> sessions;
+    Usage unattributed;
+    Usage last_closed;
+    unsigned next_id{1};
+};
+
+}
+}
+
+#endif // MIR_REPORT_MEMORY_USAGE_H_
@@ -0,0 +1,137 @@
+/*
+ * Copyright © 2017 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "compositor_report.h"
+#include "registry.h"
+
+#include <algorithm>
+#include <string>
+
+namespace mrm = mir::report::metrics;
+
+namespace
+{
+uint64_t microseconds(std::chrono::steady_clock::duration duration)
+{
+    auto const us = std::chrono::duration_cast<std::chrono::microseconds>(duration).count();
+    return us > 0 ? us : 0;
+}
+}
+
+mrm::CompositorReport::CompositorReport(
+    std::shared_ptr<Registry> const& registry,
+    std::shared_ptr<time::Clock> const& clock) :
+    registry{registry},
+    clock{clock},
+    outputs{std::make_shared<Outputs const>()}
+{
+}
+
+auto mrm::CompositorReport::output_for(SubCompositorId id) -> std::shared_ptr<Output>
+{
+    auto const current = std::atomic_load(&outputs);
+
+    auto const found = current->find(id);
+    if (found != current->end())
+        return found->second;
+
+    return add_output(id, "unknown");
+}
+
+auto mrm::CompositorReport::add_output(SubCompositorId id, std::string const& label) -> std::shared_ptr<Output>
+{
+    std::lock_guard<std::mutex> lock{mutex};
+
+    auto const labels = "output=\"" + label + "\"";
+    auto const output = std::make_shared<Output>(Output{
+        registry->histogram("mir_frame_time_us", labels),
+        registry->histogram("mir_frame_render_time_us", labels),
+        registry->histogram("mir_frame_latency_us", labels),
+        registry->counter("mir_frames_bypassed_total", labels),
+        {}, {}, false});
+
+    auto const updated = std::make_shared<Outputs>(*outputs);
+    (*updated)[id] = output;
+    std::atomic_store(&outputs, std::shared_ptr<Outputs const>{updated});
+
+    return output;
+}
+
+void mrm::CompositorReport::added_display(int width, int height, int x, int y, SubCompositorId id)
+{
+    auto const label =
+        std::to_string(width) + "x" + std::to_string(height) +
+        (x < 0 ? "" : "+") + std::to_string(x) + (y < 0 ? "" : "+") + std::to_string(y);
+
+    add_output(id, label);
+}
+
+void mrm::CompositorReport::began_frame(SubCompositorId id)
+{
+    auto const now = clock->now();
+
+    auto const output = output_for(id);
+    output->start_of_frame = now;
+    output->composited = false;
+}
+
+void mrm::CompositorReport::renderables_in_frame(SubCompositorId, graphics::RenderableList const&)
+{
+}
+
+void mrm::CompositorReport::rendered_frame(SubCompositorId id)
+{
+    auto const now = clock->now();
+
+    auto const output = output_for(id);
+    output->render_time.record(microseconds(now - output->start_of_frame));
+    output->composited = true;
+}
+
+void mrm::CompositorReport::finished_frame(SubCompositorId id)
+{
+    auto const now = clock->now();
+    time::Timestamp const scheduled{time::Timestamp::duration{last_scheduled.load(std::memory_order_relaxed)}};
+
+    auto const output = output_for(id);
+
+    // The first frame has no predecessor to measure from
+    if (output->end_of_frame != time::Timestamp{})
+        output->frame_time.record(microseconds(now - output->end_of_frame));
+    // Scheduling requests made before the previous frame finished are
+    // counted from then, as this frame is the first that could include them
+    if (scheduled != time::Timestamp{})
+        output->latency.record(microseconds(now - std::max(scheduled, output->end_of_frame)));
+    if (!output->composited)
+        output->bypassed.increment();
+
+    output->end_of_frame = now;
+}
+
+void mrm::CompositorReport::started()
+{
+}
+
+void mrm::CompositorReport::stopped()
+{
+    std::lock_guard<std::mutex> lock{mutex};
+    std::atomic_store(&outputs, std::make_shared<Outputs const>());
+}
+
+void mrm::CompositorReport::scheduled()
+{
+    last_scheduled.store(clock->now().time_since_epoch().count(), std::memory_order_relaxed);
+}
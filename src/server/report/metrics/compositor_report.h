@@ -0,0 +1,84 @@
+/*
+ * Copyright © 2017 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MIR_REPORT_METRICS_COMPOSITOR_REPORT_H_
+#define MIR_REPORT_METRICS_COMPOSITOR_REPORT_H_
+
+#include "mir/compositor/compositor_report.h"
+#include "mir/time/clock.h"
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+namespace mir
+{
+namespace report
+{
+namespace metrics
+{
+class Registry;
+class Histogram;
+class Counter;
+
+/// Records per-output frame times, render times and latencies
+class CompositorReport : public mir::compositor::CompositorReport
+{
+public:
+    CompositorReport(std::shared_ptr<Registry> const& registry, std::shared_ptr<time::Clock> const& clock);
+
+    void added_display(int width, int height, int x, int y, SubCompositorId id) override;
+    void began_frame(SubCompositorId id) override;
+    void renderables_in_frame(SubCompositorId id, graphics::RenderableList const& renderables) override;
+    void rendered_frame(SubCompositorId id) override;
+    void finished_frame(SubCompositorId id) override;
+    void started() override;
+    void stopped() override;
+    void scheduled() override;
+
+private:
+    struct Output
+    {
+        Histogram& frame_time;
+        Histogram& render_time;
+        Histogram& latency;
+        Counter& bypassed;
+
+        // Only touched by the compositor thread for the output
+        time::Timestamp start_of_frame;
+        time::Timestamp end_of_frame;
+        bool composited;
+    };
+    using Outputs = std::unordered_map<SubCompositorId, std::shared_ptr<Output>>;
+
+    std::shared_ptr<Output> output_for(SubCompositorId id);
+    std::shared_ptr<Output> add_output(SubCompositorId id, std::string const& label);
+
+    std::shared_ptr<Registry> const registry;
+    std::shared_ptr<time::Clock> const clock;
+
+    // The outputs are replaced, not modified, so that frames can look up
+    // their output without locking. The mutex serialises the replacements.
+    std::mutex mutex;
+    std::shared_ptr<Outputs const> outputs;
+    std::atomic<time::Timestamp::rep> last_scheduled{0};
+};
+}
+}
+}
+
+#endif /* MIR_REPORT_METRICS_COMPOSITOR_REPORT_H_ */
@@ -0,0 +1,100 @@
+/*
+ * Copyright © 2017 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "endpoint.h"
+#include "registry.h"
+
+#include "mir/dispatch/readable_fd.h"
+#include "mir/dispatch/threaded_dispatcher.h"
+#include "mir/terminate_with_current_exception.h"
+
+#include <boost/throw_exception.hpp>
+
+#include <sstream>
+#include <system_error>
+
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace mrm = mir::report::metrics;
+namespace md = mir::dispatch;
+
+namespace
+{
+mir::Fd listen_on(std::string const& path)
+{
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    if (path.size() >= sizeof address.sun_path)
+        BOOST_THROW_EXCEPTION(std::runtime_error{"Metrics socket path is too long: " + path});
+    path.copy(address.sun_path, path.size());
+
+    // Replace the socket left by a previous server, but nothing else
+    struct stat existing;
+    if (stat(path.c_str(), &existing) == 0 && S_ISSOCK(existing.st_mode))
+        unlink(path.c_str());
+
+    mir::Fd socket{::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0)};
+    if (socket < 0)
+        BOOST_THROW_EXCEPTION((std::system_error{errno, std::system_category(), "Failed to create metrics socket"}));
+
+    if (bind(socket, reinterpret_cast<sockaddr*>(&address), sizeof address) < 0 || listen(socket, 4) < 0)
+        BOOST_THROW_EXCEPTION((std::system_error{errno, std::system_category(), "Failed to listen on " + path}));
+
+    return socket;
+}
+}
+
+mrm::Endpoint::Endpoint(std::string const& socket_path, std::shared_ptr<Registry> const& registry) :
+    socket_path{socket_path},
+    registry{registry},
+    socket{listen_on(socket_path)},
+    thread{std::make_unique<md::ThreadedDispatcher>(
+        "Mir/Metrics",
+        std::make_shared<md::ReadableFd>(socket, [this] { serve_client(); }),
+        []() { mir::terminate_with_current_exception(); })}
+{
+}
+
+mrm::Endpoint::~Endpoint()
+{
+    unlink(socket_path.c_str());
+}
+
+void mrm::Endpoint::serve_client()
+{
+    Fd const client{accept4(socket, nullptr, nullptr, SOCK_CLOEXEC)};
+    if (client < 0)
+        return;
+
+    // Don't let a client that stops reading hold up the next one
+    timeval const timeout{1, 0};
+    setsockopt(client, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof timeout);
+
+    std::ostringstream text;
+    registry->write_to(text);
+    auto const exposition = text.str();
+
+    for (size_t sent = 0; sent < exposition.size();)
+    {
+        auto const result = send(client, exposition.data() + sent, exposition.size() - sent, MSG_NOSIGNAL);
+        if (result <= 0)
+            break;
+        sent += result;
+    }
+}
@@ -0,0 +1,64 @@
+/*
+ * Copyright © 2017 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MIR_REPORT_METRICS_ENDPOINT_H_
+#define MIR_REPORT_METRICS_ENDPOINT_H_
+
+#include "mir/fd.h"
+
+#include <memory>
+#include <string>
+
+namespace mir
+{
+namespace dispatch
+{
+class ThreadedDispatcher;
+}
+namespace report
+{
+namespace metrics
+{
+class Registry;
+
+/**
+ * Serves the text exposition of a Registry on a Unix socket.
+ *
+ * Each client that connects is sent the current value of every metric and
+ * disconnected, so "socat - UNIX-CONNECT:<path>" is enough to scrape it.
+ */
+class Endpoint
+{
+public:
+    Endpoint(std::string const& socket_path, std::shared_ptr<Registry> const& registry);
+    ~Endpoint();
+
+private:
+    Endpoint(Endpoint const&) = delete;
+    Endpoint& operator=(Endpoint const&) = delete;
+
+    void serve_client();
+
+    std::string const socket_path;
+    std::shared_ptr<Registry> const registry;
+    Fd const socket;
+    std::unique_ptr<dispatch::ThreadedDispatcher> const thread;
+};
+}
+}
+}
+
+#endif /* MIR_REPORT_METRICS_ENDPOINT_H_ */
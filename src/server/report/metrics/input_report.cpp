@@ -0,0 +1,61 @@
+/*
+ * Copyright © 2017 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "input_report.h"
+#include "registry.h"
+
+namespace mrm = mir::report::metrics;
+
+namespace
+{
+// Input event times are CLOCK_MONOTONIC, as is the server clock
+uint64_t microseconds_since(int64_t event_time, mir::time::Timestamp now)
+{
+    auto const elapsed = now.time_since_epoch() - std::chrono::nanoseconds{event_time};
+    auto const us = std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count();
+    return us > 0 ? us : 0;
+}
+}
+
+mrm::InputReport::InputReport(
+    std::shared_ptr<Registry> const& registry,
+    std::shared_ptr<time::Clock> const& clock) :
+    registry{registry},
+    clock{clock},
+    read_latency(registry->histogram("mir_input_read_latency_us"))
+{
+}
+
+void mrm::InputReport::received_event_from_kernel(int64_t when, int /*type*/, int /*code*/, int /*value*/)
+{
+    read_latency.record(microseconds_since(when, clock->now()));
+}
+
+void mrm::InputReport::published_key_event(int /*dest_fd*/, uint32_t /*seq_id*/, int64_t /*event_time*/)
+{
+}
+
+void mrm::InputReport::published_motion_event(int /*dest_fd*/, uint32_t /*seq_id*/, int64_t /*event_time*/)
+{
+}
+
+void mrm::InputReport::opened_input_device(char const* /*device_name*/, char const* /*input_platform*/)
+{
+}
+
+void mrm::InputReport::failed_to_open_input_device(char const* /*device_name*/, char const* /*input_platform*/)
+{
+}
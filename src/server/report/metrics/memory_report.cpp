@@ -0,0 +1,93 @@
+/*
+ * Copyright © 2017 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "memory_report.h"
+#include "registry.h"
+
+namespace mrm = mir::report::metrics;
+
+namespace
+{
+char const* const metric_name = "mir_memory_bytes";
+
+std::string escaped(std::string const& value)
+{
+    std::string result;
+    for (auto const c : value)
+    {
+        if (c == '\\' || c == '"')
+            result += '\\';
+
+        if (c == '\n')
+            result += "\\n";
+        else
+            result += c;
+    }
+    return result;
+}
+
+std::string labels_for(mir::report::MemoryUsage::Usage const& usage, size_t category)
+{
+    return "owner=\"" + escaped(usage.name) + "\",id=\"" + std::to_string(usage.id) +
+        "\",category=\"" + mir::report::MemoryUsage::name_of(static_cast<mir::scene::MemoryReport::Category>(category)) +
+        "\"";
+}
+}
+
+mrm::MemoryReport::MemoryReport(std::shared_ptr<Registry> const& registry) :
+    registry{registry}
+{
+}
+
+void mrm::MemoryReport::owner_created(Owner owner, Owner parent, std::string const& name)
+{
+    std::lock_guard<std::mutex> lock{mutex};
+    update(usage.owner_created(owner, parent, name));
+}
+
+void mrm::MemoryReport::owner_destroyed(Owner owner)
+{
+    std::lock_guard<std::mutex> lock{mutex};
+    update(usage.owner_destroyed(owner));
+}
+
+void mrm::MemoryReport::allocated(Owner owner, Category category, size_t bytes)
+{
+    std::lock_guard<std::mutex> lock{mutex};
+    update(usage.allocated(owner, category, bytes));
+}
+
+void mrm::MemoryReport::released(Owner owner, Category category, size_t bytes)
+{
+    std::lock_guard<std::mutex> lock{mutex};
+    update(usage.released(owner, category, bytes));
+}
+
+void mrm::MemoryReport::update(MemoryUsage::Usage const* changed)
+{
+    if (!changed)
+        return;
+
+    for (size_t category = 0; category != MemoryUsage::category_count; ++category)
+    {
+        auto const labels = labels_for(*changed, category);
+
+        if (changed->closed)
+            registry->remove_gauge(metric_name, labels);
+        else
+            registry->gauge(metric_name, labels).set(changed->bytes[category]);
+    }
+}
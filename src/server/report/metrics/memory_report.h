@@ -0,0 +1,61 @@
+/*
+ * Copyright © 2017 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MIR_REPORT_METRICS_MEMORY_REPORT_H_
+#define MIR_REPORT_METRICS_MEMORY_REPORT_H_
+
+#include "mir/scene/memory_report.h"
+#include "../memory_usage.h"
+
+#include <memory>
+#include <mutex>
+
+namespace mir
+{
+namespace report
+{
+namespace metrics
+{
+class Registry;
+
+/**
+ * Exposes the memory held for each session as mir_memory_bytes gauges,
+ * labelled with the session's name and category of memory. The gauges of a
+ * session are removed when it goes away.
+ */
+class MemoryReport : public scene::MemoryReport
+{
+public:
+    MemoryReport(std::shared_ptr<Registry> const& registry);
+
+    void owner_created(Owner owner, Owner parent, std::string const& name) override;
+    void owner_destroyed(Owner owner) override;
+    void allocated(Owner owner, Category category, size_t bytes) override;
+    void released(Owner owner, Category category, size_t bytes) override;
+
+private:
+    void update(MemoryUsage::Usage const* changed);
+
+    std::shared_ptr<Registry> const registry;
+
+    std::mutex mutex; // Protects the following...
+    MemoryUsage usage;
+};
+}
+}
+}
+
+#endif /* MIR_REPORT_METRICS_MEMORY_REPORT_H_ */
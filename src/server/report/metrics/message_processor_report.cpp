@@ -0,0 +1,93 @@
+/*
+ * Copyright © 2017 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "message_processor_report.h"
+#include "registry.h"
+
+namespace mrm = mir::report::metrics;
+
+mrm::MessageProcessorReport::MessageProcessorReport(
+    std::shared_ptr<Registry> const& registry,
+    std::shared_ptr<time::Clock> const& clock) :
+    registry{registry},
+    clock{clock},
+    unknown_methods(registry->counter("mir_rpc_unknown_methods_total")),
+    unattributed_errors(registry->counter("mir_rpc_errors_total", "method=\"unknown\""))
+{
+}
+
+auto mrm::MessageProcessorReport::method_called(std::string const& name) -> Method&
+{
+    auto& method = methods[name];
+
+    if (!method)
+    {
+        auto const labels = "method=\"" + name + "\"";
+        method.reset(new Method{
+            registry->histogram("mir_rpc_latency_us", labels),
+            registry->counter("mir_rpc_errors_total", labels)});
+    }
+
+    return *method;
+}
+
+void mrm::MessageProcessorReport::received_invocation(void const* mediator, int id, std::string const& method)
+{
+    auto const now = clock->now();
+
+    std::lock_guard<std::mutex> lock{mutex};
+    invocations[{mediator, id}] = Invocation{now, method};
+}
+
+void mrm::MessageProcessorReport::completed_invocation(void const* mediator, int id, bool /*result*/)
+{
+    auto const now = clock->now();
+
+    std::lock_guard<std::mutex> lock{mutex};
+
+    auto const invocation = invocations.find({mediator, id});
+    if (invocation == invocations.end())
+        return;
+
+    auto const elapsed = std::chrono::duration_cast<std::chrono::microseconds>(now - invocation->second.start);
+    method_called(invocation->second.method).latency.record(elapsed.count() > 0 ? elapsed.count() : 0);
+    invocations.erase(invocation);
+}
+
+void mrm::MessageProcessorReport::unknown_method(void const* mediator, int id, std::string const& /*method*/)
+{
+    unknown_methods.increment();
+
+    // Method names come from clients, so only known ones are used as labels
+    std::lock_guard<std::mutex> lock{mutex};
+    invocations.erase({mediator, id});
+}
+
+void mrm::MessageProcessorReport::exception_handled(void const* mediator, int id, std::exception const& /*error*/)
+{
+    std::lock_guard<std::mutex> lock{mutex};
+
+    auto const invocation = invocations.find({mediator, id});
+    if (invocation != invocations.end())
+        method_called(invocation->second.method).errors.increment();
+    else
+        unattributed_errors.increment();
+}
+
+void mrm::MessageProcessorReport::exception_handled(void const* /*mediator*/, std::exception const& /*error*/)
+{
+    unattributed_errors.increment();
+}
@@ -0,0 +1,78 @@
+/*
+ * Copyright © 2017 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MIR_REPORT_METRICS_MESSAGE_PROCESSOR_REPORT_H_
+#define MIR_REPORT_METRICS_MESSAGE_PROCESSOR_REPORT_H_
+
+#include "mir/frontend/message_processor_report.h"
+#include "mir/time/clock.h"
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+namespace mir
+{
+namespace report
+{
+namespace metrics
+{
+class Registry;
+class Histogram;
+class Counter;
+
+/// Records the latency and failures of each RPC method
+class MessageProcessorReport : public mir::frontend::MessageProcessorReport
+{
+public:
+    MessageProcessorReport(std::shared_ptr<Registry> const& registry, std::shared_ptr<time::Clock> const& clock);
+
+    void received_invocation(void const* mediator, int id, std::string const& method) override;
+    void completed_invocation(void const* mediator, int id, bool result) override;
+    void unknown_method(void const* mediator, int id, std::string const& method) override;
+    void exception_handled(void const* mediator, int id, std::exception const& error) override;
+    void exception_handled(void const* mediator, std::exception const& error) override;
+
+private:
+    struct Method
+    {
+        Histogram& latency;
+        Counter& errors;
+    };
+
+    struct Invocation
+    {
+        time::Timestamp start;
+        std::string method;
+    };
+
+    Method& method_called(std::string const& name);
+
+    std::shared_ptr<Registry> const registry;
+    std::shared_ptr<time::Clock> const clock;
+    Counter& unknown_methods;
+    Counter& unattributed_errors;
+
+    std::mutex mutex; // Protects the following...
+    std::map<std::string, std::unique_ptr<Method>> methods;
+    std::map<std::pair<void const*, int>, Invocation> invocations;
+};
+}
+}
+}
+
+#endif /* MIR_REPORT_METRICS_MESSAGE_PROCESSOR_REPORT_H_ */
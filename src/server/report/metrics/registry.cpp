@@ -0,0 +1,246 @@
+/*
+ * Copyright © 2017 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "registry.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace mrm = mir::report::metrics;
+
+namespace
+{
+unsigned const half_sub_buckets{mrm::Histogram::sub_buckets / 2};
+unsigned const sub_bucket_bits{6};  // log2(sub_buckets)
+
+std::atomic<unsigned> next_shard{0};
+
+struct { double fraction; char const* label; } const quantiles[] =
+    {{0.5, "0.5"}, {0.9, "0.9"}, {0.99, "0.99"}, {0.999, "0.999"}};
+
+std::string with_labels(std::string const& name, std::string const& labels, std::string const& extra = {})
+{
+    if (labels.empty() && extra.empty())
+        return name;
+
+    auto const separator = labels.empty() || extra.empty() ? "" : ",";
+    return name + "{" + labels + separator + extra + "}";
+}
+}
+
+unsigned mrm::detail::this_thread_shard()
+{
+    static thread_local unsigned const shard{next_shard++ % shard_count};
+    return shard;
+}
+
+mrm::Counter::Counter()
+{
+    for (auto& shard : shards)
+        shard.count = 0;
+}
+
+void mrm::Counter::increment(uint64_t by)
+{
+    shards[detail::this_thread_shard()].count.fetch_add(by, std::memory_order_relaxed);
+}
+
+uint64_t mrm::Counter::value() const
+{
+    uint64_t total{0};
+    for (auto const& shard : shards)
+        total += shard.count.load(std::memory_order_relaxed);
+    return total;
+}
+
+void mrm::Gauge::set(int64_t value)
+{
+    current.store(value, std::memory_order_relaxed);
+}
+
+int64_t mrm::Gauge::value() const
+{
+    return current.load(std::memory_order_relaxed);
+}
+
+mrm::Histogram::Histogram()
+{
+    for (auto& shard : shards)
+    {
+        for (auto& count : shard.counts)
+            count = 0;
+        shard.sum = 0;
+        shard.max = 0;
+    }
+}
+
+unsigned mrm::Histogram::bucket_for(uint64_t value)
+{
+    if (value < sub_buckets)
+        return value;
+
+    // Keep the top sub_bucket_bits bits of the value
+    unsigned const shift = (63 - __builtin_clzll(value)) - (sub_bucket_bits - 1);
+    auto const bucket = sub_buckets + (shift - 1) * half_sub_buckets + (value >> shift) - half_sub_buckets;
+
+    return std::min<uint64_t>(bucket, bucket_count - 1);
+}
+
+uint64_t mrm::Histogram::value_for(unsigned bucket)
+{
+    if (bucket < sub_buckets)
+        return bucket;
+
+    auto const shift = (bucket - sub_buckets) / half_sub_buckets + 1;
+    uint64_t const top_bits = (bucket - sub_buckets) % half_sub_buckets + half_sub_buckets;
+
+    return ((top_bits + 1) << shift) - 1;
+}
+
+void mrm::Histogram::record(uint64_t value)
+{
+    auto& shard = shards[detail::this_thread_shard()];
+
+    shard.counts[bucket_for(value)].fetch_add(1, std::memory_order_relaxed);
+    shard.sum.fetch_add(value, std::memory_order_relaxed);
+
+    auto max = shard.max.load(std::memory_order_relaxed);
+    while (value > max && !shard.max.compare_exchange_weak(max, value, std::memory_order_relaxed))
+        ;
+}
+
+auto mrm::Histogram::snapshot() const -> Snapshot
+{
+    Snapshot result;
+
+    for (auto const& shard : shards)
+    {
+        for (unsigned i = 0; i != bucket_count; ++i)
+        {
+            auto const count = shard.counts[i].load(std::memory_order_relaxed);
+            result.counts[i] += count;
+            result.total += count;
+        }
+        result.total_sum += shard.sum.load(std::memory_order_relaxed);
+        result.maximum = std::max(result.maximum, shard.max.load(std::memory_order_relaxed));
+    }
+
+    return result;
+}
+
+uint64_t mrm::Histogram::Snapshot::percentile(double fraction) const
+{
+    if (!total)
+        return 0;
+
+    auto const rank = std::max<uint64_t>(1, std::ceil(fraction * total));
+
+    uint64_t seen{0};
+    for (unsigned i = 0; i != bucket_count; ++i)
+    {
+        seen += counts[i];
+        if (seen >= rank)
+            return std::min(value_for(i), maximum);
+    }
+
+    return maximum;
+}
+
+auto mrm::Registry::counter(std::string const& name, std::string const& labels) -> Counter&
+{
+    std::lock_guard<std::mutex> lock{mutex};
+
+    auto& counter = counters[name][labels];
+    if (!counter)
+        counter = std::make_unique<Counter>();
+
+    return *counter;
+}
+
+auto mrm::Registry::histogram(std::string const& name, std::string const& labels) -> Histogram&
+{
+    std::lock_guard<std::mutex> lock{mutex};
+
+    auto& histogram = histograms[name][labels];
+    if (!histogram)
+        histogram = std::make_unique<Histogram>();
+
+    return *histogram;
+}
+
+auto mrm::Registry::gauge(std::string const& name, std::string const& labels) -> Gauge&
+{
+    std::lock_guard<std::mutex> lock{mutex};
+
+    auto& gauge = gauges[name][labels];
+    if (!gauge)
+        gauge = std::make_unique<Gauge>();
+
+    return *gauge;
+}
+
+void mrm::Registry::remove_gauge(std::string const& name, std::string const& labels)
+{
+    std::lock_guard<std::mutex> lock{mutex};
+
+    auto const family = gauges.find(name);
+    if (family == gauges.end())
+        return;
+
+    family->second.erase(labels);
+    if (family->second.empty())
+        gauges.erase(family);
+}
+
+void mrm::Registry::write_to(std::ostream& out) const
+{
+    std::lock_guard<std::mutex> lock{mutex};
+
+    for (auto const& family : counters)
+    {
+        out << "# TYPE " << family.first << " counter\n";
+
+        for (auto const& counter : family.second)
+            out << with_labels(family.first, counter.first) << ' ' << counter.second->value() << '\n';
+    }
+
+    for (auto const& family : gauges)
+    {
+        out << "# TYPE " << family.first << " gauge\n";
+
+        for (auto const& gauge : family.second)
+            out << with_labels(family.first, gauge.first) << ' ' << gauge.second->value() << '\n';
+    }
+
+    for (auto const& family : histograms)
+    {
+        out << "# TYPE " << family.first << " summary\n";
+
+        for (auto const& histogram : family.second)
+        {
+            auto const& labels = histogram.first;
+            auto const snapshot = histogram.second->snapshot();
+
+            for (auto const quantile : quantiles)
+            {
+                out << with_labels(family.first, labels, std::string{"quantile=\""} + quantile.label + "\"")
+                    << ' ' << snapshot.percentile(quantile.fraction) << '\n';
+            }
+            out << with_labels(family.first + "_sum", labels) << ' ' << snapshot.sum() << '\n';
+            out << with_labels(family.first + "_count", labels) << ' ' << snapshot.count() << '\n';
+        }
+    }
+}
@@ -0,0 +1,164 @@
+/*
+ * Copyright © 2017 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MIR_REPORT_METRICS_REGISTRY_H_
+#define MIR_REPORT_METRICS_REGISTRY_H_
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace mir
+{
+namespace report
+{
+namespace metrics
+{
+namespace detail
+{
+unsigned const shard_count{4};
+
+/// The shard used by the calling thread, so threads rarely share cache lines
+unsigned this_thread_shard();
+}
+
+/// A monotonic count, sharded so that concurrent increments don't contend
+class Counter
+{
+public:
+    Counter();
+
+    void increment(uint64_t by = 1);
+    uint64_t value() const;
+
+private:
+    struct alignas(64) Shard
+    {
+        std::atomic<uint64_t> count;
+    };
+    std::array<Shard, detail::shard_count> shards;
+};
+
+/// A value that goes up and down, such as the number of bytes in use
+class Gauge
+{
+public:
+    Gauge() = default;
+
+    void set(int64_t value);
+    int64_t value() const;
+
+private:
+    std::atomic<int64_t> current{0};
+};
+
+/**
+ * A histogram of durations in microseconds with bounded relative error.
+ *
+ * As in HdrHistogram each power of two is divided into equal sized buckets,
+ * each 1/32 of the power of two wide. Values are reported as the largest
+ * in their bucket, so are overstated by at most 1/32 (about 3%) however
+ * large they are.
+ * Recording is a handful of relaxed atomic increments on the calling
+ * thread's shard; the shards are only merged when a Snapshot is taken.
+ */
+class Histogram
+{
+public:
+    static unsigned const sub_buckets{64};
+    static unsigned const bucket_count{sub_buckets + 32 * (sub_buckets / 2)};
+
+    class Snapshot
+    {
+    public:
+        uint64_t count() const { return total; }
+        uint64_t sum() const { return total_sum; }
+        uint64_t max() const { return maximum; }
+
+        /// The value below which the given fraction of recorded values fall
+        uint64_t percentile(double fraction) const;
+
+    private:
+        friend class Histogram;
+        std::array<uint64_t, bucket_count> counts{};
+        uint64_t total{0};
+        uint64_t total_sum{0};
+        uint64_t maximum{0};
+    };
+
+    Histogram();
+
+    void record(uint64_t value);
+    Snapshot snapshot() const;
+
+    static unsigned bucket_for(uint64_t value);
+    /// The largest value that falls in the bucket
+    static uint64_t value_for(unsigned bucket);
+
+private:
+    struct alignas(64) Shard
+    {
+        std::array<std::atomic<uint64_t>, bucket_count> counts;
+        std::atomic<uint64_t> sum;
+        std::atomic<uint64_t> max;
+    };
+    std::array<Shard, detail::shard_count> shards;
+};
+
+/**
+ * The named metrics of a server, and their text exposition.
+ *
+ * Metrics are identified by a name and an optional set of labels in the
+ * Prometheus text format (e.g. "method=\"next_buffer\""). Looking a metric up
+ * takes a lock, so reports look up what they need once and keep the
+ * reference, which remains valid for the lifetime of the registry. Gauges
+ * describing something transient (such as a session) can be removed when it
+ * goes away, after which references to them are no longer valid.
+ */
+class Registry
+{
+public:
+    Registry() = default;
+
+    Counter& counter(std::string const& name, std::string const& labels = {});
+    Histogram& histogram(std::string const& name, std::string const& labels = {});
+    Gauge& gauge(std::string const& name, std::string const& labels = {});
+
+    void remove_gauge(std::string const& name, std::string const& labels = {});
+
+    /// Writes every metric in the Prometheus text format, histograms as summaries
+    void write_to(std::ostream& out) const;
+
+private:
+    Registry(Registry const&) = delete;
+    Registry& operator=(Registry const&) = delete;
+
+    std::mutex mutable mutex;
+    std::map<std::string, std::map<std::string, std::unique_ptr<Counter>>> counters;
+    std::map<std::string, std::map<std::string, std::unique_ptr<Histogram>>> histograms;
+    std::map<std::string, std::map<std::string, std::unique_ptr<Gauge>>> gauges;
+};
+}
+}
+}
+
+#endif /* MIR_REPORT_METRICS_REGISTRY_H_ */
@@ -0,0 +1,97 @@
+/*
+ * Copyright © 2017 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "seat_report.h"
+#include "registry.h"
+
+#include "mir_toolkit/events/event.h"
+#include "mir_toolkit/events/input/input_event.h"
+
+namespace mrm = mir::report::metrics;
+
+namespace
+{
+// Input event times are CLOCK_MONOTONIC, as is the server clock
+uint64_t microseconds_since(int64_t event_time, mir::time::Timestamp now)
+{
+    auto const elapsed = now.time_since_epoch() - std::chrono::nanoseconds{event_time};
+    auto const us = std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count();
+    return us > 0 ? us : 0;
+}
+}
+
+mrm::SeatReport::SeatReport(
+    std::shared_ptr<Registry> const& registry,
+    std::shared_ptr<time::Clock> const& clock) :
+    registry{registry},
+    clock{clock},
+    key_latency(registry->histogram("mir_input_dispatch_latency_us", "type=\"key\"")),
+    pointer_latency(registry->histogram("mir_input_dispatch_latency_us", "type=\"pointer\"")),
+    touch_latency(registry->histogram("mir_input_dispatch_latency_us", "type=\"touch\""))
+{
+}
+
+void mrm::SeatReport::seat_dispatch_event(std::shared_ptr<MirEvent const> const& event)
+{
+    if (mir_event_get_type(event.get()) != mir_event_type_input)
+        return;
+
+    auto const input_event = mir_event_get_input_event(event.get());
+    auto const latency = microseconds_since(mir_input_event_get_event_time(input_event), clock->now());
+
+    switch (mir_input_event_get_type(input_event))
+    {
+    case mir_input_event_type_key:
+        key_latency.record(latency);
+        break;
+    case mir_input_event_type_pointer:
+        pointer_latency.record(latency);
+        break;
+    case mir_input_event_type_touch:
+        touch_latency.record(latency);
+        break;
+    default:
+        break;
+    }
+}
+
+void mrm::SeatReport::seat_add_device(uint64_t /*id*/)
+{
+}
+
+void mrm::SeatReport::seat_remove_device(uint64_t /*id*/)
+{
+}
+
+void mrm::SeatReport::seat_set_key_state(uint64_t /*id*/, std::vector<uint32_t> const& /*scan_codes*/)
+{
+}
+
+void mrm::SeatReport::seat_set_pointer_state(uint64_t /*id*/, unsigned /*buttons*/)
+{
+}
+
+void mrm::SeatReport::seat_set_cursor_position(float /*cursor_x*/, float /*cursor_y*/)
+{
+}
+
+void mrm::SeatReport::seat_set_confinement_region_called(geometry::Rectangles const& /*regions*/)
+{
+}
+
+void mrm::SeatReport::seat_reset_confinement_regions()
+{
+}
@@ -0,0 +1,43 @@
+/*
+ * Copyright © 2017 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "buffer_lifetime_report.h"
+
+namespace mrn = mir::report::null;
+
+void mrn::BufferLifetimeReport::buffer_submitted(StreamId, graphics::BufferID)
+{
+}
+
+void mrn::BufferLifetimeReport::buffer_acquired(StreamId, graphics::BufferID, compositor::CompositorID)
+{
+}
+
+void mrn::BufferLifetimeReport::buffer_released(StreamId, graphics::BufferID)
+{
+}
+
+void mrn::BufferLifetimeReport::stream_destroyed(StreamId)
+{
+}
+
+void mrn::BufferLifetimeReport::frame_interval_changed(StreamId, std::chrono::milliseconds)
+{
+}
+
+void mrn::BufferLifetimeReport::buffer_deferred(StreamId, graphics::BufferID)
+{
+}
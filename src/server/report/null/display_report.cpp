@@ -30,3 +30,4 @@ void mrn::DisplayReport::report_vt_switch_away_failure() {}
 void mrn::DisplayReport::report_vt_switch_back_failure() {}
 void mrn::DisplayReport::report_egl_configuration(EGLDisplay, EGLConfig) {}
 void mrn::DisplayReport::report_vsync(unsigned int, mir::graphics::Frame const&) {}
+void mrn::DisplayReport::report_render_time(unsigned int, std::chrono::microseconds, std::chrono::microseconds) {}
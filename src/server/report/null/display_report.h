@@ -44,6 +44,10 @@ public:
     void report_vt_switch_back_failure() override;
     void report_egl_configuration(EGLDisplay disp, EGLConfig cfg) override;
     void report_vsync(unsigned int output_id, graphics::Frame const&) override;
+    void report_render_time(
+        unsigned int output_id,
+        std::chrono::microseconds predicted,
+        std::chrono::microseconds actual) override;
 };
 }
 }
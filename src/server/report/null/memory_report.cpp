@@ -0,0 +1,35 @@
+/*
+ * Copyright © 2017 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "memory_report.h"
+
+namespace mrn = mir::report::null;
+
+void mrn::MemoryReport::owner_created(Owner, Owner, std::string const&)
+{
+}
+
+void mrn::MemoryReport::owner_destroyed(Owner)
+{
+}
+
+void mrn::MemoryReport::allocated(Owner, Category, size_t)
+{
+}
+
+void mrn::MemoryReport::released(Owner, Category, size_t)
+{
+}
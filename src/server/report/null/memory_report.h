@@ -0,0 +1,42 @@
+/*
+ * Copyright © 2017 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MIR_REPORT_NULL_MEMORY_REPORT_H_
+#define MIR_REPORT_NULL_MEMORY_REPORT_H_
+
+#include "mir/scene/memory_report.h"
+
+namespace mir
+{
+namespace report
+{
+namespace null
+{
+
+class MemoryReport : public scene::MemoryReport
+{
+public:
+    void owner_created(Owner owner, Owner parent, std::string const& name) override;
+    void owner_destroyed(Owner owner) override;
+    void allocated(Owner owner, Category category, size_t bytes) override;
+    void released(Owner owner, Category category, size_t bytes) override;
+};
+
+}
+}
+}
+
+#endif // MIR_REPORT_NULL_MEMORY_REPORT_H_
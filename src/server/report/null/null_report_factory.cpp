@@ -19,6 +19,7 @@
 #include "../null_report_factory.h"
 
 #include "compositor_report.h"
+#include "buffer_lifetime_report.h"
 #include "connector_report.h"
 #include "message_processor_report.h"
 #include "session_mediator_report.h"
@@ -27,6 +28,7 @@
 #include "seat_report.h"
 #include "shell_report.h"
 #include "scene_report.h"
+#include "memory_report.h"
 #include "mir/logging/null_shared_library_prober_report.h"
 
 std::shared_ptr<mir::compositor::CompositorReport> mir::report::NullReportFactory::create_compositor_report()
@@ -34,6 +36,11 @@ std::shared_ptr<mir::compositor::CompositorReport> mir::report::NullReportFactor
     return std::make_shared<null::CompositorReport>();
 }
 
+std::shared_ptr<mir::compositor::BufferLifetimeReport> mir::report::NullReportFactory::create_buffer_lifetime_report()
+{
+    return std::make_shared<null::BufferLifetimeReport>();
+}
+
 std::shared_ptr<mir::graphics::DisplayReport> mir::report::NullReportFactory::create_display_report()
 {
     return std::make_shared<null::DisplayReport>();
@@ -44,6 +51,11 @@ std::shared_ptr<mir::scene::SceneReport> mir::report::NullReportFactory::create_
     return std::make_shared<null::SceneReport>();
 }
 
+std::shared_ptr<mir::scene::MemoryReport> mir::report::NullReportFactory::create_memory_report()
+{
+    return std::make_shared<null::MemoryReport>();
+}
+
 std::shared_ptr<mir::frontend::ConnectorReport> mir::report::NullReportFactory::create_connector_report()
 {
     return std::make_shared<null::ConnectorReport>();
@@ -84,6 +96,11 @@ std::shared_ptr<mir::compositor::CompositorReport> mir::report::null_compositor_
     return NullReportFactory{}.create_compositor_report();
 }
 
+std::shared_ptr<mir::compositor::BufferLifetimeReport> mir::report::null_buffer_lifetime_report()
+{
+    return NullReportFactory{}.create_buffer_lifetime_report();
+}
+
 std::shared_ptr<mir::SharedLibraryProberReport> mir::report::null_shared_library_prober_report()
 {
     return NullReportFactory{}.create_shared_library_prober_report();
@@ -97,6 +114,10 @@ std::shared_ptr<mir::scene::SceneReport> mir::report::null_scene_report()
 {
     return NullReportFactory{}.create_scene_report();
 }
+std::shared_ptr<mir::scene::MemoryReport> mir::report::null_memory_report()
+{
+    return NullReportFactory{}.create_memory_report();
+}
 std::shared_ptr<mir::frontend::ConnectorReport> mir::report::null_connector_report()
 {
     return NullReportFactory{}.create_connector_report();
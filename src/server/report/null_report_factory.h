@@ -29,8 +29,10 @@ class NullReportFactory : public mir::report::ReportFactory
 {
 public:
     std::shared_ptr<compositor::CompositorReport> create_compositor_report() override;
+    std::shared_ptr<compositor::BufferLifetimeReport> create_buffer_lifetime_report() override;
     std::shared_ptr<graphics::DisplayReport> create_display_report() override;
     std::shared_ptr<scene::SceneReport> create_scene_report() override;
+    std::shared_ptr<scene::MemoryReport> create_memory_report() override;
     std::shared_ptr<frontend::ConnectorReport> create_connector_report() override;
     std::shared_ptr<frontend::SessionMediatorObserver> create_session_mediator_report() override;
     std::shared_ptr<frontend::MessageProcessorReport> create_message_processor_report() override;
@@ -41,8 +43,10 @@ public:
 };
 
 std::shared_ptr<compositor::CompositorReport> null_compositor_report();
+std::shared_ptr<compositor::BufferLifetimeReport> null_buffer_lifetime_report();
 std::shared_ptr<graphics::DisplayReport> null_display_report();
 std::shared_ptr<scene::SceneReport> null_scene_report();
+std::shared_ptr<scene::MemoryReport> null_memory_report();
 std::shared_ptr<frontend::ConnectorReport> null_connector_report();
 std::shared_ptr<frontend::SessionMediatorObserver> null_session_mediator_report();
 std::shared_ptr<frontend::MessageProcessorReport> null_message_processor_report();
@@ -27,6 +27,7 @@ class SharedLibraryProberReport;
 namespace compositor
 {
 class CompositorReport;
+class BufferLifetimeReport;
 }
 namespace frontend
 {
@@ -46,6 +47,7 @@ class SeatObserver;
 namespace scene
 {
 class SceneReport;
+class MemoryReport;
 }
 namespace shell { class ShellReport; }
 
@@ -56,8 +58,10 @@ class ReportFactory
 public:
     virtual ~ReportFactory() = default;
     virtual std::shared_ptr<compositor::CompositorReport> create_compositor_report() = 0;
+    virtual std::shared_ptr<compositor::BufferLifetimeReport> create_buffer_lifetime_report() = 0;
     virtual std::shared_ptr<graphics::DisplayReport> create_display_report() = 0;
     virtual std::shared_ptr<scene::SceneReport> create_scene_report() = 0;
+    virtual std::shared_ptr<scene::MemoryReport> create_memory_report() = 0;
     virtual std::shared_ptr<frontend::ConnectorReport> create_connector_report() = 0;
     virtual std::shared_ptr<frontend::SessionMediatorObserver> create_session_mediator_report() = 0;
     virtual std::shared_ptr<frontend::MessageProcessorReport> create_message_processor_report() = 0;
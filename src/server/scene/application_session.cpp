@@ -58,7 +58,25 @@ ms::ApplicationSession::ApplicationSession(
     std::shared_ptr<SessionListener> const& session_listener,
     mg::DisplayConfiguration const& initial_config,
     std::shared_ptr<mf::EventSink> const& sink,
-    std::shared_ptr<graphics::GraphicBufferAllocator> const& gralloc) : 
+    std::shared_ptr<graphics::GraphicBufferAllocator> const& gralloc) :
+    ApplicationSession(
+        surface_stack, surface_factory, buffer_stream_factory, pid, session_name, snapshot_strategy,
+        session_listener, initial_config, sink, gralloc, nullptr)
+{
+}
+
+ms::ApplicationSession::ApplicationSession(
+    std::shared_ptr<msh::SurfaceStack> const& surface_stack,
+    std::shared_ptr<SurfaceFactory> const& surface_factory,
+    std::shared_ptr<ms::BufferStreamFactory> const& buffer_stream_factory,
+    pid_t pid,
+    std::string const& session_name,
+    std::shared_ptr<SnapshotStrategy> const& snapshot_strategy,
+    std::shared_ptr<SessionListener> const& session_listener,
+    mg::DisplayConfiguration const& initial_config,
+    std::shared_ptr<mf::EventSink> const& sink,
+    std::shared_ptr<graphics::GraphicBufferAllocator> const& gralloc,
+    std::shared_ptr<graphics::Display const> const& display) :
     surface_stack(surface_stack),
     surface_factory(surface_factory),
     buffer_stream_factory(buffer_stream_factory),
@@ -68,6 +86,7 @@ ms::ApplicationSession::ApplicationSession(
     session_listener(session_listener),
     event_sink(sink),
     gralloc(gralloc),
+    display(display),
     next_surface_id(0)
 {
     assert(surface_stack);
@@ -152,7 +171,8 @@ mf::SurfaceId ms::ApplicationSession::create_surface(
         id,
         *surface,
         output_cache,
-        surface_sink);
+        surface_sink,
+        display);
     surface->add_observer(observer);
 
     {
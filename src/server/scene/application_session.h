@@ -37,6 +37,7 @@ class ClientBuffers;
 namespace compositor { class BufferStream; }
 namespace graphics
 {
+class Display;
 class DisplayConfiguration;
 class GraphicBufferAllocator;
 class BufferAttribute;
@@ -65,6 +66,20 @@ public:
         std::shared_ptr<frontend::EventSink> const& sink,
         std::shared_ptr<graphics::GraphicBufferAllocator> const& allocator);
 
+    /// Clients are also sent the vblank timestamps of the outputs their surfaces are on
+    ApplicationSession(
+        std::shared_ptr<shell::SurfaceStack> const& surface_stack,
+        std::shared_ptr<SurfaceFactory> const& surface_factory,
+        std::shared_ptr<BufferStreamFactory> const& buffer_stream_factory,
+        pid_t pid,
+        std::string const& session_name,
+        std::shared_ptr<SnapshotStrategy> const& snapshot_strategy,
+        std::shared_ptr<SessionListener> const& session_listener,
+        graphics::DisplayConfiguration const& initial_config,
+        std::shared_ptr<frontend::EventSink> const& sink,
+        std::shared_ptr<graphics::GraphicBufferAllocator> const& allocator,
+        std::shared_ptr<graphics::Display const> const& display);
+
     ~ApplicationSession();
 
     frontend::SurfaceId create_surface(
@@ -114,6 +129,7 @@ private:
     std::shared_ptr<SessionListener> const session_listener;
     std::shared_ptr<frontend::EventSink> const event_sink;
     std::shared_ptr<graphics::GraphicBufferAllocator> const gralloc;
+    std::shared_ptr<graphics::Display const> const display;
 
     frontend::SurfaceId next_id();
 
@@ -26,6 +26,7 @@
 #include "mir/graphics/cursor_image.h"
 #include "mir/graphics/pixel_format_utils.h"
 #include "mir/geometry/displacement.h"
+#include "mir/geometry/rectangles.h"
 #include "mir/renderer/sw/pixel_source.h"
 
 #include "mir/scene/scene_report.h"
@@ -35,6 +36,8 @@
 
 #include <stdexcept>
 #include <algorithm>
+#include <cmath>
+#include <limits>
 
 #include <string.h> // memcpy
 
@@ -71,10 +74,10 @@ void ms::SurfaceObservers::hidden_set_to(Surface const* surf, bool hide)
         { observer->hidden_set_to(surf, hide); });
 }
 
-void ms::SurfaceObservers::frame_posted(Surface const* surf, int frames_available, geometry::Size const& size)
+void ms::SurfaceObservers::frame_posted(Surface const* surf, int frames_available, geometry::Rectangle const& damage)
 {
     for_each([&](std::shared_ptr<SurfaceObserver> const& observer)
-        { observer->frame_posted(surf, frames_available, size); });
+        { observer->frame_posted(surf, frames_available, damage); });
 }
 
 void ms::SurfaceObservers::alpha_set_to(Surface const* surf, float alpha)
@@ -153,6 +156,12 @@ void ms::SurfaceObservers::start_drag_and_drop(Surface const* surf, std::vector<
                  { observer->start_drag_and_drop(surf, handle); });
 }
 
+void ms::SurfaceObservers::input_region_set_to(Surface const* surf, std::vector<geometry::Rectangle> const& region)
+{
+    for_each([&](std::shared_ptr<SurfaceObserver> const& observer)
+        { observer->input_region_set_to(surf, region); });
+}
+
 
 struct ms::CursorStreamImageAdapter
 {
@@ -222,6 +231,39 @@ std::shared_ptr<mc::BufferStream> default_stream(std::list<ms::StreamInfo> const
         return layers.front().stream;
 }
 
+// The bounds of the rectangle once transformed about its centre, as the renderers do
+geom::Rectangle transformed_bounds(geom::Rectangle const& rect, glm::mat4 const& transformation)
+{
+    if (transformation == glm::mat4(1))
+        return rect;
+
+    auto const left = rect.top_left.x.as_int();
+    auto const top = rect.top_left.y.as_int();
+    auto const right = left + rect.size.width.as_int();
+    auto const bottom = top + rect.size.height.as_int();
+    auto const centre_x = (left + right) / 2.0f;
+    auto const centre_y = (top + bottom) / 2.0f;
+
+    auto min_x = std::numeric_limits<float>::max();
+    auto min_y = std::numeric_limits<float>::max();
+    auto max_x = std::numeric_limits<float>::lowest();
+    auto max_y = std::numeric_limits<float>::lowest();
+    for (auto const& corner : {glm::vec4(left, top, 0, 1), glm::vec4(right, top, 0, 1),
+                               glm::vec4(left, bottom, 0, 1), glm::vec4(right, bottom, 0, 1)})
+    {
+        auto p = transformation * glm::vec4(corner.x - centre_x, corner.y - centre_y, 0, 1);
+        if (p.w > 0.0f)
+            p /= p.w;
+        min_x = std::min(min_x, p.x + centre_x);
+        min_y = std::min(min_y, p.y + centre_y);
+        max_x = std::max(max_x, p.x + centre_x);
+        max_y = std::max(max_y, p.y + centre_y);
+    }
+
+    geom::Point const top_left{static_cast<int>(std::floor(min_x)), static_cast<int>(std::floor(min_y))};
+    geom::Point const bottom_right{static_cast<int>(std::ceil(max_x)), static_cast<int>(std::ceil(max_y))};
+    return {top_left, as_size(bottom_right - top_left)};
+}
 }
 
 ms::BasicSurface::BasicSurface(
@@ -247,10 +289,9 @@ ms::BasicSurface::BasicSurface(
     confine_pointer_state_(state),
     cursor_stream_adapter{std::make_unique<ms::CursorStreamImageAdapter>(*this)}
 {
-    auto callback = [this](auto const& size) { observers.frame_posted(this, 1, size); };
-
     for (auto& layer : layers)
     {
+        auto const callback = frame_posted_callback_for(layer.stream.get());
         if (layer.stream->has_submitted_buffer())
             callback(layer.stream->stream_size());
         layer.stream->set_frame_posted_callback(callback);
@@ -317,8 +358,11 @@ std::shared_ptr<mf::BufferStream> ms::BasicSurface::primary_buffer_stream() cons
 
 void ms::BasicSurface::set_input_region(std::vector<geom::Rectangle> const& input_rectangles)
 {
-    std::unique_lock<std::mutex> lock(guard);
-    custom_input_rectangles = input_rectangles;
+    {
+        std::unique_lock<std::mutex> lock(guard);
+        custom_input_rectangles = input_rectangles;
+    }
+    observers.input_region_set_to(this, input_rectangles);
 }
 
 void ms::BasicSurface::resize(geom::Size const& desired_size)
@@ -359,6 +403,21 @@ geom::Rectangle ms::BasicSurface::input_bounds() const
     return surface_rect;
 }
 
+geom::Rectangle ms::BasicSurface::input_region_bounds() const
+{
+    std::unique_lock<std::mutex> lk(guard);
+
+    // Custom input rectangles are not clipped to the surface, so may extend beyond it
+    geom::Rectangles region{surface_rect};
+    for (auto const& rectangle : custom_input_rectangles)
+    {
+        if (rectangle.size.width.as_int() > 0 && rectangle.size.height.as_int() > 0)
+            region.add({rectangle.top_left + (surface_rect.top_left - geom::Point{0, 0}), rectangle.size});
+    }
+
+    return region.bounding_rectangle();
+}
+
 // TODO: Does not account for transformation().
 bool ms::BasicSurface::input_area_contains(geom::Point const& point) const
 {
@@ -863,23 +922,53 @@ void ms::BasicSurface::rename(std::string const& title)
 
 void ms::BasicSurface::set_streams(std::list<scene::StreamInfo> const& s)
 {
+    std::list<StreamInfo> old_layers;
+    std::chrono::milliseconds interval;
     {
         std::unique_lock<std::mutex> lk(guard);
-        for(auto& layer : layers)
-            layer.stream->set_frame_posted_callback([](auto){});
-
+        old_layers = std::move(layers);
         layers = s;
+        interval = frame_interval;
+    }
 
-        for(auto& layer : layers)
-            layer.stream->set_frame_posted_callback(
-                [this](auto const& size)
-                {
-                    observers.frame_posted(this, 1, size);
-                });
+    // Not holding guard: a lifted frame interval posts the deferred frame to
+    // our observers, which may call back into the surface
+    for(auto& layer : old_layers)
+        layer.stream->set_frame_posted_callback([](auto){});
+
+    for(auto& layer : s)
+    {
+        layer.stream->set_frame_posted_callback(frame_posted_callback_for(layer.stream.get()));
+        layer.stream->set_frame_interval(interval);
     }
+
     observers.moved_to(this, surface_rect.top_left);
 }
 
+auto ms::BasicSurface::frame_posted_callback_for(mc::BufferStream const* stream)
+    -> std::function<void(geometry::Size const&)>
+{
+    return [this, stream](geometry::Size const& size)
+        {
+            geom::Rectangle damage;
+            {
+                std::unique_lock<std::mutex> lk(guard);
+                auto const layer = std::find_if(begin(layers), end(layers),
+                    [stream](StreamInfo const& info) { return info.stream.get() == stream; });
+
+                // A stream that has just left the surface damages nothing of it
+                if (layer == end(layers))
+                    return;
+
+                // The same placement generate_renderables() gives the stream
+                auto const stream_size = layer->size.is_set() ? layer->size.value() : size;
+                damage = transformed_bounds(
+                    {surface_rect.top_left + layer->displacement, stream_size}, transformation_matrix);
+            }
+            observers.frame_posted(this, 1, damage);
+        };
+}
+
 mg::RenderableList ms::BasicSurface::generate_renderables(mc::CompositorID id) const
 {
     std::unique_lock<std::mutex> lk(guard);
@@ -922,3 +1011,15 @@ void mir::scene::BasicSurface::start_drag_and_drop(std::vector<uint8_t> const& h
 {
     observers.start_drag_and_drop(this, handle);
 }
+
+void mir::scene::BasicSurface::set_frame_interval(std::chrono::milliseconds interval)
+{
+    std::unique_lock<std::mutex> lk(guard);
+    frame_interval = interval;
+    auto const streams = layers;
+    lk.unlock();
+
+    // Lifting the limit may post a deferred frame to our observers
+    for (auto& layer : streams)
+        layer.stream->set_frame_interval(interval);
+}
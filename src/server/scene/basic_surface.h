@@ -28,6 +28,7 @@
 #include "mir_toolkit/common.h"
 
 #include <glm/glm.hpp>
+#include <functional>
 #include <vector>
 #include <list>
 #include <memory>
@@ -96,6 +97,7 @@ public:
     void resize(geometry::Size const& size) override;
     geometry::Point top_left() const override;
     geometry::Rectangle input_bounds() const override;
+    geometry::Rectangle input_region_bounds() const override;
     bool input_area_contains(geometry::Point const& point) const override;
     void consume(MirEvent const* event) override;
     void set_alpha(float alpha) override;
@@ -140,6 +142,7 @@ public:
     MirPointerConfinementState confine_pointer_state() const override;
     void placed_relative(geometry::Rectangle const& placement) override;
     void start_drag_and_drop(std::vector<uint8_t> const& handle) override;
+    void set_frame_interval(std::chrono::milliseconds interval) override;
 
 private:
     bool visible(std::unique_lock<std::mutex>&) const;
@@ -151,6 +154,9 @@ private:
     MirWindowFocusState set_focus_state(MirWindowFocusState f);
     MirOrientationMode set_preferred_orientation(MirOrientationMode mode);
 
+    /// Reports a frame of the stream to the observers, damaging where the stream is shown
+    std::function<void(geometry::Size const&)> frame_posted_callback_for(compositor::BufferStream const* stream);
+
     SurfaceObservers observers;
     std::mutex mutable guard;
     std::string surface_name;
@@ -175,6 +181,7 @@ private:
     MirWindowVisibility visibility_ = mir_window_visibility_occluded;
     MirOrientationMode pref_orientation_mode = mir_orientation_mode_any;
     MirPointerConfinementState confine_pointer_state_ = mir_pointer_unconfined;
+    std::chrono::milliseconds frame_interval{0};
 
     std::unique_ptr<CursorStreamImageAdapter> const cursor_stream_adapter;
 };
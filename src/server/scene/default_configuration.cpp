@@ -40,6 +40,8 @@
 #include "prompt_session_manager_impl.h"
 #include "default_coordinate_translator.h"
 #include "unsupported_coordinate_translator.h"
+#include "default_frame_rate_policy.h"
+#include "frame_rate_governor.h"
 #include "timeout_application_not_responding_detector.h"
 #include "mir/options/program_option.h"
 #include "mir/options/default_configuration.h"
@@ -87,6 +89,8 @@ mir::DefaultServerConfiguration::the_surface_stack()
                  auto const wrapped = scene_surface_stack([this]()
                      { return std::make_shared<ms::SurfaceStack>(the_scene_report()); });
 
+                 wrapped->add_observer(std::make_shared<ms::FrameRateGovernor>(the_frame_rate_policy()));
+
                  return wrap_surface_stack(wrapped);
              });
 }
@@ -203,7 +207,8 @@ mir::DefaultServerConfiguration::the_pixel_buffer()
             };
 
             return std::make_shared<ms::GLPixelBuffer>(
-                as_context_source(the_display().get())->create_gl_context());
+                as_context_source(the_display().get())->create_gl_context(),
+                the_memory_report());
         });
 }
 
@@ -243,6 +248,13 @@ mir::DefaultServerConfiguration::the_coordinate_translator()
         });
 }
 
+std::shared_ptr<ms::FrameRatePolicy>
+mir::DefaultServerConfiguration::the_frame_rate_policy()
+{
+    return frame_rate_policy(
+        []{ return std::make_shared<ms::DefaultFrameRatePolicy>(); });
+}
+
 auto mir::DefaultServerConfiguration::the_application_not_responding_detector()
 -> std::shared_ptr<scene::ApplicationNotRespondingDetector>
 {
@@ -0,0 +1,32 @@
+/*
+ * Copyright © 2017 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "default_frame_rate_policy.h"
+
+namespace ms = mir::scene;
+
+std::chrono::milliseconds ms::DefaultFrameRatePolicy::frame_interval_for(
+    MirWindowType /*type*/,
+    MirWindowFocusState /*focus*/,
+    MirWindowVisibility visibility) const
+{
+    // The compositor takes no frames from an occluded surface; any limit
+    // stops its client dropping frames and so paces it by its buffer queue.
+    if (visibility == mir_window_visibility_occluded)
+        return std::chrono::seconds{1};
+
+    return std::chrono::milliseconds::zero();
+}
@@ -0,0 +1,38 @@
+/*
+ * Copyright © 2017 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MIR_SCENE_DEFAULT_FRAME_RATE_POLICY_H_
+#define MIR_SCENE_DEFAULT_FRAME_RATE_POLICY_H_
+
+#include "mir/scene/frame_rate_policy.h"
+
+namespace mir
+{
+namespace scene
+{
+/// Leaves surfaces on screen alone and stops occluded surfaces rendering frames nobody sees
+class DefaultFrameRatePolicy : public FrameRatePolicy
+{
+public:
+    std::chrono::milliseconds frame_interval_for(
+        MirWindowType type,
+        MirWindowFocusState focus,
+        MirWindowVisibility visibility) const override;
+};
+}
+}
+
+#endif // MIR_SCENE_DEFAULT_FRAME_RATE_POLICY_H_
@@ -0,0 +1,134 @@
+/*
+ * Copyright © 2017 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "frame_rate_governor.h"
+#include "mir/scene/frame_rate_policy.h"
+#include "mir/scene/null_surface_observer.h"
+#include "mir/scene/surface.h"
+
+#include <atomic>
+
+namespace ms = mir::scene;
+
+class ms::FrameRateGovernor::SurfaceTracker : public NullSurfaceObserver
+{
+public:
+    SurfaceTracker(FrameRatePolicy const& policy, Surface& surface) :
+        policy{policy},
+        surface{surface}
+    {
+    }
+
+    void attrib_changed(Surface const*, MirWindowAttrib attrib, int) override
+    {
+        switch (attrib)
+        {
+        case mir_window_attrib_type:
+        case mir_window_attrib_focus:
+        case mir_window_attrib_visibility:
+            apply_policy();
+            break;
+
+        default:
+            break;
+        }
+    }
+
+    void apply_policy()
+    {
+        auto visibility = static_cast<MirWindowVisibility>(surface.query(mir_window_attrib_visibility));
+
+        // Surfaces start out "occluded" until the compositor first shows them,
+        // which is no reason to hold back the client drawing its first frames.
+        if (visibility == mir_window_visibility_exposed)
+            exposed_once = true;
+        else if (!exposed_once)
+            visibility = mir_window_visibility_exposed;
+
+        surface.set_frame_interval(policy.frame_interval_for(
+            surface.type(),
+            static_cast<MirWindowFocusState>(surface.query(mir_window_attrib_focus)),
+            visibility));
+    }
+
+private:
+    FrameRatePolicy const& policy;
+    Surface& surface;
+    std::atomic<bool> exposed_once{false};
+};
+
+ms::FrameRateGovernor::FrameRateGovernor(std::shared_ptr<FrameRatePolicy> const& policy) :
+    policy{policy}
+{
+}
+
+void ms::FrameRateGovernor::surface_added(Surface* surface)
+{
+    track(surface);
+}
+
+void ms::FrameRateGovernor::surface_exists(Surface* surface)
+{
+    track(surface);
+}
+
+void ms::FrameRateGovernor::surface_removed(Surface* surface)
+{
+    std::shared_ptr<SurfaceTracker> tracker;
+    {
+        std::lock_guard<std::mutex> lock{mutex};
+        auto const i = trackers.find(surface);
+        if (i == trackers.end())
+            return;
+
+        tracker = i->second;
+        trackers.erase(i);
+    }
+
+    surface->remove_observer(tracker);
+}
+
+void ms::FrameRateGovernor::surfaces_reordered()
+{
+}
+
+void ms::FrameRateGovernor::scene_changed()
+{
+}
+
+void ms::FrameRateGovernor::end_observation()
+{
+    decltype(trackers) removed;
+    {
+        std::lock_guard<std::mutex> lock{mutex};
+        removed.swap(trackers);
+    }
+
+    for (auto const& tracker : removed)
+        tracker.first->remove_observer(tracker.second);
+}
+
+void ms::FrameRateGovernor::track(Surface* surface)
+{
+    auto const tracker = std::make_shared<SurfaceTracker>(*policy, *surface);
+    {
+        std::lock_guard<std::mutex> lock{mutex};
+        trackers[surface] = tracker;
+    }
+
+    surface->add_observer(tracker);
+    tracker->apply_policy();
+}
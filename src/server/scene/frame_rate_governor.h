@@ -0,0 +1,58 @@
+/*
+ * Copyright © 2017 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MIR_SCENE_FRAME_RATE_GOVERNOR_H_
+#define MIR_SCENE_FRAME_RATE_GOVERNOR_H_
+
+#include "mir/scene/observer.h"
+
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+namespace mir
+{
+namespace scene
+{
+class FrameRatePolicy;
+
+/// Applies the FrameRatePolicy to each surface in the scene as its type, focus or visibility change
+class FrameRateGovernor : public Observer
+{
+public:
+    FrameRateGovernor(std::shared_ptr<FrameRatePolicy> const& policy);
+
+    void surface_added(Surface* surface) override;
+    void surface_removed(Surface* surface) override;
+    void surfaces_reordered() override;
+    void scene_changed() override;
+    void surface_exists(Surface* surface) override;
+    void end_observation() override;
+
+private:
+    class SurfaceTracker;
+
+    void track(Surface* surface);
+
+    std::shared_ptr<FrameRatePolicy> const policy;
+
+    std::mutex mutex;
+    std::unordered_map<Surface*, std::shared_ptr<SurfaceTracker>> trackers;
+};
+}
+}
+
+#endif // MIR_SCENE_FRAME_RATE_GOVERNOR_H_
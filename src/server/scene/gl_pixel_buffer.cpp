@@ -17,6 +17,7 @@
  */
 
 #include "gl_pixel_buffer.h"
+#include "mir/scene/memory_report.h"
 #include "mir/graphics/buffer.h"
 #include "mir/renderer/gl/context.h"
 #include "mir/renderer/gl/texture_source.h"
@@ -49,8 +50,11 @@ inline uint32_t abgr_to_argb(uint32_t p)
 
 }
 
-ms::GLPixelBuffer::GLPixelBuffer(std::unique_ptr<renderer::gl::Context> gl_context)
+ms::GLPixelBuffer::GLPixelBuffer(
+    std::unique_ptr<renderer::gl::Context> gl_context,
+    std::shared_ptr<MemoryReport> const& memory_report)
     : gl_context{std::move(gl_context)},
+      memory_report{memory_report},
       tex{0}, fbo{0}, gl_pixel_format{0}, pixels_need_y_flip{false}
 {
     /*
@@ -62,6 +66,9 @@ ms::GLPixelBuffer::GLPixelBuffer(std::unique_ptr<renderer::gl::Context> gl_conte
         BOOST_THROW_EXCEPTION(std::runtime_error(
             "GLPixelBuffer doesn't support big endian architectures"));
     }
+
+    // Snapshots of every session share the pixels, so they are their own owner
+    memory_report->owner_created(this, nullptr, "snapshots");
 }
 
 ms::GLPixelBuffer::~GLPixelBuffer() noexcept
@@ -77,6 +84,8 @@ ms::GLPixelBuffer::~GLPixelBuffer() noexcept
         glDeleteTextures(1, &tex);
     if (fbo != 0)
         glDeleteFramebuffers(1, &fbo);
+
+    memory_report->owner_destroyed(this);
 }
 
 void ms::GLPixelBuffer::prepare()
@@ -100,7 +109,13 @@ void ms::GLPixelBuffer::fill_from(graphics::Buffer& buffer)
     auto width = buffer.size().width.as_uint32_t();
     auto height = buffer.size().height.as_uint32_t();
 
+    auto const capacity = pixels.capacity();
     pixels.resize(width * height * 4);
+    if (pixels.capacity() != capacity)
+    {
+        memory_report->released(this, MemoryReport::Category::snapshots, capacity);
+        memory_report->allocated(this, MemoryReport::Category::snapshots, pixels.capacity());
+    }
 
     prepare();
 
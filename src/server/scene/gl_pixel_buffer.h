@@ -42,11 +42,15 @@ class Context;
 
 namespace scene
 {
+class MemoryReport;
+
 /** Extracts the pixels from a graphics::Buffer using GL facilities. */
 class GLPixelBuffer : public PixelBuffer
 {
 public:
-    GLPixelBuffer(std::unique_ptr<renderer::gl::Context> gl_context);
+    GLPixelBuffer(
+        std::unique_ptr<renderer::gl::Context> gl_context,
+        std::shared_ptr<MemoryReport> const& memory_report);
     ~GLPixelBuffer() noexcept;
 
     void fill_from(graphics::Buffer& buffer);
@@ -59,6 +63,7 @@ private:
     void copy_and_convert_pixel_line(char* src, char* dst);
 
     std::unique_ptr<renderer::gl::Context> const gl_context;
+    std::shared_ptr<MemoryReport> const memory_report;
     GLuint tex;
     GLuint fbo;
     std::vector<char> pixels;
@@ -59,6 +59,11 @@ void ms::GlobalEventSender::send_ping(int32_t)
     // Ping events are per-application session.
 }
 
+void ms::GlobalEventSender::send_vsync(mir::frontend::SurfaceId, uint32_t, mg::Frame const&)
+{
+    // Vsync events are per-surface.
+}
+
 void ms::GlobalEventSender::send_buffer(mir::frontend::BufferStreamId, mg::Buffer&, mg::BufferIpcMsgType)
 {
 }
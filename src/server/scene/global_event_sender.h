@@ -39,6 +39,7 @@ public:
     void handle_error(ClientVisibleError const& error) override;
     void handle_input_config_change(MirInputConfig const& config) override;
     void send_ping(int32_t serial) override;
+    void send_vsync(frontend::SurfaceId id, uint32_t output_id, graphics::Frame const& frame) override;
     void send_buffer(frontend::BufferStreamId id, graphics::Buffer& buffer, graphics::BufferIpcMsgType) override;
     void add_buffer(graphics::Buffer&) override;
     void update_buffer(graphics::Buffer&) override;
@@ -0,0 +1,247 @@
+/*
+ * Copyright © 2017 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "input_region_index.h"
+
+#include "mir/scene/surface.h"
+#include "mir/scene/null_surface_observer.h"
+
+#include <algorithm>
+
+namespace ms = mir::scene;
+namespace geom = mir::geometry;
+
+namespace
+{
+int const cell_size{256};
+
+// Surfaces spanning more cells than this are not listed per cell
+int const max_cells_per_surface{64};
+
+int cell_of(int coordinate)
+{
+    // Round towards negative infinity so cells don't straddle the axes
+    return coordinate >= 0 ? coordinate / cell_size : -((-coordinate - 1) / cell_size) - 1;
+}
+
+uint64_t key_for(int cell_x, int cell_y)
+{
+    return (uint64_t(uint32_t(cell_x)) << 32) | uint32_t(cell_y);
+}
+}
+
+class ms::InputRegionIndex::BoundsTracker : public ms::NullSurfaceObserver
+{
+public:
+    BoundsTracker(InputRegionIndex* index) : index{index} {}
+
+    void resized_to(Surface const* surface, geom::Size const&) override
+    {
+        index->update_bounds(surface);
+    }
+
+    void moved_to(Surface const* surface, geom::Point const&) override
+    {
+        index->update_bounds(surface);
+    }
+
+    void input_region_set_to(Surface const* surface, std::vector<geom::Rectangle> const&) override
+    {
+        index->update_bounds(surface);
+    }
+
+private:
+    InputRegionIndex* const index;
+};
+
+ms::InputRegionIndex::InputRegionIndex() :
+    next_depth{0}
+{
+}
+
+ms::InputRegionIndex::~InputRegionIndex()
+{
+    for (auto const& entry : entries)
+        entry.second->surface->remove_observer(entry.second->tracker);
+}
+
+void ms::InputRegionIndex::insert(std::shared_ptr<Surface> const& surface)
+{
+    auto const tracker = std::make_shared<BoundsTracker>(this);
+
+    // Start tracking before reading the bounds so that no move is missed
+    surface->add_observer(tracker);
+
+    {
+        std::lock_guard<std::mutex> lock{mutex};
+
+        auto& entry = entries[surface.get()];
+        if (!entry)
+        {
+            entry.reset(new Entry{surface, tracker, surface->input_region_bounds(), next_depth++, false});
+            add_to_cells(entry.get());
+            return;
+        }
+    }
+
+    // Already indexed. Observers are removed without the index locked as
+    // removal waits for notifications in progress, which lock the index.
+    surface->remove_observer(tracker);
+}
+
+void ms::InputRegionIndex::erase(Surface const* surface)
+{
+    std::unique_ptr<Entry> removed;
+    {
+        std::lock_guard<std::mutex> lock{mutex};
+
+        auto const found = entries.find(surface);
+        if (found == entries.end())
+            return;
+
+        remove_from_cells(found->second.get());
+        removed = std::move(found->second);
+        entries.erase(found);
+    }
+
+    removed->surface->remove_observer(removed->tracker);
+}
+
+void ms::InputRegionIndex::restack(std::vector<std::shared_ptr<Surface>> const& surfaces)
+{
+    std::lock_guard<std::mutex> lock{mutex};
+
+    next_depth = 0;
+    for (auto const& surface : surfaces)
+    {
+        auto const found = entries.find(surface.get());
+        if (found != entries.end())
+            found->second->depth = next_depth++;
+    }
+}
+
+auto ms::InputRegionIndex::top_surface_at(geom::Point point) const -> std::shared_ptr<Surface>
+{
+    std::vector<std::pair<uint64_t, std::shared_ptr<Surface>>> candidates;
+    {
+        std::lock_guard<std::mutex> lock{mutex};
+
+        auto const add_candidates = [&](std::vector<Entry*> const& listed)
+            {
+                for (auto const entry : listed)
+                {
+                    if (entry->bounds.contains(point))
+                        candidates.emplace_back(entry->depth, entry->surface);
+                }
+            };
+
+        auto const cell = cells.find(key_for(cell_of(point.x.as_int()), cell_of(point.y.as_int())));
+        if (cell != cells.end())
+            add_candidates(cell->second);
+        add_candidates(oversized);
+    }
+
+    // Surfaces lock themselves to test their input area, so that happens
+    // without the index locked
+    std::sort(begin(candidates), end(candidates),
+        [](auto const& lhs, auto const& rhs) { return lhs.first > rhs.first; });
+
+    for (auto const& candidate : candidates)
+    {
+        if (candidate.second->input_area_contains(point))
+            return candidate.second;
+    }
+
+    return {};
+}
+
+void ms::InputRegionIndex::update_bounds(Surface const* surface)
+{
+    std::lock_guard<std::mutex> lock{mutex};
+
+    auto const found = entries.find(surface);
+    if (found == entries.end())
+        return;
+
+    auto const entry = found->second.get();
+    auto const bounds = entry->surface->input_region_bounds();
+
+    if (bounds == entry->bounds)
+        return;
+
+    remove_from_cells(entry);
+    entry->bounds = bounds;
+    add_to_cells(entry);
+}
+
+template<typename Action>
+void ms::InputRegionIndex::for_each_cell(geom::Rectangle const& bounds, Action const& action)
+{
+    auto const bottom_right = bounds.bottom_right();
+    auto const left = cell_of(bounds.top_left.x.as_int());
+    auto const top = cell_of(bounds.top_left.y.as_int());
+    auto const right = cell_of(bottom_right.x.as_int() - 1);
+    auto const bottom = cell_of(bottom_right.y.as_int() - 1);
+
+    for (auto y = top; y <= bottom; ++y)
+        for (auto x = left; x <= right; ++x)
+            action(key_for(x, y));
+}
+
+void ms::InputRegionIndex::add_to_cells(Entry* entry)
+{
+    auto const& bounds = entry->bounds;
+
+    if (bounds.size.width.as_int() <= 0 || bounds.size.height.as_int() <= 0)
+    {
+        entry->oversized = false;
+        return;
+    }
+
+    auto const columns = cell_of(bounds.bottom_right().x.as_int() - 1) - cell_of(bounds.top_left.x.as_int()) + 1;
+    auto const rows = cell_of(bounds.bottom_right().y.as_int() - 1) - cell_of(bounds.top_left.y.as_int()) + 1;
+
+    entry->oversized = int64_t(columns) * rows > max_cells_per_surface;
+
+    if (entry->oversized)
+        oversized.push_back(entry);
+    else
+        for_each_cell(bounds, [&](CellKey key) { cells[key].push_back(entry); });
+}
+
+void ms::InputRegionIndex::remove_from_cells(Entry* entry)
+{
+    auto const& bounds = entry->bounds;
+
+    if (entry->oversized)
+    {
+        oversized.erase(std::remove(begin(oversized), end(oversized), entry), end(oversized));
+    }
+    else if (bounds.size.width.as_int() > 0 && bounds.size.height.as_int() > 0)
+    {
+        for_each_cell(bounds, [&](CellKey key)
+            {
+                auto const cell = cells.find(key);
+                if (cell == cells.end())
+                    return;
+
+                auto& listed = cell->second;
+                listed.erase(std::remove(begin(listed), end(listed), entry), end(listed));
+                if (listed.empty())
+                    cells.erase(cell);
+            });
+    }
+}
@@ -0,0 +1,93 @@
+/*
+ * Copyright © 2017 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MIR_SCENE_INPUT_REGION_INDEX_H_
+#define MIR_SCENE_INPUT_REGION_INDEX_H_
+
+#include "mir/geometry/point.h"
+#include "mir/geometry/rectangle.h"
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace mir
+{
+namespace scene
+{
+class Surface;
+
+/**
+ * A spatial index of the input region bounds of the surfaces in a stack.
+ *
+ * The plane is divided into a grid of square cells and each surface is
+ * listed in the cells its input region bounds overlap, so a hit test only
+ * needs to consider the surfaces listed in a single cell. Surfaces covering
+ * too many cells to be worth listing are kept aside and always considered.
+ *
+ * The index follows the surfaces it contains as they move, resize or change
+ * input region, but the stacking order has to be supplied by the owner
+ * through restack().
+ */
+class InputRegionIndex
+{
+public:
+    InputRegionIndex();
+    ~InputRegionIndex();
+
+    /// Adds a surface above all those already in the index
+    void insert(std::shared_ptr<Surface> const& surface);
+    void erase(Surface const* surface);
+
+    /// Sets the stacking order, bottom to top, of the surfaces in the index
+    void restack(std::vector<std::shared_ptr<Surface>> const& surfaces);
+
+    /// The topmost surface whose input area contains the point
+    auto top_surface_at(geometry::Point point) const -> std::shared_ptr<Surface>;
+
+private:
+    InputRegionIndex(InputRegionIndex const&) = delete;
+    InputRegionIndex& operator=(InputRegionIndex const&) = delete;
+
+    class BoundsTracker;
+    struct Entry
+    {
+        std::shared_ptr<Surface> const surface;
+        std::shared_ptr<BoundsTracker> const tracker;
+        geometry::Rectangle bounds;
+        uint64_t depth;
+        bool oversized;
+    };
+    using CellKey = uint64_t;
+
+    void update_bounds(Surface const* surface);
+    void add_to_cells(Entry* entry);
+    void remove_from_cells(Entry* entry);
+    template<typename Action>
+    void for_each_cell(geometry::Rectangle const& bounds, Action const& action);
+
+    std::mutex mutable mutex;
+    std::unordered_map<Surface const*, std::unique_ptr<Entry>> entries;
+    std::unordered_map<CellKey, std::vector<Entry*>> cells;
+    std::vector<Entry*> oversized;
+    uint64_t next_depth;
+};
+}
+}
+
+#endif /* MIR_SCENE_INPUT_REGION_INDEX_H_ */
@@ -46,7 +46,7 @@ void ms::LegacySurfaceChangeNotification::hidden_set_to(Surface const*, bool)
     notify_scene_change();
 }
 
-void ms::LegacySurfaceChangeNotification::frame_posted(Surface const*, int frames_available, geometry::Size const&)
+void ms::LegacySurfaceChangeNotification::frame_posted(Surface const*, int frames_available, geometry::Rectangle const&)
 {
     notify_buffer_change(frames_available);
 }
@@ -113,3 +113,8 @@ void ms::LegacySurfaceChangeNotification::input_consumed(Surface const*, MirEven
 void ms::LegacySurfaceChangeNotification::start_drag_and_drop(Surface const*, std::vector<uint8_t> const&)
 {
 }
+
+// The input region is not drawn, so changing it does not need recomposition.
+void ms::LegacySurfaceChangeNotification::input_region_set_to(Surface const*, std::vector<geometry::Rectangle> const&)
+{
+}
@@ -149,7 +149,8 @@ std::shared_ptr<ms::Session> ms::SessionManager::open_session(
             observers,
             *display->configuration(),
             sender,
-            allocator);
+            allocator,
+            display);
 
     app_container->insert_session(new_session);
 
@@ -22,6 +22,8 @@
 #include "mir/events/event_builders.h"
 #include "output_properties_cache.h"
 
+#include "mir/graphics/display.h"
+
 #include "mir/geometry/size.h"
 #include "mir/geometry/rectangle.h"
 
@@ -32,15 +34,33 @@ namespace ms = mir::scene;
 namespace mev = mir::events;
 namespace geom = mir::geometry;
 
+namespace
+{
+// The client knows the period from the output's refresh rate, so an
+// occasional vblank is enough to keep it in phase with the display
+std::chrono::seconds const vsync_resync_interval{1};
+}
+
 ms::SurfaceEventSource::SurfaceEventSource(
     frontend::SurfaceId id,
     Surface const& surface,
     OutputPropertiesCache const& outputs,
     std::shared_ptr<frontend::EventSink> const& event_sink) :
+    SurfaceEventSource(id, surface, outputs, event_sink, nullptr)
+{
+}
+
+ms::SurfaceEventSource::SurfaceEventSource(
+    frontend::SurfaceId id,
+    Surface const& surface,
+    OutputPropertiesCache const& outputs,
+    std::shared_ptr<frontend::EventSink> const& event_sink,
+    std::shared_ptr<graphics::Display const> const& display) :
     id(id),
     surface{surface},
     outputs{outputs},
-    event_sink(event_sink)
+    event_sink(event_sink),
+    display{display}
 {
 }
 
@@ -52,8 +72,13 @@ void ms::SurfaceEventSource::resized_to(Surface const*, geometry::Size const& si
 void ms::SurfaceEventSource::moved_to(Surface const*, geometry::Point const& top_left)
 {
     auto new_output_properties = outputs.properties_for(geom::Rectangle{top_left, surface.size()});
+
+    std::unique_lock<std::mutex> lock{mutex};
     if (new_output_properties && (new_output_properties != last_output.lock()))
     {
+        last_output = new_output_properties;
+        lock.unlock();
+
         event_sink->handle_event(*mev::make_event(
             id,
             new_output_properties->dpi,
@@ -62,7 +87,6 @@ void ms::SurfaceEventSource::moved_to(Surface const*, geometry::Point const& top
             new_output_properties->form_factor,
             static_cast<uint32_t>(new_output_properties->id.as_value())
         ));
-        last_output = new_output_properties;
     }
 }
 
@@ -108,3 +132,35 @@ void ms::SurfaceEventSource::start_drag_and_drop(Surface const*, std::vector<uin
 {
     event_sink->handle_event(*mev::make_start_drag_and_drop_event(id, handle));
 }
+
+void ms::SurfaceEventSource::frame_posted(Surface const*, int, geometry::Rectangle const&)
+{
+    if (!display)
+        return;
+
+    std::unique_lock<std::mutex> lock{mutex};
+
+    auto const output = last_output.lock();
+    if (!output)
+        return;
+
+    auto const output_id = output->id.as_value();
+    auto const frame = display->last_frame_on(output_id);
+
+    // Not every platform knows when its vblanks happen
+    if (frame.msc == 0)
+        return;
+
+    if (output_id == vsync_output_id &&
+        frame.ust.clock_id == last_vsync.ust.clock_id &&
+        frame.ust - last_vsync.ust < vsync_resync_interval)
+    {
+        return;
+    }
+
+    vsync_output_id = output_id;
+    last_vsync = frame;
+    lock.unlock();
+
+    event_sink->send_vsync(id, static_cast<uint32_t>(output_id), frame);
+}
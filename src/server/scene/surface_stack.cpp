@@ -228,6 +228,7 @@ void ms::SurfaceStack::add_surface(
     {
         RecursiveWriteLock lg(guard);
         surfaces.push_back(surface);
+        input_regions.insert(surface);
         create_rendering_tracker_for(surface);
     }
     surface->set_reception_mode(input_mode);
@@ -249,6 +250,7 @@ void ms::SurfaceStack::remove_surface(std::weak_ptr<Surface> const& surface)
         if (surface != surfaces.end())
         {
             surfaces.erase(surface);
+            input_regions.erase(keep_alive.get());
             rendering_trackers.erase(keep_alive.get());
             found_surface = true;
         }
@@ -263,34 +265,20 @@ void ms::SurfaceStack::remove_surface(std::weak_ptr<Surface> const& surface)
     // TODO: error logging when surface not found
 }
 
-namespace
-{
-template <typename Container>
-struct InReverse {
-    Container& container;
-    auto begin() -> decltype(container.rbegin()) { return container.rbegin(); }
-    auto end() -> decltype(container.rend()) { return container.rend(); }
-};
-
-template <typename Container>
-InReverse<Container> in_reverse(Container& container) { return InReverse<Container>{container}; }
-}
-
 auto ms::SurfaceStack::surface_at(geometry::Point cursor) const
 -> std::shared_ptr<Surface>
 {
-    RecursiveReadLock lg(guard);
-    for (auto const& surface : in_reverse(surfaces))
-    {
-        // TODO There's a lack of clarity about how the input area will
-        // TODO be maintained and whether this test will detect clicks on
-        // TODO decorations (it should) as these may be outside the area
-        // TODO known to the client.  But it works for now.
-        if (surface->input_area_contains(cursor))
-                return surface;
-    }
+    // TODO There's a lack of clarity about how the input area will
+    // TODO be maintained and whether this test will detect clicks on
+    // TODO decorations (it should) as these may be outside the area
+    // TODO known to the client.  But it works for now.
+    return input_regions.top_surface_at(cursor);
+}
 
-    return {};
+auto ms::SurfaceStack::input_surface_at(geometry::Point const& point)
+-> std::shared_ptr<mi::Surface>
+{
+    return input_regions.top_surface_at(point);
 }
 
 void ms::SurfaceStack::for_each(std::function<void(std::shared_ptr<mi::Surface> const&)> const& callback)
@@ -316,6 +304,7 @@ void ms::SurfaceStack::raise(std::weak_ptr<Surface> const& s)
         {
             surfaces.erase(p);
             surfaces.push_back(surface);
+            input_regions.restack(surfaces);
             surfaces_reordered = true;
         }
     }
@@ -339,7 +328,10 @@ void ms::SurfaceStack::raise(SurfaceSet const& ss)
             [&](std::weak_ptr<Surface> const& s) { return !ss.count(s); });
 
         if (old_surfaces != surfaces)
+        {
+            input_regions.restack(surfaces);
             surfaces_reordered = true;
+        }
     }
 
     if (surfaces_reordered)
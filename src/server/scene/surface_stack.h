@@ -25,6 +25,7 @@
 #include "mir/scene/observer.h"
 #include "mir/input/scene.h"
 #include "mir/recursive_read_write_mutex.h"
+#include "input_region_index.h"
 
 #include "mir/basic_observers.h"
 
@@ -79,6 +80,7 @@ public:
 
     // From Scene
     void for_each(std::function<void(std::shared_ptr<input::Surface> const&)> const& callback) override;
+    auto input_surface_at(geometry::Point const& point) -> std::shared_ptr<input::Surface> override;
 
     virtual void remove_surface(std::weak_ptr<Surface> const& surface) override;
 
@@ -112,6 +114,7 @@ private:
     std::shared_ptr<SceneReport> const report;
 
     std::vector<std::shared_ptr<Surface>> surfaces;
+    InputRegionIndex input_regions;
     std::map<Surface*,std::shared_ptr<RenderingTracker>> rendering_trackers;
     std::set<compositor::CompositorID> registered_compositors;
     
@@ -18,6 +18,8 @@
 
 #include "mir/server.h"
 
+#include "mir/abnormal_exit.h"
+#include "mir/cached_ptr.h"
 #include "mir/emergency_cleanup.h"
 #include "mir/fd.h"
 #include "mir/frontend/connector.h"
@@ -33,6 +35,7 @@
 #include "mir/main_loop.h"
 #include "mir/report_exception.h"
 #include "mir/run_mir.h"
+#include "mir/startup_profiler.h"
 #include "mir/cookie/authority.h"
 
 // TODO these are used to frig a stub renderer when running headless
@@ -42,13 +45,95 @@
 
 #include "frontend_wayland/wayland_connector.h"
 
+#include <fstream>
+#include <future>
 #include <iostream>
 
 namespace mo = mir::options;
 namespace mi = mir::input;
+namespace ml = mir::logging;
 
 namespace
 {
+ml::Severity parse_severity_option(std::string const& opt)
+{
+    static std::pair<char const*, ml::Severity> const severities[] = {
+        {"critical", ml::Severity::critical},
+        {"error", ml::Severity::error},
+        {"warning", ml::Severity::warning},
+        {"informational", ml::Severity::informational},
+        {"debug", ml::Severity::debug}};
+
+    for (auto const& severity : severities)
+    {
+        if (opt == severity.first)
+            return severity.second;
+    }
+
+    throw mir::AbnormalExit(std::string("Invalid ") + mo::log_severity_opt + " option: " + opt +
+        " (valid options are: \"critical\", \"error\", \"warning\", \"informational\" and \"debug\")");
+}
+
+void write_startup_profile_to(std::string const& filename)
+{
+    std::ofstream out{filename};
+    mir::write_startup_profile(out);
+
+    if (!out)
+        mir::log_warning("Failed to write startup profile to %s", filename.c_str());
+}
+
+/*
+ * Starts constructing the subsystems that don't need the display to be
+ * ready on startup threads. These all depend on the graphics platform (for
+ * input platform probing, IPC operations and buffer allocation), so the
+ * caller must have constructed it first. The main thread then constructs
+ * the display and compositor, and picks up whatever these threads have
+ * built (or waits for them) when it reaches them. CachedPtr ensures nothing
+ * is constructed twice.
+ *
+ * The startup threads construct speculatively, backing off rather than
+ * waiting for anything the main thread is constructing, so they cannot
+ * deadlock with it. Whatever they fail to construct is left for the main
+ * thread to construct (and report any failure) when it reaches it.
+ */
+std::vector<std::future<std::shared_ptr<void>>> construct_in_parallel(mir::DefaultServerConfiguration& config)
+{
+    std::vector<std::function<std::shared_ptr<void>()>> const subsystems{
+        [&config] { return config.the_input_manager(); },
+        [&config] { return config.the_connector(); },
+        [&config] { return config.the_prompt_connector(); },
+        [&config] { return config.the_wayland_connector(); }};
+
+    std::vector<std::future<std::shared_ptr<void>>> result;
+    for (auto const& subsystem : subsystems)
+    {
+        result.push_back(std::async(std::launch::async, [subsystem]() -> std::shared_ptr<void>
+            {
+                mir::SpeculativeConstruction const speculative;
+                try
+                {
+                    return subsystem();
+                }
+                catch (mir::ConstructionInProgress const&)
+                {
+                    // The main thread got there first
+                }
+                catch (std::exception const& error)
+                {
+                    mir::log_warning("Failed to construct a subsystem on a startup thread: %s", error.what());
+                }
+                catch (...)
+                {
+                    mir::log_warning("Failed to construct a subsystem on a startup thread");
+                }
+                return {};
+            }));
+    }
+
+    return result;
+}
+
 struct TemporaryCompositeEventFilter : public mi::CompositeEventFilter
 {
     bool handle(MirEvent const&) override { return false; }
@@ -104,7 +189,8 @@ struct TemporaryCompositeEventFilter : public mi::CompositeEventFilter
     MACRO(application_not_responding_detector)\
     MACRO(cookie_authority)\
     MACRO(coordinate_translator) \
-    MACRO(persistent_surface_store)
+    MACRO(persistent_surface_store)\
+    MACRO(frame_rate_policy)
 
 #define FOREACH_ACCESSOR(MACRO)\
     MACRO(the_buffer_stream_factory)\
@@ -386,7 +472,11 @@ void mir::Server::apply_settings()
     self->server_config = config;
     self->options = config->the_options();
 
-    mir::logging::set_logger(config->the_logger());
+    if (config->the_options()->is_set(mo::startup_profile_opt))
+        mir::enable_startup_profile();
+
+    ml::set_max_severity(parse_severity_option(config->the_options()->get<std::string>(mo::log_severity_opt)));
+    ml::set_logger(config->the_logger());
 }
 
 void mir::Server::run()
@@ -406,10 +496,24 @@ void mir::Server::run()
 
         self->pre_init_callback();
 
+        // Holds the subsystems constructed in parallel until the DisplayServer owns them
+        std::shared_ptr<void> graphics_platform;
+        std::vector<std::future<std::shared_ptr<void>>> constructing;
+        if (self->server_config->the_options()->get<bool>(mo::parallel_startup_opt))
+        {
+            // Platform probing stays on the main thread, ahead of everything that needs it
+            graphics_platform = self->server_config->the_graphics_platform();
+            constructing = construct_in_parallel(*self->server_config);
+        }
+
         run_mir(
             *self->server_config,
             [&](DisplayServer&)
-                { self->init_callback(); },
+                {
+                    constructing.clear();
+                    graphics_platform.reset();
+                    self->init_callback();
+                },
             self->terminator);
 
         self->exit_status = true;
@@ -421,6 +525,10 @@ void mir::Server::run()
         else
             mir::report_exception(std::cerr);
     }
+
+    if (self->server_config && self->server_config->the_options()->is_set(mo::startup_profile_opt))
+        write_startup_profile_to(self->server_config->the_options()->get<std::string>(mo::startup_profile_opt));
+
     /*
      * The server_config *must* outlive exception processing as it holds references to
      * the loaded platforms, and those references are keeping the DSOs loaded.
@@ -68,7 +68,7 @@ public:
     MOCK_METHOD2(resized_to, void(msc::Surface const*, geom::Size const& size));
     MOCK_METHOD2(moved_to, void(msc::Surface const*, geom::Point const& top_left));
     MOCK_METHOD2(hidden_set_to, void(msc::Surface const*, bool hide));
-    MOCK_METHOD3(frame_posted, void(msc::Surface const*, int frames_available, geom::Size const& size));
+    MOCK_METHOD3(frame_posted, void(msc::Surface const*, int frames_available, geom::Rectangle const& damage));
     MOCK_METHOD2(alpha_set_to, void(msc::Surface const*, float alpha));
     MOCK_METHOD2(orientation_set_to, void(msc::Surface const*, MirOrientation orientation));
     MOCK_METHOD2(transformation_set_to, void(msc::Surface const*, glm::mat4 const& t));
@@ -87,6 +87,7 @@ public:
     MOCK_METHOD2(placed_relative, void(msc::Surface const*, geom::Rectangle const& placement));
     MOCK_METHOD2(input_consumed, void(msc::Surface const*, MirEvent const*));
     MOCK_METHOD2(start_drag_and_drop, void(msc::Surface const*, std::vector<uint8_t> const& handle));
+    MOCK_METHOD2(input_region_set_to, void(msc::Surface const*, std::vector<geom::Rectangle> const& region));
 };
 
 
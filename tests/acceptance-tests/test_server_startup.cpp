@@ -20,6 +20,7 @@
 #include "mir_test_framework/interprocess_client_server_test.h"
 #include "mir_test_framework/headless_in_process_server.h"
 #include "mir_test_framework/detect_server.h"
+#include "mir_toolkit/mir_client_library.h"
 
 #include <chrono>
 #include <gmock/gmock.h>
@@ -94,3 +95,22 @@ TEST(ServerStartupReliability, can_start_with_low_entropy)
 
     server.TearDown();
 }
+
+TEST(ServerStartupReliability, can_start_with_parallel_startup)
+{
+    using namespace ::testing;
+
+    struct Server : mtf::HeadlessInProcessServer
+    {
+        Server() { add_to_environment("MIR_SERVER_PARALLEL_STARTUP", "true"); }
+        void TestBody() override {}
+    } server;
+
+    EXPECT_NO_THROW(server.SetUp(););
+
+    auto const connection = mir_connect_sync(server.new_connection().c_str(), __PRETTY_FUNCTION__);
+    EXPECT_TRUE(mir_connection_is_valid(connection));
+    mir_connection_release(connection);
+
+    server.TearDown();
+}
@@ -0,0 +1,45 @@
+/*
+ * Copyright © 2017 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 or 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MIR_TEST_DOUBLES_MOCK_BUFFER_LIFETIME_REPORT_H_
+#define MIR_TEST_DOUBLES_MOCK_BUFFER_LIFETIME_REPORT_H_
+
+#include "mir/compositor/buffer_lifetime_report.h"
+#include <gmock/gmock.h>
+
+namespace mir
+{
+namespace test
+{
+namespace doubles
+{
+
+class MockBufferLifetimeReport : public compositor::BufferLifetimeReport
+{
+public:
+    MOCK_METHOD2(buffer_submitted, void(StreamId, graphics::BufferID));
+    MOCK_METHOD3(buffer_acquired, void(StreamId, graphics::BufferID, compositor::CompositorID));
+    MOCK_METHOD2(buffer_released, void(StreamId, graphics::BufferID));
+    MOCK_METHOD1(stream_destroyed, void(StreamId));
+    MOCK_METHOD2(frame_interval_changed, void(StreamId, std::chrono::milliseconds));
+    MOCK_METHOD2(buffer_deferred, void(StreamId, graphics::BufferID));
+};
+
+}
+}
+}
+
+#endif /* MIR_TEST_DOUBLES_MOCK_BUFFER_LIFETIME_REPORT_H_ */
@@ -54,6 +54,8 @@ public:
                        std::vector<uint32_t>& possible_encoder_ids,
                        geometry::Size const& physical_size,
                        drmModeSubPixel subpixel_arrangement = DRM_MODE_SUBPIXEL_UNKNOWN);
+    /* A plane, with the "type", "FB_ID" and "CRTC_ID" properties atomic KMS uses */
+    void add_plane(uint32_t plane_id, uint32_t possible_crtcs_mask, uint64_t type);
 
     void prepare();
     void reset();
@@ -61,6 +63,13 @@ public:
     drmModeCrtc* find_crtc(uint32_t id);
     drmModeEncoder* find_encoder(uint32_t id);
     drmModeConnector* find_connector(uint32_t id);
+    drmModePlane* find_plane(uint32_t id);
+    drmModePlaneRes* plane_resources_ptr();
+    drmModeObjectProperties* find_object_properties(uint32_t object_id);
+    drmModePropertyRes* find_property(uint32_t property_id);
+
+    /* The id of the named property, which is the same for every object */
+    uint32_t property_id(char const* name);
 
     enum ModePreference {NormalMode, PreferredMode};
     static drmModeModeInfo create_mode(uint16_t hdisplay, uint16_t vdisplay,
@@ -82,6 +91,19 @@ private:
     std::vector<drmModeModeInfo> modes;
     std::vector<drmModeModeInfo> modes_empty;
     std::vector<uint32_t> connector_encoder_ids;
+
+    struct ObjectProperties
+    {
+        std::vector<uint32_t> ids;
+        std::vector<uint64_t> values;
+        drmModeObjectProperties props;
+    };
+
+    std::vector<drmModePlane> planes;
+    std::vector<uint32_t> plane_ids;
+    drmModePlaneRes plane_resources;
+    std::unordered_map<uint32_t, ObjectProperties> object_properties;
+    std::unordered_map<uint32_t, drmModePropertyRes> properties;
 };
 
 class MockDRM
@@ -125,6 +147,12 @@ public:
 
     MOCK_METHOD5(drmModePageFlip, int(int fd, uint32_t crtc_id, uint32_t fb_id,
                                                   uint32_t flags, void *user_data));
+    MOCK_METHOD0(drmModeAtomicAlloc, drmModeAtomicReqPtr());
+    MOCK_METHOD1(drmModeAtomicFree, void(drmModeAtomicReqPtr req));
+    MOCK_METHOD4(drmModeAtomicAddProperty, int(drmModeAtomicReqPtr req, uint32_t object_id,
+                                               uint32_t property_id, uint64_t value));
+    MOCK_METHOD4(drmModeAtomicCommit, int(int fd, drmModeAtomicReqPtr req,
+                                          uint32_t flags, void* user_data));
     MOCK_METHOD2(drmHandleEvent, int(int fd, drmEventContextPtr evctx));
 
     MOCK_METHOD3(drmGetCap, int(int fd, uint64_t capability, uint64_t *value));
@@ -178,6 +206,12 @@ public:
         std::vector<uint32_t>& possible_encoder_ids,
         geometry::Size const& physical_size,
         drmModeSubPixel subpixel_arrangement = DRM_MODE_SUBPIXEL_UNKNOWN);
+    void add_plane(
+        char const* device,
+        uint32_t plane_id,
+        uint32_t possible_crtcs_mask,
+        uint64_t type);
+    uint32_t property_id(char const* device, char const* name);
 
     void prepare(char const* device);
     void reset(char const* device);
@@ -191,6 +225,7 @@ private:
     std::unordered_map<std::string, FakeDRMResources> fake_drms;
     std::unordered_map<int, FakeDRMResources&> fd_to_drm;
     drmModeObjectProperties empty_object_props;
+    char fake_atomic_request;
 };
 
 testing::Matcher<int> IsFdOfDevice(char const* device);
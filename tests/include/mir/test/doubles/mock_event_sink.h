@@ -22,6 +22,7 @@
 #include "mir/frontend/event_sink.h"
 #include "mir/client_visible_error.h"
 #include "mir/graphics/display_configuration.h"
+#include "mir/graphics/frame.h"
 #include "mir/events/event_private.h"
 #include "mir/input/mir_input_config.h"
 
@@ -40,6 +41,7 @@ struct MockEventSink : public frontend::EventSink
     MOCK_METHOD1(handle_display_config_change, void(graphics::DisplayConfiguration const&));
     MOCK_METHOD1(handle_error, void(ClientVisibleError const&));
     MOCK_METHOD1(send_ping, void(int32_t));
+    MOCK_METHOD3(send_vsync, void(frontend::SurfaceId, uint32_t, graphics::Frame const&));
     MOCK_METHOD3(send_buffer, void(frontend::BufferStreamId, graphics::Buffer&, graphics::BufferIpcMsgType));
     MOCK_METHOD1(add_buffer, void(graphics::Buffer&));
     MOCK_METHOD1(update_buffer, void(graphics::Buffer&));
@@ -0,0 +1,44 @@
+/*
+ * Copyright © 2017 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 or 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MIR_TEST_DOUBLES_MOCK_BUFFER_LIFETIME_REPORT_H_
+#ifndef MIR_TEST_DOUBLES_MOCK_MEMORY_REPORT_H_
+#define MIR_TEST_DOUBLES_MOCK_MEMORY_REPORT_H_
+
+#include "mir/scene/memory_report.h"
+#include <gmock/gmock.h>
+
+namespace mir
+{
+namespace test
+{
+namespace doubles
+{
+
+class MockMemoryReport : public scene::MemoryReport
+{
+public:
+    MOCK_METHOD3(owner_created, void(Owner, Owner, std::string const&));
+    MOCK_METHOD1(owner_destroyed, void(Owner));
+    MOCK_METHOD3(allocated, void(Owner, Category, size_t));
+    MOCK_METHOD3(released, void(Owner, Category, size_t));
+};
+
+}
+}
+}
+
+#endif /* MIR_TEST_DOUBLES_MOCK_MEMORY_REPORT_H_ */
@@ -0,0 +1,48 @@
+/*
+ * Copyright © 2017 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MIR_TEST_DOUBLES_STUB_ALARM_FACTORY_H_
+#define MIR_TEST_DOUBLES_STUB_ALARM_FACTORY_H_
+
+#include "mir/time/alarm_factory.h"
+#include "mir/test/doubles/stub_alarm.h"
+
+namespace mir
+{
+namespace test
+{
+namespace doubles
+{
+
+class StubAlarmFactory : public time::AlarmFactory
+{
+public:
+    std::unique_ptr<time::Alarm> create_alarm(std::function<void()> const&) override
+    {
+        return std::make_unique<StubAlarm>();
+    }
+
+    std::unique_ptr<time::Alarm> create_alarm(std::unique_ptr<LockableCallback>) override
+    {
+        return std::make_unique<StubAlarm>();
+    }
+};
+
+}
+}
+}
+
+#endif // MIR_TEST_DOUBLES_STUB_ALARM_FACTORY_H_
@@ -63,6 +63,9 @@ public:
     {
         return false;
     }
+    void set_frame_interval(std::chrono::milliseconds) override
+    {
+    }
     int buffers_ready_for_compositor(void const*) const override { return nready; }
 
     void drop_old_buffers() override {}
@@ -126,6 +126,10 @@ struct StubDisplayServer : public mir::frontend::detail::DisplayServer
         mir::protobuf::BufferRequest const* /*request*/,
         mir::protobuf::Void* /*response*/,
         google::protobuf::Closure* /*done*/) override {}
+    void submit_transaction(
+        mir::protobuf::Transaction const* /*request*/,
+        mir::protobuf::Void* /*response*/,
+        google::protobuf::Closure* /*done*/) override {}
     void allocate_buffers(
         mir::protobuf::BufferAllocation const* /*request*/,
         mir::protobuf::Void* /*response*/,
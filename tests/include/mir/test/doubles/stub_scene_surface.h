@@ -47,6 +47,7 @@ public:
     geometry::Size client_size() const override { return {};}
     geometry::Size size() const override { return {}; }
     geometry::Rectangle input_bounds() const override { return {{},{}}; }
+    geometry::Rectangle input_region_bounds() const override { return {{},{}}; }
     bool input_area_contains(mir::geometry::Point const&) const override { return false; }
 
     void set_streams(std::list<scene::StreamInfo> const&) override {}
@@ -94,6 +95,7 @@ public:
     MirPointerConfinementState confine_pointer_state() const override { return {}; }
     void placed_relative(geometry::Rectangle const& /*placement*/) override {}
     void start_drag_and_drop(std::vector<uint8_t> const& /*handle*/) override {}
+    void set_frame_interval(std::chrono::milliseconds /*interval*/) override {}
 };
 
 }
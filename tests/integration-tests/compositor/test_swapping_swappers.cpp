@@ -19,6 +19,8 @@
 #include "multithread_harness.h"
 
 #include "src/server/compositor/stream.h"
+#include "src/server/report/null_report_factory.h"
+#include "mir/test/doubles/stub_alarm_factory.h"
 #include "mir/graphics/graphic_buffer_allocator.h"
 
 #include <gmock/gmock.h>
@@ -32,6 +34,7 @@ namespace mc = mir::compositor;
 namespace mf = mir::frontend;
 namespace mg = mir::graphics;
 namespace mt = mir::testing;
+namespace mtd = mir::test::doubles;
 namespace geom = mir::geometry;
 
 namespace
@@ -42,6 +45,8 @@ struct SwapperSwappingStress : public ::testing::Test
     void SetUp()
     {
         stream = std::make_shared<mc::Stream>(
+            mir::report::null_buffer_lifetime_report(),
+            std::make_shared<mtd::StubAlarmFactory>(),
             geom::Size{380, 210}, mir_pixel_format_abgr_8888);
     }
 
@@ -24,9 +24,11 @@
 #include "src/client/protobuf_to_native_buffer.h"
 #include "src/client/connection_surface_map.h"
 #include "src/server/compositor/stream.h"
+#include "src/server/report/null_report_factory.h"
 #include "mir/test/doubles/stub_client_buffer_factory.h"
 #include "mir/test/doubles/mock_client_buffer_factory.h"
 #include "mir/test/doubles/stub_buffer_allocator.h"
+#include "mir/test/doubles/stub_alarm_factory.h"
 #include "mir/test/fake_shared.h"
 #include "mir_protobuf.pb.h"
 #include <gtest/gtest.h>
@@ -210,6 +212,7 @@ struct StubEventSink : public mf::EventSink
     void handle_error(mir::ClientVisibleError const&) {}
     void handle_input_config_change(MirInputConfig const&) {}
     void send_ping(int32_t) {}
+    void send_vsync(mf::SurfaceId, uint32_t, mg::Frame const&) {}
 
     std::shared_ptr<StubIpcSystem> ipc;
 };
@@ -507,6 +510,8 @@ struct BufferScheduling : public Test, ::testing::WithParamInterface<int>
         ipc = std::make_shared<StubIpcSystem>();
         sink = std::make_shared<StubEventSink>(ipc);
         auto submit_stream = std::make_shared<mc::Stream>(
+            mir::report::null_buffer_lifetime_report(),
+            std::make_shared<mtd::StubAlarmFactory>(),
             geom::Size{100,100},
             mir_pixel_format_abgr_8888);
         auto weak_stream = std::weak_ptr<mc::Stream>(submit_stream);
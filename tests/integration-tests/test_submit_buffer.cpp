@@ -24,6 +24,7 @@
 #include "mir/test/doubles/stub_buffer_allocator.h"
 #include "mir/test/doubles/stub_display.h"
 #include "mir/test/doubles/null_platform.h"
+#include "mir/test/doubles/stub_alarm_factory.h"
 #include "mir/graphics/buffer_id.h"
 #include "mir/graphics/buffer_ipc_message.h"
 #include "mir/graphics/platform_operation_message.h"
@@ -32,6 +33,7 @@
 #include "mir/frontend/event_sink.h"
 #include "mir/compositor/buffer_stream.h"
 #include "src/server/compositor/stream.h"
+#include "src/server/report/null_report_factory.h"
 #include "mir_toolkit/mir_client_library.h"
 #include "mir_toolkit/debug/surface.h"
 #include "src/client/mir_connection.h"
@@ -79,7 +81,10 @@ struct StubStreamFactory : public msc::BufferStreamFactory
         mf::BufferStreamId,
         mg::BufferProperties const& properties) override
     {
-        return std::make_shared<mc::Stream>(properties.size, properties.format);
+        return std::make_shared<mc::Stream>(
+            mir::report::null_buffer_lifetime_report(),
+            std::make_shared<mtd::StubAlarmFactory>(),
+            properties.size, properties.format);
     }
 
     std::vector<mg::BufferID> const buffer_id_seq;
@@ -17,6 +17,7 @@
  */
 
 #include "mir/test/doubles/fake_alarm_factory.h"
+#include "mir/lockable_callback.h"
 
 #include <numeric>
 #include <algorithm>
@@ -147,9 +148,16 @@ std::unique_ptr<mt::Alarm> mtd::FakeAlarmFactory::create_alarm(
 }
 
 std::unique_ptr<mt::Alarm> mtd::FakeAlarmFactory::create_alarm(
-    std::unique_ptr<LockableCallback> /*callback*/)
+    std::unique_ptr<LockableCallback> callback)
 {
-    throw std::logic_error{"Lockable alarm creation not implemented for fake alarms"};
+    std::shared_ptr<LockableCallback> const shared_callback{std::move(callback)};
+
+    return create_alarm(
+        [shared_callback]
+        {
+            std::lock_guard<LockableCallback> lock{*shared_callback};
+            (*shared_callback)();
+        });
 }
 
 void mtd::FakeAlarmFactory::advance_by(mt::Duration step)
@@ -22,6 +22,7 @@
 #include <gtest/gtest.h>
 
 #include <stdexcept>
+#include <cstring>
 #include <unistd.h>
 #include <dlfcn.h>
 #include <system_error>
@@ -36,7 +37,8 @@ mtd::MockDRM* global_mock = nullptr;
 }
 
 mtd::FakeDRMResources::FakeDRMResources()
-    : pipe_fds{-1, -1}
+    : pipe_fds{-1, -1},
+      plane_resources()
 {
     /* Use the read end of a pipe as the fake DRM fd */
     if (pipe(pipe_fds) < 0 || pipe_fds[0] < 0)
@@ -127,6 +129,9 @@ void mtd::FakeDRMResources::reset()
     crtc_ids.clear();
     encoder_ids.clear();
     connector_ids.clear();
+
+    planes.clear();
+    object_properties.clear();
 }
 
 void mtd::FakeDRMResources::add_crtc(uint32_t id, drmModeModeInfo mode)
@@ -177,6 +182,25 @@ void mtd::FakeDRMResources::add_connector(uint32_t connector_id,
     connectors.push_back(connector);
 }
 
+void mtd::FakeDRMResources::add_plane(uint32_t plane_id, uint32_t possible_crtcs_mask, uint64_t type)
+{
+    drmModePlane plane = drmModePlane();
+
+    plane.plane_id = plane_id;
+    plane.possible_crtcs = possible_crtcs_mask;
+
+    planes.push_back(plane);
+
+    auto& props = object_properties[plane_id];
+    for (auto const& property : {std::make_pair("type", type),
+                                 std::make_pair("FB_ID", uint64_t{0}),
+                                 std::make_pair("CRTC_ID", uint64_t{0})})
+    {
+        props.ids.push_back(property_id(property.first));
+        props.values.push_back(property.second);
+    }
+}
+
 drmModeCrtc* mtd::FakeDRMResources::find_crtc(uint32_t id)
 {
     for (auto& crtc : crtcs)
@@ -208,6 +232,70 @@ drmModeConnector* mtd::FakeDRMResources::find_connector(uint32_t id)
 }
 
 
+drmModePlane* mtd::FakeDRMResources::find_plane(uint32_t id)
+{
+    for (auto& plane : planes)
+    {
+        if (plane.plane_id == id)
+            return &plane;
+    }
+    return nullptr;
+}
+
+drmModePlaneRes* mtd::FakeDRMResources::plane_resources_ptr()
+{
+    /* Without planes, behave like a driver without universal planes */
+    if (planes.empty())
+        return nullptr;
+
+    plane_ids.clear();
+    for (auto const& plane : planes)
+        plane_ids.push_back(plane.plane_id);
+
+    plane_resources.count_planes = plane_ids.size();
+    plane_resources.planes = plane_ids.data();
+
+    return &plane_resources;
+}
+
+drmModeObjectProperties* mtd::FakeDRMResources::find_object_properties(uint32_t object_id)
+{
+    auto const found = object_properties.find(object_id);
+    if (found == object_properties.end())
+        return nullptr;
+
+    auto& object = found->second;
+    object.props.count_props = object.ids.size();
+    object.props.props = object.ids.data();
+    object.props.prop_values = object.values.data();
+
+    return &object.props;
+}
+
+drmModePropertyRes* mtd::FakeDRMResources::find_property(uint32_t property_id)
+{
+    auto const found = properties.find(property_id);
+    return found != properties.end() ? &found->second : nullptr;
+}
+
+uint32_t mtd::FakeDRMResources::property_id(char const* name)
+{
+    for (auto const& property : properties)
+    {
+        if (strcmp(property.second.name, name) == 0)
+            return property.first;
+    }
+
+    uint32_t const id = 1000 + properties.size();
+
+    drmModePropertyRes property = drmModePropertyRes();
+    property.prop_id = id;
+    strncpy(property.name, name, sizeof property.name - 1);
+    properties[id] = property;
+
+    return id;
+}
+
 drmModeModeInfo mtd::FakeDRMResources::create_mode(uint16_t hdisplay, uint16_t vdisplay,
                                                    uint32_t clock, uint16_t htotal,
                                                    uint16_t vtotal,
@@ -296,8 +384,46 @@ mtd::MockDRM::MockDRM()
                     return fd_to_drm.at(fd).find_connector(connector_id);
                 }));
 
+    ON_CALL(*this, drmModeGetPlaneResources(_))
+        .WillByDefault(
+            Invoke(
+                [this](int fd) -> drmModePlaneRes*
+                {
+                    auto const drm = fd_to_drm.find(fd);
+                    return drm != fd_to_drm.end() ? drm->second.plane_resources_ptr() : nullptr;
+                }));
+
+    ON_CALL(*this, drmModeGetPlane(_, _))
+        .WillByDefault(
+            Invoke(
+                [this](int fd, uint32_t plane_id) -> drmModePlane*
+                {
+                    auto const drm = fd_to_drm.find(fd);
+                    return drm != fd_to_drm.end() ? drm->second.find_plane(plane_id) : nullptr;
+                }));
+
     ON_CALL(*this, drmModeObjectGetProperties(_, _, _))
-        .WillByDefault(Return(&empty_object_props));
+        .WillByDefault(
+            Invoke(
+                [this](int fd, uint32_t object_id, uint32_t)
+                {
+                    auto const drm = fd_to_drm.find(fd);
+                    auto const props = drm != fd_to_drm.end() ?
+                        drm->second.find_object_properties(object_id) : nullptr;
+                    return props ? props : &empty_object_props;
+                }));
+
+    ON_CALL(*this, drmModeGetProperty(_, _))
+        .WillByDefault(
+            Invoke(
+                [this](int fd, uint32_t property_id) -> drmModePropertyRes*
+                {
+                    auto const drm = fd_to_drm.find(fd);
+                    return drm != fd_to_drm.end() ? drm->second.find_property(property_id) : nullptr;
+                }));
+
+    ON_CALL(*this, drmModeAtomicAlloc())
+        .WillByDefault(Return(reinterpret_cast<drmModeAtomicReqPtr>(&fake_atomic_request)));
 
     ON_CALL(*this, drmSetInterfaceVersion(_, _))
     .WillByDefault(Return(0));
@@ -342,6 +468,20 @@ void mtd::MockDRM::add_encoder(
     fake_drms[device].add_encoder(encoder_id, crtc_id, possible_crtcs_mask);
 }
 
+void mtd::MockDRM::add_plane(
+    char const* device,
+    uint32_t plane_id,
+    uint32_t possible_crtcs_mask,
+    uint64_t type)
+{
+    fake_drms[device].add_plane(plane_id, possible_crtcs_mask, type);
+}
+
+uint32_t mtd::MockDRM::property_id(char const* device, char const* name)
+{
+    return fake_drms[device].property_id(name);
+}
+
 void mtd::MockDRM::prepare(char const *device)
 {
     fake_drms[device].prepare();
@@ -619,6 +759,27 @@ int drmModePageFlip(int fd, uint32_t crtc_id, uint32_t fb_id,
                                         flags, user_data);
 }
 
+drmModeAtomicReqPtr drmModeAtomicAlloc(void)
+{
+    return global_mock->drmModeAtomicAlloc();
+}
+
+void drmModeAtomicFree(drmModeAtomicReqPtr req)
+{
+    global_mock->drmModeAtomicFree(req);
+}
+
+int drmModeAtomicAddProperty(drmModeAtomicReqPtr req, uint32_t object_id,
+                             uint32_t property_id, uint64_t value)
+{
+    return global_mock->drmModeAtomicAddProperty(req, object_id, property_id, value);
+}
+
+int drmModeAtomicCommit(int fd, drmModeAtomicReqPtr req, uint32_t flags, void* user_data)
+{
+    return global_mock->drmModeAtomicCommit(fd, req, flags, user_data);
+}
+
 int drmHandleEvent(int fd, drmEventContextPtr evctx)
 {
     return global_mock->drmHandleEvent(fd, evctx);
@@ -39,6 +39,7 @@ public:
     void handle_display_config_change(mg::DisplayConfiguration const& conf) override;
     void handle_error(mir::ClientVisibleError const& error) override;
     void send_ping(int32_t serial) override;
+    void send_vsync(mf::SurfaceId id, uint32_t output_id, mg::Frame const& frame) override;
     void send_buffer(mf::BufferStreamId id, mg::Buffer& buf, mg::BufferIpcMsgType type) override;
     void handle_input_config_change(MirInputConfig const& devices) override;
     void add_buffer(mir::graphics::Buffer&) override;
@@ -80,6 +81,11 @@ void GloballyUniqueMockEventSink::send_ping(int32_t serial)
     underlying_sink->send_ping(serial);
 }
 
+void GloballyUniqueMockEventSink::send_vsync(mf::SurfaceId id, uint32_t output_id, mg::Frame const& frame)
+{
+    underlying_sink->send_vsync(id, output_id, frame);
+}
+
 void GloballyUniqueMockEventSink::handle_input_config_change(
     MirInputConfig const& config)
 {
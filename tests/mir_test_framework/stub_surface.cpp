@@ -75,6 +75,11 @@ mir::geometry::Rectangle mtd::StubSurface::input_bounds() const
     return {};
 }
 
+mir::geometry::Rectangle mtd::StubSurface::input_region_bounds() const
+{
+    return {};
+}
+
 bool mtd::StubSurface::input_area_contains(mir::geometry::Point const& /*point*/) const
 {
     return false;
@@ -197,6 +202,10 @@ void mtd::StubSurface::start_drag_and_drop(std::vector<uint8_t> const& /*handle*
 {
 }
 
+void mtd::StubSurface::set_frame_interval(std::chrono::milliseconds /*interval*/)
+{
+}
+
 namespace
 {
 // Ensure we don't accidentally have an abstract class
@@ -0,0 +1,40 @@
+/*
+ * Copyright © 2017 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "benchmark_results.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+
+void mir::test::record_benchmark_results(std::string const& name, std::string const& json)
+{
+    // Parameterised test cases are named "<instantiation>/<test case>"
+    std::string test_case{testing::UnitTest::GetInstance()->current_test_info()->test_case_name()};
+    std::replace(test_case.begin(), test_case.end(), '/', '_');
+
+    auto const output_filename = "/tmp/" + test_case + "_" + name + ".json";
+
+    std::cout << json << std::endl;
+    testing::Test::RecordProperty("results", json);
+
+    std::ofstream output{output_filename};
+    output << json << std::endl;
+    EXPECT_TRUE(output.good()) << "Failed to write benchmark results to " << output_filename;
+}
@@ -0,0 +1,34 @@
+/*
+ * Copyright © 2017 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef MIR_TEST_BENCHMARK_RESULTS_H_
+#define MIR_TEST_BENCHMARK_RESULTS_H_
+
+#include <string>
+
+namespace mir { namespace test {
+
+/**
+ * Reports the JSON results of the current benchmark test: prints them,
+ * records them as a test property and writes them to
+ * /tmp/<test case>_<name>.json, failing the test if the file can't be written.
+ */
+void record_benchmark_results(std::string const& name, std::string const& json);
+
+} } // namespace mir::test
+
+#endif // MIR_TEST_BENCHMARK_RESULTS_H_
@@ -23,6 +23,10 @@
 #include <gtest/gtest.h>
 
 #include <chrono>
+#include <fstream>
+#include <iterator>
+
+#include <unistd.h>
 
 namespace mtf = mir_test_framework;
 
@@ -119,3 +123,45 @@ TEST_F(ClientStartupPerformance, create_surface_and_swap)
     mir_connection_release(conn);
 }
 
+
+namespace
+{
+struct ServerStartupPerformance : testing::Test, mtf::AsyncServerRunner
+{
+    std::string const profile_file{"/tmp/mir_startup_profile_" + std::to_string(getpid())};
+
+    ~ServerStartupPerformance()
+    {
+        unlink(profile_file.c_str());
+    }
+
+    std::string profile() const
+    {
+        std::ifstream in{profile_file};
+        return {std::istreambuf_iterator<char>{in}, std::istreambuf_iterator<char>{}};
+    }
+};
+}
+
+TEST_F(ServerStartupPerformance, starts_server)
+{
+    using namespace std::chrono_literals;
+    add_to_environment("MIR_SERVER_STARTUP_PROFILE", profile_file.c_str());
+
+    auto start = std::chrono::steady_clock::now();
+
+    start_server();
+
+    auto end = std::chrono::steady_clock::now();
+    auto diff = std::chrono::duration_cast<std::chrono::milliseconds>(end-start);
+
+    stop_server();
+
+    //NOTE: Ideally, the expected number should vary according to platform
+    auto max_expected_time = 500ms;
+    EXPECT_THAT(diff.count(), Lt(max_expected_time.count()));
+
+    // The profile is written as the server exits; the phases in it show where the time went
+    EXPECT_THAT(profile(), HasSubstr("mir::graphics::Platform "));
+    EXPECT_THAT(profile(), HasSubstr("mir::DisplayServer::run "));
+}
@@ -0,0 +1,311 @@
+/*
+ * Copyright © 2017 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "benchmark_results.h"
+#include "mir_test_framework/headless_test.h"
+#include "mir_test_framework/headless_display_buffer_compositor_factory.h"
+#include "mir/test/doubles/stub_display_buffer.h"
+
+#include "mir/compositor/buffer_stream.h"
+#include "mir/compositor/compositor.h"
+#include "mir/compositor/display_buffer_compositor.h"
+#include "mir/compositor/scene.h"
+#include "mir/compositor/scene_element.h"
+#include "mir/graphics/buffer.h"
+#include "mir/graphics/buffer_properties.h"
+#include "mir/graphics/graphic_buffer_allocator.h"
+#include "mir/graphics/platform.h"
+#include "mir/graphics/renderable.h"
+#include "mir/scene/buffer_stream_factory.h"
+#include "mir/scene/surface.h"
+#include "mir/scene/surface_creation_parameters.h"
+#include "mir/scene/surface_factory.h"
+#include "mir/shell/surface_stack.h"
+#include "src/server/compositor/occlusion.h"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <sstream>
+
+#include <time.h>
+
+namespace mc = mir::compositor;
+namespace mg = mir::graphics;
+namespace ms = mir::scene;
+namespace mtd = mir::test::doubles;
+namespace mtf = mir_test_framework;
+namespace geom = mir::geometry;
+
+using namespace testing;
+
+namespace
+{
+geom::Rectangle const display_area{{0, 0}, {1920, 1080}};
+int const warmup_frames{20};
+int const measured_frames{500};
+int const buffers_per_surface{3};
+
+struct Scenario
+{
+    char const* name;
+    int surfaces;
+    geom::Size surface_size;
+    // How much neighbouring surfaces overlap, from 0 (not at all) to 1 (completely)
+    float overlap;
+    float alpha;
+    // Each surface gets a new buffer every this many frames, or never if 0
+    int update_every;
+};
+
+std::ostream& operator<<(std::ostream& out, Scenario const& scenario)
+{
+    return out << scenario.name;
+}
+
+// The CPU time of the calling thread, so that time spent descheduled isn't counted
+std::chrono::nanoseconds thread_cpu_time()
+{
+    timespec ts;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return std::chrono::seconds{ts.tv_sec} + std::chrono::nanoseconds{ts.tv_nsec};
+}
+
+class Phase
+{
+public:
+    explicit Phase(char const* name) : name{name} {}
+
+    template<typename Work>
+    auto measure(Work const& work) -> decltype(work())
+    {
+        struct Sample
+        {
+            ~Sample() { samples.push_back(thread_cpu_time() - start); }
+            std::vector<std::chrono::nanoseconds>& samples;
+            std::chrono::nanoseconds const start;
+        } const sample{samples, thread_cpu_time()};
+
+        return work();
+    }
+
+    void discard() { samples.clear(); }
+
+    void write_json_to(std::ostream& out)
+    {
+        std::sort(begin(samples), end(samples));
+
+        std::chrono::nanoseconds total{0};
+        for (auto const& sample : samples)
+            total += sample;
+
+        auto const in_us = [](std::chrono::nanoseconds t) { return t.count() / 1000.0; };
+
+        out << '"' << name << "\": {"
+            << "\"mean_us\": " << in_us(total / samples.size())
+            << ", \"median_us\": " << in_us(samples[samples.size() / 2])
+            << ", \"p99_us\": " << in_us(samples[samples.size() * 99 / 100])
+            << ", \"max_us\": " << in_us(samples.back())
+            << "}";
+    }
+
+private:
+    char const* const name;
+    std::vector<std::chrono::nanoseconds> samples;
+};
+
+struct SyntheticSurface
+{
+    std::shared_ptr<mc::BufferStream> stream;
+    std::vector<std::shared_ptr<mg::Buffer>> buffers;
+    int next_buffer;
+
+    void submit_next_buffer()
+    {
+        stream->submit_buffer(buffers[next_buffer]);
+        next_buffer = (next_buffer + 1) % buffers.size();
+    }
+};
+
+struct CompositorThroughput : mtf::HeadlessTest, WithParamInterface<Scenario>
+{
+    CompositorThroughput()
+    {
+        initial_display_layout({display_area});
+    }
+
+    void SetUp() override
+    {
+        start_server();
+
+        // We composite the scene ourselves, on this thread, so that we can measure it
+        server.the_compositor()->stop();
+
+        scene = std::dynamic_pointer_cast<mc::Scene>(server.the_surface_stack());
+        ASSERT_THAT(scene, NotNull());
+        scene->register_compositor(this);
+
+        allocator = server.the_graphics_platform()->create_buffer_allocator();
+    }
+
+    void TearDown() override
+    {
+        scene->unregister_compositor(this);
+        surfaces.clear();
+        stop_server();
+    }
+
+    geom::Point position_of(int index, Scenario const& scenario) const
+    {
+        auto const size = scenario.surface_size;
+        auto const step_x = std::max(1, static_cast<int>(size.width.as_int() * (1.0f - scenario.overlap)));
+        auto const step_y = std::max(1, static_cast<int>(size.height.as_int() * (1.0f - scenario.overlap)));
+        auto const columns = std::max(1, (display_area.size.width.as_int() - size.width.as_int()) / step_x + 1);
+        auto const rows = std::max(1, (display_area.size.height.as_int() - size.height.as_int()) / step_y + 1);
+
+        return {(index % columns) * step_x, (index / columns % rows) * step_y};
+    }
+
+    void create_surfaces(Scenario const& scenario)
+    {
+        mg::BufferProperties const properties{
+            scenario.surface_size, mir_pixel_format_abgr_8888, mg::BufferUsage::software};
+
+        for (int i = 0; i != scenario.surfaces; ++i)
+        {
+            SyntheticSurface surface{
+                server.the_buffer_stream_factory()->create_buffer_stream({}, properties), {}, 0};
+
+            for (int j = 0; j != buffers_per_surface; ++j)
+                surface.buffers.push_back(allocator->alloc_software_buffer(properties.size, properties.format));
+
+            surface.submit_next_buffer();
+
+            auto const scene_surface = server.the_surface_factory()->create_surface(
+                {ms::StreamInfo{surface.stream, {}, {}}},
+                ms::a_surface()
+                    .of_name(std::string{"synthetic "} + std::to_string(i))
+                    .of_size(scenario.surface_size)
+                    .of_position(position_of(i, scenario)));
+
+            scene_surface->set_alpha(scenario.alpha);
+            server.the_surface_stack()->add_surface(scene_surface, mir::input::InputReceptionMode::normal);
+
+            surfaces.push_back(surface);
+        }
+    }
+
+    void update_surfaces(Scenario const& scenario, int frame)
+    {
+        if (scenario.update_every == 0)
+            return;
+
+        // Spread the updates out over the frames, as independent clients would
+        for (unsigned i = 0; i != surfaces.size(); ++i)
+        {
+            if ((frame + i) % scenario.update_every == 0)
+                surfaces[i].submit_next_buffer();
+        }
+    }
+
+    void composite_frame(mc::DisplayBufferCompositor& compositor)
+    {
+        auto elements = scene_elements.measure([this] { return scene->scene_elements_for(this); });
+
+        auto const occluded = occlusion.measure([&]
+            { return mc::filter_occlusions_from(elements, display_area); });
+
+        for (auto const& element : occluded)
+            element->occluded();
+
+        buffer_acquisition.measure([&]
+            {
+                for (auto const& element : elements)
+                    element->renderable()->buffer();
+            });
+
+        dispatch.measure([&] { compositor.composite(std::move(elements)); });
+    }
+
+    std::string results_as_json(Scenario const& scenario)
+    {
+        std::ostringstream out;
+        out << "{\"benchmark_name\": \"compositor-throughput\""
+            << ", \"scenario\": \"" << scenario.name << '"'
+            << ", \"surfaces\": " << scenario.surfaces
+            << ", \"surface_size\": [" << scenario.surface_size.width.as_int()
+            << ", " << scenario.surface_size.height.as_int() << "]"
+            << ", \"overlap\": " << scenario.overlap
+            << ", \"alpha\": " << scenario.alpha
+            << ", \"update_every\": " << scenario.update_every
+            << ", \"frames\": " << measured_frames
+            << ", ";
+        scene_elements.write_json_to(out);
+        out << ", ";
+        occlusion.write_json_to(out);
+        out << ", ";
+        buffer_acquisition.write_json_to(out);
+        out << ", ";
+        dispatch.write_json_to(out);
+        out << "}";
+        return out.str();
+    }
+
+    std::shared_ptr<mc::Scene> scene;
+    std::shared_ptr<mg::GraphicBufferAllocator> allocator;
+    std::vector<SyntheticSurface> surfaces;
+
+    Phase scene_elements{"scene_elements_for"};
+    Phase occlusion{"occlusion"};
+    Phase buffer_acquisition{"buffer_acquisition"};
+    Phase dispatch{"dispatch"};
+};
+}
+
+TEST_P(CompositorThroughput, measures_cpu_time_per_frame)
+{
+    auto const scenario = GetParam();
+    create_surfaces(scenario);
+
+    mtd::StubDisplayBuffer display_buffer{display_area};
+    auto const compositor = mtf::HeadlessDisplayBufferCompositorFactory{}.create_compositor_for(display_buffer);
+
+    for (int frame = 0; frame != warmup_frames + measured_frames; ++frame)
+    {
+        if (frame == warmup_frames)
+        {
+            for (auto phase : {&scene_elements, &occlusion, &buffer_acquisition, &dispatch})
+                phase->discard();
+        }
+
+        update_surfaces(scenario, frame);
+        composite_frame(*compositor);
+    }
+
+    mir::test::record_benchmark_results(scenario.name, results_as_json(scenario));
+}
+
+INSTANTIATE_TEST_CASE_P(
+    Scenes,
+    CompositorThroughput,
+    Values(
+        Scenario{"single_fullscreen", 1, display_area.size, 0.0f, 1.0f, 1},
+        Scenario{"tiled_opaque", 16, {480, 270}, 0.0f, 1.0f, 1},
+        Scenario{"cascaded_opaque", 32, {800, 600}, 0.9f, 1.0f, 2},
+        Scenario{"cascaded_translucent", 32, {800, 600}, 0.9f, 0.5f, 2},
+        Scenario{"many_small", 256, {64, 64}, 0.5f, 1.0f, 4},
+        Scenario{"static", 64, {400, 300}, 0.5f, 1.0f, 0}));
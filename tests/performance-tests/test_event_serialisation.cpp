@@ -0,0 +1,264 @@
+/*
+ * Copyright © 2017 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "src/server/frontend/event_sender.h"
+#include "src/server/frontend/socket_messenger.h"
+
+#include "mir/events/event_builders.h"
+#include "mir/events/event_private.h"
+
+#include "mir_protobuf.pb.h"
+#include "mir_protobuf_wire.pb.h"
+
+#include <boost/asio.hpp>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <fstream>
+#include <new>
+#include <sstream>
+#include <system_error>
+
+#include <endian.h>
+#include <sys/socket.h>
+#include <time.h>
+#include <unistd.h>
+
+namespace mf = mir::frontend;
+namespace mfd = mir::frontend::detail;
+namespace mev = mir::events;
+namespace mp = mir::protobuf;
+namespace ba = boost::asio;
+
+using namespace testing;
+
+namespace
+{
+int const warmup_events{100};
+int const measured_events{10000};
+
+// Counts operator new calls on the thread that enables it. capnp builds its
+// first segment with calloc(), which this doesn't see.
+thread_local bool counting_allocations{false};
+thread_local long allocations{0};
+}
+
+void* operator new(std::size_t size)
+{
+    if (counting_allocations)
+        ++allocations;
+
+    if (auto const p = std::malloc(size ? size : 1))
+        return p;
+
+    throw std::bad_alloc{};
+}
+
+namespace
+{
+enum class Kind
+{
+    pointer_motion,
+    touch,
+    key
+};
+
+char const* name_of(Kind kind)
+{
+    switch (kind)
+    {
+    case Kind::pointer_motion: return "pointer_motion";
+    case Kind::touch: return "touch";
+    case Kind::key: return "key";
+    }
+
+    return "unknown";
+}
+
+std::ostream& operator<<(std::ostream& out, Kind kind)
+{
+    return out << name_of(kind);
+}
+
+mir::EventUPtr make_input_event(Kind kind, int n)
+{
+    std::chrono::nanoseconds const time{n};
+
+    switch (kind)
+    {
+    case Kind::pointer_motion:
+        return mev::make_event(
+            MirInputDeviceId{1}, time, std::vector<uint8_t>{}, mir_input_event_modifier_none,
+            mir_pointer_action_motion, 0, n % 1920, n % 1080, 0, 0, 1, 1);
+
+    case Kind::touch:
+    {
+        auto ev = mev::make_event(MirInputDeviceId{2}, time, std::vector<uint8_t>{}, mir_input_event_modifier_none);
+        for (int contact = 0; contact != 2; ++contact)
+            mev::add_touch(*ev, contact, mir_touch_action_change, mir_touch_tooltype_finger, n % 1920, n % 1080, 1, 1, 1, 1);
+        return ev;
+    }
+
+    case Kind::key:
+        return mev::make_event(
+            MirInputDeviceId{3}, time, std::vector<uint8_t>{}, mir_keyboard_action_down, 0, 30,
+            mir_input_event_modifier_none);
+    }
+
+    throw std::logic_error{"Unknown event kind"};
+}
+
+struct Cost
+{
+    std::vector<std::chrono::nanoseconds> times;
+    long allocations{0};
+
+    template<typename Work>
+    void measure(Work const& work)
+    {
+        timespec start, end;
+        ::allocations = 0;
+        counting_allocations = true;
+        clock_gettime(CLOCK_THREAD_CPUTIME_ID, &start);
+        work();
+        clock_gettime(CLOCK_THREAD_CPUTIME_ID, &end);
+        counting_allocations = false;
+
+        times.push_back(std::chrono::seconds{end.tv_sec - start.tv_sec} +
+                        std::chrono::nanoseconds{end.tv_nsec - start.tv_nsec});
+        allocations += ::allocations;
+    }
+
+    void write_json_to(std::ostream& out, char const* name)
+    {
+        std::sort(begin(times), end(times));
+        auto const in_us = [](std::chrono::nanoseconds t) { return t.count() / 1000.0; };
+
+        out << '"' << name << "\": {"
+            << "\"median_us\": " << in_us(times[times.size() / 2])
+            << ", \"p99_us\": " << in_us(times[times.size() * 99 / 100])
+            << ", \"allocations_per_event\": " << static_cast<double>(allocations) / times.size()
+            << "}";
+    }
+};
+
+// Sends events with the server's EventSender over a socket pair, and reads them
+// back the way the client's MirProtobufRpcChannel does
+struct EventSerialisation : TestWithParam<Kind>
+{
+    EventSerialisation()
+    {
+        int fds[2];
+        if (socketpair(AF_LOCAL, SOCK_STREAM, 0, fds))
+            throw std::system_error{errno, std::system_category(), "Failed to create socket pair"};
+
+        auto const socket = std::make_shared<ba::local::stream_protocol::socket>(io);
+        socket->assign(ba::local::stream_protocol(), fds[0]);
+        client_fd = fds[1];
+
+        sender = std::make_unique<mfd::EventSender>(std::make_shared<mfd::SocketMessenger>(socket), nullptr);
+    }
+
+    ~EventSerialisation()
+    {
+        sender.reset();
+        close(client_fd);
+    }
+
+    void read_exactly(void* buffer, size_t size)
+    {
+        auto const bytes = static_cast<char*>(buffer);
+        for (size_t done = 0; done != size;)
+        {
+            auto const result = read(client_fd, bytes + done, size - done);
+            if (result <= 0)
+                throw std::system_error{errno, std::system_category(), "Failed to read event"};
+            done += result;
+        }
+    }
+
+    mir::EventUPtr receive()
+    {
+        uint16_t message_size;
+        read_exactly(&message_size, sizeof message_size);
+        message_size = be16toh(message_size);
+
+        body_bytes.resize(message_size);
+        read_exactly(body_bytes.data(), message_size);
+
+        mp::wire::Result result;
+        result.ParseFromArray(body_bytes.data(), message_size);
+
+        mp::EventSequence seq;
+        seq.ParseFromString(result.events(0));
+        return MirEvent::deserialize(seq.event(0).raw());
+    }
+
+    ba::io_service io;
+    int client_fd;
+    std::unique_ptr<mfd::EventSender> sender;
+    std::vector<char> body_bytes;
+
+    Cost send_cost;
+    Cost receive_cost;
+};
+}
+
+TEST_P(EventSerialisation, measures_cost_per_event)
+{
+    auto const kind = GetParam();
+
+    for (int i = 0; i != warmup_events + measured_events; ++i)
+    {
+        if (i == warmup_events)
+            send_cost = receive_cost = Cost{};
+
+        auto const event = make_input_event(kind, i);
+        mir::EventUPtr received{nullptr, [](MirEvent*) {}};
+
+        send_cost.measure([&] { sender->handle_event(*event); });
+        receive_cost.measure([&] { received = receive(); });
+
+        ASSERT_THAT(MirEvent::serialize(received.get()), Eq(MirEvent::serialize(event.get())));
+    }
+
+    std::ostringstream json;
+    json << "{\"benchmark_name\": \"event-serialisation\""
+         << ", \"event\": \"" << kind << '"'
+         << ", \"serialised_bytes\": " << MirEvent::serialize(make_input_event(kind, 0).get()).size()
+         << ", ";
+    send_cost.write_json_to(json, "server_send");
+    json << ", ";
+    receive_cost.write_json_to(json, "client_receive");
+    json << "}";
+
+    auto const test_info = UnitTest::GetInstance()->current_test_info();
+    std::ostringstream output_filename;
+    output_filename << "/tmp/" << test_info->test_case_name() << "_" << kind << ".json";
+
+    std::cout << json.str() << std::endl;
+    std::ofstream{output_filename.str()} << json.str() << std::endl;
+    RecordProperty("results", json.str());
+}
+
+INSTANTIATE_TEST_CASE_P(
+    InputEvents,
+    EventSerialisation,
+    Values(Kind::pointer_motion, Kind::touch, Kind::key));
@@ -0,0 +1,558 @@
+/*
+ * Copyright © 2017 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "benchmark_results.h"
+#include "mir_test_framework/headless_test.h"
+#include "mir_test_framework/executable_path.h"
+#include "mir_toolkit/mir_client_library.h"
+#include "mir_toolkit/mir_buffer.h"
+
+#include <wayland-client.h>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <fstream>
+#include <future>
+#include <mutex>
+#include <sstream>
+#include <thread>
+
+#include <dirent.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/mman.h>
+#include <time.h>
+#include <unistd.h>
+
+namespace mtf = mir_test_framework;
+
+using namespace testing;
+using namespace std::chrono_literals;
+
+namespace
+{
+using Clock = std::chrono::steady_clock;
+
+std::chrono::seconds const reply_timeout{10};
+int const total_requests{2000};
+int const min_requests_per_client{5};
+int const pongs_per_fence{50};
+int const surface_width{32};
+int const surface_height{32};
+
+enum class Request
+{
+    submit_buffer,
+    allocate_buffers,
+    modify_surface,
+    pong,
+    wl_surface_commit
+};
+
+char const* name_of(Request request)
+{
+    switch (request)
+    {
+    case Request::submit_buffer: return "submit_buffer";
+    case Request::allocate_buffers: return "allocate_buffers";
+    case Request::modify_surface: return "modify_surface";
+    case Request::pong: return "pong";
+    case Request::wl_surface_commit: return "wl_surface_commit";
+    }
+
+    return "unknown";
+}
+
+struct Load
+{
+    Request request;
+    int clients;
+    // Whether mirclient offers the server shared memory rings in place of the socket
+    bool shared_memory;
+};
+
+std::ostream& operator<<(std::ostream& out, Load const& load)
+{
+    return out << name_of(load.request) << "_" << load.clients << (load.shared_memory ? "_shm" : "");
+}
+
+std::chrono::nanoseconds cpu_time(clockid_t clock)
+{
+    timespec ts;
+    clock_gettime(clock, &ts);
+    return std::chrono::seconds{ts.tv_sec} + std::chrono::nanoseconds{ts.tv_nsec};
+}
+
+// The CPU time used so far by the threads of this process with the given name
+std::chrono::nanoseconds cpu_time_of_threads_named(std::string const& name)
+{
+    auto const tick = std::chrono::nanoseconds{std::chrono::seconds{1}} / sysconf(_SC_CLK_TCK);
+    std::chrono::nanoseconds total{0};
+
+    auto const tasks = opendir("/proc/self/task");
+    if (!tasks)
+        return total;
+
+    while (auto const task = readdir(tasks))
+    {
+        std::string const path{std::string{"/proc/self/task/"} + task->d_name};
+
+        std::string comm;
+        std::getline(std::ifstream{path + "/comm"}, comm);
+        if (comm != name)
+            continue;
+
+        // utime and stime are the 12th and 13th fields after the parenthesised name
+        std::string stat;
+        std::getline(std::ifstream{path + "/stat"}, stat);
+        std::istringstream fields{stat.substr(stat.rfind(')') + 1)};
+
+        std::string skipped;
+        for (int i = 0; i != 11; ++i)
+            fields >> skipped;
+
+        long utime{0}, stime{0};
+        fields >> utime >> stime;
+        total += (utime + stime) * tick;
+    }
+
+    closedir(tasks);
+    return total;
+}
+
+class Client
+{
+public:
+    virtual ~Client() = default;
+
+    /// Makes a request and waits for the server's reply
+    virtual void round_trip() = 0;
+
+protected:
+    Client() = default;
+    Client(Client const&) = delete;
+    Client& operator=(Client const&) = delete;
+};
+
+class MirClient : public Client
+{
+public:
+    MirClient(std::string const& connect_string, bool with_window) :
+        connection{mir_connect_sync(connect_string.c_str(), "IPC benchmark")}
+    {
+        if (!mir_connection_is_valid(connection))
+            throw std::runtime_error{std::string{"Connection failed: "} + mir_connection_get_error_message(connection)};
+
+        if (!with_window)
+            return;
+
+        auto const spec = mir_create_normal_window_spec(connection, surface_width, surface_height);
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wdeprecated-declarations"
+        // A format with alpha, so that no window is ever considered occluded
+        mir_window_spec_set_pixel_format(spec, mir_pixel_format_argb_8888);
+#pragma GCC diagnostic pop
+        window = mir_create_window_sync(spec);
+        mir_window_spec_release(spec);
+
+        if (!mir_window_is_valid(window))
+            throw std::runtime_error{std::string{"Window creation failed: "} + mir_window_get_error_message(window)};
+    }
+
+    ~MirClient()
+    {
+        if (window)
+            mir_window_release_sync(window);
+        mir_connection_release(connection);
+    }
+
+protected:
+    MirConnection* const connection;
+    MirWindow* window{nullptr};
+};
+
+class SubmitBufferClient : public MirClient
+{
+public:
+    SubmitBufferClient(std::string const& connect_string) : MirClient{connect_string, true} {}
+
+    void round_trip() override
+    {
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wdeprecated-declarations"
+        mir_buffer_stream_swap_buffers_sync(mir_window_get_buffer_stream(window));
+#pragma GCC diagnostic pop
+    }
+};
+
+class AllocateBuffersClient : public MirClient
+{
+public:
+    AllocateBuffersClient(std::string const& connect_string) : MirClient{connect_string, false} {}
+
+    void round_trip() override
+    {
+        auto const buffer = mir_connection_allocate_buffer_sync(
+            connection, surface_width, surface_height, mir_pixel_format_argb_8888);
+
+        if (!mir_buffer_is_valid(buffer))
+            throw std::runtime_error{std::string{"Buffer allocation failed: "} + mir_buffer_get_error_message(buffer)};
+
+        mir_buffer_release(buffer);
+    }
+};
+
+class ModifySurfaceClient : public MirClient
+{
+public:
+    ModifySurfaceClient(std::string const& connect_string) :
+        MirClient{connect_string, true},
+        state{mir_window_get_state(window)}
+    {
+        mir_window_set_event_handler(window, &ModifySurfaceClient::handle_event, this);
+    }
+
+    ~ModifySurfaceClient()
+    {
+        mir_window_set_event_handler(window, nullptr, nullptr);
+    }
+
+    void round_trip() override
+    {
+        std::unique_lock<std::mutex> lock{mutex};
+        auto const requested = state == mir_window_state_maximized ? mir_window_state_restored : mir_window_state_maximized;
+
+        mir_window_set_state(window, requested);
+
+        // The reply is the window event telling us the state has changed
+        if (!changed.wait_for(lock, reply_timeout, [&] { return state == requested; }))
+            throw std::runtime_error{"Timed out waiting for window state change"};
+    }
+
+private:
+    static void handle_event(MirWindow*, MirEvent const* event, void* context)
+    {
+        static_cast<ModifySurfaceClient*>(context)->handle(event);
+    }
+
+    void handle(MirEvent const* event)
+    {
+        if (mir_event_get_type(event) != mir_event_type_window)
+            return;
+
+        auto const window_event = mir_event_get_window_event(event);
+        if (mir_window_event_get_attribute(window_event) != mir_window_attrib_state)
+            return;
+
+        std::lock_guard<std::mutex> lock{mutex};
+        state = static_cast<MirWindowState>(mir_window_event_get_attribute_value(window_event));
+        changed.notify_all();
+    }
+
+    std::mutex mutex;
+    std::condition_variable changed;
+    MirWindowState state;
+};
+
+class PongClient : public MirClient
+{
+public:
+    PongClient(std::string const& connect_string) : MirClient{connect_string, false} {}
+
+    // Pongs have no reply a client can see, but requests are handled in order,
+    // so a batch of them is fenced with a round trip that does
+    void round_trip() override
+    {
+        for (int i = 0; i != pongs_per_fence; ++i)
+            mir_connection_pong(connection, ++serial);
+
+        mir_buffer_release(mir_connection_allocate_buffer_sync(
+            connection, surface_width, surface_height, mir_pixel_format_argb_8888));
+    }
+
+private:
+    int32_t serial{0};
+};
+
+class WaylandClient : public Client
+{
+public:
+    WaylandClient(std::string const& socket_name) :
+        display{wl_display_connect(socket_name.c_str())}
+    {
+        if (!display)
+            throw std::runtime_error{"Failed to connect to Wayland socket " + socket_name};
+
+        auto const registry = wl_display_get_registry(display);
+        wl_registry_add_listener(registry, &registry_listener, this);
+        wl_display_roundtrip(display);
+        wl_registry_destroy(registry);
+
+        if (!compositor || !shm || !shell)
+            throw std::runtime_error{"Missing Wayland globals"};
+
+        int const stride{surface_width * 4};
+        int const buffer_size{stride * surface_height};
+
+        int const fd{open("/dev/shm", O_TMPFILE | O_RDWR | O_EXCL, S_IRWXU)};
+        if (fd < 0 || ftruncate(fd, buffer_size * 2) < 0)
+            throw std::system_error{errno, std::system_category(), "Failed to create shm pool"};
+
+        auto const pool = wl_shm_create_pool(shm, fd, buffer_size * 2);
+        for (int i = 0; i != 2; ++i)
+        {
+            buffers[i] = wl_shm_pool_create_buffer(
+                pool, i * buffer_size, surface_width, surface_height, stride, WL_SHM_FORMAT_ARGB8888);
+        }
+        wl_shm_pool_destroy(pool);
+        close(fd);
+
+        surface = wl_compositor_create_surface(compositor);
+        shell_surface = wl_shell_get_shell_surface(shell, surface);
+        wl_shell_surface_set_toplevel(shell_surface);
+    }
+
+    ~WaylandClient()
+    {
+        for (auto const buffer : buffers)
+            wl_buffer_destroy(buffer);
+        wl_shell_surface_destroy(shell_surface);
+        wl_surface_destroy(surface);
+        wl_shell_destroy(shell);
+        wl_shm_destroy(shm);
+        wl_compositor_destroy(compositor);
+        wl_display_disconnect(display);
+    }
+
+    // The reply to a commit is its frame callback
+    void round_trip() override
+    {
+        bool done{false};
+        auto const frame = wl_surface_frame(surface);
+        wl_callback_add_listener(frame, &frame_listener, &done);
+
+        wl_surface_attach(surface, buffers[next_buffer], 0, 0);
+        wl_surface_damage(surface, 0, 0, surface_width, surface_height);
+        wl_surface_commit(surface);
+        next_buffer = (next_buffer + 1) % 2;
+
+        auto const deadline = Clock::now() + reply_timeout;
+        while (!done)
+        {
+            while (wl_display_prepare_read(display) != 0)
+                wl_display_dispatch_pending(display);
+            wl_display_flush(display);
+
+            pollfd readable{wl_display_get_fd(display), POLLIN, 0};
+            auto const remaining = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - Clock::now());
+            if (remaining.count() <= 0 || poll(&readable, 1, remaining.count()) <= 0)
+            {
+                wl_display_cancel_read(display);
+                throw std::runtime_error{"Timed out waiting for frame callback"};
+            }
+
+            wl_display_read_events(display);
+            wl_display_dispatch_pending(display);
+        }
+    }
+
+private:
+    static void global(void* data, wl_registry* registry, uint32_t id, char const* interface, uint32_t)
+    {
+        auto const self = static_cast<WaylandClient*>(data);
+        std::string const name{interface};
+
+        if (name == "wl_compositor")
+            self->compositor = static_cast<wl_compositor*>(wl_registry_bind(registry, id, &wl_compositor_interface, 3));
+        else if (name == "wl_shm")
+            self->shm = static_cast<wl_shm*>(wl_registry_bind(registry, id, &wl_shm_interface, 1));
+        else if (name == "wl_shell")
+            self->shell = static_cast<wl_shell*>(wl_registry_bind(registry, id, &wl_shell_interface, 1));
+    }
+
+    static void global_remove(void*, wl_registry*, uint32_t) {}
+
+    static void frame_done(void* data, wl_callback* callback, uint32_t)
+    {
+        *static_cast<bool*>(data) = true;
+        wl_callback_destroy(callback);
+    }
+
+    static wl_registry_listener const registry_listener;
+    static wl_callback_listener const frame_listener;
+
+    wl_display* const display;
+    wl_compositor* compositor{nullptr};
+    wl_shm* shm{nullptr};
+    wl_shell* shell{nullptr};
+    wl_surface* surface{nullptr};
+    wl_shell_surface* shell_surface{nullptr};
+    wl_buffer* buffers[2];
+    int next_buffer{0};
+};
+
+wl_registry_listener const WaylandClient::registry_listener{&WaylandClient::global, &WaylandClient::global_remove};
+wl_callback_listener const WaylandClient::frame_listener{&WaylandClient::frame_done};
+
+struct IpcThroughput : mtf::HeadlessTest, WithParamInterface<Load>
+{
+    IpcThroughput()
+    {
+        add_to_environment("MIR_SERVER_WAYLAND_SOCKET_NAME", wayland_socket.c_str());
+        add_to_environment("MIR_CLIENT_PLATFORM_PATH", (mtf::library_path() + "/client-modules").c_str());
+
+        if (GetParam().shared_memory)
+            add_to_environment("MIR_CLIENT_SHM_TRANSPORT", "1");
+    }
+
+    void SetUp() override
+    {
+        start_server();
+    }
+
+    void TearDown() override
+    {
+        clients.clear();
+        stop_server();
+    }
+
+    std::unique_ptr<Client> make_client(Request request)
+    {
+        switch (request)
+        {
+        case Request::submit_buffer: return std::make_unique<SubmitBufferClient>(new_connection());
+        case Request::allocate_buffers: return std::make_unique<AllocateBuffersClient>(new_connection());
+        case Request::modify_surface: return std::make_unique<ModifySurfaceClient>(new_connection());
+        case Request::pong: return std::make_unique<PongClient>(new_connection());
+        case Request::wl_surface_commit: return std::make_unique<WaylandClient>(wayland_socket);
+        }
+
+        throw std::logic_error{"Unknown request"};
+    }
+
+    std::string const wayland_socket{"mir-ipc-benchmark-" + std::to_string(getpid())};
+    std::vector<std::unique_ptr<Client>> clients;
+};
+}
+
+TEST_P(IpcThroughput, measures_round_trips_and_server_cpu)
+{
+    auto const load = GetParam();
+    auto const round_trips_per_client = std::max(min_requests_per_client, total_requests / load.clients);
+    auto const requests_per_round_trip = load.request == Request::pong ? pongs_per_fence : 1;
+
+    for (int i = 0; i != load.clients; ++i)
+        clients.push_back(make_client(load.request));
+
+    std::vector<std::vector<Clock::duration>> latencies(load.clients);
+    std::vector<std::chrono::nanoseconds> client_cpu(load.clients);
+    std::atomic<bool> failed{false};
+
+    std::promise<void> go;
+    auto const started = go.get_future().share();
+
+    std::vector<std::thread> threads;
+    for (int i = 0; i != load.clients; ++i)
+    {
+        threads.emplace_back([&, i]
+            {
+                started.wait();
+                auto const cpu_at_start = cpu_time(CLOCK_THREAD_CPUTIME_ID);
+
+                try
+                {
+                    for (int j = 0; j != round_trips_per_client; ++j)
+                    {
+                        auto const start = Clock::now();
+                        clients[i]->round_trip();
+                        latencies[i].push_back(Clock::now() - start);
+                    }
+                }
+                catch (std::exception const& error)
+                {
+                    std::cerr << error.what() << std::endl;
+                    failed = true;
+                }
+
+                client_cpu[i] = cpu_time(CLOCK_THREAD_CPUTIME_ID) - cpu_at_start;
+            });
+    }
+
+    // The mirclient threads handling replies are also client CPU, not server CPU
+    auto const client_rpc_cpu_at_start = cpu_time_of_threads_named("RPC Thread");
+    auto const process_cpu_at_start = cpu_time(CLOCK_PROCESS_CPUTIME_ID);
+    auto const start = Clock::now();
+
+    go.set_value();
+    for (auto& thread : threads)
+        thread.join();
+
+    auto const elapsed = Clock::now() - start;
+    auto const process_cpu = cpu_time(CLOCK_PROCESS_CPUTIME_ID) - process_cpu_at_start;
+    auto const client_rpc_cpu = cpu_time_of_threads_named("RPC Thread") - client_rpc_cpu_at_start;
+
+    ASSERT_FALSE(failed);
+
+    std::vector<Clock::duration> all_latencies;
+    for (auto const& client_latencies : latencies)
+        all_latencies.insert(all_latencies.end(), client_latencies.begin(), client_latencies.end());
+    std::sort(all_latencies.begin(), all_latencies.end());
+
+    auto server_cpu = process_cpu - client_rpc_cpu;
+    for (auto const& cpu : client_cpu)
+        server_cpu -= cpu;
+
+    auto const requests = all_latencies.size() * requests_per_round_trip;
+    auto const in_us = [](auto t) { return std::chrono::duration<double, std::micro>{t}.count(); };
+
+    std::ostringstream json;
+    json << "{\"benchmark_name\": \"ipc-throughput\""
+         << ", \"request\": \"" << name_of(load.request) << '"'
+         << ", \"clients\": " << load.clients
+         << ", \"transport\": \"" << (load.shared_memory ? "shm" : "socket") << '"'
+         << ", \"requests\": " << requests
+         << ", \"requests_per_second\": " << requests / std::chrono::duration<double>{elapsed}.count()
+         << ", \"round_trip_p50_us\": " << in_us(all_latencies[all_latencies.size() / 2])
+         << ", \"round_trip_p99_us\": " << in_us(all_latencies[all_latencies.size() * 99 / 100])
+         << ", \"server_cpu_per_request_us\": " << in_us(std::max(server_cpu, 0ns)) / requests
+         << "}";
+
+    std::ostringstream name;
+    name << load;
+    mir::test::record_benchmark_results(name.str(), json.str());
+}
+
+INSTANTIATE_TEST_CASE_P(
+    Frontends,
+    IpcThroughput,
+    Values(
+        Load{Request::submit_buffer, 1, false}, Load{Request::submit_buffer, 10, false},
+        Load{Request::submit_buffer, 100, false}, Load{Request::submit_buffer, 500, false},
+        Load{Request::allocate_buffers, 1, false}, Load{Request::allocate_buffers, 10, false},
+        Load{Request::allocate_buffers, 100, false}, Load{Request::allocate_buffers, 500, false},
+        Load{Request::modify_surface, 1, false}, Load{Request::modify_surface, 10, false},
+        Load{Request::modify_surface, 100, false}, Load{Request::modify_surface, 500, false},
+        Load{Request::pong, 1, false}, Load{Request::pong, 10, false},
+        Load{Request::pong, 100, false}, Load{Request::pong, 500, false},
+        Load{Request::wl_surface_commit, 1, false}, Load{Request::wl_surface_commit, 10, false},
+        Load{Request::wl_surface_commit, 100, false}, Load{Request::wl_surface_commit, 500, false},
+        Load{Request::submit_buffer, 1, true}, Load{Request::submit_buffer, 100, true},
+        Load{Request::modify_surface, 1, true}, Load{Request::modify_surface, 100, true},
+        Load{Request::pong, 1, true}, Load{Request::pong, 100, true}));
@@ -0,0 +1,171 @@
+/*
+ * Copyright © 2017 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "src/client/rpc/mir_basic_rpc_channel.h"
+#include "src/client/rpc/mir_display_server.h"
+#include "mir_protobuf.pb.h"
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <thread>
+
+namespace mclr = mir::client::rpc;
+namespace mp = mir::protobuf;
+
+using namespace testing;
+
+namespace
+{
+struct RecordingRpcChannel : mclr::MirBasicRpcChannel
+{
+    void call_method(
+        std::string const& name,
+        google::protobuf::MessageLite const* parameters,
+        google::protobuf::MessageLite* response,
+        google::protobuf::Closure* complete) override
+    {
+        methods.push_back(name);
+        if (name == "submit_transaction")
+            transaction.CopyFrom(*static_cast<mp::Transaction const*>(parameters));
+        if (!error.empty())
+            static_cast<mp::Void*>(response)->set_error(error);
+        complete->Run();
+    }
+
+    void discard_future_calls() override {}
+    void wait_for_outstanding_calls() override {}
+
+    std::vector<std::string> methods;
+    mp::Transaction transaction;
+    std::string error;
+};
+
+void count_completion(int* count)
+{
+    ++*count;
+}
+
+struct ClientDisplayServer : Test
+{
+    void submit_buffer(int stream)
+    {
+        mp::BufferRequest request;
+        request.mutable_id()->set_value(stream);
+        server.submit_buffer(&request, &reply, google::protobuf::NewCallback(&count_completion, &completions));
+    }
+
+    void modify_surface(int surface)
+    {
+        mp::SurfaceModifications request;
+        request.mutable_surface_id()->set_value(surface);
+        server.modify_surface(&request, &reply, google::protobuf::NewCallback(&count_completion, &completions));
+    }
+
+    std::shared_ptr<RecordingRpcChannel> const channel{std::make_shared<RecordingRpcChannel>()};
+    mclr::DisplayServer server{channel};
+    mp::Void reply;
+    int completions{0};
+};
+}
+
+TEST_F(ClientDisplayServer, sends_calls_straight_away_outside_a_transaction)
+{
+    server.set_transactions_supported(true);
+
+    submit_buffer(1);
+    modify_surface(2);
+
+    EXPECT_THAT(channel->methods, ElementsAre("submit_buffer", "modify_surface"));
+    EXPECT_THAT(completions, Eq(2));
+}
+
+TEST_F(ClientDisplayServer, sends_a_transaction_as_one_call_on_commit)
+{
+    server.set_transactions_supported(true);
+
+    server.begin_transaction();
+    submit_buffer(1);
+    modify_surface(2);
+    submit_buffer(3);
+
+    EXPECT_THAT(channel->methods, IsEmpty());
+    EXPECT_THAT(completions, Eq(0));
+
+    server.commit_transaction();
+
+    EXPECT_THAT(channel->methods, ElementsAre("submit_transaction"));
+    ASSERT_THAT(channel->transaction.submissions_size(), Eq(2));
+    EXPECT_THAT(channel->transaction.submissions(0).id().value(), Eq(1));
+    EXPECT_THAT(channel->transaction.submissions(1).id().value(), Eq(3));
+    ASSERT_THAT(channel->transaction.modifications_size(), Eq(1));
+    EXPECT_THAT(channel->transaction.modifications(0).surface_id().value(), Eq(2));
+    EXPECT_THAT(completions, Eq(3));
+}
+
+TEST_F(ClientDisplayServer, only_the_outermost_commit_sends_the_transaction)
+{
+    server.set_transactions_supported(true);
+
+    server.begin_transaction();
+    server.begin_transaction();
+    submit_buffer(1);
+    server.commit_transaction();
+
+    EXPECT_THAT(channel->methods, IsEmpty());
+
+    server.commit_transaction();
+
+    EXPECT_THAT(channel->methods, ElementsAre("submit_transaction"));
+}
+
+TEST_F(ClientDisplayServer, transaction_errors_reach_each_batched_call)
+{
+    server.set_transactions_supported(true);
+    channel->error = "no such stream";
+
+    server.begin_transaction();
+    submit_buffer(1);
+    server.commit_transaction();
+
+    EXPECT_THAT(reply.error(), Eq("no such stream"));
+}
+
+TEST_F(ClientDisplayServer, replays_calls_in_order_to_a_server_without_transactions)
+{
+    server.begin_transaction();
+    submit_buffer(1);
+    modify_surface(2);
+    server.commit_transaction();
+
+    EXPECT_THAT(channel->methods, ElementsAre("submit_buffer", "modify_surface"));
+    EXPECT_THAT(completions, Eq(2));
+}
+
+TEST_F(ClientDisplayServer, transaction_holds_back_only_the_calls_of_its_thread)
+{
+    server.set_transactions_supported(true);
+
+    server.begin_transaction();
+    std::thread{[this] { submit_buffer(1); }}.join();
+
+    EXPECT_THAT(channel->methods, ElementsAre("submit_buffer"));
+
+    server.commit_transaction();
+
+    EXPECT_THAT(channel->methods, ElementsAre("submit_buffer"));
+}
@@ -453,3 +453,45 @@ TEST_F(FrameClockTest, nesting_adds_zero_lag)
     EXPECT_EQ(one_frame, in2 - in1);
     EXPECT_EQ(one_frame, out2 - out1);
 }
+
+TEST_F(FrameClockTest, follows_pushed_vsync_phase_without_resyncing)
+{
+    FrameClock clock(with_fake_time);
+    clock.set_period(one_frame);
+
+    int resyncs = 0;
+    clock.set_resync_callback([&]
+        {
+            ++resyncs;
+            return fake_time[CLOCK_MONOTONIC];
+        });
+
+    PosixTimestamp a;
+    auto b = clock.next_frame_after(a);
+    EXPECT_EQ(1, resyncs);
+
+    fake_sleep_until(b);
+    auto const vsync = fake_time[CLOCK_MONOTONIC] - one_frame/3;
+    clock.set_vsync(vsync);
+
+    auto c = clock.next_frame_after(b);
+    EXPECT_EQ(1, resyncs);
+    EXPECT_EQ(vsync % one_frame, c % one_frame);
+    EXPECT_GT(c, b);
+}
+
+TEST_F(FrameClockTest, resyncs_to_pushed_vsync_by_default)
+{
+    FrameClock clock(with_fake_time);
+    clock.set_period(one_frame);
+
+    fake_sleep_for(10*one_frame);
+    auto const vsync = fake_time[CLOCK_MONOTONIC] - 5*one_frame - one_frame/4;
+    clock.set_vsync(vsync);
+
+    PosixTimestamp a;
+    auto b = clock.next_frame_after(a);
+    EXPECT_EQ(vsync % one_frame, b % one_frame);
+    EXPECT_GT(b, fake_time[CLOCK_MONOTONIC]);
+    EXPECT_LE(b - fake_time[CLOCK_MONOTONIC], one_frame);
+}
@@ -160,6 +160,8 @@ public:
     MOCK_METHOD2(receive_data, void(void*, size_t));
     MOCK_METHOD3(receive_data, void(void*, size_t, std::vector<mir::Fd>&));
     MOCK_METHOD2(send_message, void(std::vector<uint8_t> const&, std::vector<mir::Fd> const&));
+    MOCK_METHOD0(offer_shared_memory, std::vector<mir::Fd>());
+    MOCK_METHOD1(shared_memory_offer_answered, void(bool));
 
     mir::Fd watch_fd() const override
     {
@@ -334,6 +336,93 @@ TEST_F(MirProtobufRpcChannelTest, sets_correct_size_when_sending_message)
     EXPECT_EQ(transport->sent_messages.front().size() - sizeof(uint16_t), message_header);
 }
 
+namespace
+{
+std::vector<uint8_t> message_from(mir::protobuf::wire::Result const& result)
+{
+    std::vector<uint8_t> buffer(result.ByteSize() + sizeof(uint16_t));
+    *reinterpret_cast<uint16_t*>(buffer.data()) = htobe16(result.ByteSize());
+    result.SerializeToArray(buffer.data() + sizeof(uint16_t), buffer.size() - sizeof(uint16_t));
+    return buffer;
+}
+
+void set_flag(bool* flag)
+{
+    *flag = true;
+}
+
+std::vector<mir::Fd> shared_memory_fds()
+{
+    std::vector<mir::Fd> fds;
+    for (int i = 0; i != 4; ++i)
+        fds.emplace_back(eventfd(0, EFD_CLOEXEC));
+    return fds;
+}
+}
+
+TEST_F(MirProtobufRpcChannelTest, offers_shared_memory_with_connect)
+{
+    using namespace testing;
+    auto const offer = shared_memory_fds();
+    EXPECT_CALL(*transport, offer_shared_memory()).WillOnce(Return(offer));
+    EXPECT_CALL(*transport, send_message(_, ContainerEq(offer)));
+
+    mclr::DisplayServer channel_user{channel};
+    mir::protobuf::ConnectParameters message;
+    channel_user.connect(&message, nullptr, nullptr);
+
+    ASSERT_EQ(transport->sent_messages.size(), 1u);
+    mir::protobuf::wire::Invocation invocation;
+    invocation.ParseFromArray(transport->sent_messages.front().data() + sizeof(uint16_t),
+                              transport->sent_messages.front().size() - sizeof(uint16_t));
+    EXPECT_TRUE(invocation.shm_transport());
+    EXPECT_EQ(offer.size(), invocation.side_channel_fds());
+}
+
+TEST_F(MirProtobufRpcChannelTest, moves_to_shared_memory_when_server_acknowledges)
+{
+    using namespace testing;
+    ON_CALL(*transport, offer_shared_memory()).WillByDefault(Return(shared_memory_fds()));
+    EXPECT_CALL(*transport, shared_memory_offer_answered(true));
+
+    mclr::DisplayServer channel_user{channel};
+    mir::protobuf::ConnectParameters message;
+    channel_user.connect(&message, nullptr, nullptr);
+
+    mir::protobuf::wire::Result acknowledgement;
+    acknowledgement.set_shm_transport(true);
+    transport->add_server_message(message_from(acknowledgement));
+
+    channel->dispatch(md::FdEvent::readable);
+    EXPECT_TRUE(transport->all_data_consumed());
+}
+
+TEST_F(MirProtobufRpcChannelTest, stays_on_socket_when_server_replies_without_acknowledging)
+{
+    using namespace testing;
+    ON_CALL(*transport, offer_shared_memory()).WillByDefault(Return(shared_memory_fds()));
+    EXPECT_CALL(*transport, shared_memory_offer_answered(false));
+
+    bool connected{false};
+    mclr::DisplayServer channel_user{channel};
+    mir::protobuf::ConnectParameters message;
+    mir::protobuf::Connection connection;
+    channel_user.connect(&message, &connection,
+        google::protobuf::NewCallback(&set_flag, &connected));
+
+    mir::protobuf::wire::Invocation invocation;
+    invocation.ParseFromArray(transport->sent_messages.front().data() + sizeof(uint16_t),
+                              transport->sent_messages.front().size() - sizeof(uint16_t));
+
+    mir::protobuf::wire::Result reply;
+    reply.set_id(invocation.id());
+    reply.set_response(mir::protobuf::Connection{}.SerializeAsString());
+    transport->add_server_message(message_from(reply));
+
+    channel->dispatch(md::FdEvent::readable);
+    EXPECT_TRUE(connected);
+}
+
 TEST_F(MirProtobufRpcChannelTest, reads_fds)
 {
     mclr::DisplayServer channel_user{channel};
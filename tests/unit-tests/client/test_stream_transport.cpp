@@ -19,6 +19,7 @@
 #include "src/client/rpc/stream_transport.h"
 #include "src/client/rpc/stream_socket_transport.h"
 #include "mir/fd.h"
+#include "mir/shm_ring.h"
 
 #include "mir/test/auto_unblock_thread.h"
 #include "mir/test/signal.h"
@@ -1318,3 +1319,131 @@ TYPED_TEST(StreamTransportTest, receiving_data_without_asking_for_fds_is_an_erro
 
     EXPECT_TRUE(receive_done->wait_for(std::chrono::seconds{1}));
 }
+
+namespace
+{
+struct SharedMemoryStreamTransport : testing::Test
+{
+    SharedMemoryStreamTransport()
+    {
+        int socket_fds[2];
+        if (socketpair(AF_UNIX, SOCK_STREAM, 0, socket_fds) < 0)
+        {
+            throw std::system_error(errno, std::system_category());
+        }
+
+        test_fd = mir::Fd{socket_fds[0]};
+        transport = std::make_shared<mclr::StreamSocketTransport>(mir::Fd{socket_fds[1]}, true);
+    }
+
+    std::vector<uint8_t> read_from_socket(size_t size)
+    {
+        std::vector<uint8_t> received(size);
+        EXPECT_EQ(static_cast<ssize_t>(size), read(test_fd, received.data(), size));
+        return received;
+    }
+
+    mir::Fd test_fd;
+    std::shared_ptr<mclr::StreamSocketTransport> transport;
+};
+}
+
+TEST_F(SharedMemoryStreamTransport, offers_a_ring_each_way)
+{
+    auto const offer = transport->offer_shared_memory();
+
+    ASSERT_EQ(4u, offer.size());
+    EXPECT_NO_THROW((mir::ShmRing{offer[0], offer[1]}));
+    EXPECT_NO_THROW((mir::ShmRing{offer[2], offer[3]}));
+}
+
+TEST_F(SharedMemoryStreamTransport, offers_only_once)
+{
+    transport->offer_shared_memory();
+
+    EXPECT_TRUE(transport->offer_shared_memory().empty());
+}
+
+TEST_F(SharedMemoryStreamTransport, holds_back_messages_until_the_server_accepts)
+{
+    auto const offer = transport->offer_shared_memory();
+    mir::ShmRing to_server{offer[0], offer[1]};
+
+    std::vector<uint8_t> const offering{1, 2, 3};
+    std::vector<uint8_t> const held_back{4, 5};
+
+    transport->send_message(offering, {});
+    transport->send_message(held_back, {});
+
+    EXPECT_THAT(read_from_socket(offering.size()), testing::Eq(offering));
+    EXPECT_FALSE(mt::fd_is_readable(test_fd));
+    EXPECT_EQ(0u, to_server.available());
+
+    transport->shared_memory_offer_answered(true);
+
+    std::vector<uint8_t> received(held_back.size());
+    ASSERT_TRUE(to_server.read(received.data(), received.size()));
+    EXPECT_THAT(received, testing::Eq(held_back));
+}
+
+TEST_F(SharedMemoryStreamTransport, sends_held_back_messages_on_the_socket_if_the_server_declines)
+{
+    transport->offer_shared_memory();
+
+    std::vector<uint8_t> const offering{1, 2, 3};
+    std::vector<uint8_t> const held_back{4, 5};
+
+    transport->send_message(offering, {});
+    transport->send_message(held_back, {});
+    transport->shared_memory_offer_answered(false);
+
+    EXPECT_THAT(read_from_socket(offering.size()), testing::Eq(offering));
+    EXPECT_THAT(read_from_socket(held_back.size()), testing::Eq(held_back));
+}
+
+TEST_F(SharedMemoryStreamTransport, notifies_of_data_on_the_ring_once_accepted)
+{
+    using namespace testing;
+
+    auto const offer = transport->offer_shared_memory();
+    mir::ShmRing from_server{offer[2], offer[3]};
+
+    std::vector<uint8_t> const message{6, 7, 8, 9};
+    std::vector<uint8_t> received(message.size());
+
+    auto observer = std::make_shared<NiceMock<MockObserver>>();
+    ON_CALL(*observer, on_data_available())
+        .WillByDefault(Invoke([&] { transport->receive_data(received.data(), received.size()); }));
+    transport->register_observer(observer);
+
+    transport->send_message({0}, {});
+    transport->shared_memory_offer_answered(true);
+    ASSERT_TRUE(transport->dispatch(md::FdEvent::readable));
+
+    ASSERT_TRUE(from_server.write(message.data(), message.size()));
+
+    ASSERT_TRUE(mt::fd_becomes_readable(transport->watch_fd(), std::chrono::seconds{1}));
+    EXPECT_CALL(*observer, on_data_available());
+    EXPECT_TRUE(transport->dispatch(md::FdEvent::readable));
+
+    EXPECT_THAT(received, Eq(message));
+    EXPECT_FALSE(mt::fd_is_readable(transport->watch_fd()));
+}
+
+TEST_F(SharedMemoryStreamTransport, notices_remote_disconnect_while_on_the_ring)
+{
+    using namespace testing;
+
+    transport->offer_shared_memory();
+    transport->send_message({0}, {});
+    transport->shared_memory_offer_answered(true);
+
+    auto observer = std::make_shared<NiceMock<MockObserver>>();
+    EXPECT_CALL(*observer, on_disconnected());
+    transport->register_observer(observer);
+
+    test_fd = mir::Fd{};
+
+    ASSERT_TRUE(mt::fd_becomes_readable(transport->watch_fd(), std::chrono::seconds{1}));
+    EXPECT_FALSE(transport->dispatch(md::FdEvent::readable));
+}
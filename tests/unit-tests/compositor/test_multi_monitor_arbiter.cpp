@@ -21,8 +21,12 @@
 #include "mir/test/doubles/stub_buffer_allocator.h"
 #include "src/server/compositor/multi_monitor_arbiter.h"
 #include "src/server/compositor/schedule.h"
+#include "src/server/compositor/queueing_schedule.h"
+#include "src/server/compositor/dropping_schedule.h"
 
 #include <gtest/gtest.h>
+#include <atomic>
+#include <thread>
 using namespace testing;
 namespace mt = mir::test;
 namespace mtd = mir::test::doubles;
@@ -619,3 +623,78 @@ TEST_F(MultiMonitorArbiter, releases_buffer_on_destruction)
     }
     EXPECT_TRUE(*buffer_released);
 }
+
+namespace
+{
+// Hammers one arbiter from a producer and several compositors at once. Each
+// compositor must only ever see buffers in submission order.
+void stress_arbiter_with(std::shared_ptr<mc::Schedule> const& schedule)
+{
+    int const num_compositors = 4;
+    int const num_submissions = 5000;
+
+    mc::MultiMonitorArbiter arbiter{schedule};
+    std::vector<std::shared_ptr<mg::Buffer>> submissions;
+    for (auto i = 0; i < num_submissions; i++)
+        submissions.emplace_back(std::make_shared<mtd::StubBuffer>());
+
+    schedule->schedule(submissions.front());
+
+    std::atomic<bool> done{false};
+    std::atomic<int> out_of_order{0};
+    std::vector<std::thread> compositors;
+    for (auto i = 0; i < num_compositors; i++)
+    {
+        compositors.emplace_back(
+            [&]
+            {
+                int const compositor_id = 0;
+                auto const id = &compositor_id;
+                unsigned int last_seen = 0;
+                do
+                {
+                    arbiter.buffer_ready_for(id);
+                    auto const buffer = arbiter.compositor_acquire(id);
+                    if (buffer->id().as_value() < last_seen)
+                        ++out_of_order;
+                    last_seen = buffer->id().as_value();
+                }
+                while (!done);
+            });
+    }
+
+    for (auto const& buffer : submissions)
+    {
+        schedule->schedule(buffer);
+        arbiter.has_buffer();
+    }
+
+    done = true;
+    for (auto& compositor : compositors)
+        compositor.join();
+
+    EXPECT_THAT(out_of_order, Eq(0));
+    EXPECT_TRUE(arbiter.has_buffer());
+}
+}
+
+TEST_F(MultiMonitorArbiter, concurrent_compositors_and_producer_with_queueing_schedule)
+{
+    stress_arbiter_with(std::make_shared<mc::QueueingSchedule>());
+}
+
+TEST_F(MultiMonitorArbiter, concurrent_compositors_and_producer_with_dropping_schedule)
+{
+    stress_arbiter_with(std::make_shared<mc::DroppingSchedule>());
+}
+
+TEST_F(MultiMonitorArbiter, many_transient_compositors_can_acquire)
+{
+    schedule.set_schedule({buffers[0], buffers[1]});
+
+    std::vector<int> compositor_ids(100);
+    for (auto& id : compositor_ids)
+        EXPECT_THAT(arbiter.compositor_acquire(&id), IsSameBufferAs(buffers[0]));
+
+    EXPECT_THAT(arbiter.compositor_acquire(&compositor_ids.back()), IsSameBufferAs(buffers[1]));
+}
@@ -19,6 +19,8 @@
 #include "mir/test/doubles/stub_buffer.h"
 #include "mir/test/doubles/stub_buffer_allocator.h"
 #include "mir/test/doubles/mock_event_sink.h"
+#include "mir/test/doubles/mock_buffer_lifetime_report.h"
+#include "mir/test/doubles/fake_alarm_factory.h"
 #include "mir/test/fake_shared.h"
 #include "src/server/compositor/stream.h"
 #include "mir/scene/null_surface_observer.h"
@@ -50,8 +52,13 @@ struct Stream : Test
     geom::Size initial_size{44,2};
     std::vector<std::shared_ptr<mg::Buffer>> buffers;
     MirPixelFormat construction_format{mir_pixel_format_rgb_565};
+    std::shared_ptr<NiceMock<mtd::MockBufferLifetimeReport>> const report{
+        std::make_shared<NiceMock<mtd::MockBufferLifetimeReport>>()};
+    std::shared_ptr<mtd::FakeAlarmFactory> const alarm_factory{
+        std::make_shared<mtd::FakeAlarmFactory>()};
+    std::chrono::milliseconds const frame_interval{100};
     mc::Stream stream{
-        initial_size, construction_format};
+        report, alarm_factory, initial_size, construction_format};
 };
 }
 
@@ -226,3 +233,117 @@ TEST_F(Stream, returns_buffers_to_client_when_told_to_bring_queue_up_to_date)
     EXPECT_THAT(buffers[1].use_count(), Eq(1));
     EXPECT_THAT(buffers[2].use_count(), Eq(2));
 }
+
+TEST_F(Stream, reports_buffer_lifetime)
+{
+    auto const stream_id = static_cast<void const*>(&stream);
+    auto const compositor_id = this;
+    auto const buffer_id = buffers[0]->id();
+
+    EXPECT_CALL(*report, buffer_submitted(stream_id, _)).Times(AnyNumber());
+    EXPECT_CALL(*report, buffer_acquired(stream_id, _, compositor_id)).Times(AnyNumber());
+    EXPECT_CALL(*report, buffer_released(stream_id, _)).Times(AnyNumber());
+    {
+        InSequence seq;
+        EXPECT_CALL(*report, buffer_submitted(stream_id, buffer_id));
+        EXPECT_CALL(*report, buffer_acquired(stream_id, buffer_id, compositor_id));
+        EXPECT_CALL(*report, buffer_released(stream_id, buffer_id));
+    }
+
+    stream.submit_buffer(buffers[0]);
+    stream.lock_compositor_buffer(compositor_id);
+    stream.submit_buffer(buffers[1]);
+    stream.lock_compositor_buffer(compositor_id);
+}
+
+TEST_F(Stream, acquired_buffer_is_the_submitted_buffer)
+{
+    stream.submit_buffer(buffers[0]);
+
+    auto const acquired = stream.lock_compositor_buffer(this);
+
+    EXPECT_THAT(acquired.get(), Eq(buffers[0].get()));
+    EXPECT_THAT(buffers[0].use_count(), Eq(2));
+}
+
+TEST_F(Stream, frame_interval_limits_how_often_the_compositor_takes_a_new_frame)
+{
+    stream.set_frame_interval(frame_interval);
+    for(auto& buffer : buffers)
+        stream.submit_buffer(buffer);
+
+    EXPECT_THAT(stream.buffers_ready_for_compositor(this), Eq(1));
+    EXPECT_THAT(stream.lock_compositor_buffer(this)->id(), Eq(buffers[0]->id()));
+
+    EXPECT_THAT(stream.buffers_ready_for_compositor(this), Eq(0));
+    EXPECT_THAT(stream.lock_compositor_buffer(this)->id(), Eq(buffers[0]->id()));
+
+    alarm_factory->advance_by(frame_interval + std::chrono::milliseconds(1));
+
+    EXPECT_THAT(stream.buffers_ready_for_compositor(this), Eq(1));
+    EXPECT_THAT(stream.lock_compositor_buffer(this)->id(), Eq(buffers[1]->id()));
+}
+
+TEST_F(Stream, queues_rather_than_drops_frames_while_frame_rate_is_limited)
+{
+    stream.allow_framedropping(true);
+    stream.set_frame_interval(frame_interval);
+
+    for(auto& buffer : buffers)
+        stream.submit_buffer(buffer);
+
+    EXPECT_THAT(
+        buffers,
+        Each(Property(&std::shared_ptr<mg::Buffer>::unique, Eq(false))));
+    EXPECT_TRUE(stream.framedropping());
+
+    stream.set_frame_interval(std::chrono::milliseconds(0));
+
+    // Lifting the limit restores the client's choice of dropping frames
+    EXPECT_THAT(
+        std::make_tuple(buffers.data(), buffers.size() - 1),
+        Each(Property(&std::shared_ptr<mg::Buffer>::unique, Eq(true))));
+}
+
+TEST_F(Stream, defers_frame_posted_until_frame_interval_expires)
+{
+    int frame_count{0};
+    stream.set_frame_posted_callback([&frame_count](auto) { ++frame_count; });
+    stream.set_frame_interval(frame_interval);
+
+    EXPECT_CALL(*report, buffer_deferred(&stream, buffers[1]->id()));
+
+    stream.submit_buffer(buffers[0]);
+    stream.lock_compositor_buffer(this);
+    stream.submit_buffer(buffers[1]);
+    EXPECT_THAT(frame_count, Eq(1));
+
+    alarm_factory->advance_by(frame_interval + std::chrono::milliseconds(1));
+    EXPECT_THAT(frame_count, Eq(2));
+}
+
+TEST_F(Stream, removing_frame_interval_posts_deferred_frame)
+{
+    int frame_count{0};
+    stream.set_frame_posted_callback([&frame_count](auto) { ++frame_count; });
+    stream.set_frame_interval(frame_interval);
+
+    stream.submit_buffer(buffers[0]);
+    stream.lock_compositor_buffer(this);
+    stream.submit_buffer(buffers[1]);
+    stream.set_frame_interval(std::chrono::milliseconds(0));
+
+    EXPECT_THAT(frame_count, Eq(2));
+    EXPECT_THAT(stream.buffers_ready_for_compositor(this), Eq(1));
+}
+
+TEST_F(Stream, reports_frame_interval_changes)
+{
+    InSequence seq;
+    EXPECT_CALL(*report, frame_interval_changed(&stream, frame_interval));
+    EXPECT_CALL(*report, frame_interval_changed(&stream, std::chrono::milliseconds(0)));
+
+    stream.set_frame_interval(frame_interval);
+    stream.set_frame_interval(frame_interval);
+    stream.set_frame_interval(std::chrono::milliseconds(0));
+}
@@ -23,7 +23,9 @@
 #include "src/server/frontend/event_sender.h"
 
 #include "mir/events/event_builders.h"
+#include "mir/events/event_private.h"
 #include "mir/client_visible_error.h"
+#include "mir/graphics/frame.h"
 
 #include "mir/test/display_config_matchers.h"
 #include "mir/test/input_devices_matcher.h"
@@ -32,6 +34,7 @@
 #include "mir/test/doubles/stub_buffer.h"
 #include "mir/test/doubles/stub_input_device.h"
 #include "mir/test/doubles/mock_platform_ipc_operations.h"
+#include "mir/test/doubles/fake_alarm_factory.h"
 #include "mir/input/device.h"
 #include "mir/input/device_capability.h"
 #include "mir/input/mir_input_config.h"
@@ -120,6 +123,34 @@ struct EventSender : public testing::Test
     mfd::EventSender event_sender;
 };
 
+struct BatchingEventSender : EventSender
+{
+    BatchingEventSender()
+        : batching_sender(
+            mt::fake_shared(mock_msg_sender), mt::fake_shared(mock_buffer_packer), alarm_factory, batch_delay)
+    {
+    }
+
+    mir::EventUPtr pointer_motion(int n, MirInputDeviceId device = 1, MirPointerButtons buttons = 0)
+    {
+        return mev::make_event(
+            device, std::chrono::nanoseconds{n}, std::vector<uint8_t>{}, mir_input_event_modifier_none,
+            mir_pointer_action_motion, buttons, n, n, 0, 0, 1, 1);
+    }
+
+    mir::EventUPtr touch(MirTouchAction action)
+    {
+        auto ev = mev::make_event(
+            MirInputDeviceId{2}, std::chrono::nanoseconds{0}, std::vector<uint8_t>{}, mir_input_event_modifier_none);
+        mev::add_touch(*ev, 0, action, mir_touch_tooltype_finger, 1, 1, 1, 1, 1, 1);
+        return ev;
+    }
+
+    std::chrono::milliseconds const batch_delay{4};
+    mtd::FakeAlarmFactory alarm_factory;
+    mfd::EventSender batching_sender;
+};
+
 std::function<void(char const*, size_t, mir::frontend::FdSets)>
 make_validator(std::function<void(mir::protobuf::EventSequence const&)> const& sequence_validator)
 {
@@ -307,3 +338,178 @@ TEST_F(EventSender, sends_errors)
 
     event_sender.handle_error(error);
 }
+
+TEST_F(EventSender, sends_vsync)
+{
+    using namespace testing;
+
+    mir::graphics::Frame frame;
+    frame.msc = 1234;
+    frame.ust = {CLOCK_MONOTONIC, std::chrono::nanoseconds{5678}};
+
+    auto msg_validator = make_validator(
+        [](auto const& seq)
+        {
+            ASSERT_TRUE(seq.has_vsync_event());
+            EXPECT_THAT(seq.vsync_event().surface_id().value(), Eq(7));
+            EXPECT_THAT(seq.vsync_event().output_id(), Eq(2u));
+            EXPECT_THAT(seq.vsync_event().msc(), Eq(1234));
+            EXPECT_THAT(seq.vsync_event().ust(), Eq(5678));
+            EXPECT_THAT(seq.vsync_event().clock_id(), Eq(CLOCK_MONOTONIC));
+        });
+
+    EXPECT_CALL(mock_msg_sender, send(_, _, _))
+        .Times(1)
+        .WillOnce(Invoke(msg_validator));
+
+    event_sender.send_vsync(mf::SurfaceId{7}, 2, frame);
+}
+
+TEST_F(BatchingEventSender, holds_pointer_motion_until_the_batch_delay)
+{
+    using namespace testing;
+
+    auto msg_validator = make_validator(
+        [](auto const& seq) { EXPECT_THAT(seq.event_size(), Eq(3)); });
+
+    EXPECT_CALL(mock_msg_sender, send(_, _, _)).Times(0);
+    for (int i = 0; i != 3; ++i)
+        batching_sender.handle_event(*pointer_motion(i, i));
+    alarm_factory.advance_by(batch_delay / 2);
+    Mock::VerifyAndClearExpectations(&mock_msg_sender);
+
+    EXPECT_CALL(mock_msg_sender, send(_, _, _))
+        .Times(1)
+        .WillOnce(Invoke(msg_validator));
+    alarm_factory.advance_by(batch_delay);
+}
+
+TEST_F(BatchingEventSender, sends_held_events_with_the_next_event_that_cant_wait)
+{
+    using namespace testing;
+
+    auto const key = mev::make_event(MirInputDeviceId(), std::chrono::nanoseconds(0), std::vector<uint8_t>{},
+        MirKeyboardAction(), 0, 0, MirInputEventModifiers());
+
+    auto msg_validator = make_validator(
+        [&key](auto const& seq)
+        {
+            ASSERT_THAT(seq.event_size(), Eq(3));
+            EXPECT_THAT(seq.event(2).raw(), Eq(MirEvent::serialize(key.get())));
+        });
+
+    EXPECT_CALL(mock_msg_sender, send(_, _, _))
+        .Times(1)
+        .WillOnce(Invoke(msg_validator));
+
+    batching_sender.handle_event(*pointer_motion(0, 1));
+    batching_sender.handle_event(*pointer_motion(1, 2));
+    batching_sender.handle_event(*key);
+}
+
+TEST_F(BatchingEventSender, holds_touch_moves_but_not_touch_downs)
+{
+    using namespace testing;
+
+    EXPECT_CALL(mock_msg_sender, send(_, _, _)).Times(0);
+    batching_sender.handle_event(*touch(mir_touch_action_change));
+    Mock::VerifyAndClearExpectations(&mock_msg_sender);
+
+    EXPECT_CALL(mock_msg_sender, send(_, _, _)).Times(1);
+    batching_sender.handle_event(*touch(mir_touch_action_down));
+}
+
+TEST_F(BatchingEventSender, sends_held_events_before_other_messages)
+{
+    using namespace testing;
+
+    auto events_validator = make_validator(
+        [](auto const& seq) { EXPECT_THAT(seq.event_size(), Eq(1)); });
+    auto ping_validator = make_validator(
+        [](auto const& seq) { EXPECT_TRUE(seq.has_ping_event()); });
+
+    InSequence seq;
+    EXPECT_CALL(mock_msg_sender, send(_, _, _)).WillOnce(Invoke(events_validator));
+    EXPECT_CALL(mock_msg_sender, send(_, _, _)).WillOnce(Invoke(ping_validator));
+
+    batching_sender.handle_event(*pointer_motion(0));
+    batching_sender.send_ping(7);
+}
+
+TEST_F(BatchingEventSender, sends_held_events_on_destruction)
+{
+    using namespace testing;
+
+    auto sender = std::make_unique<mfd::EventSender>(
+        mt::fake_shared(mock_msg_sender), mt::fake_shared(mock_buffer_packer), alarm_factory, batch_delay);
+    sender->handle_event(*pointer_motion(0));
+
+    EXPECT_CALL(mock_msg_sender, send(_, _, _)).Times(1);
+    sender.reset();
+}
+
+TEST_F(BatchingEventSender, merges_held_motion_from_a_device)
+{
+    using namespace testing;
+
+    auto msg_validator = make_validator(
+        [](auto const& seq)
+        {
+            ASSERT_THAT(seq.event_size(), Eq(1));
+            auto const ev = MirEvent::deserialize(seq.event(0).raw());
+            auto const pointer = ev->to_input()->to_pointer();
+            EXPECT_THAT(pointer->x(), FloatEq(2));
+            EXPECT_THAT(pointer->dx(), FloatEq(3));
+            EXPECT_THAT(pointer->dy(), FloatEq(3));
+            EXPECT_THAT(pointer->event_time(), Eq(std::chrono::nanoseconds{2}));
+        });
+
+    EXPECT_CALL(mock_msg_sender, send(_, _, _))
+        .Times(1)
+        .WillOnce(Invoke(msg_validator));
+
+    for (int i = 0; i != 3; ++i)
+        batching_sender.handle_event(*pointer_motion(i));
+    alarm_factory.advance_by(batch_delay);
+}
+
+TEST_F(BatchingEventSender, keeps_merged_motion_in_time_order)
+{
+    using namespace testing;
+
+    auto msg_validator = make_validator(
+        [](auto const& seq)
+        {
+            ASSERT_THAT(seq.event_size(), Eq(2));
+            auto const first = MirEvent::deserialize(seq.event(0).raw());
+            auto const second = MirEvent::deserialize(seq.event(1).raw());
+            EXPECT_THAT(first->to_input()->device_id(), Eq(2));
+            EXPECT_THAT(second->to_input()->device_id(), Eq(1));
+            EXPECT_THAT(first->to_input()->event_time(), Le(second->to_input()->event_time()));
+        });
+
+    EXPECT_CALL(mock_msg_sender, send(_, _, _))
+        .Times(1)
+        .WillOnce(Invoke(msg_validator));
+
+    batching_sender.handle_event(*pointer_motion(0, 1));
+    batching_sender.handle_event(*pointer_motion(1, 2));
+    batching_sender.handle_event(*pointer_motion(2, 1));
+    alarm_factory.advance_by(batch_delay);
+}
+
+TEST_F(BatchingEventSender, does_not_merge_motion_across_button_changes)
+{
+    using namespace testing;
+
+    auto msg_validator = make_validator(
+        [](auto const& seq) { EXPECT_THAT(seq.event_size(), Eq(2)); });
+
+    EXPECT_CALL(mock_msg_sender, send(_, _, _))
+        .Times(1)
+        .WillOnce(Invoke(msg_validator));
+
+    batching_sender.handle_event(*pointer_motion(0, 1, 0));
+    batching_sender.handle_event(*pointer_motion(1, 1, mir_pointer_button_primary));
+    alarm_factory.advance_by(batch_delay);
+}
@@ -49,6 +49,7 @@
 #include "mir/test/doubles/mock_frontend_surface.h"
 #include "mir/test/doubles/mock_event_sink.h"
 #include "mir/test/doubles/mock_event_sink_factory.h"
+#include "mir/test/doubles/mock_memory_report.h"
 #include "mir/test/doubles/mock_screencast.h"
 #include "mir/test/doubles/stub_buffer.h"
 #include "mir/test/doubles/mock_buffer.h"
@@ -313,6 +314,7 @@ struct SessionMediator : public ::testing::Test
             mt::fake_shared(mock_input_config_changer),
             {},
             allocator,
+            mr::null_memory_report(),
             executor}
     {
         using namespace ::testing;
@@ -345,6 +347,7 @@ struct SessionMediator : public ::testing::Test
             mir::cookie::Authority::create(),
             mt::fake_shared(mock_input_config_changer), std::vector<mir::ExtensionDescription>{},
             allocator,
+            mr::null_memory_report(),
             executor);
     }
 
@@ -362,6 +365,26 @@ struct SessionMediator : public ::testing::Test
             mir::cookie::Authority::create(),
             mt::fake_shared(mock_input_config_changer), std::vector<mir::ExtensionDescription>{},
             allocator,
+            mr::null_memory_report(),
+            executor);
+    }
+
+    std::shared_ptr<mf::SessionMediator> create_session_mediator_with_memory_report(
+        std::shared_ptr<ms::MemoryReport> const& memory_report)
+    {
+        return std::make_shared<mf::SessionMediator>(
+            shell, mt::fake_shared(mock_ipc_operations), graphics_changer,
+            surface_pixel_formats, report,
+            std::make_shared<mtd::NullEventSinkFactory>(),
+            std::make_shared<mtd::NullMessageSender>(),
+            resource_cache, stub_screencast, &connector, nullptr,
+            std::make_shared<NullCoordinateTranslator>(),
+            std::make_shared<mtd::NullANRDetector>(),
+            mir::cookie::Authority::create(),
+            mt::fake_shared(mock_input_config_changer),
+            std::vector<mir::ExtensionDescription>{},
+            allocator,
+            memory_report,
             executor);
     }
 
@@ -397,6 +420,11 @@ struct SessionMediator : public ::testing::Test
                 wrapped->send_ping(serial);
             }
 
+            void send_vsync(mf::SurfaceId id, uint32_t output_id, mg::Frame const& frame) override
+            {
+                wrapped->send_vsync(id, output_id, frame);
+            }
+
             void handle_input_config_change(MirInputConfig const& config) override
             {
                 wrapped->handle_input_config_change(config);
@@ -467,6 +495,7 @@ struct SessionMediator : public ::testing::Test
             mt::fake_shared(mock_input_config_changer),
             std::vector<mir::ExtensionDescription>{},
             allocator,
+            mr::null_memory_report(),
             executor);
     }
 
@@ -863,6 +892,40 @@ TEST_F(SessionMediator, allocates_software_buffers)
     EXPECT_THAT(allocator->allocated_buffers.size(), Eq(num_requests));
 }
 
+TEST_F(SessionMediator, reports_cached_buffers_against_the_session)
+{
+    using namespace testing;
+
+    auto const memory_report = std::make_shared<NiceMock<mtd::MockMemoryReport>>();
+    auto const mediator = create_session_mediator_with_memory_report(memory_report);
+    auto const session = static_cast<mf::Session const*>(stubbed_session.get());
+    auto const category = ms::MemoryReport::Category::client_buffers;
+    size_t const buffer_bytes{640 * 480 * 4};
+
+    mp::Void null;
+    mp::BufferAllocation allocate_request;
+    auto allocate = allocate_request.add_buffer_requests();
+    allocate->set_buffer_usage(static_cast<int32_t>(mg::BufferUsage::software));
+    allocate->set_pixel_format(mir_pixel_format_abgr_8888);
+    allocate->set_width(640);
+    allocate->set_height(480);
+
+    InSequence seq;
+    EXPECT_CALL(*memory_report, owner_created(session, nullptr, _));
+    EXPECT_CALL(*memory_report, allocated(session, category, buffer_bytes));
+    EXPECT_CALL(*memory_report, released(session, category, buffer_bytes));
+    EXPECT_CALL(*memory_report, owner_destroyed(session));
+
+    mediator->connect(&connect_parameters, &connection, null_callback.get());
+    mediator->allocate_buffers(&allocate_request, &null, null_callback.get());
+
+    mp::BufferRelease release_request;
+    release_request.add_buffers()->set_buffer_id(allocator->allocated_buffers.front().lock()->id().as_value());
+    mediator->release_buffers(&release_request, &null, null_callback.get());
+
+    mediator->disconnect(&null, &null, null_callback.get());
+}
+
 TEST_F(SessionMediator, allocates_native_buffers)
 {
     using namespace testing;
@@ -1385,6 +1448,45 @@ TEST_F(SessionMediator, buffer_releases_are_sent_from_specified_executor)
     mediator.submit_buffer(&submit_request, &null, null_callback.get());
 }
 
+TEST_F(SessionMediator, applies_transaction_modifications_before_its_buffer_submissions)
+{
+    using namespace testing;
+    mp::BufferAllocation allocate_buffer;
+    mp::Void null;
+
+    auto stream_id = mf::BufferStreamId{42};
+    auto stream = stubbed_session->create_mock_stream(stream_id);
+
+    allocate_buffer.mutable_id()->set_value(stream_id.as_value());
+    auto buffer_props = allocate_buffer.add_buffer_requests();
+    buffer_props->set_buffer_usage(0);
+    buffer_props->set_pixel_format(0);
+    buffer_props->set_width(230);
+    buffer_props->set_height(230);
+
+    mediator.connect(&connect_parameters, &connection, null_callback.get());
+    EXPECT_TRUE(connection.transactions_supported());
+
+    mediator.create_surface(&surface_parameters, &surface_response, null_callback.get());
+    mediator.allocate_buffers(&allocate_buffer, &null, null_callback.get());
+    ASSERT_THAT(allocator->allocated_buffers.size(), Eq(1));
+    auto const buffer_id = allocator->allocated_buffers.front().lock()->id();
+
+    mp::Transaction transaction;
+    auto const submission = transaction.add_submissions();
+    submission->mutable_id()->set_value(stream_id.as_value());
+    submission->mutable_buffer()->set_buffer_id(buffer_id.as_value());
+    auto const mods = transaction.add_modifications();
+    mods->mutable_surface_id()->set_value(surface_response.id().value());
+    mods->mutable_surface_specification()->set_min_width(1);
+
+    InSequence seq;
+    EXPECT_CALL(*shell, modify_surface(_, mf::SurfaceId{surface_response.id().value()}, _));
+    EXPECT_CALL(*stream, submit_buffer(_));
+
+    mediator.submit_transaction(&transaction, &null, null_callback.get());
+}
+
 namespace
 {
 void add_software_buffer_request(
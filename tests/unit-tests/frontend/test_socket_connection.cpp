@@ -113,6 +113,7 @@ struct StubReceiver : mfd::MessageReceiver
     std::vector<mir::Fd> some_fds;
 
     MOCK_METHOD0(client_creds, mf::SessionCredentials());
+    MOCK_METHOD2(use_shared_memory, bool(std::vector<mir::Fd> const&, std::string const&));
 };
 
 struct MockProcessor : public mfd::MessageProcessor
@@ -139,15 +140,20 @@ struct SocketConnection : public Test
     }
 
     void fake_receiving_message()
+    {
+        mir::protobuf::wire::Invocation invocation;
+        invocation.set_method_name("");
+        invocation.set_side_channel_fds(2);
+        fake_receiving(invocation);
+    }
+
+    void fake_receiving(mir::protobuf::wire::Invocation& invocation)
     {
         int const header_size = 2;
         char buffer[512];
-        mir::protobuf::wire::Invocation invocation;
         invocation.set_id(1);
-        invocation.set_method_name("");
         invocation.set_parameters(buffer, 0);
         invocation.set_protocol_version(mir::protobuf::current_protocol_version());
-        invocation.set_side_channel_fds(2);
         auto const body_size = invocation.ByteSize();
         buffer[0] = body_size / 0x100;
         buffer[1] = body_size % 0x100;
@@ -206,3 +212,34 @@ TEST_F(SocketConnection, receives_and_dispatches_fds)
     EXPECT_CALL(mock_processor, dispatch(_, ContainerEq(fds)));
     fake_receiving_message();
 }
+
+TEST_F(SocketConnection, moves_to_shared_memory_offered_with_connect)
+{
+    mir::protobuf::wire::Invocation invocation;
+    invocation.set_method_name("connect");
+    invocation.set_side_channel_fds(4);
+    invocation.set_shm_transport(true);
+
+    mir::protobuf::wire::Result acknowledgement;
+    acknowledgement.set_shm_transport(true);
+
+    InSequence seq;
+    EXPECT_CALL(stub_receiver, use_shared_memory(SizeIs(4), acknowledgement.SerializeAsString()))
+        .WillOnce(Return(true));
+    EXPECT_CALL(mock_processor, dispatch(_, IsEmpty()));
+
+    fake_receiving(invocation);
+}
+
+TEST_F(SocketConnection, ignores_shared_memory_offered_with_other_calls)
+{
+    mir::protobuf::wire::Invocation invocation;
+    invocation.set_method_name("ping");
+    invocation.set_side_channel_fds(4);
+    invocation.set_shm_transport(true);
+
+    EXPECT_CALL(stub_receiver, use_shared_memory(_, _)).Times(0);
+    EXPECT_CALL(mock_processor, dispatch(_, SizeIs(4)));
+
+    fake_receiving(invocation);
+}
@@ -0,0 +1,117 @@
+/*
+ * Copyright © 2017 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "src/server/frontend/socket_messenger.h"
+#include "mir/shm_ring.h"
+#include "mir/fd.h"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <array>
+
+#include <poll.h>
+#include <sys/mman.h>
+#include <sys/eventfd.h>
+
+namespace ba = boost::asio;
+namespace bs = boost::system;
+namespace mfd = mir::frontend::detail;
+
+using namespace testing;
+
+namespace
+{
+bool is_readable(int fd)
+{
+    pollfd pfd{fd, POLLIN, 0};
+    return poll(&pfd, 1, 0) == 1;
+}
+
+struct SocketMessengerOnRings : Test
+{
+    SocketMessengerOnRings()
+    {
+        ba::local::connect_pair(*server_socket, client_socket);
+        messenger = std::make_shared<mfd::SocketMessenger>(server_socket);
+
+        std::string const acknowledgement{"ok"};
+        EXPECT_TRUE(messenger->use_shared_memory(
+            {from_client.memory_fd(), from_client.doorbell_fd(), to_client.memory_fd(), to_client.doorbell_fd()},
+            acknowledgement));
+
+        // Header and acknowledgement, the last message on the socket
+        std::array<char, 4> received;
+        ba::read(client_socket, ba::buffer(received));
+    }
+
+    void corrupt_incoming_head()
+    {
+        // The head is the first index in the ring's header
+        auto const header = static_cast<uint64_t*>(
+            mmap(nullptr, 4096, PROT_READ | PROT_WRITE, MAP_SHARED, from_client.memory_fd(), 0));
+        header[0] = 1ull << 40;
+        munmap(header, 4096);
+    }
+
+    ba::io_service io_service;
+    std::shared_ptr<ba::local::stream_protocol::socket> const server_socket{
+        std::make_shared<ba::local::stream_protocol::socket>(io_service)};
+    ba::local::stream_protocol::socket client_socket{io_service};
+    std::shared_ptr<mfd::SocketMessenger> messenger;
+
+    mir::ShmRing from_client{4096};
+    mir::ShmRing to_client{4096};
+};
+}
+
+TEST_F(SocketMessengerOnRings, reports_a_corrupted_ring_to_the_read_handler)
+{
+    corrupt_incoming_head();
+
+    std::array<char, 2> header;
+    bs::error_code result;
+    bool called{false};
+    messenger->async_receive_msg(
+        [&](bs::error_code const& error, size_t) { called = true; result = error; },
+        ba::buffer(header));
+    io_service.poll();
+
+    EXPECT_TRUE(called);
+    EXPECT_THAT(result, Eq(bs::error_code{ba::error::fault}));
+}
+
+TEST_F(SocketMessengerOnRings, reports_a_corrupted_ring_to_synchronous_reads)
+{
+    corrupt_incoming_head();
+
+    std::array<char, 2> header;
+    EXPECT_THAT(messenger->available_bytes(), Eq(0u));
+    EXPECT_THAT(messenger->receive_msg(ba::buffer(header)), Eq(bs::error_code{ba::error::fault}));
+}
+
+TEST_F(SocketMessengerOnRings, sends_no_fds_for_a_message_that_does_not_fit)
+{
+    std::vector<char> const filler(to_client.capacity() - 16);
+    ASSERT_TRUE(to_client.write(filler.data(), filler.size()));
+
+    mir::Fd const fd{eventfd(0, EFD_CLOEXEC)};
+    std::vector<char> const message(64);
+
+    EXPECT_THROW(messenger->send(message.data(), message.size(), {{fd}}), std::runtime_error);
+    EXPECT_FALSE(is_readable(client_socket.native_handle()));
+}
@@ -17,10 +17,13 @@
  */
 
 #include <gtest/gtest.h>
+#include <gmock/gmock.h>
 
 #include "mir/graphics/platform.h"
 #include "mir/graphics/platform_probe.h"
+#include "mir/options/configuration.h"
 #include "mir/options/program_option.h"
+#include "mir/shared_library_prober_report.h"
 
 #include "mir/raii.h"
 
@@ -35,6 +38,11 @@
 #include "mir_test_framework/udev_environment.h"
 #include "mir_test_framework/executable_path.h"
 
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <unistd.h>
+
 namespace mtd = mir::test::doubles;
 namespace mtf = mir_test_framework;
 
@@ -78,6 +86,48 @@ std::shared_ptr<void> ensure_mesa_probing_succeeds()
     return env;
 }
 
+class MockSharedLibraryProberReport : public mir::SharedLibraryProberReport
+{
+public:
+    MOCK_METHOD1(probing_path, void(boost::filesystem::path const&));
+    MOCK_METHOD2(probing_failed, void(boost::filesystem::path const&, std::exception const&));
+    MOCK_METHOD1(loading_library, void(boost::filesystem::path const&));
+    MOCK_METHOD2(loading_failed, void(boost::filesystem::path const&, std::exception const&));
+    MOCK_METHOD2(loading_finished, void(boost::filesystem::path const&, std::chrono::nanoseconds));
+    MOCK_METHOD2(probed_module, void(boost::filesystem::path const&, std::chrono::nanoseconds));
+    MOCK_METHOD3(selected_module, void(boost::filesystem::path const&, bool, std::chrono::nanoseconds));
+};
+
+struct ServerPlatformProbeCache : ::testing::Test
+{
+    ServerPlatformProbeCache()
+    {
+        boost::program_options::options_description desc("");
+        desc.add_options()
+            (mir::options::platform_probe_cache_opt, boost::program_options::value<std::string>(), "");
+        std::array<char const*, 3> args {{ "./aserver", "--platform-probe-cache", cache_file.c_str() }};
+        options.parse_arguments(desc, args.size(), args.data());
+
+        add_dummy_platform(modules);
+    }
+
+    ~ServerPlatformProbeCache()
+    {
+        unlink(cache_file.c_str());
+    }
+
+    std::string cache_contents() const
+    {
+        std::ifstream in{cache_file};
+        return {std::istreambuf_iterator<char>{in}, std::istreambuf_iterator<char>{}};
+    }
+
+    std::string const cache_file{"/tmp/mir_test_platform_probe_cache_" + std::to_string(getpid())};
+    mir::options::ProgramOption options;
+    std::vector<std::shared_ptr<mir::SharedLibrary>> modules;
+    std::shared_ptr<void> const block_mesa{ensure_mesa_probing_fails()};
+};
+
 class ServerPlatformProbeMockDRM : public ::testing::Test
 {
 #if defined(MIR_BUILD_PLATFORM_MESA_KMS) || defined(MIR_BUILD_PLATFORM_MESA_X11)
@@ -188,3 +238,64 @@ TEST_F(ServerPlatformProbeMockDRM, IgnoresNonPlatformModules)
     auto module = mir::graphics::module_for_device(modules, options);
     EXPECT_NE(nullptr, module);
 }
+
+TEST_F(ServerPlatformProbeCache, writes_the_probe_results_to_the_cache)
+{
+    using namespace testing;
+    NiceMock<MockSharedLibraryProberReport> report;
+
+    EXPECT_CALL(report, selected_module(_, false, _));
+
+    mir::graphics::module_for_device(modules, options, report);
+
+    EXPECT_THAT(cache_contents(), StartsWith("mir-platform-probe-cache 1\nfingerprint "));
+    EXPECT_THAT(cache_contents(), HasSubstr("graphics-dummy.so"));
+}
+
+TEST_F(ServerPlatformProbeCache, selects_the_cached_module_on_the_same_system)
+{
+    using namespace testing;
+    NiceMock<MockSharedLibraryProberReport> report;
+
+    auto const probed = mir::graphics::module_for_device(modules, options);
+
+    EXPECT_CALL(report, selected_module(_, true, _));
+    EXPECT_CALL(report, probed_module(_, _)).Times(1);
+
+    auto const cached = mir::graphics::module_for_device(modules, options, report);
+
+    EXPECT_THAT(cached, Eq(probed));
+}
+
+TEST_F(ServerPlatformProbeCache, ignores_a_cache_from_a_different_system)
+{
+    using namespace testing;
+    NiceMock<MockSharedLibraryProberReport> report;
+
+    mir::graphics::module_for_device(modules, options);
+
+    auto contents = cache_contents();
+    auto const fingerprint = contents.find("fingerprint ") + strlen("fingerprint ");
+    contents.replace(fingerprint, contents.find('\n', fingerprint) - fingerprint, "0");
+    std::ofstream{cache_file} << contents;
+
+    EXPECT_CALL(report, selected_module(_, false, _));
+
+    auto const module = mir::graphics::module_for_device(modules, options, report);
+
+    EXPECT_THAT(module, NotNull());
+}
+
+TEST_F(ServerPlatformProbeCache, ignores_a_corrupt_cache)
+{
+    using namespace testing;
+    NiceMock<MockSharedLibraryProberReport> report;
+
+    std::ofstream{cache_file} << "garbage\n";
+
+    EXPECT_CALL(report, selected_module(_, false, _));
+
+    auto const module = mir::graphics::module_for_device(modules, options, report);
+
+    EXPECT_THAT(module, NotNull());
+}
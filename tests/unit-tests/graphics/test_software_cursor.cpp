@@ -28,6 +28,8 @@
 #include <gtest/gtest.h>
 #include <gmock/gmock.h>
 
+#include <array>
+
 namespace mg = mir::graphics;
 namespace mtd = mir::test::doubles;
 namespace mt = mir::test;
@@ -49,11 +51,11 @@ struct MockInputScene : mtd::StubInputScene
 
 struct StubCursorImage : mg::CursorImage
 {
-    StubCursorImage(geom::Displacement const& hotspot)
+    StubCursorImage(geom::Displacement const& hotspot, unsigned char fill = 0x55)
         : hotspot_{hotspot},
           pixels(
             size().width.as_uint32_t() * size().height.as_uint32_t() * bytes_per_pixel,
-            0x55)
+            fill)
     {
     }
 
@@ -81,7 +83,7 @@ private:
 struct SoftwareCursor : testing::Test
 {
     StubCursorImage stub_cursor_image{{3,4}};
-    StubCursorImage another_stub_cursor_image{{10,9}};
+    StubCursorImage another_stub_cursor_image{{10,9}, 0xaa};
     mtd::StubBufferAllocator stub_buffer_allocator;
     testing::NiceMock<MockInputScene> mock_input_scene;
 
@@ -294,26 +296,76 @@ TEST_F(SoftwareCursor, places_new_cursor_renderable_at_correct_position)
     cursor.show(another_stub_cursor_image);
 }
 
+struct MockBufferAllocator : public mg::GraphicBufferAllocator
+{
+    MOCK_METHOD1(alloc_buffer, std::shared_ptr<mg::Buffer>(mg::BufferProperties const&));
+    MOCK_METHOD2(alloc_software_buffer, std::shared_ptr<mg::Buffer>(geom::Size, MirPixelFormat));
+    MOCK_METHOD3(alloc_buffer, std::shared_ptr<mg::Buffer>(geom::Size, uint32_t, uint32_t));
+    std::vector<MirPixelFormat> supported_pixel_formats() { return {mir_pixel_format_abgr_8888}; }
+};
+
 //lp: #1413211
-TEST_F(SoftwareCursor, new_buffer_on_each_show)
+TEST_F(SoftwareCursor, new_buffer_for_each_new_image)
 {
-    struct MockBufferAllocator : public mg::GraphicBufferAllocator
-    {
-        MOCK_METHOD1(alloc_buffer, std::shared_ptr<mg::Buffer>(mg::BufferProperties const&));
-        MOCK_METHOD2(alloc_software_buffer, std::shared_ptr<mg::Buffer>(geom::Size, MirPixelFormat));
-        MOCK_METHOD3(alloc_buffer, std::shared_ptr<mg::Buffer>(geom::Size, uint32_t, uint32_t));
-        std::vector<MirPixelFormat> supported_pixel_formats() { return {mir_pixel_format_abgr_8888}; } 
-    } mock_allocator;
+    MockBufferAllocator mock_allocator;
 
     EXPECT_CALL(mock_allocator, alloc_buffer(testing::_))
-        .Times(3)
-        .WillRepeatedly(testing::Return(std::make_shared<mtd::StubBuffer>()));;
+        .Times(2)
+        .WillRepeatedly(testing::Invoke([](auto const&) { return std::make_shared<mtd::StubBuffer>(); }));
     mg::SoftwareCursor cursor{
         mt::fake_shared(mock_allocator),
         mt::fake_shared(mock_input_scene)};
     cursor.show(another_stub_cursor_image);
+    cursor.show(stub_cursor_image);
+}
+
+TEST_F(SoftwareCursor, reuses_the_buffer_when_an_image_is_shown_again)
+{
+    using namespace testing;
+    MockBufferAllocator mock_allocator;
+
+    EXPECT_CALL(mock_allocator, alloc_buffer(_))
+        .Times(2)
+        .WillRepeatedly(Invoke([](auto const&) { return std::make_shared<mtd::StubBuffer>(); }));
+    mg::SoftwareCursor cursor{
+        mt::fake_shared(mock_allocator),
+        mt::fake_shared(mock_input_scene)};
+
+    std::vector<std::shared_ptr<mg::Renderable>> renderables;
+    EXPECT_CALL(mock_input_scene, add_input_visualization(_))
+        .WillRepeatedly(Invoke([&](auto const& renderable) { renderables.push_back(renderable); }));
+
+    cursor.show(stub_cursor_image);
     cursor.show(another_stub_cursor_image);
     cursor.show(stub_cursor_image);
+
+    ASSERT_THAT(renderables.size(), Eq(3u));
+    EXPECT_THAT(renderables[2]->buffer(), Eq(renderables[0]->buffer()));
+    EXPECT_THAT(renderables[2], Ne(renderables[0]));
+}
+
+TEST_F(SoftwareCursor, converts_the_image_to_the_buffer_format)
+{
+    using namespace testing;
+    MockBufferAllocator mock_allocator;
+    auto const buffer = std::make_shared<mtd::StubBuffer>();
+
+    EXPECT_CALL(mock_allocator, alloc_buffer(_)).WillOnce(Return(buffer));
+    mg::SoftwareCursor cursor{
+        mt::fake_shared(mock_allocator),
+        mt::fake_shared(mock_input_scene)};
+
+    struct : StubCursorImage
+    {
+        using StubCursorImage::StubCursorImage;
+        void const* as_argb_8888() const override { return pixel.data(); }
+        geom::Size size() const override { return {1, 1}; }
+        std::array<unsigned char, 4> const pixel{{0x11, 0x22, 0x33, 0x44}};
+    } const argb_pixel{{0, 0}};
+
+    cursor.show(argb_pixel);
+
+    EXPECT_THAT(buffer->written_pixels, ElementsAre(0x33, 0x22, 0x11, 0x44));
 }
 
 //lp: 1483779
@@ -165,11 +165,19 @@ struct StubInputSurface : public mtd::StubSceneSurface
         observers.erase(it);
     }
 
+    void notify_moved()
+    {
+        for (auto observer : observers)
+        {
+            observer->moved_to(this, bounds.top_left);
+        }
+    }
+
     void post_frame()
     {
         for (auto observer : observers)
         {
-            observer->frame_posted(this, 1, geom::Size{0, 0});
+            observer->frame_posted(this, 1, geom::Rectangle{{0, 0}, {0, 0}});
         }
     }
 
@@ -198,6 +206,19 @@ struct StubScene : public mtd::StubInputScene
             callback(target);
     }
 
+    std::shared_ptr<mi::Surface> input_surface_at(geom::Point const& point) override
+    {
+        ++hit_tests;
+
+        std::shared_ptr<mi::Surface> top_surface;
+        for (auto const& target : targets)
+        {
+            if (target->input_area_contains(point))
+                top_surface = target;
+        }
+        return top_surface;
+    }
+
     void add_observer(std::shared_ptr<ms::Observer> const& observer) override
     {
         observers.add(observer);
@@ -232,6 +253,7 @@ struct StubScene : public mtd::StubInputScene
     std::vector<std::shared_ptr<ms::Surface>> targets;
 
     mir::ThreadSafeList<std::shared_ptr<ms::Observer>> observers;
+    int hit_tests{0};
 };
 
 struct TestCursorController : public testing::Test
@@ -451,3 +473,48 @@ TEST_F(TestCursorController, zero_sized_image_hides_cursor)
 
     targets.add_surface(mt::fake_shared(surface));
 }
+
+TEST_F(TestCursorController, changes_to_surfaces_away_from_the_cursor_dont_hit_test_the_scene)
+{
+    using namespace ::testing;
+
+    // The cursor begins at 0,0
+    StubInputSurface surface{rect_1_1_1_1,
+        std::make_shared<NamedCursorImage>(cursor_name_1)};
+    StubScene targets({mt::fake_shared(surface)});
+
+    mi::CursorController controller(mt::fake_shared(targets),
+        mt::fake_shared(cursor), default_cursor_image);
+
+    auto const initial_hit_tests = targets.hit_tests;
+
+    EXPECT_CALL(cursor, show(_)).Times(0);
+
+    surface.notify_moved();
+    surface.post_frame();
+    surface.set_cursor_image(std::make_shared<NamedCursorImage>(cursor_name_2));
+
+    EXPECT_THAT(targets.hit_tests, Eq(initial_hit_tests));
+}
+
+TEST_F(TestCursorController, change_to_surface_under_cursor_updates_image)
+{
+    using namespace ::testing;
+
+    StubInputSurface surface{rect_0_0_1_1,
+        std::make_shared<NamedCursorImage>(cursor_name_1)};
+    StubScene targets({mt::fake_shared(surface)});
+
+    EXPECT_CALL(cursor, show(CursorNamed(cursor_name_1))).Times(1);
+
+    mi::CursorController controller(mt::fake_shared(targets),
+        mt::fake_shared(cursor), default_cursor_image);
+
+    Mock::VerifyAndClearExpectations(&cursor);
+
+    surface.set_cursor_image_without_notifications(
+        std::make_shared<NamedCursorImage>(cursor_name_2));
+
+    EXPECT_CALL(cursor, show(CursorNamed(cursor_name_2))).Times(1);
+    surface.notify_moved();
+}
@@ -283,3 +283,23 @@ TEST_F(InputEventBuilder, when_deserialized_input_device_state_event_has_supplie
         EXPECT_THAT(mir_input_device_state_event_device_pressed_keys_for_index(ids_event, 2, i), Eq(pressed_keys[i]));
     }
 }
+
+TEST_F(InputEventBuilder, serialized_into_a_used_string_round_trips_events_of_several_segments)
+{
+    std::vector<uint32_t> const pressed_keys(10, KEY_Q);
+    std::vector<mev::InputDeviceState> devices;
+    for (int i = 0; i != 20; ++i)
+        devices.push_back(mev::InputDeviceState{MirInputDeviceId(i), pressed_keys, 0});
+
+    auto ev = mev::make_event(timestamp, 0, mir_input_event_modifier_none, 0.0f, 0.0f, std::move(devices));
+
+    std::string encoded(4096, 'x');
+    MirEvent::serialize(ev.get(), encoded);
+    EXPECT_THAT(encoded, Eq(MirEvent::serialize(ev.get())));
+
+    auto deserialzed_event = MirEvent::deserialize(encoded);
+    auto ids_event = mir_event_get_input_device_state_event(deserialzed_event.get());
+
+    ASSERT_THAT(mir_input_device_state_event_device_count(ids_event), Eq(20));
+    EXPECT_THAT(mir_input_device_state_event_device_pressed_keys_count(ids_event, 19), Eq(10));
+}
@@ -0,0 +1,186 @@
+/*
+ * Copyright © 2017 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 or 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "src/server/input/threaded_seat.h"
+
+#include "mir/events/event_builders.h"
+#include "mir/test/doubles/mock_input_seat.h"
+#include "mir/test/doubles/mock_device.h"
+#include "mir/test/signal.h"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <thread>
+#include <vector>
+
+namespace mi = mir::input;
+namespace mt = mir::test;
+namespace mtd = mt::doubles;
+namespace mev = mir::events;
+using namespace std::literals::chrono_literals;
+using namespace ::testing;
+
+namespace
+{
+struct ThreadedSeat : Test
+{
+    std::shared_ptr<MirEvent> a_key_event(MirInputDeviceId device, int scan_code)
+    {
+        return mev::make_event(device, 0ns, std::vector<uint8_t>{}, mir_keyboard_action_down,
+                               0, scan_code, mir_input_event_modifier_none);
+    }
+
+    MirInputDeviceId const device_id{7};
+    NiceMock<mtd::MockDevice> device{device_id, mi::DeviceCapability::keyboard, "keyboard", "keyboard-uid"};
+    std::shared_ptr<NiceMock<mtd::MockInputSeat>> const seat = std::make_shared<NiceMock<mtd::MockInputSeat>>();
+    std::chrono::seconds const timeout{10};
+};
+}
+
+TEST_F(ThreadedSeat, dispatches_events_on_the_seat_thread)
+{
+    mi::ThreadedSeat threaded_seat{seat, "Test/Seat"};
+    mt::Signal dispatched;
+    std::thread::id dispatching_thread;
+
+    EXPECT_CALL(*seat, dispatch_event(_))
+        .WillOnce(Invoke([&](std::shared_ptr<MirEvent> const&)
+            {
+                dispatching_thread = std::this_thread::get_id();
+                dispatched.raise();
+            }));
+
+    threaded_seat.dispatch_event(a_key_event(device_id, 1));
+
+    ASSERT_TRUE(dispatched.wait_for(timeout));
+    EXPECT_THAT(dispatching_thread, Ne(std::this_thread::get_id()));
+}
+
+TEST_F(ThreadedSeat, preserves_event_order)
+{
+    mi::ThreadedSeat threaded_seat{seat, "Test/Seat"};
+    size_t const event_count{500};
+    std::vector<std::shared_ptr<MirEvent>> events;
+    std::vector<MirEvent const*> received;
+    mt::Signal all_received;
+
+    ON_CALL(*seat, dispatch_event(_))
+        .WillByDefault(Invoke([&](std::shared_ptr<MirEvent> const& event)
+            {
+                received.push_back(event.get());
+                if (received.size() == event_count)
+                    all_received.raise();
+            }));
+
+    for (size_t i = 0; i != event_count; ++i)
+    {
+        events.push_back(a_key_event(device_id, i));
+        threaded_seat.dispatch_event(events.back());
+    }
+
+    ASSERT_TRUE(all_received.wait_for(timeout));
+
+    std::vector<MirEvent const*> expected;
+    for (auto const& event : events)
+        expected.push_back(event.get());
+    EXPECT_THAT(received, ContainerEq(expected));
+}
+
+TEST_F(ThreadedSeat, removes_device_only_after_its_queued_events_are_dispatched)
+{
+    mi::ThreadedSeat threaded_seat{seat, "Test/Seat"};
+    mt::Signal dispatch_started;
+    mt::Signal dispatch_may_finish;
+
+    InSequence seq;
+    EXPECT_CALL(*seat, dispatch_event(_))
+        .WillOnce(Invoke([&](std::shared_ptr<MirEvent> const&)
+            {
+                dispatch_started.raise();
+                dispatch_may_finish.wait_for(timeout);
+            }));
+    EXPECT_CALL(*seat, dispatch_event(_));
+    EXPECT_CALL(*seat, remove_device(Ref(device)));
+
+    threaded_seat.dispatch_event(a_key_event(device_id, 1));
+    threaded_seat.dispatch_event(a_key_event(device_id, 2));
+    ASSERT_TRUE(dispatch_started.wait_for(timeout));
+
+    std::thread release{[&] { std::this_thread::sleep_for(10ms); dispatch_may_finish.raise(); }};
+    threaded_seat.remove_device(device);
+    release.join();
+}
+
+TEST_F(ThreadedSeat, applies_state_changes_after_the_events_queued_before_them)
+{
+    mi::ThreadedSeat threaded_seat{seat, "Test/Seat"};
+    mt::Signal dispatch_may_finish;
+    mt::Signal all_applied;
+
+    InSequence seq;
+    EXPECT_CALL(*seat, dispatch_event(_))
+        .WillOnce(InvokeWithoutArgs([&] { dispatch_may_finish.wait_for(timeout); }));
+    EXPECT_CALL(*seat, set_key_state(Ref(device), ElementsAre(1u)));
+    EXPECT_CALL(*seat, set_cursor_position(10.0f, 20.0f));
+    EXPECT_CALL(*seat, dispatch_event(_));
+    EXPECT_CALL(*seat, reset_confinement_regions())
+        .WillOnce(InvokeWithoutArgs([&] { all_applied.raise(); }));
+
+    threaded_seat.dispatch_event(a_key_event(device_id, 1));
+    threaded_seat.set_key_state(device, {1});
+    threaded_seat.set_cursor_position(10.0f, 20.0f);
+    threaded_seat.dispatch_event(a_key_event(device_id, 2));
+    threaded_seat.reset_confinement_regions();
+    dispatch_may_finish.raise();
+
+    EXPECT_TRUE(all_applied.wait_for(timeout));
+}
+
+TEST_F(ThreadedSeat, creates_device_state_after_the_queued_events)
+{
+    mi::ThreadedSeat threaded_seat{seat, "Test/Seat"};
+    mt::Signal dispatch_started;
+    mt::Signal dispatch_may_finish;
+
+    InSequence seq;
+    EXPECT_CALL(*seat, dispatch_event(_))
+        .WillOnce(InvokeWithoutArgs([&]
+            {
+                dispatch_started.raise();
+                dispatch_may_finish.wait_for(timeout);
+            }));
+    EXPECT_CALL(*seat, create_device_state());
+
+    threaded_seat.dispatch_event(a_key_event(device_id, 1));
+    ASSERT_TRUE(dispatch_started.wait_for(timeout));
+
+    std::thread release{[&] { std::this_thread::sleep_for(10ms); dispatch_may_finish.raise(); }};
+    threaded_seat.create_device_state();
+    release.join();
+}
+
+TEST_F(ThreadedSeat, forwards_queries_and_device_additions_directly)
+{
+    mi::ThreadedSeat threaded_seat{seat, "Test/Seat"};
+    mir::geometry::Rectangle const bounds{{0, 0}, {800, 600}};
+
+    EXPECT_CALL(*seat, add_device(Ref(device)));
+    EXPECT_CALL(*seat, bounding_rectangle()).WillOnce(Return(bounds));
+
+    threaded_seat.add_device(device);
+    EXPECT_THAT(threaded_seat.bounding_rectangle(), Eq(bounds));
+}
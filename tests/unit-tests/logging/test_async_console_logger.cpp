@@ -0,0 +1,181 @@
+/*
+ * Copyright © 2017 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "mir/logging/async_console_logger.h"
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace ml = mir::logging;
+using namespace testing;
+
+namespace
+{
+std::string contents_of(std::FILE* file)
+{
+    std::string result;
+    std::rewind(file);
+
+    char buffer[256];
+    size_t read;
+    while ((read = std::fread(buffer, 1, sizeof buffer, file)) > 0)
+        result.append(buffer, read);
+
+    return result;
+}
+
+struct AsyncConsoleLogger : Test
+{
+    ~AsyncConsoleLogger()
+    {
+        ml::set_max_severity(ml::Severity::debug);
+        std::fclose(out);
+        std::fclose(err);
+    }
+
+    std::FILE* const out{std::tmpfile()};
+    std::FILE* const err{std::tmpfile()};
+    ml::AsyncConsoleLogger logger{out, err};
+};
+}
+
+TEST_F(AsyncConsoleLogger, writes_formatted_messages_once_flushed)
+{
+    logger.log("test", ml::Severity::informational, "%s %d", "answer", 42);
+    logger.flush();
+
+    EXPECT_THAT(contents_of(out), MatchesRegex("\\[.*\\] test: answer 42\n"));
+}
+
+TEST_F(AsyncConsoleLogger, writes_errors_to_the_error_stream_with_their_severity)
+{
+    logger.log(ml::Severity::warning, "careful", "test");
+    logger.log(ml::Severity::debug, "detail", "test");
+    logger.flush();
+
+    EXPECT_THAT(contents_of(err), MatchesRegex("\\[.*\\] <WARNING> test: careful\n"));
+    EXPECT_THAT(contents_of(out), MatchesRegex("\\[.*\\] <DEBUG> test: detail\n"));
+}
+
+TEST_F(AsyncConsoleLogger, writes_messages_in_order_across_streams)
+{
+    ml::AsyncConsoleLogger shared_logger{out, out};
+
+    shared_logger.log(ml::Severity::informational, "first", "test");
+    shared_logger.log(ml::Severity::error, "second", "test");
+    shared_logger.log(ml::Severity::informational, "third", "test");
+    shared_logger.flush();
+
+    auto const written = contents_of(out);
+    EXPECT_THAT(written.find("first"), Lt(written.find("second")));
+    EXPECT_THAT(written.find("second"), Lt(written.find("third")));
+}
+
+TEST_F(AsyncConsoleLogger, writes_critical_messages_before_returning)
+{
+    logger.log(ml::Severity::critical, "dying", "test");
+
+    EXPECT_THAT(contents_of(err), HasSubstr("<CRITICAL> test: dying"));
+}
+
+TEST_F(AsyncConsoleLogger, writes_critical_messages_when_the_ring_is_full)
+{
+    int pipe_fds[2];
+    ASSERT_THAT(pipe2(pipe_fds, O_NONBLOCK), Eq(0));
+
+    // Fill the pipe so the writer stalls on its first write
+    char const filler[4096]{};
+    while (write(pipe_fds[1], filler, sizeof filler) > 0)
+        ;
+    fcntl(pipe_fds[1], F_SETFL, 0);
+    fcntl(pipe_fds[0], F_SETFL, 0);
+    auto const unread = fdopen(pipe_fds[1], "w");
+
+    std::thread drain;
+    {
+        ml::AsyncConsoleLogger stalled_logger{unread, err};
+
+        for (auto i = 0; i != 4 * 1024; ++i)
+            stalled_logger.log(ml::Severity::informational, std::string(100, 'x'), "test");
+
+        drain = std::thread{[&]
+            {
+                std::this_thread::sleep_for(std::chrono::milliseconds{100});
+                char buffer[4096];
+                while (read(pipe_fds[0], buffer, sizeof buffer) > 0)
+                    ;
+            }};
+
+        stalled_logger.log(ml::Severity::critical, "dying", "test");
+
+        EXPECT_THAT(contents_of(err), HasSubstr("<CRITICAL> test: dying"));
+    }
+
+    std::fclose(unread);
+    drain.join();
+    close(pipe_fds[0]);
+}
+
+TEST_F(AsyncConsoleLogger, drops_messages_more_verbose_than_max_severity)
+{
+    ml::set_max_severity(ml::Severity::informational);
+
+    logger.log(ml::Severity::debug, "hidden", "test");
+    logger.log("test", ml::Severity::debug, "%s", "hidden");
+    logger.log(ml::Severity::informational, "shown", "test");
+    logger.flush();
+
+    EXPECT_THAT(contents_of(out), Not(HasSubstr("hidden")));
+    EXPECT_THAT(contents_of(out), HasSubstr("shown"));
+}
+
+TEST_F(AsyncConsoleLogger, preserves_the_order_of_messages_from_each_thread)
+{
+    int const threads = 4;
+    int const messages = 200;
+
+    std::vector<std::thread> loggers;
+    for (auto t = 0; t != threads; ++t)
+    {
+        loggers.emplace_back([this, t]
+            {
+                for (auto i = 0; i != messages; ++i)
+                    logger.log("test", ml::Severity::informational, "%d %d", t, i);
+            });
+    }
+    for (auto& thread : loggers)
+        thread.join();
+    logger.flush();
+
+    std::vector<int> next(threads, 0);
+    auto const written = contents_of(out);
+    for (auto line = written.find(": "); line != std::string::npos; line = written.find(": ", line + 1))
+    {
+        int t, i;
+        ASSERT_THAT(sscanf(written.c_str() + line, ": %d %d", &t, &i), Eq(2));
+        EXPECT_THAT(i, Eq(next[t]));
+        next[t] = i + 1;
+    }
+}
@@ -0,0 +1,143 @@
+/*
+ * Copyright © 2017 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 or 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "src/server/report/logging/buffer_lifetime_report.h"
+#include "mir/logging/logger.h"
+#include "mir/test/doubles/advanceable_clock.h"
+
+#include <gtest/gtest.h>
+#include <string>
+
+namespace mtd = mir::test::doubles;
+namespace mrl = mir::report::logging;
+namespace ml = mir::logging;
+namespace mg = mir::graphics;
+
+namespace
+{
+
+class Recorder : public ml::Logger
+{
+public:
+    void log(ml::Severity, std::string const& message, std::string const&) override
+    {
+        last = message;
+        ++count;
+    }
+
+    bool last_message_contains(char const* substr) const
+    {
+        return last.find(substr) != std::string::npos;
+    }
+
+    std::string last;
+    int count = 0;
+};
+
+struct LoggingBufferLifetimeReport : ::testing::Test
+{
+    std::shared_ptr<mtd::AdvanceableClock> const clock =
+        std::make_shared<mtd::AdvanceableClock>();
+    std::shared_ptr<Recorder> const recorder =
+        std::make_shared<Recorder>();
+    mrl::BufferLifetimeReport report{recorder, clock};
+
+    void const* const stream = "stream";
+    void const* const compositor = "compositor";
+    mg::BufferID const buffer{7};
+};
+
+}
+
+TEST_F(LoggingBufferLifetimeReport, reports_nothing_within_a_second)
+{
+    report.buffer_submitted(stream, buffer);
+    clock->advance_by(std::chrono::milliseconds(2));
+    report.buffer_acquired(stream, buffer, compositor);
+    clock->advance_by(std::chrono::milliseconds(8));
+    report.buffer_released(stream, buffer);
+
+    EXPECT_EQ(0, recorder->count);
+}
+
+TEST_F(LoggingBufferLifetimeReport, reports_latency_percentiles_per_stream)
+{
+    report.buffer_submitted(stream, buffer);
+    clock->advance_by(std::chrono::microseconds(2000));
+    report.buffer_acquired(stream, buffer, compositor);
+    clock->advance_by(std::chrono::microseconds(8000));
+    report.buffer_released(stream, buffer);
+    clock->advance_by(std::chrono::microseconds(3000));
+    report.buffer_submitted(stream, buffer);
+    clock->advance_by(std::chrono::seconds(1));
+    report.buffer_acquired(stream, buffer, compositor);
+
+    ASSERT_EQ(1, recorder->count);
+    EXPECT_TRUE(recorder->last_message_contains("2 frames")) << recorder->last;
+    EXPECT_TRUE(recorder->last_message_contains("queued p50/p99 2048/")) << recorder->last;
+    EXPECT_TRUE(recorder->last_message_contains("held p50/p99 8192/8192 us")) << recorder->last;
+    EXPECT_TRUE(recorder->last_message_contains("client turnaround p50/p99 4096/4096 us")) << recorder->last;
+}
+
+TEST_F(LoggingBufferLifetimeReport, only_first_compositor_dequeues_a_buffer)
+{
+    void const* const other_compositor = "other compositor";
+
+    report.buffer_submitted(stream, buffer);
+    report.buffer_acquired(stream, buffer, compositor);
+    report.buffer_acquired(stream, buffer, other_compositor);
+    clock->advance_by(std::chrono::seconds(1));
+    report.buffer_released(stream, buffer);
+
+    ASSERT_EQ(1, recorder->count);
+    EXPECT_TRUE(recorder->last_message_contains("1 frames")) << recorder->last;
+    EXPECT_TRUE(recorder->last_message_contains("max queue depth 1")) << recorder->last;
+}
+
+TEST_F(LoggingBufferLifetimeReport, forgets_destroyed_streams)
+{
+    report.buffer_submitted(stream, buffer);
+    report.buffer_acquired(stream, buffer, compositor);
+    report.stream_destroyed(stream);
+    clock->advance_by(std::chrono::seconds(1));
+    report.buffer_released(stream, buffer);
+
+    EXPECT_EQ(0, recorder->count);
+}
+
+TEST_F(LoggingBufferLifetimeReport, logs_frame_rate_limit_changes)
+{
+    report.frame_interval_changed(stream, std::chrono::milliseconds(100));
+
+    ASSERT_EQ(1, recorder->count);
+    EXPECT_TRUE(recorder->last_message_contains("one frame per 100 ms")) << recorder->last;
+
+    report.frame_interval_changed(stream, std::chrono::milliseconds(0));
+
+    ASSERT_EQ(2, recorder->count);
+    EXPECT_TRUE(recorder->last_message_contains("frame rate unlimited")) << recorder->last;
+}
+
+TEST_F(LoggingBufferLifetimeReport, counts_deferred_frames)
+{
+    report.buffer_submitted(stream, buffer);
+    report.buffer_deferred(stream, buffer);
+    clock->advance_by(std::chrono::seconds(1));
+    report.buffer_acquired(stream, buffer, compositor);
+
+    ASSERT_EQ(1, recorder->count);
+    EXPECT_TRUE(recorder->last_message_contains("1 deferred by frame rate limit")) << recorder->last;
+}
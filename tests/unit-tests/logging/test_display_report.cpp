@@ -197,3 +197,23 @@ TEST_F(DisplayReport, reports_vsync_steady_interval_despite_missed_frames)
     frame.ust.nanoseconds += d2 * nanos_per_frame;
     report.report_vsync(id, frame);
 }
+
+TEST_F(DisplayReport, reports_render_time_against_prediction)
+{
+    unsigned const id{7};
+
+    InSequence seq;
+    EXPECT_CALL(*logger, log(
+        ml::Severity::informational,
+        Eq("render time on 7: 4.250ms, predicted 6.000ms"),
+        component));
+    EXPECT_CALL(*logger, log(
+        ml::Severity::informational,
+        Eq("render time on 7: 9.001ms, predicted 6.000ms (missed)"),
+        component));
+
+    mrl::DisplayReport report(logger);
+
+    report.report_render_time(id, std::chrono::microseconds{6000}, std::chrono::microseconds{4250});
+    report.report_render_time(id, std::chrono::microseconds{6000}, std::chrono::microseconds{9001});
+}
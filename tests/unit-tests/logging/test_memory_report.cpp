@@ -0,0 +1,169 @@
+/*
+ * Copyright © 2017 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "src/server/report/memory_usage.h"
+#include "src/server/report/logging/memory_report.h"
+#include "src/server/report/metrics/memory_report.h"
+#include "src/server/report/metrics/registry.h"
+#include "mir/logging/logger.h"
+#include "mir/test/doubles/advanceable_clock.h"
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <sstream>
+
+namespace mr = mir::report;
+namespace mrl = mir::report::logging;
+namespace mrm = mir::report::metrics;
+namespace ml = mir::logging;
+namespace mtd = mir::test::doubles;
+using namespace testing;
+using namespace std::chrono_literals;
+
+namespace
+{
+using Category = mir::scene::MemoryReport::Category;
+
+class Recorder : public ml::Logger
+{
+public:
+    void log(ml::Severity, std::string const& message, std::string const&) override
+    {
+        messages.push_back(message);
+    }
+
+    std::vector<std::string> messages;
+};
+
+struct MemoryReport : Test
+{
+    int const session{0};
+    int const stream{0};
+    int const stranger{0};
+};
+}
+
+TEST_F(MemoryReport, attributes_memory_of_children_to_their_session)
+{
+    mr::MemoryUsage usage;
+
+    auto const created = usage.owner_created(&session, nullptr, "client");
+    ASSERT_THAT(created, NotNull());
+    EXPECT_THAT(created->name, Eq("client"));
+    auto const id = created->id;
+
+    EXPECT_THAT(usage.owner_created(&stream, &session, "buffer stream 1"), IsNull());
+
+    usage.allocated(&session, Category::client_buffers, 4096);
+    auto const changed = usage.allocated(&stream, Category::textures, 1024);
+
+    ASSERT_THAT(changed, NotNull());
+    EXPECT_THAT(changed->id, Eq(id));
+    EXPECT_THAT(changed->bytes[static_cast<size_t>(Category::client_buffers)], Eq(4096u));
+    EXPECT_THAT(changed->bytes[static_cast<size_t>(Category::textures)], Eq(1024u));
+    EXPECT_THAT(changed->total(), Eq(5120u));
+
+    // What a child still holds when it goes is no longer the session's
+    auto const after = usage.owner_destroyed(&stream);
+    ASSERT_THAT(after, NotNull());
+    EXPECT_THAT(after->total(), Eq(4096u));
+    EXPECT_FALSE(after->closed);
+}
+
+TEST_F(MemoryReport, charges_memory_of_unknown_owners_to_unattributed)
+{
+    mr::MemoryUsage usage;
+
+    auto const changed = usage.allocated(&stranger, Category::snapshots, 100);
+
+    ASSERT_THAT(changed, NotNull());
+    EXPECT_THAT(changed->name, Eq("unattributed"));
+    EXPECT_THAT(changed->id, Eq(0u));
+    EXPECT_THAT(changed->total(), Eq(100u));
+
+    EXPECT_THAT(usage.released(&stranger, Category::snapshots, 100)->total(), Eq(0u));
+    EXPECT_THAT(usage.released(&stranger, Category::snapshots, 100), IsNull());
+}
+
+TEST_F(MemoryReport, forgets_a_closed_session)
+{
+    mr::MemoryUsage usage;
+    usage.owner_created(&session, nullptr, "client");
+    usage.owner_created(&stream, &session, "buffer stream 1");
+    usage.allocated(&stream, Category::client_buffers, 4096);
+
+    auto const closed = usage.owner_destroyed(&session);
+
+    ASSERT_THAT(closed, NotNull());
+    EXPECT_TRUE(closed->closed);
+    EXPECT_THAT(closed->total(), Eq(4096u));
+
+    int sessions{0};
+    usage.for_each([&](mr::MemoryUsage::Usage const& u) { if (u.id) ++sessions; });
+    EXPECT_THAT(sessions, Eq(0));
+
+    // The stream went with the session, so its memory is now unattributed
+    EXPECT_THAT(usage.allocated(&stream, Category::textures, 1)->id, Eq(0u));
+}
+
+TEST_F(MemoryReport, logs_changed_sessions_at_most_once_a_second)
+{
+    auto const clock = std::make_shared<mtd::AdvanceableClock>();
+    auto const recorder = std::make_shared<Recorder>();
+    mrl::MemoryReport report{recorder, clock};
+
+    report.owner_created(&session, nullptr, "client");
+    report.allocated(&session, Category::client_buffers, 8192);
+    clock->advance_by(100ms);
+    report.allocated(&session, Category::textures, 2048);
+
+    EXPECT_THAT(recorder->messages, IsEmpty());
+
+    clock->advance_by(1s);
+    report.allocated(&session, Category::textures, 2048);
+
+    ASSERT_THAT(recorder->messages, SizeIs(1));
+    EXPECT_THAT(recorder->messages.back(), StartsWith("\"client\" (#1) holds 12 KiB: "
+        "8 KiB client buffers, 4 KiB textures, 0 KiB snapshots"));
+
+    report.owner_destroyed(&session);
+
+    ASSERT_THAT(recorder->messages, SizeIs(2));
+    EXPECT_THAT(recorder->messages.back(), HasSubstr("closed 12 KiB"));
+}
+
+TEST_F(MemoryReport, exposes_session_memory_as_gauges)
+{
+    auto const registry = std::make_shared<mrm::Registry>();
+    mrm::MemoryReport report{registry};
+
+    report.owner_created(&session, nullptr, "a \"quoted\" client");
+    report.allocated(&session, Category::client_buffers, 8192);
+
+    std::ostringstream out;
+    registry->write_to(out);
+
+    EXPECT_THAT(out.str(), HasSubstr("# TYPE mir_memory_bytes gauge\n"));
+    EXPECT_THAT(out.str(), HasSubstr(
+        "mir_memory_bytes{owner=\"a \\\"quoted\\\" client\",id=\"1\",category=\"client_buffers\"} 8192\n"));
+
+    report.owner_destroyed(&session);
+
+    std::ostringstream after;
+    registry->write_to(after);
+    EXPECT_THAT(after.str(), Not(HasSubstr("quoted")));
+}
@@ -0,0 +1,216 @@
+/*
+ * Copyright © 2017 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "src/server/report/metrics/registry.h"
+#include "src/server/report/metrics/compositor_report.h"
+#include "src/server/report/metrics/message_processor_report.h"
+#include "src/server/report/metrics/endpoint.h"
+#include "mir/test/doubles/advanceable_clock.h"
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <sstream>
+#include <thread>
+#include <vector>
+
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace mrm = mir::report::metrics;
+namespace mtd = mir::test::doubles;
+using namespace testing;
+using namespace std::chrono_literals;
+
+namespace
+{
+struct MetricsReport : Test
+{
+    std::string exposition() const
+    {
+        std::ostringstream out;
+        registry->write_to(out);
+        return out.str();
+    }
+
+    std::shared_ptr<mrm::Registry> const registry{std::make_shared<mrm::Registry>()};
+    std::shared_ptr<mtd::AdvanceableClock> const clock{std::make_shared<mtd::AdvanceableClock>()};
+};
+}
+
+TEST(MetricsHistogram, buckets_values_with_bounded_relative_error)
+{
+    for (uint64_t value = 1; value < (1ull << 36); value = value * 3 / 2 + 1)
+    {
+        auto const bucket = mrm::Histogram::bucket_for(value);
+        auto const upper = mrm::Histogram::value_for(bucket);
+
+        EXPECT_THAT(upper, Ge(value));
+        EXPECT_THAT(upper - value, Le(value / 32)) << "value=" << value;
+        EXPECT_THAT(mrm::Histogram::bucket_for(upper), Eq(bucket));
+    }
+}
+
+TEST(MetricsHistogram, reports_percentiles_of_recorded_values)
+{
+    mrm::Histogram histogram;
+
+    for (uint64_t value = 1; value <= 10000; ++value)
+        histogram.record(value);
+
+    auto const snapshot = histogram.snapshot();
+
+    EXPECT_THAT(snapshot.count(), Eq(10000u));
+    EXPECT_THAT(snapshot.max(), Eq(10000u));
+    EXPECT_THAT(snapshot.percentile(0.5), AllOf(Ge(5000u), Le(5000u * 33 / 32)));
+    EXPECT_THAT(snapshot.percentile(0.99), AllOf(Ge(9900u), Le(10000u)));
+    EXPECT_THAT(snapshot.percentile(1.0), Eq(10000u));
+}
+
+TEST(MetricsHistogram, merges_values_recorded_on_different_threads)
+{
+    mrm::Histogram histogram;
+    mrm::Counter counter;
+
+    std::vector<std::thread> threads;
+    for (int i = 0; i != 8; ++i)
+    {
+        threads.emplace_back([&]
+            {
+                for (int j = 0; j != 1000; ++j)
+                {
+                    histogram.record(j);
+                    counter.increment();
+                }
+            });
+    }
+    for (auto& thread : threads)
+        thread.join();
+
+    EXPECT_THAT(histogram.snapshot().count(), Eq(8000u));
+    EXPECT_THAT(counter.value(), Eq(8000u));
+}
+
+TEST_F(MetricsReport, exposes_metrics_in_text_format)
+{
+    registry->counter("mir_things_total", "kind=\"a\"").increment(3);
+    registry->histogram("mir_thing_time_us").record(42);
+
+    auto const text = exposition();
+
+    EXPECT_THAT(text, HasSubstr("# TYPE mir_things_total counter\nmir_things_total{kind=\"a\"} 3\n"));
+    EXPECT_THAT(text, HasSubstr("# TYPE mir_thing_time_us summary\n"));
+    EXPECT_THAT(text, HasSubstr("mir_thing_time_us{quantile=\"0.99\"} 42\n"));
+    EXPECT_THAT(text, HasSubstr("mir_thing_time_us_sum 42\n"));
+    EXPECT_THAT(text, HasSubstr("mir_thing_time_us_count 1\n"));
+}
+
+TEST_F(MetricsReport, records_frame_times_per_output)
+{
+    mrm::CompositorReport report{registry, clock};
+    int const output{0};
+
+    report.added_display(1920, 1080, 0, 0, &output);
+    for (int frame = 0; frame != 10; ++frame)
+    {
+        report.scheduled();
+        report.began_frame(&output);
+        clock->advance_by(4ms);
+        report.rendered_frame(&output);
+        report.finished_frame(&output);
+        clock->advance_by(12ms);
+    }
+
+    auto const labels = "output=\"1920x1080+0+0\"";
+    auto const frame_time = registry->histogram("mir_frame_time_us", labels).snapshot();
+    auto const render_time = registry->histogram("mir_frame_render_time_us", labels).snapshot();
+
+    EXPECT_THAT(frame_time.count(), Eq(9u));
+    EXPECT_THAT(frame_time.percentile(0.99), AllOf(Ge(16000u), Le(17000u)));
+    EXPECT_THAT(render_time.percentile(0.5), AllOf(Ge(4000u), Le(4250u)));
+}
+
+TEST_F(MetricsReport, records_frames_of_outputs_composited_concurrently)
+{
+    mrm::CompositorReport report{registry, clock};
+    int const outputs[4]{};
+    int const frames{100};
+
+    std::vector<std::thread> compositors;
+    for (auto const& output : outputs)
+    {
+        compositors.emplace_back([&]
+            {
+                for (int frame = 0; frame != frames; ++frame)
+                {
+                    report.scheduled();
+                    report.began_frame(&output);
+                    report.rendered_frame(&output);
+                    report.finished_frame(&output);
+                }
+            });
+    }
+    for (auto& compositor : compositors)
+        compositor.join();
+
+    auto const frame_time = registry->histogram("mir_frame_time_us", "output=\"unknown\"").snapshot();
+    EXPECT_THAT(frame_time.count(), Eq(4u * (frames - 1)));
+}
+
+TEST_F(MetricsReport, records_rpc_latency_per_method)
+{
+    mrm::MessageProcessorReport report{registry, clock};
+    int const mediator{0};
+
+    report.received_invocation(&mediator, 1, "next_buffer");
+    clock->advance_by(2ms);
+    report.completed_invocation(&mediator, 1, true);
+
+    report.received_invocation(&mediator, 2, "\"bogus\"");
+    report.unknown_method(&mediator, 2, "\"bogus\"");
+    report.completed_invocation(&mediator, 2, false);
+
+    auto const latency = registry->histogram("mir_rpc_latency_us", "method=\"next_buffer\"").snapshot();
+    EXPECT_THAT(latency.count(), Eq(1u));
+    EXPECT_THAT(latency.max(), Eq(2000u));
+
+    EXPECT_THAT(exposition(), Not(HasSubstr("bogus")));
+    EXPECT_THAT(registry->counter("mir_rpc_unknown_methods_total").value(), Eq(1u));
+}
+
+TEST_F(MetricsReport, serves_metrics_on_a_socket)
+{
+    std::string const path = "/tmp/mir_test_metrics_" + std::to_string(getpid());
+    registry->counter("mir_things_total").increment();
+
+    mrm::Endpoint endpoint{path, registry};
+
+    int const client{socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0)};
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    path.copy(address.sun_path, path.size());
+    ASSERT_THAT(connect(client, reinterpret_cast<sockaddr*>(&address), sizeof address), Eq(0));
+
+    std::string received;
+    char buffer[256];
+    ssize_t read_bytes;
+    while ((read_bytes = read(client, buffer, sizeof buffer)) > 0)
+        received.append(buffer, read_bytes);
+    close(client);
+
+    EXPECT_THAT(received, Eq(exposition()));
+}
@@ -30,6 +30,7 @@ namespace graphics
 namespace mesa
 {
 class DRMFB;
+class PageFlipGroup;
 }
 }
 
@@ -57,6 +58,12 @@ struct MockKMSOutput : public graphics::mesa::KMSOutput
         return schedule_page_flip_thunk(&fb);
     }
     MOCK_METHOD1(schedule_page_flip_thunk, bool(graphics::mesa::FBHandle const*));
+
+    bool add_page_flip_to(graphics::mesa::PageFlipGroup& group, graphics::mesa::FBHandle const& fb) override
+    {
+        return add_page_flip_to_thunk(&group, &fb);
+    }
+    MOCK_METHOD2(add_page_flip_to_thunk, bool(graphics::mesa::PageFlipGroup*, graphics::mesa::FBHandle const*));
     MOCK_METHOD0(wait_for_page_flip, void());
 
     MOCK_CONST_METHOD0(last_frame, graphics::Frame());
@@ -0,0 +1,230 @@
+/*
+ * Copyright © 2017 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "src/platforms/mesa/server/kms/atomic_kms_page_flipper.h"
+
+#include "mir/test/doubles/mock_drm.h"
+#include "mir/test/doubles/mock_display_report.h"
+#include "mir/test/fake_shared.h"
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <fcntl.h>
+
+namespace mg  = mir::graphics;
+namespace mgm = mir::graphics::mesa;
+namespace mt  = mir::test;
+namespace mtd = mir::test::doubles;
+
+using namespace testing;
+
+namespace
+{
+
+class AtomicKMSPageFlipperTest : public ::testing::Test
+{
+public:
+    AtomicKMSPageFlipperTest()
+    {
+        mock_drm.add_plane(drm_device, primary_plane_ids[0], 0x1, DRM_PLANE_TYPE_PRIMARY);
+        mock_drm.add_plane(drm_device, primary_plane_ids[1], 0x2, DRM_PLANE_TYPE_PRIMARY);
+        mock_drm.add_plane(drm_device, overlay_plane_id, 0x3, DRM_PLANE_TYPE_OVERLAY);
+    }
+
+    NiceMock<mtd::MockDisplayReport> report;
+    NiceMock<mtd::MockDRM> mock_drm;
+
+    char const* const drm_device = "/dev/dri/card0";
+    int const drm_fd{open(drm_device, 0, 0)};
+
+    // The default fake DRM device has these two CRTCs
+    uint32_t const crtc_ids[2]{10, 11};
+    uint32_t const primary_plane_ids[2]{40, 41};
+    uint32_t const overlay_plane_id{42};
+    uint32_t const fb_id{101};
+    uint32_t const connector_id{345};
+
+    uint32_t const fb_id_property{mock_drm.property_id(drm_device, "FB_ID")};
+    uint32_t const crtc_id_property{mock_drm.property_id(drm_device, "CRTC_ID")};
+
+    uint32_t const test_only{DRM_MODE_ATOMIC_TEST_ONLY};
+    uint32_t const nonblocking_flip{DRM_MODE_ATOMIC_NONBLOCK | DRM_MODE_PAGE_FLIP_EVENT};
+};
+
+ACTION_P(InvokePageFlipHandler, param)
+{
+    int const dont_care{0};
+    char dummy;
+
+    arg1->page_flip_handler(dont_care, dont_care, dont_care, dont_care, *param);
+    ASSERT_EQ(1, read(arg0, &dummy, 1));
+}
+
+}
+
+TEST_F(AtomicKMSPageFlipperTest, flips_the_primary_plane_with_a_nonblocking_atomic_commit)
+{
+    mgm::AtomicKMSPageFlipper page_flipper{drm_fd, mt::fake_shared(report)};
+
+    EXPECT_CALL(mock_drm, drmModeAtomicAddProperty(_, _, _, _))
+        .Times(AnyNumber());
+    EXPECT_CALL(mock_drm, drmModeAtomicAddProperty(_, primary_plane_ids[0], fb_id_property, fb_id))
+        .Times(AtLeast(1));
+    EXPECT_CALL(mock_drm, drmModeAtomicAddProperty(_, primary_plane_ids[0], crtc_id_property, crtc_ids[0]))
+        .Times(AtLeast(1));
+    EXPECT_CALL(mock_drm, drmModeAtomicAddProperty(_, overlay_plane_id, _, _))
+        .Times(0);
+    EXPECT_CALL(mock_drm, drmModeAtomicCommit(drm_fd, _, test_only, _));
+    EXPECT_CALL(mock_drm, drmModeAtomicCommit(drm_fd, _, nonblocking_flip, NotNull()));
+    EXPECT_CALL(mock_drm, drmModePageFlip(_, _, _, _, _))
+        .Times(0);
+
+    EXPECT_TRUE(page_flipper.schedule_flip(crtc_ids[0], fb_id, connector_id));
+}
+
+TEST_F(AtomicKMSPageFlipperTest, validates_a_configuration_only_once)
+{
+    mgm::AtomicKMSPageFlipper page_flipper{drm_fd, mt::fake_shared(report)};
+    void* user_data{nullptr};
+
+    EXPECT_CALL(mock_drm, drmModeAtomicCommit(drm_fd, _, test_only, _))
+        .Times(1);
+    EXPECT_CALL(mock_drm, drmModeAtomicCommit(drm_fd, _, nonblocking_flip, _))
+        .Times(2)
+        .WillRepeatedly(DoAll(SaveArg<3>(&user_data), Return(0)));
+    EXPECT_CALL(mock_drm, drmHandleEvent(drm_fd, _))
+        .WillRepeatedly(DoAll(InvokePageFlipHandler(&user_data), Return(0)));
+
+    for (int i = 0; i != 2; ++i)
+    {
+        EXPECT_TRUE(page_flipper.schedule_flip(crtc_ids[0], fb_id, connector_id));
+        mock_drm.generate_event_on(drm_device);
+        page_flipper.wait_for_flip(crtc_ids[0]);
+    }
+}
+
+TEST_F(AtomicKMSPageFlipperTest, uses_legacy_flips_for_configurations_the_driver_rejects)
+{
+    mgm::AtomicKMSPageFlipper page_flipper{drm_fd, mt::fake_shared(report)};
+    void* user_data{nullptr};
+
+    EXPECT_CALL(mock_drm, drmModeAtomicCommit(drm_fd, _, test_only, _))
+        .Times(1)
+        .WillOnce(Return(-EINVAL));
+    EXPECT_CALL(mock_drm, drmModeAtomicCommit(drm_fd, _, nonblocking_flip, _))
+        .Times(0);
+    EXPECT_CALL(mock_drm, drmModePageFlip(drm_fd, crtc_ids[0], fb_id, DRM_MODE_PAGE_FLIP_EVENT, _))
+        .Times(2)
+        .WillRepeatedly(DoAll(SaveArg<4>(&user_data), Return(0)));
+    EXPECT_CALL(mock_drm, drmHandleEvent(drm_fd, _))
+        .WillRepeatedly(DoAll(InvokePageFlipHandler(&user_data), Return(0)));
+
+    for (int i = 0; i != 2; ++i)
+    {
+        EXPECT_TRUE(page_flipper.schedule_flip(crtc_ids[0], fb_id, connector_id));
+        mock_drm.generate_event_on(drm_device);
+        page_flipper.wait_for_flip(crtc_ids[0]);
+    }
+}
+
+TEST_F(AtomicKMSPageFlipperTest, uses_legacy_flips_for_crtcs_without_a_primary_plane)
+{
+    mock_drm.reset(drm_device);
+    mock_drm.add_crtc(drm_device, crtc_ids[0], drmModeModeInfo());
+    mock_drm.prepare(drm_device);
+
+    mgm::AtomicKMSPageFlipper page_flipper{drm_fd, mt::fake_shared(report)};
+
+    EXPECT_CALL(mock_drm, drmModeAtomicCommit(_, _, _, _))
+        .Times(0);
+    EXPECT_CALL(mock_drm, drmModePageFlip(drm_fd, crtc_ids[0], fb_id, _, _));
+
+    EXPECT_TRUE(page_flipper.schedule_flip(crtc_ids[0], fb_id, connector_id));
+}
+
+TEST_F(AtomicKMSPageFlipperTest, failed_commit_is_not_left_pending)
+{
+    mgm::AtomicKMSPageFlipper page_flipper{drm_fd, mt::fake_shared(report)};
+
+    EXPECT_CALL(mock_drm, drmModeAtomicCommit(drm_fd, _, test_only, _))
+        .Times(AnyNumber());
+    EXPECT_CALL(mock_drm, drmModeAtomicCommit(drm_fd, _, nonblocking_flip, _))
+        .WillOnce(Return(-EBUSY))
+        .WillOnce(Return(0));
+
+    EXPECT_FALSE(page_flipper.schedule_flip(crtc_ids[0], fb_id, connector_id));
+    EXPECT_NO_THROW(page_flipper.schedule_flip(crtc_ids[0], fb_id, connector_id));
+}
+
+TEST_F(AtomicKMSPageFlipperTest, commits_crtcs_separately_when_events_dont_identify_them)
+{
+    EXPECT_CALL(mock_drm, drmGetCap(drm_fd, _, _))
+        .WillRepeatedly(Return(-EINVAL));
+
+    mgm::AtomicKMSPageFlipper page_flipper{drm_fd, mt::fake_shared(report)};
+
+    EXPECT_CALL(mock_drm, drmModeAtomicCommit(drm_fd, _, test_only, _))
+        .Times(AnyNumber());
+    EXPECT_CALL(mock_drm, drmModeAtomicCommit(drm_fd, _, nonblocking_flip, _))
+        .Times(2);
+
+    EXPECT_TRUE(page_flipper.schedule_flips({
+        {crtc_ids[0], fb_id, connector_id},
+        {crtc_ids[1], fb_id, connector_id + 1}}));
+}
+
+#if defined(DRM_CAP_CRTC_IN_VBLANK_EVENT) && DRM_EVENT_CONTEXT_VERSION >= 3
+TEST_F(AtomicKMSPageFlipperTest, flips_clones_with_a_single_commit)
+{
+    ON_CALL(mock_drm, drmGetCap(drm_fd, DRM_CAP_CRTC_IN_VBLANK_EVENT, _))
+        .WillByDefault(DoAll(SetArgPointee<2>(1), Return(0)));
+
+    mgm::AtomicKMSPageFlipper page_flipper{drm_fd, mt::fake_shared(report)};
+    void* user_data{nullptr};
+
+    EXPECT_CALL(mock_drm, drmModeAtomicAddProperty(_, _, _, _))
+        .Times(AnyNumber());
+    EXPECT_CALL(mock_drm, drmModeAtomicAddProperty(_, primary_plane_ids[0], fb_id_property, fb_id))
+        .Times(AtLeast(1));
+    EXPECT_CALL(mock_drm, drmModeAtomicAddProperty(_, primary_plane_ids[1], fb_id_property, fb_id))
+        .Times(AtLeast(1));
+    EXPECT_CALL(mock_drm, drmModeAtomicCommit(drm_fd, _, test_only, _))
+        .Times(AnyNumber());
+    EXPECT_CALL(mock_drm, drmModeAtomicCommit(drm_fd, _, nonblocking_flip, _))
+        .WillOnce(DoAll(SaveArg<3>(&user_data), Return(0)));
+    EXPECT_CALL(mock_drm, drmHandleEvent(drm_fd, _))
+        .WillOnce(DoAll(
+            Invoke([&](int, drmEventContextPtr evctx)
+                {
+                    // The kernel sends an event per CRTC, all with the same data
+                    for (auto const crtc_id : crtc_ids)
+                        evctx->page_flip_handler2(drm_fd, 0, 0, 0, crtc_id, user_data);
+
+                    char dummy;
+                    ASSERT_EQ(1, read(drm_fd, &dummy, 1));
+                }),
+            Return(0)));
+
+    EXPECT_TRUE(page_flipper.schedule_flips({
+        {crtc_ids[0], fb_id, connector_id},
+        {crtc_ids[1], fb_id, connector_id + 1}}));
+
+    mock_drm.generate_event_on(drm_device);
+    page_flipper.wait_for_flip(crtc_ids[0]);
+    page_flipper.wait_for_flip(crtc_ids[1]);
+}
+#endif
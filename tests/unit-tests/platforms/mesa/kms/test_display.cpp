@@ -656,6 +656,19 @@ TEST_F(MesaDisplayTest, for_each_display_buffer_calls_callback)
     EXPECT_NE(0, callback_count);
 }
 
+TEST_F(MesaDisplayTest, last_frame_on_unknown_output_is_zero_frame)
+{
+    using namespace ::testing;
+
+    auto display = create_display(create_platform());
+
+    mg::Frame frame;
+    EXPECT_NO_THROW(frame = display->last_frame_on(1000));
+    EXPECT_THAT(frame.msc, Eq(0));
+    EXPECT_NO_THROW(frame = display->last_frame_on(0));
+    EXPECT_THAT(frame.msc, Eq(0));
+}
+
 TEST_F(MesaDisplayTest, constructor_sets_vt_graphics_mode)
 {
     using namespace testing;
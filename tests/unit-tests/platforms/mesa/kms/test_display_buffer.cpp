@@ -27,6 +27,7 @@
 #include "mir/test/doubles/mock_drm.h"
 #include "mir/test/doubles/mock_buffer.h"
 #include "mir/test/doubles/mock_gbm.h"
+#include "mir/test/doubles/mock_display_report.h"
 #include "mir/test/doubles/stub_gl_config.h"
 #include "mir/test/doubles/stub_gbm_native_buffer.h"
 #include "mir_test_framework/udev_environment.h"
@@ -91,6 +92,8 @@ public:
             .WillByDefault(Return(true));
         ON_CALL(*mock_kms_output, schedule_page_flip_thunk(_))
             .WillByDefault(Return(true));
+        ON_CALL(*mock_kms_output, add_page_flip_to_thunk(_, _))
+            .WillByDefault(Return(true));
         ON_CALL(*mock_kms_output, max_refresh_rate())
             .WillByDefault(Return(mock_refresh_rate));
         ON_CALL(*mock_kms_output, fb_for(_))
@@ -233,6 +236,69 @@ TEST_F(MesaDisplayBufferTest, frames_requiring_gl_are_not_throttled)
     }
 }
 
+TEST_F(MesaDisplayBufferTest, composited_frames_are_throttled_once_render_time_is_measured)
+{
+    graphics::RenderableList non_bypassable_list{
+        std::make_shared<FakeRenderable>(geometry::Rectangle{{12, 34}, {1, 1}})
+    };
+    auto const report = std::make_shared<NiceMock<MockDisplayReport>>();
+
+    EXPECT_CALL(*report, report_render_time(_, _, _)).Times(AtLeast(1));
+
+    graphics::mesa::DisplayBuffer db(
+        graphics::mesa::BypassOption::allowed,
+        report,
+        {mock_kms_output},
+        make_output_surface(),
+        display_area,
+        identity);
+
+    for (int frame = 0; frame < 30; ++frame)
+    {
+        ASSERT_FALSE(db.overlay(non_bypassable_list));
+        db.make_current();
+        db.swap_buffers();
+        db.post();
+    }
+
+    // Cast to a simple int type so that test failures are readable
+    int milliseconds_per_frame = 1000 / mock_refresh_rate;
+    EXPECT_THAT(db.recommended_sleep().count(), Ge(milliseconds_per_frame/2));
+}
+
+TEST_F(MesaDisplayBufferTest, measures_render_time_with_a_fence_when_supported)
+{
+    auto const fake_sync = reinterpret_cast<EGLSyncKHR>(0x5ca1ab1e);
+    graphics::RenderableList non_bypassable_list{
+        std::make_shared<FakeRenderable>(geometry::Rectangle{{12, 34}, {1, 1}})
+    };
+
+    ON_CALL(mock_egl, eglQueryString(_, EGL_EXTENSIONS))
+        .WillByDefault(Return("EGL_KHR_image EGL_KHR_image_base EGL_KHR_fence_sync"));
+
+    graphics::mesa::DisplayBuffer db(
+        graphics::mesa::BypassOption::allowed,
+        null_display_report(),
+        {mock_kms_output},
+        make_output_surface(),
+        display_area,
+        identity);
+
+    InSequence seq;
+    EXPECT_CALL(mock_egl, eglCreateSyncKHR(_, EGL_SYNC_FENCE_KHR, _))
+        .WillOnce(Return(fake_sync));
+    EXPECT_CALL(mock_egl, eglSwapBuffers(_, _));
+    EXPECT_CALL(mock_egl, eglClientWaitSyncKHR(_, fake_sync, _, _))
+        .WillOnce(Return(EGL_CONDITION_SATISFIED_KHR));
+    EXPECT_CALL(*mock_kms_output, wait_for_page_flip());
+    EXPECT_CALL(mock_egl, eglDestroySyncKHR(_, fake_sync));
+
+    ASSERT_FALSE(db.overlay(non_bypassable_list));
+    db.make_current();
+    db.swap_buffers();
+    db.post();
+}
+
 TEST_F(MesaDisplayBufferTest, bypass_buffer_only_referenced_once_by_db)
 {
     graphics::mesa::DisplayBuffer db(
@@ -381,7 +447,7 @@ TEST_F(MesaDisplayBufferTest, clone_mode_first_flip_flips_but_no_wait)
 {
     // Ensure clone mode can do multiple page flips in parallel without
     // blocking on either (at least till the second post)
-    EXPECT_CALL(*mock_kms_output, schedule_page_flip_thunk(_))
+    EXPECT_CALL(*mock_kms_output, add_page_flip_to_thunk(_, _))
         .Times(2);
     EXPECT_CALL(*mock_kms_output, wait_for_page_flip())
         .Times(0);
@@ -398,6 +464,25 @@ TEST_F(MesaDisplayBufferTest, clone_mode_first_flip_flips_but_no_wait)
     db.post();
 }
 
+TEST_F(MesaDisplayBufferTest, clone_mode_flips_outputs_as_a_group)
+{
+    EXPECT_CALL(*mock_kms_output, schedule_page_flip_thunk(_))
+        .Times(0);
+    EXPECT_CALL(*mock_kms_output, add_page_flip_to_thunk(NotNull(), _))
+        .Times(2);
+
+    graphics::mesa::DisplayBuffer db(
+        graphics::mesa::BypassOption::allowed,
+        null_display_report(),
+        {mock_kms_output, mock_kms_output},
+        make_output_surface(),
+        display_area,
+        identity);
+
+    db.swap_buffers();
+    db.post();
+}
+
 TEST_F(MesaDisplayBufferTest, single_mode_first_post_flips_with_wait)
 {
     EXPECT_CALL(*mock_kms_output, schedule_page_flip_thunk(_))
@@ -423,11 +508,11 @@ TEST_F(MesaDisplayBufferTest, clone_mode_waits_for_page_flip_on_second_flip)
 
     EXPECT_CALL(*mock_kms_output, wait_for_page_flip())
         .Times(0);
-    EXPECT_CALL(*mock_kms_output, schedule_page_flip_thunk(_))
+    EXPECT_CALL(*mock_kms_output, add_page_flip_to_thunk(_, _))
         .Times(2);
     EXPECT_CALL(*mock_kms_output, wait_for_page_flip())
         .Times(2);
-    EXPECT_CALL(*mock_kms_output, schedule_page_flip_thunk(_))
+    EXPECT_CALL(*mock_kms_output, add_page_flip_to_thunk(_, _))
         .Times(2);
     EXPECT_CALL(*mock_kms_output, wait_for_page_flip())
         .Times(0);
@@ -103,6 +103,29 @@ TEST_F(KMSPageFlipperTest, double_schedule_flip_throws)
     }, std::logic_error);
 }
 
+TEST_F(KMSPageFlipperTest, schedule_flips_flips_each_crtc)
+{
+    using namespace testing;
+
+    uint32_t const crtc_ids[]{10, 11};
+    uint32_t const fb_id{101};
+    uint32_t const connector_ids[]{345, 346};
+
+    EXPECT_CALL(mock_drm, drmModePageFlip(drm_fd, crtc_ids[0], fb_id, _, _))
+        .WillOnce(Return(-EINVAL));
+    EXPECT_CALL(mock_drm, drmModePageFlip(drm_fd, crtc_ids[1], fb_id, _, _))
+        .WillOnce(Return(0));
+
+    EXPECT_TRUE(page_flipper.schedule_flips({
+        {crtc_ids[0], fb_id, connector_ids[0]},
+        {crtc_ids[1], fb_id, connector_ids[1]}}));
+
+    /* The failed flip isn't left pending */
+    EXPECT_CALL(mock_drm, drmModePageFlip(drm_fd, crtc_ids[0], fb_id, _, _))
+        .WillOnce(Return(0));
+    EXPECT_NO_THROW(page_flipper.schedule_flip(crtc_ids[0], fb_id, connector_ids[0]));
+}
+
 TEST_F(KMSPageFlipperTest, wait_for_flip_handles_drm_event)
 {
     using namespace testing;
@@ -46,6 +46,7 @@ class NullPageFlipper : public mgm::PageFlipper
 {
 public:
     bool schedule_flip(uint32_t,uint32_t,uint32_t) override { return true; }
+    bool schedule_flips(std::vector<Flip> const&) override { return true; }
     mg::Frame wait_for_flip(uint32_t) override { return {}; }
 };
 
@@ -53,6 +54,7 @@ class MockPageFlipper : public mgm::PageFlipper
 {
 public:
     MOCK_METHOD3(schedule_flip, bool(uint32_t,uint32_t,uint32_t));
+    MOCK_METHOD1(schedule_flips, bool(std::vector<Flip> const&));
     MOCK_METHOD1(wait_for_flip, mg::Frame(uint32_t));
 };
 
@@ -260,6 +262,40 @@ TEST_F(RealKMSOutputTest, operations_use_possible_crtc)
     output.wait_for_page_flip();
 }
 
+TEST_F(RealKMSOutputTest, flips_added_to_a_group_are_scheduled_together)
+{
+    using namespace testing;
+
+    setup_outputs_connected_crtc();
+
+    uint32_t const fb_id{42};
+    append_fb_id(fb_id);
+
+    EXPECT_CALL(mock_page_flipper, schedule_flip(_, _, _))
+        .Times(0);
+    EXPECT_CALL(mock_page_flipper, schedule_flips(ElementsAre(AllOf(
+            Field(&mgm::PageFlipper::Flip::crtc_id, crtc_ids[0]),
+            Field(&mgm::PageFlipper::Flip::fb_id, fb_id),
+            Field(&mgm::PageFlipper::Flip::connector_id, connector_ids[0])))))
+        .WillOnce(Return(true));
+    EXPECT_CALL(mock_page_flipper, wait_for_flip(crtc_ids[0]))
+        .Times(1);
+
+    mgm::RealKMSOutput output{
+        drm_fd,
+        mg::kms::get_connector(drm_fd, connector_ids[0]),
+        mt::fake_shared(mock_page_flipper)};
+
+    auto fb = output.fb_for(fake_bo);
+
+    EXPECT_TRUE(output.set_crtc(*fb));
+
+    mgm::PageFlipGroup group;
+    EXPECT_TRUE(output.add_page_flip_to(group, *fb));
+    EXPECT_TRUE(group.schedule());
+    output.wait_for_page_flip();
+}
+
 TEST_F(RealKMSOutputTest, set_crtc_failure_is_handled_gracefully)
 {
     mir::FatalErrorStrategy on_error{mir::fatal_error_except};
@@ -0,0 +1,90 @@
+/*
+ * Copyright © 2017 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "src/platforms/mesa/server/kms/render_time_predictor.h"
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+namespace mgm = mir::graphics::mesa;
+using namespace testing;
+using namespace std::chrono_literals;
+
+namespace
+{
+struct RenderTimePredictor : Test
+{
+    void record_frames(int frames, std::chrono::microseconds each)
+    {
+        for (int i = 0; i != frames; ++i)
+            predictor.record(each);
+    }
+
+    std::chrono::microseconds const ceiling{50ms};
+    mgm::RenderTimePredictor predictor{ceiling};
+};
+}
+
+TEST_F(RenderTimePredictor, predicts_the_ceiling_until_frames_are_measured)
+{
+    EXPECT_THAT(predictor.predicted(), Eq(ceiling));
+
+    record_frames(5, 2ms);
+
+    EXPECT_THAT(predictor.predicted(), Eq(ceiling));
+}
+
+TEST_F(RenderTimePredictor, predicts_the_slowest_recent_frame_with_a_margin)
+{
+    record_frames(20, 4ms);
+    ASSERT_FALSE(predictor.record(5ms));
+    record_frames(5, 4ms);
+
+    EXPECT_THAT(predictor.predicted(), AllOf(Gt(5ms), Lt(8ms)));
+}
+
+TEST_F(RenderTimePredictor, forgets_slow_frames_that_are_no_longer_recent)
+{
+    record_frames(20, 4ms);
+    predictor.record(8ms);
+    record_frames(100, 4ms);
+
+    EXPECT_THAT(predictor.predicted(), AllOf(Gt(4ms), Lt(8ms)));
+}
+
+TEST_F(RenderTimePredictor, never_predicts_more_than_the_ceiling)
+{
+    record_frames(20, 80ms);
+
+    EXPECT_THAT(predictor.predicted(), Eq(ceiling));
+}
+
+TEST_F(RenderTimePredictor, widens_the_margin_for_a_while_after_a_miss)
+{
+    record_frames(20, 4ms);
+    auto const before = predictor.predicted();
+
+    EXPECT_FALSE(predictor.record(4ms));
+    EXPECT_TRUE(predictor.record(before + 1ms));
+
+    // Even once the slow frame is forgotten, we stay cautious for a while...
+    record_frames(20, 4ms);
+    EXPECT_THAT(predictor.predicted(), Ge(8ms));
+
+    // ...but not for ever
+    record_frames(100, 4ms);
+    EXPECT_THAT(predictor.predicted(), Eq(before));
+}
@@ -68,6 +68,8 @@ public:
     MOCK_METHOD1(client_surface_close_requested, void(ms::Surface const*));
     MOCK_METHOD2(cursor_image_set_to, void(ms::Surface const*, mir::graphics::CursorImage const& image));
     MOCK_METHOD1(cursor_image_removed, void(ms::Surface const*));
+    MOCK_METHOD3(frame_posted, void(ms::Surface const*, int, geom::Rectangle const&));
+    MOCK_METHOD2(input_region_set_to, void(ms::Surface const*, std::vector<geom::Rectangle> const&));
 };
 
 struct BasicSurfaceTest : public testing::Test
@@ -440,6 +442,29 @@ TEST_F(BasicSurfaceTest, restores_default_input_region_when_setting_empty_input_
     EXPECT_TRUE(surface.input_area_contains(rect.bottom_right() - geom::Displacement{1,1}));
 }
 
+TEST_F(BasicSurfaceTest, input_region_can_extend_beyond_surface)
+{
+    using namespace testing;
+    surface.set_input_region({{{-10, -10}, {100, 100}}});
+
+    EXPECT_TRUE(surface.input_area_contains(rect.top_left - geom::Displacement{5,5}));
+    EXPECT_TRUE(surface.input_area_contains(rect.bottom_right()));
+    EXPECT_THAT(surface.input_region_bounds(),
+        Eq(geom::Rectangle{rect.top_left - geom::Displacement{10,10}, {100, 100}}));
+}
+
+TEST_F(BasicSurfaceTest, notifies_observers_of_input_region)
+{
+    using namespace testing;
+    std::vector<geom::Rectangle> const region{{{0, 0}, {10, 10}}};
+    NiceMock<MockSurfaceObserver> mock_surface_observer;
+    surface.add_observer(mt::fake_shared(mock_surface_observer));
+
+    EXPECT_CALL(mock_surface_observer, input_region_set_to(_, Eq(region)));
+
+    surface.set_input_region(region);
+}
+
 TEST_F(BasicSurfaceTest, disables_input_when_setting_input_region_with_empty_rectangle)
 {
     surface.set_input_region({geom::Rectangle()});
@@ -861,6 +886,108 @@ TEST_F(BasicSurfaceTest, registers_frame_callbacks_on_set_streams)
     surface.set_streams(streams);
 }
 
+TEST_F(BasicSurfaceTest, frames_damage_only_where_their_stream_is_shown)
+{
+    using namespace testing;
+
+    auto const video_stream = std::make_shared<NiceMock<mtd::MockBufferStream>>();
+    std::function<void(geom::Size const&)> post_video_frame;
+    EXPECT_CALL(*video_stream, set_frame_posted_callback(_))
+        .WillOnce(SaveArg<0>(&post_video_frame));
+
+    geom::Displacement const video_offset{30, 40};
+    geom::Size const video_size{64, 48};
+    surface.set_streams({{ mock_buffer_stream, {0,0}, {} }, { video_stream, video_offset, {} }});
+    ASSERT_TRUE(post_video_frame);
+
+    NiceMock<MockSurfaceObserver> mock_surface_observer;
+    surface.add_observer(mt::fake_shared(mock_surface_observer));
+
+    EXPECT_CALL(mock_surface_observer,
+        frame_posted(&surface, 1, geom::Rectangle{rect.top_left + video_offset, video_size}));
+
+    post_video_frame(video_size);
+}
+
+TEST_F(BasicSurfaceTest, frame_damage_covers_the_transformed_stream)
+{
+    using namespace testing;
+
+    std::function<void(geom::Size const&)> post_frame;
+    auto const buffer_stream = std::make_shared<NiceMock<mtd::MockBufferStream>>();
+    EXPECT_CALL(*buffer_stream, set_frame_posted_callback(_))
+        .WillOnce(SaveArg<0>(&post_frame));
+
+    geom::Size const size{10, 20};
+    surface.set_streams({{ buffer_stream, {0,0}, {} }});
+    ASSERT_TRUE(post_frame);
+
+    glm::mat4 const double_size{2, 0, 0, 0,
+                                0, 2, 0, 0,
+                                0, 0, 1, 0,
+                                0, 0, 0, 1};
+    surface.set_transformation(double_size);
+
+    NiceMock<MockSurfaceObserver> mock_surface_observer;
+    surface.add_observer(mt::fake_shared(mock_surface_observer));
+
+    // Scaled about its centre, as the renderers do
+    EXPECT_CALL(mock_surface_observer,
+        frame_posted(&surface, 1, geom::Rectangle{rect.top_left - geom::Displacement{5, 10}, {20, 40}}));
+
+    post_frame(size);
+}
+
+TEST_F(BasicSurfaceTest, frames_of_streams_removed_from_the_surface_damage_nothing)
+{
+    using namespace testing;
+
+    std::function<void(geom::Size const&)> post_frame;
+    auto const buffer_stream = std::make_shared<NiceMock<mtd::MockBufferStream>>();
+    EXPECT_CALL(*buffer_stream, set_frame_posted_callback(_))
+        .WillOnce(SaveArg<0>(&post_frame))
+        .WillRepeatedly(Return());
+
+    surface.set_streams({{ mock_buffer_stream, {0,0}, {} }, { buffer_stream, {0,0}, {} }});
+    surface.set_streams({{ mock_buffer_stream, {0,0}, {} }});
+
+    NiceMock<MockSurfaceObserver> mock_surface_observer;
+    surface.add_observer(mt::fake_shared(mock_surface_observer));
+
+    EXPECT_CALL(mock_surface_observer, frame_posted(_, _, _)).Times(0);
+
+    // A frame racing the stream's removal
+    post_frame(geom::Size{10, 10});
+}
+
+TEST_F(BasicSurfaceTest, frames_posted_while_setting_streams_can_call_back_into_the_surface)
+{
+    using namespace testing;
+
+    struct QueryingObserver : ms::NullSurfaceObserver
+    {
+        void frame_posted(ms::Surface const* surface, int, geom::Rectangle const&) override
+        {
+            ++frames;
+            surface->input_area_contains({0, 0});
+        }
+        int frames{0};
+    } observer;
+    surface.add_observer(mt::fake_shared(observer));
+
+    // Lifting a frame interval posts the frame it deferred
+    std::function<void(geom::Size const&)> post_frame;
+    auto const buffer_stream = std::make_shared<NiceMock<mtd::MockBufferStream>>();
+    ON_CALL(*buffer_stream, set_frame_posted_callback(_))
+        .WillByDefault(SaveArg<0>(&post_frame));
+    ON_CALL(*buffer_stream, set_frame_interval(_))
+        .WillByDefault(InvokeWithoutArgs([&] { if (post_frame) post_frame({10, 10}); }));
+
+    surface.set_streams({{ buffer_stream, {0,0}, {} }});
+
+    EXPECT_THAT(observer.frames, Eq(1));
+}
+
 TEST_F(BasicSurfaceTest, showing_brings_all_streams_up_to_date)
 {
     using namespace testing;
@@ -1093,3 +1220,18 @@ TEST_F(BasicSurfaceTest, notifies_when_first_visible)
     EXPECT_THAT(observer->exposes(), Eq(1));
     EXPECT_THAT(observer->hides(), Eq(0));
 }
+
+TEST_F(BasicSurfaceTest, frame_interval_applies_to_all_streams)
+{
+    using namespace testing;
+    std::chrono::milliseconds const interval{40};
+    auto const buffer_stream = std::make_shared<NiceMock<mtd::MockBufferStream>>();
+
+    EXPECT_CALL(*mock_buffer_stream, set_frame_interval(interval));
+    surface.set_frame_interval(interval);
+    Mock::VerifyAndClearExpectations(mock_buffer_stream.get());
+
+    // Streams added later pick up the surface's limit
+    EXPECT_CALL(*buffer_stream, set_frame_interval(interval));
+    surface.set_streams({{ mock_buffer_stream, {0,0}, {} }, { buffer_stream, {0,0}, {} }});
+}
@@ -0,0 +1,127 @@
+/*
+ * Copyright © 2017 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "src/server/scene/frame_rate_governor.h"
+#include "src/server/scene/basic_surface.h"
+#include "src/server/report/null_report_factory.h"
+#include "mir/scene/frame_rate_policy.h"
+#include "mir/test/doubles/mock_buffer_stream.h"
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+namespace ms = mir::scene;
+namespace mg = mir::graphics;
+namespace mr = mir::report;
+namespace mtd = mir::test::doubles;
+namespace geom = mir::geometry;
+
+using namespace testing;
+
+namespace
+{
+struct MockFrameRatePolicy : ms::FrameRatePolicy
+{
+    MOCK_CONST_METHOD3(frame_interval_for,
+        std::chrono::milliseconds(MirWindowType, MirWindowFocusState, MirWindowVisibility));
+};
+
+struct FrameRateGovernor : Test
+{
+    FrameRateGovernor()
+    {
+        ON_CALL(*policy, frame_interval_for(_, _, _))
+            .WillByDefault(Return(std::chrono::milliseconds::zero()));
+    }
+
+    std::shared_ptr<NiceMock<MockFrameRatePolicy>> const policy =
+        std::make_shared<NiceMock<MockFrameRatePolicy>>();
+    std::shared_ptr<NiceMock<mtd::MockBufferStream>> const stream =
+        std::make_shared<NiceMock<mtd::MockBufferStream>>();
+    ms::BasicSurface surface{
+        "surface",
+        geom::Rectangle{{0,0},{100,100}},
+        mir_pointer_unconfined,
+        std::list<ms::StreamInfo>{{ stream, {}, {} }},
+        std::shared_ptr<mg::CursorImage>(),
+        mr::null_scene_report()};
+    ms::FrameRateGovernor governor{policy};
+
+    std::chrono::milliseconds const occluded_interval{1000};
+    std::chrono::milliseconds const unfocused_interval{100};
+};
+}
+
+TEST_F(FrameRateGovernor, applies_policy_to_new_surfaces_as_if_exposed)
+{
+    EXPECT_CALL(*policy, frame_interval_for(
+        mir_window_type_normal, mir_window_focus_state_unfocused, mir_window_visibility_exposed))
+        .WillOnce(Return(unfocused_interval));
+    EXPECT_CALL(*stream, set_frame_interval(unfocused_interval));
+
+    governor.surface_added(&surface);
+}
+
+TEST_F(FrameRateGovernor, only_treats_surfaces_as_occluded_once_they_have_been_exposed)
+{
+    ON_CALL(*policy, frame_interval_for(_, _, mir_window_visibility_occluded))
+        .WillByDefault(Return(occluded_interval));
+    EXPECT_CALL(*stream, set_frame_interval(occluded_interval)).Times(0);
+
+    governor.surface_added(&surface);
+    surface.configure(mir_window_attrib_focus, mir_window_focus_state_focused);
+    Mock::VerifyAndClearExpectations(stream.get());
+
+    EXPECT_CALL(*stream, set_frame_interval(occluded_interval));
+
+    surface.configure(mir_window_attrib_visibility, mir_window_visibility_exposed);
+    surface.configure(mir_window_attrib_visibility, mir_window_visibility_occluded);
+}
+
+TEST_F(FrameRateGovernor, reapplies_policy_when_visibility_and_focus_change)
+{
+    governor.surface_added(&surface);
+
+    ON_CALL(*policy, frame_interval_for(_, mir_window_focus_state_unfocused, mir_window_visibility_exposed))
+        .WillByDefault(Return(unfocused_interval));
+
+    InSequence seq;
+    EXPECT_CALL(*stream, set_frame_interval(unfocused_interval));
+    EXPECT_CALL(*stream, set_frame_interval(std::chrono::milliseconds::zero()));
+
+    surface.configure(mir_window_attrib_visibility, mir_window_visibility_exposed);
+    surface.configure(mir_window_attrib_focus, mir_window_focus_state_focused);
+}
+
+TEST_F(FrameRateGovernor, ignores_surfaces_once_removed)
+{
+    governor.surface_added(&surface);
+    governor.surface_removed(&surface);
+
+    EXPECT_CALL(*policy, frame_interval_for(_, _, _)).Times(0);
+
+    surface.configure(mir_window_attrib_visibility, mir_window_visibility_exposed);
+}
+
+TEST_F(FrameRateGovernor, ignores_surfaces_after_end_of_observation)
+{
+    governor.surface_exists(&surface);
+    governor.end_observation();
+
+    EXPECT_CALL(*policy, frame_interval_for(_, _, _)).Times(0);
+
+    surface.configure(mir_window_attrib_focus, mir_window_focus_state_focused);
+}
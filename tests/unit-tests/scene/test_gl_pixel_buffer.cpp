@@ -17,6 +17,7 @@
  */
 
 #include "src/server/scene/gl_pixel_buffer.h"
+#include "src/server/report/null_report_factory.h"
 #include "mir/renderer/gl/context.h"
 
 #include "mir/test/doubles/mock_gl_buffer.h"
@@ -105,7 +106,7 @@ ACTION(FillPixelsRGBA)
 
 TEST_F(GLPixelBufferTest, returns_empty_if_not_initialized)
 {
-    ms::GLPixelBuffer pixels{std::move(context)};
+    ms::GLPixelBuffer pixels{std::move(context), mir::report::null_memory_report()};
 
     EXPECT_EQ(geom::Size(), pixels.size());
     EXPECT_EQ(geom::Stride(), pixels.stride());
@@ -146,7 +147,7 @@ TEST_F(GLPixelBufferTest, returns_data_from_bgra_buffer_texture)
         EXPECT_CALL(mock_gl, glDeleteFramebuffers(_,_));
     }
 
-    ms::GLPixelBuffer pixels{std::move(context)};
+    ms::GLPixelBuffer pixels{std::move(context), mir::report::null_memory_report()};
 
     pixels.fill_from(mock_buffer);
     auto data = pixels.as_argb_8888();
@@ -207,7 +208,7 @@ TEST_F(GLPixelBufferTest, returns_data_from_rgba_buffer_texture)
         EXPECT_CALL(mock_gl, glDeleteFramebuffers(_,_));
     }
 
-    ms::GLPixelBuffer pixels{std::move(context)};
+    ms::GLPixelBuffer pixels{std::move(context), mir::report::null_memory_report()};
 
     pixels.fill_from(mock_buffer);
     auto data = pixels.as_argb_8888();
@@ -0,0 +1,164 @@
+/*
+ * Copyright © 2017 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "src/server/scene/input_region_index.h"
+#include "src/server/scene/basic_surface.h"
+#include "src/server/report/null_report_factory.h"
+#include "mir/test/doubles/stub_buffer_stream.h"
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+namespace ms = mir::scene;
+namespace mg = mir::graphics;
+namespace mr = mir::report;
+namespace mtd = mir::test::doubles;
+namespace geom = mir::geometry;
+
+using namespace testing;
+
+namespace
+{
+struct InputRegionIndex : Test
+{
+    std::shared_ptr<ms::BasicSurface> surface_at(geom::Rectangle const& rect)
+    {
+        return std::make_shared<ms::BasicSurface>(
+            "surface",
+            rect,
+            mir_pointer_unconfined,
+            std::list<ms::StreamInfo>{{ std::make_shared<mtd::StubBufferStream>(), {}, {} }},
+            std::shared_ptr<mg::CursorImage>(),
+            mr::null_scene_report());
+    }
+
+    ms::InputRegionIndex index;
+};
+}
+
+TEST_F(InputRegionIndex, finds_nothing_when_empty)
+{
+    EXPECT_THAT(index.top_surface_at({10, 10}), IsNull());
+}
+
+TEST_F(InputRegionIndex, finds_topmost_surface_containing_point)
+{
+    auto const bottom = surface_at({{0, 0}, {900, 900}});
+    auto const middle = surface_at({{100, 100}, {500, 200}});
+    auto const top = surface_at({{150, 50}, {200, 500}});
+
+    index.insert(bottom);
+    index.insert(middle);
+    index.insert(top);
+
+    EXPECT_THAT(index.top_surface_at({200, 150}), Eq(top));
+    EXPECT_THAT(index.top_surface_at({500, 150}), Eq(middle));
+    EXPECT_THAT(index.top_surface_at({800, 800}), Eq(bottom));
+    EXPECT_THAT(index.top_surface_at({950, 950}), IsNull());
+}
+
+TEST_F(InputRegionIndex, follows_surfaces_that_move)
+{
+    auto const surface = surface_at({{0, 0}, {100, 100}});
+    index.insert(surface);
+
+    surface->move_to({1000, 1000});
+
+    EXPECT_THAT(index.top_surface_at({50, 50}), IsNull());
+    EXPECT_THAT(index.top_surface_at({1050, 1050}), Eq(surface));
+}
+
+TEST_F(InputRegionIndex, follows_surfaces_that_resize)
+{
+    auto const surface = surface_at({{0, 0}, {100, 100}});
+    index.insert(surface);
+
+    surface->resize({1000, 1000});
+    EXPECT_THAT(index.top_surface_at({900, 900}), Eq(surface));
+
+    surface->resize({10, 10});
+    EXPECT_THAT(index.top_surface_at({50, 50}), IsNull());
+}
+
+TEST_F(InputRegionIndex, respects_restacking)
+{
+    auto const first = surface_at({{0, 0}, {100, 100}});
+    auto const second = surface_at({{0, 0}, {100, 100}});
+    index.insert(first);
+    index.insert(second);
+
+    index.restack({second, first});
+
+    EXPECT_THAT(index.top_surface_at({50, 50}), Eq(first));
+}
+
+TEST_F(InputRegionIndex, skips_candidates_whose_input_area_excludes_the_point)
+{
+    auto const bottom = surface_at({{0, 0}, {100, 100}});
+    auto const top = surface_at({{0, 0}, {100, 100}});
+    index.insert(bottom);
+    index.insert(top);
+
+    top->set_input_region({{{0, 0}, {10, 10}}});
+    EXPECT_THAT(index.top_surface_at({50, 50}), Eq(bottom));
+
+    top->set_hidden(true);
+    EXPECT_THAT(index.top_surface_at({5, 5}), Eq(bottom));
+}
+
+TEST_F(InputRegionIndex, finds_input_regions_extending_beyond_the_surface)
+{
+    auto const surface = surface_at({{0, 0}, {100, 100}});
+    index.insert(surface);
+
+    surface->set_input_region({{{-50, -50}, {500, 500}}});
+    EXPECT_THAT(index.top_surface_at({-25, -25}), Eq(surface));
+    EXPECT_THAT(index.top_surface_at({400, 400}), Eq(surface));
+
+    surface->set_input_region({});
+    EXPECT_THAT(index.top_surface_at({400, 400}), IsNull());
+}
+
+TEST_F(InputRegionIndex, finds_surfaces_at_negative_coordinates)
+{
+    auto const surface = surface_at({{-300, -300}, {100, 100}});
+    index.insert(surface);
+
+    EXPECT_THAT(index.top_surface_at({-250, -250}), Eq(surface));
+    EXPECT_THAT(index.top_surface_at({-150, -150}), IsNull());
+}
+
+TEST_F(InputRegionIndex, finds_surfaces_spanning_many_cells)
+{
+    auto const huge = surface_at({{0, 0}, {10000, 10000}});
+    auto const small = surface_at({{5000, 5000}, {10, 10}});
+    index.insert(huge);
+    index.insert(small);
+
+    EXPECT_THAT(index.top_surface_at({9000, 9000}), Eq(huge));
+    EXPECT_THAT(index.top_surface_at({5005, 5005}), Eq(small));
+}
+
+TEST_F(InputRegionIndex, stops_tracking_erased_surfaces)
+{
+    auto const surface = surface_at({{0, 0}, {100, 100}});
+    index.insert(surface);
+
+    index.erase(surface.get());
+    surface->move_to({10, 10});
+
+    EXPECT_THAT(index.top_surface_at({50, 50}), IsNull());
+}
@@ -95,7 +95,27 @@ TEST_F(LegacySceneChangeNotificationTest, observes_surface_changes)
 
     ms::LegacySceneChangeNotification observer(scene_change_callback, buffer_change_callback);
     observer.surface_added(&surface);
-    surface_observer->frame_posted(&surface, buffer_num, mir::geometry::Size{0, 0});
+    surface_observer->frame_posted(&surface, buffer_num, mir::geometry::Rectangle{{0, 0}, {0, 0}});
+}
+
+TEST_F(LegacySceneChangeNotificationTest, forwards_the_damage_of_posted_frames)
+{
+    using namespace ::testing;
+    std::shared_ptr<ms::SurfaceObserver> surface_observer;
+    EXPECT_CALL(surface, add_observer(_)).Times(1)
+        .WillOnce(SaveArg<0>(&surface_observer));
+
+    mir::geometry::Rectangle const damage{{110, 220}, {320, 240}};
+    mir::geometry::Rectangle damage_notified;
+    EXPECT_CALL(scene_callback, invoke()).Times(0);
+
+    ms::LegacySceneChangeNotification observer(
+        scene_change_callback,
+        [&](int, mir::geometry::Rectangle const& damage) { damage_notified = damage; });
+    observer.surface_added(&surface);
+    surface_observer->frame_posted(&surface, 1, damage);
+
+    EXPECT_THAT(damage_notified, Eq(damage));
 }
 
 TEST_F(LegacySceneChangeNotificationTest, redraws_on_rename)
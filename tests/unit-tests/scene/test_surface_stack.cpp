@@ -30,6 +30,7 @@
 #include "mir/test/doubles/stub_buffer_stream_factory.h"
 #include "mir/test/doubles/stub_renderable.h"
 #include "mir/test/doubles/mock_buffer_stream.h"
+#include "mir/test/doubles/stub_alarm_factory.h"
 
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
@@ -231,7 +232,7 @@ TEST_F(SurfaceStack, scene_counts_pending_accurately)
     ms::SurfaceStack stack{report};
     stack.register_compositor(this);
 
-    auto stream = std::make_shared<mc::Stream>(geom::Size{ 1, 1 }, mir_pixel_format_abgr_8888);
+    auto stream = std::make_shared<mc::Stream>(mr::null_buffer_lifetime_report(), std::make_shared<mtd::StubAlarmFactory>(), geom::Size{ 1, 1 }, mir_pixel_format_abgr_8888);
 
     auto surface = std::make_shared<ms::BasicSurface>(
         std::string("stub"),
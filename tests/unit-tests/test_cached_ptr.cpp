@@ -0,0 +1,134 @@
+/*
+ * Copyright © 2017 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "mir/cached_ptr.h"
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+using namespace testing;
+using namespace std::chrono_literals;
+
+namespace
+{
+struct Component {};
+}
+
+TEST(CachedPtr, constructs_once_while_referenced)
+{
+    mir::CachedPtr<Component> cached;
+    int constructed{0};
+    auto const make = [&] { ++constructed; return std::make_shared<Component>(); };
+
+    auto const first = cached(make);
+    auto const second = cached(make);
+
+    EXPECT_THAT(second, Eq(first));
+    EXPECT_THAT(constructed, Eq(1));
+}
+
+TEST(CachedPtr, constructs_again_once_released)
+{
+    mir::CachedPtr<Component> cached;
+    int constructed{0};
+    auto const make = [&] { ++constructed; return std::make_shared<Component>(); };
+
+    cached(make);
+    cached(make);
+
+    EXPECT_THAT(constructed, Eq(2));
+}
+
+TEST(CachedPtr, constructs_once_when_requested_from_several_threads)
+{
+    mir::CachedPtr<Component> cached;
+    std::atomic<int> constructed{0};
+    auto const make = [&]
+        {
+            ++constructed;
+            std::this_thread::sleep_for(10ms);
+            return std::make_shared<Component>();
+        };
+
+    std::vector<std::shared_ptr<Component>> results(4);
+    std::vector<std::thread> threads;
+    for (auto& result : results)
+        threads.emplace_back([&] { result = cached(make); });
+    for (auto& thread : threads)
+        thread.join();
+
+    EXPECT_THAT(constructed, Eq(1));
+    EXPECT_THAT(results, Each(Eq(results.front())));
+}
+
+TEST(CachedPtr, may_be_requested_again_while_wrapping_on_the_same_thread)
+{
+    mir::CachedPtr<Component> cached;
+    auto const wrapped = std::make_shared<Component>();
+
+    auto const result = cached([&]
+        {
+            return cached([&] { return wrapped; });
+        });
+
+    EXPECT_THAT(result, Eq(wrapped));
+}
+
+TEST(CachedPtr, speculative_construction_backs_off_from_construction_on_another_thread)
+{
+    mir::CachedPtr<Component> cached;
+    std::atomic<bool> constructing{false};
+    std::atomic<bool> backed_off{false};
+
+    std::thread other{[&]
+        {
+            cached([&]
+                {
+                    constructing = true;
+                    while (!backed_off)
+                        std::this_thread::yield();
+                    return std::make_shared<Component>();
+                });
+        }};
+
+    while (!constructing)
+        std::this_thread::yield();
+
+    {
+        mir::SpeculativeConstruction const speculative;
+        EXPECT_THROW(cached([] { return std::make_shared<Component>(); }), mir::ConstructionInProgress);
+    }
+    backed_off = true;
+    other.join();
+}
+
+TEST(CachedPtr, speculative_construction_may_request_again_while_wrapping_on_the_same_thread)
+{
+    mir::CachedPtr<Component> cached;
+    auto const wrapped = std::make_shared<Component>();
+    mir::SpeculativeConstruction const speculative;
+
+    auto const result = cached([&]
+        {
+            return cached([&] { return wrapped; });
+        });
+
+    EXPECT_THAT(result, Eq(wrapped));
+}
@@ -41,6 +41,9 @@ public:
     MOCK_METHOD2(probing_failed, void(boost::filesystem::path const&, std::exception const&));
     MOCK_METHOD1(loading_library, void(boost::filesystem::path const&));
     MOCK_METHOD2(loading_failed, void(boost::filesystem::path const&, std::exception const&));
+    MOCK_METHOD2(loading_finished, void(boost::filesystem::path const&, std::chrono::nanoseconds));
+    MOCK_METHOD2(probed_module, void(boost::filesystem::path const&, std::chrono::nanoseconds));
+    MOCK_METHOD3(selected_module, void(boost::filesystem::path const&, bool, std::chrono::nanoseconds));
 };
 
 class SharedLibraryProber : public testing::Test
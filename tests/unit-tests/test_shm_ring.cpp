@@ -0,0 +1,197 @@
+/*
+ * Copyright © 2017 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "mir/shm_ring.h"
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <numeric>
+#include <thread>
+#include <vector>
+
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <linux/memfd.h>
+#include <unistd.h>
+
+using namespace testing;
+
+namespace
+{
+bool is_readable(mir::Fd const& fd)
+{
+    pollfd pfd{fd, POLLIN, 0};
+    return poll(&pfd, 1, 0) == 1;
+}
+
+struct ShmRing : Test
+{
+    mir::ShmRing producer{4096};
+    mir::ShmRing consumer{producer.memory_fd(), producer.doorbell_fd()};
+};
+}
+
+TEST_F(ShmRing, reads_what_was_written_through_another_mapping)
+{
+    std::vector<char> const message{'h', 'e', 'l', 'l', 'o'};
+    ASSERT_TRUE(producer.write(message.data(), message.size()));
+
+    std::vector<char> received(message.size());
+    EXPECT_THAT(consumer.available(), Eq(message.size()));
+    ASSERT_TRUE(consumer.read(received.data(), received.size()));
+    EXPECT_THAT(received, Eq(message));
+    EXPECT_THAT(consumer.available(), Eq(0u));
+}
+
+TEST_F(ShmRing, wraps_around_the_end_of_the_buffer)
+{
+    std::vector<unsigned char> message(producer.capacity() * 3 / 4);
+    std::iota(begin(message), end(message), 0);
+    std::vector<unsigned char> received(message.size());
+
+    for (int i = 0; i != 3; ++i)
+    {
+        ASSERT_TRUE(producer.write(message.data(), message.size()));
+        ASSERT_TRUE(consumer.read(received.data(), received.size()));
+        EXPECT_THAT(received, Eq(message));
+    }
+}
+
+TEST_F(ShmRing, writes_nothing_if_there_is_no_room)
+{
+    std::vector<char> const block(producer.capacity() - 1);
+    std::vector<char> const overflow(2);
+
+    ASSERT_TRUE(producer.write(block.data(), block.size()));
+    EXPECT_FALSE(producer.write(overflow.data(), overflow.size()));
+    EXPECT_THAT(consumer.available(), Eq(block.size()));
+}
+
+TEST_F(ShmRing, reports_the_room_left_to_write)
+{
+    std::vector<char> const message(1000);
+
+    EXPECT_THAT(producer.free_space(), Eq(producer.capacity()));
+    ASSERT_TRUE(producer.write(message.data(), message.size()));
+    EXPECT_THAT(producer.free_space(), Eq(producer.capacity() - message.size()));
+}
+
+TEST_F(ShmRing, reads_nothing_until_enough_has_arrived)
+{
+    char const header[2]{0, 3};
+    ASSERT_TRUE(producer.write(header, 1));
+
+    char received[2];
+    EXPECT_FALSE(consumer.read(received, sizeof received));
+    EXPECT_THAT(consumer.available(), Eq(1u));
+}
+
+TEST_F(ShmRing, writes_spans_as_one)
+{
+    char const header[2]{0, 3};
+    char const body[3]{'a', 'b', 'c'};
+    ASSERT_TRUE(producer.write({{header, sizeof header}, {body, sizeof body}}));
+
+    char received[5];
+    ASSERT_TRUE(consumer.read(received, sizeof received));
+    EXPECT_THAT(std::vector<char>(received, received + 5), ElementsAre(0, 3, 'a', 'b', 'c'));
+}
+
+TEST_F(ShmRing, rings_the_doorbell_only_for_a_waiting_consumer)
+{
+    char const byte{'x'};
+
+    ASSERT_TRUE(producer.write(&byte, 1));
+    EXPECT_FALSE(is_readable(consumer.doorbell_fd()));
+
+    char received;
+    ASSERT_TRUE(consumer.read(&received, 1));
+
+    ASSERT_TRUE(consumer.prepare_to_wait(1));
+    ASSERT_TRUE(producer.write(&byte, 1));
+    EXPECT_TRUE(is_readable(consumer.doorbell_fd()));
+
+    consumer.clear_doorbell();
+    EXPECT_FALSE(is_readable(consumer.doorbell_fd()));
+}
+
+TEST_F(ShmRing, does_not_wait_for_data_that_has_arrived)
+{
+    char const byte{'x'};
+    ASSERT_TRUE(producer.write(&byte, 1));
+
+    EXPECT_FALSE(consumer.prepare_to_wait(1));
+    EXPECT_TRUE(consumer.prepare_to_wait(2));
+}
+
+TEST_F(ShmRing, refuses_memory_that_can_be_resized)
+{
+    mir::Fd const memory{static_cast<int>(syscall(SYS_memfd_create, "unsealed", MFD_CLOEXEC))};
+    ASSERT_THAT(ftruncate(memory, 4096 + 4096), Eq(0));
+
+    EXPECT_THROW((mir::ShmRing{memory, producer.doorbell_fd()}), std::runtime_error);
+}
+
+TEST_F(ShmRing, notices_a_corrupted_tail)
+{
+    // The tail is the second index, on its own cache line
+    auto const header = static_cast<uint64_t*>(
+        mmap(nullptr, 4096, PROT_READ | PROT_WRITE, MAP_SHARED, producer.memory_fd(), 0));
+    header[8] = 12345;
+    munmap(header, 4096);
+
+    EXPECT_THROW(consumer.available(), std::runtime_error);
+    EXPECT_THAT(producer.free_space(), Eq(0u));
+    char const byte{'x'};
+    EXPECT_FALSE(producer.write(&byte, 1));
+}
+
+TEST_F(ShmRing, carries_a_stream_between_threads)
+{
+    int const messages{10000};
+
+    std::thread writer{[this]
+        {
+            for (int i = 0; i != messages;)
+            {
+                if (producer.write(&i, sizeof i))
+                    ++i;
+                else
+                    std::this_thread::yield();
+            }
+        }};
+
+    for (int i = 0; i != messages; ++i)
+    {
+        int received{-1};
+        while (!consumer.read(&received, sizeof received))
+        {
+            if (consumer.prepare_to_wait(sizeof received))
+            {
+                pollfd pfd{consumer.doorbell_fd(), POLLIN, 0};
+                poll(&pfd, 1, -1);
+                consumer.clear_doorbell();
+            }
+        }
+        ASSERT_THAT(received, Eq(i));
+    }
+
+    writer.join();
+}
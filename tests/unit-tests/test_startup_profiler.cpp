@@ -0,0 +1,103 @@
+/*
+ * Copyright © 2017 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "mir/startup_profiler.h"
+#include "mir/cached_ptr.h"
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <sstream>
+#include <thread>
+
+using namespace testing;
+using namespace std::chrono_literals;
+
+namespace
+{
+struct StartupProfiler : Test
+{
+    StartupProfiler()
+    {
+        mir::enable_startup_profile();
+    }
+
+    std::string profile() const
+    {
+        std::ostringstream out;
+        mir::write_startup_profile(out);
+        return out.str();
+    }
+
+    /// The time recorded for the stack, or -1 if it wasn't recorded
+    long time_of(std::string const& stack) const
+    {
+        std::istringstream in{profile()};
+        for (std::string line; std::getline(in, line);)
+        {
+            auto const separator = line.rfind(' ');
+            if (line.substr(0, separator) == stack)
+                return std::stol(line.substr(separator + 1));
+        }
+        return -1;
+    }
+};
+
+struct ProfiledComponent {};
+}
+
+TEST_F(StartupProfiler, records_nested_phases_as_stacks)
+{
+    {
+        mir::StartupPhase const outer{"outer"};
+        mir::StartupPhase const inner{"inner"};
+    }
+
+    EXPECT_THAT(time_of("outer"), Ge(0));
+    EXPECT_THAT(time_of("outer;inner"), Ge(0));
+}
+
+TEST_F(StartupProfiler, excludes_nested_phases_from_the_time_of_the_outer_phase)
+{
+    {
+        mir::StartupPhase const outer{"sleepy_outer"};
+        mir::StartupPhase const inner{"sleepy_inner"};
+        std::this_thread::sleep_for(20ms);
+    }
+
+    EXPECT_THAT(time_of("sleepy_outer;sleepy_inner"), Ge(20000));
+    EXPECT_THAT(time_of("sleepy_outer"), Lt(20000));
+}
+
+TEST_F(StartupProfiler, records_construction_through_cached_ptr)
+{
+    mir::CachedPtr<ProfiledComponent> component;
+
+    auto const constructed = component([] { return std::make_shared<ProfiledComponent>(); });
+
+    EXPECT_THAT(profile(), HasSubstr("ProfiledComponent "));
+    EXPECT_THAT(profile(), Not(HasSubstr("shared_ptr")));
+}
+
+TEST_F(StartupProfiler, records_phases_on_other_threads_as_separate_stacks)
+{
+    mir::StartupPhase const outer{"main_thread"};
+
+    std::thread{[] { mir::StartupPhase const phase{"other_thread"}; }}.join();
+
+    EXPECT_THAT(time_of("other_thread"), Ge(0));
+    EXPECT_THAT(time_of("main_thread;other_thread"), Eq(-1));
+}